@@ -0,0 +1,210 @@
+/*
+ * lzblock - a small LZ77 block codec.
+ *
+ * Copyright: see the accompanying file COPYING or copy at
+ * https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ */
+
+#include "lzblock.h"
+
+#include <stdint.h>
+#include <string.h>
+
+#define LZBLOCK_MIN_MATCH 4
+#define LZBLOCK_MAX_OFFSET 65535
+#define LZBLOCK_HASH_BITS 14
+#define LZBLOCK_LAST_LITERALS 5  /* the last bytes of a block are always literals */
+#define LZBLOCK_MATCH_LIMIT 12   /* a match cannot start in the last bytes of a block */
+
+static uint32_t read32(const unsigned char* p)
+{
+  uint32_t result;
+  memcpy(&result, p, sizeof(result));
+  return result;
+}
+
+static uint32_t hash32(uint32_t value)
+{
+  return (value * 2654435761U) >> (32 - LZBLOCK_HASH_BITS);
+}
+
+static unsigned char* write_length(unsigned char* out, size_t length)
+{
+  while (length >= 255)
+  {
+    *out++ = 255;
+    length -= 255;
+  }
+  *out++ = (unsigned char)length;
+  return out;
+}
+
+static unsigned char* write_sequence(unsigned char* out,
+                                     const unsigned char* literals,
+                                     size_t literal_length,
+                                     size_t offset,
+                                     size_t match_length)
+{
+  unsigned char* token = out++;
+  *token = (unsigned char)((literal_length >= 15 ? 15 : literal_length) << 4);
+  if (literal_length >= 15)
+  {
+    out = write_length(out, literal_length - 15);
+  }
+  if (literal_length > 0)
+  {
+    memcpy(out, literals, literal_length);
+    out += literal_length;
+  }
+
+  if (match_length > 0)
+  {
+    size_t length = match_length - LZBLOCK_MIN_MATCH;
+    *out++ = (unsigned char)(offset & 255);
+    *out++ = (unsigned char)(offset >> 8);
+    *token |= (unsigned char)(length >= 15 ? 15 : length);
+    if (length >= 15)
+    {
+      out = write_length(out, length - 15);
+    }
+  }
+  return out;
+}
+
+size_t lzblock_compress_bound(size_t size)
+{
+  return size + size / 255 + 16;
+}
+
+size_t lzblock_compress(const unsigned char* source, size_t size, unsigned char* destination)
+{
+  uint32_t table[1 << LZBLOCK_HASH_BITS];
+  const unsigned char* anchor = source;
+  const unsigned char* in = source;
+  const unsigned char* end = source + size;
+  unsigned char* out = destination;
+
+  if (size >= LZBLOCK_MATCH_LIMIT)
+  {
+    const unsigned char* match_limit = end - LZBLOCK_MATCH_LIMIT;
+    const unsigned char* extend_limit = end - LZBLOCK_LAST_LITERALS;
+    memset(table, 0, sizeof(table));
+
+    while (in < match_limit)
+    {
+      uint32_t value = read32(in);
+      uint32_t h = hash32(value);
+      const unsigned char* candidate = source + table[h];
+      table[h] = (uint32_t)(in - source);
+
+      if (candidate < in && (size_t)(in - candidate) <= LZBLOCK_MAX_OFFSET && read32(candidate) == value)
+      {
+        const unsigned char* match_end = in + LZBLOCK_MIN_MATCH;
+        const unsigned char* reference = candidate + LZBLOCK_MIN_MATCH;
+        while (match_end < extend_limit && *match_end == *reference)
+        {
+          ++match_end;
+          ++reference;
+        }
+
+        out = write_sequence(out, anchor, (size_t)(in - anchor), (size_t)(in - candidate), (size_t)(match_end - in));
+        in = match_end;
+        anchor = in;
+      }
+      else
+      {
+        ++in;
+      }
+    }
+  }
+
+  return (size_t)(write_sequence(out, anchor, (size_t)(end - anchor), 0, 0) - destination);
+}
+
+/* Reads an additional length that follows a nibble of 15, returns zero when the input ends. */
+static int read_length(const unsigned char** in, const unsigned char* end, size_t* length)
+{
+  unsigned char byte;
+  do
+  {
+    if (*in >= end)
+    {
+      return 0;
+    }
+    byte = *(*in)++;
+    *length += byte;
+  }
+  while (byte == 255);
+  return 1;
+}
+
+int lzblock_decompress(const unsigned char* source, size_t size, unsigned char* destination, size_t original_size)
+{
+  const unsigned char* in = source;
+  const unsigned char* in_end = source + size;
+  unsigned char* out = destination;
+  unsigned char* out_end = destination + original_size;
+
+  while (in < in_end)
+  {
+    unsigned char token = *in++;
+    size_t literal_length = token >> 4;
+    if (literal_length == 15 && !read_length(&in, in_end, &literal_length))
+    {
+      return 1;
+    }
+    if (literal_length > (size_t)(in_end - in) || literal_length > (size_t)(out_end - out))
+    {
+      return 1;
+    }
+    if (literal_length > 0)
+    {
+      memcpy(out, in, literal_length);
+      in += literal_length;
+      out += literal_length;
+    }
+
+    if (in == in_end)
+    {
+      break; /* the last sequence only consists of literals */
+    }
+
+    if (in_end - in < 2)
+    {
+      return 1;
+    }
+    size_t offset = (size_t)in[0] | ((size_t)in[1] << 8);
+    in += 2;
+    size_t match_length = token & 15;
+    if (match_length == 15 && !read_length(&in, in_end, &match_length))
+    {
+      return 1;
+    }
+    match_length += LZBLOCK_MIN_MATCH;
+    if (offset == 0 || offset > (size_t)(out - destination) || match_length > (size_t)(out_end - out))
+    {
+      return 1;
+    }
+
+    /* The match may overlap with the bytes that it produces, so it is copied byte by byte in that case. */
+    const unsigned char* reference = out - offset;
+    if (offset >= match_length)
+    {
+      memcpy(out, reference, match_length);
+      out += match_length;
+    }
+    else
+    {
+      for (size_t i = 0; i < match_length; ++i)
+      {
+        *out++ = *reference++;
+      }
+    }
+  }
+
+  return out == out_end ? 0 : 1;
+}
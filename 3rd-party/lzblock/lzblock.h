@@ -0,0 +1,44 @@
+/*
+ * lzblock - a small LZ77 block codec.
+ *
+ * Copyright: see the accompanying file COPYING or copy at
+ * https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+ *
+ * Distributed under the Boost Software License, Version 1.0.
+ * (See accompanying file LICENSE_1_0.txt or copy at
+ * http://www.boost.org/LICENSE_1_0.txt)
+ *
+ * The compressed data uses the LZ4 block format: a sequence consists of a token
+ * byte with the number of literals in the high and the match length minus four
+ * in the low nibble, optional additional length bytes, the literals, a two byte
+ * little endian match offset and optional additional match length bytes. The
+ * last sequence only contains literals. Blocks are compressed independently, and
+ * the size of the uncompressed block must be known to decompress it.
+ */
+
+#ifndef LZBLOCK_H
+#define LZBLOCK_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Returns the maximum size of the compressed data for a block of the given size. */
+size_t lzblock_compress_bound(size_t size);
+
+/* Compresses size bytes from source into destination, which must have room for
+ * lzblock_compress_bound(size) bytes. Returns the size of the compressed data. */
+size_t lzblock_compress(const unsigned char* source, size_t size, unsigned char* destination);
+
+/* Decompresses size bytes from source into destination, which must have room for
+ * exactly original_size bytes. Returns zero on success and a non-zero value when
+ * the compressed data is malformed or does not decompress to original_size bytes. */
+int lzblock_decompress(const unsigned char* source, size_t size, unsigned char* destination, size_t original_size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LZBLOCK_H */
@@ -29,14 +29,16 @@ namespace atermpp
 ///          Packet headers also contain a special value to indicate that the read term should be visible as output as opposed to
 ///          being only a subterm.
 ///          The start of the stream is a zero followed by a header and a version and a term with function symbol index zero
-///          indicates the end of the stream.
+///          indicates the end of the stream. When the stream is compressed a flag is set in the version, and all data after
+///          the header is compressed in blocks by the underlying bitstream.
 ///
 class binary_aterm_ostream final : public aterm_ostream
 {
 public:
   /// \brief Provide the output stream to which the terms are written.
-  binary_aterm_ostream(std::ostream& os);
-  binary_aterm_ostream(std::shared_ptr<mcrl2::utilities::obitstream> stream);
+  /// \param compress Whether the terms are compressed.
+  binary_aterm_ostream(std::ostream& os, bool compress = false);
+  binary_aterm_ostream(std::shared_ptr<mcrl2::utilities::obitstream> stream, bool compress = false);
 
   ~binary_aterm_ostream() override;
 
@@ -18,6 +18,10 @@
 namespace atermpp::detail
 {
 
+/// \brief The garbage collections of the term pool, and the number of terms that they removed.
+inline const mcrl2::utilities::performance_span garbage_collection_span("atermpp.garbage_collection");
+inline const mcrl2::utilities::performance_counter terms_collected_counter("atermpp.garbage_collection.terms_removed");
+
 aterm_pool::aterm_pool() :
   m_int_storage(*this),
   m_appl_storage(
@@ -210,6 +214,7 @@ void aterm_pool::collect_impl(mcrl2::utilities::shared_mutex& shared_mutex)
       return;
     } 
 
+    mcrl2::utilities::scoped_performance_span span(garbage_collection_span);
     auto timestamp = std::chrono::system_clock::now();
     std::size_t old_size = size();
 
@@ -267,6 +272,8 @@ void aterm_pool::collect_impl(mcrl2::utilities::shared_mutex& shared_mutex)
         << mark_duration + sweep_duration << " ms (marking " << mark_duration << " ms + sweep " << sweep_duration << " ms).\n";
     }
 
+    terms_collected_counter.add(old_size - size());
+
     // Garbage collect function symbols.
     m_function_symbol_pool.sweep();
 
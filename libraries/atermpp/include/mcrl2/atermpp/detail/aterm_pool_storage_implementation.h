@@ -10,6 +10,7 @@
 #ifndef MCRL2_ATERMPP_DETAIL_ATERM_POOL_STORAGE_IMPLEMENTATION_H
 #define MCRL2_ATERMPP_DETAIL_ATERM_POOL_STORAGE_IMPLEMENTATION_H
 
+#include "mcrl2/utilities/performance_counters.h"
 #include "mcrl2/utilities/stack_array.h"
 #include "mcrl2/atermpp/detail/aterm_pool.h"
 
@@ -20,6 +21,10 @@
 namespace atermpp::detail
 {
 
+/// \brief The number of term lookups in the hash tables of the term pool, and the number of lookups that created a new term.
+inline const mcrl2::utilities::performance_counter term_lookups_counter("atermpp.hashtable.lookups");
+inline const mcrl2::utilities::performance_counter terms_created_counter("atermpp.hashtable.terms_created");
+
 /// \brief Construct the proxy where its arguments are given by applying the converter
 ///        to each element in the iterator.
 template <std::size_t N,
@@ -413,8 +418,10 @@ bool ATERM_POOL_STORAGE::emplace(aterm_core& term, Args&&... args)
   auto [it, added] = m_term_set.emplace(std::forward<Args>(args)...);
   new (&term) atermpp::unprotected_aterm_core(&*it); 
 
+  term_lookups_counter.add();
   if (added)
   {
+    terms_created_counter.add();
     if (EnableCreationMetrics) { m_term_metric.miss(); }
   }
   else if (EnableCreationMetrics)
@@ -39,6 +39,10 @@ static constexpr std::uint16_t BAF_MAGIC = 0x8baf;
 /// 6  August 2024    : version changed to 0x8308 (introduced machine numbers)
 static constexpr std::uint16_t BAF_VERSION = 0x8308;
 
+/// \brief This flag is added to the version when the data after the header is compressed.
+/// \details Older versions of the toolset report these files as having an incompatible version.
+static constexpr std::uint16_t BAF_COMPRESSED = 0x4000;
+
 /// \brief Each packet has a header consisting of a type.
 /// \details Either indicates a function symbol, a term (either shared or output) or an arbitrary integer.
 enum class packet_type
@@ -52,7 +56,7 @@ enum class packet_type
 /// \brief The number of bits needed to store an element of packet_type.
 static constexpr unsigned int packet_bits = 2;
 
-binary_aterm_ostream::binary_aterm_ostream(std::shared_ptr<mcrl2::utilities::obitstream> stream)
+binary_aterm_ostream::binary_aterm_ostream(std::shared_ptr<mcrl2::utilities::obitstream> stream, bool compress)
   : m_stream(stream)
 {
   // The term with function symbol index 0 indicates the end of the stream, its actual value does not matter.
@@ -62,11 +66,16 @@ binary_aterm_ostream::binary_aterm_ostream(std::shared_ptr<mcrl2::utilities::obi
   // Write the header of the binary aterm format.
   m_stream->write_bits(0, 8);
   m_stream->write_bits(BAF_MAGIC, 16);
-  m_stream->write_bits(BAF_VERSION, 16);  
+  m_stream->write_bits(compress ? BAF_VERSION | BAF_COMPRESSED : BAF_VERSION, 16);
+
+  if (compress)
+  {
+    m_stream->enable_compression();
+  }
 }
 
-binary_aterm_ostream::binary_aterm_ostream(std::ostream& stream)
-  : binary_aterm_ostream(std::make_shared<mcrl2::utilities::obitstream>(stream))
+binary_aterm_ostream::binary_aterm_ostream(std::ostream& stream, bool compress)
+  : binary_aterm_ostream(std::make_shared<mcrl2::utilities::obitstream>(stream), compress)
 {}
 
 binary_aterm_ostream::~binary_aterm_ostream()
@@ -205,11 +214,18 @@ binary_aterm_istream::binary_aterm_istream(std::shared_ptr<mcrl2::utilities::ibi
   }
 
   std::size_t version = m_stream->read_bits(16);
+  const bool compressed = (version & BAF_COMPRESSED) != 0;
+  version &= ~static_cast<std::size_t>(BAF_COMPRESSED);
   if (version != BAF_VERSION)
   {
     throw mcrl2::runtime_error("The BAF version (" + std::to_string(version) + ") of the input file is incompatible with the version (" + std::to_string(BAF_VERSION) +
                                ") of this tool. The input file must be regenerated. ");
   }
+
+  if (compressed)
+  {
+    m_stream->enable_decompression();
+  }
 }
 
 binary_aterm_istream::binary_aterm_istream(std::istream& is)
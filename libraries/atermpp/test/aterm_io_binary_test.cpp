@@ -104,3 +104,35 @@ BOOST_AUTO_TEST_CASE(transitions_test)
     BOOST_CHECK_EQUAL(t, term);
   }
 }
+
+BOOST_AUTO_TEST_CASE(compressed_test)
+{
+  // A long sequence of similar terms, such that the compressed stream consists of several blocks.
+  std::vector<aterm> sequence;
+  function_symbol f("f", 2);
+  for (std::size_t index = 0; index < 100000; ++index)
+  {
+    sequence.emplace_back(f, aterm_int(index % 1000), aterm(function_symbol("g" + std::to_string(index % 10), 0)));
+  }
+
+  std::stringstream uncompressed;
+  std::stringstream compressed;
+  {
+    binary_aterm_ostream output(uncompressed, false);
+    binary_aterm_ostream compressed_output(compressed, true);
+    for (const atermpp::aterm& term : sequence)
+    {
+      output << term;
+      compressed_output << term;
+    }
+  }
+  BOOST_CHECK(compressed.str().size() < uncompressed.str().size());
+
+  binary_aterm_istream input(compressed);
+  for (const atermpp::aterm& term : sequence)
+  {
+    aterm t;
+    input.get(t);
+    BOOST_CHECK_EQUAL(t, term);
+  }
+}
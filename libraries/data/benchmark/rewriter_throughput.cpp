@@ -0,0 +1,150 @@
+// Author(s): agent
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file rewriter_throughput.cpp
+/// \brief Measures the throughput of a rewrite strategy on a number of small workloads, and writes the results
+///        in JSON format such that they can be compared across commits.
+
+#include "mcrl2/data/parse.h"
+#include "mcrl2/data/rewriter.h"
+#include "mcrl2/utilities/performance_counters.h"
+#include "mcrl2/utilities/stopwatch.h"
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+using namespace mcrl2;
+
+// Every workload rewrites an expression in the free variable n, for values of n from 0 up to range.
+const std::string DATA_SPECIFICATION =
+  "sort Tree = struct leaf | node(left: Tree, value: Nat, right: Tree);\n"
+  "\n"
+  "map fib: Nat -> Nat;\n"
+  "    alternate: Nat # Int -> Int;\n"
+  "    range: Nat -> List(Nat);\n"
+  "    reverse: List(Nat) # List(Nat) -> List(Nat);\n"
+  "    total: List(Nat) -> Nat;\n"
+  "    to_set: Nat -> Set(Nat);\n"
+  "    to_bag: Nat -> FBag(Nat);\n"
+  "    update: Nat # (Nat -> Nat) -> (Nat -> Nat);\n"
+  "    insert: Nat # Tree -> Tree;\n"
+  "    build: Nat # Tree -> Tree;\n"
+  "    total: Tree -> Nat;\n"
+  "\n"
+  "var n, m: Nat; x: Int; l, r: List(Nat); f: Nat -> Nat; t, u: Tree;\n"
+  "eqn n <= 1 -> fib(n) = n;\n"
+  "    n > 1 -> fib(n) = fib(Int2Nat(n - 1)) + fib(Int2Nat(n - 2));\n"
+  "    alternate(0, x) = x;\n"
+  "    n > 0 -> alternate(n, x) = alternate(Int2Nat(n - 1), n * n - x);\n"
+  "    range(0) = [];\n"
+  "    n > 0 -> range(n) = n |> range(Int2Nat(n - 1));\n"
+  "    reverse([], r) = r;\n"
+  "    reverse(n |> l, r) = reverse(l, n |> r);\n"
+  "    total([]) = 0;\n"
+  "    total(n |> l) = n + total(l);\n"
+  "    to_set(0) = {};\n"
+  "    n > 0 -> to_set(n) = {n mod 17} + to_set(Int2Nat(n - 1));\n"
+  "    to_bag(0) = {:};\n"
+  "    n > 0 -> to_bag(n) = {n mod 7: 1} + to_bag(Int2Nat(n - 1));\n"
+  "    update(0, f) = f;\n"
+  "    n > 0 -> update(n, f) = update(Int2Nat(n - 1), f[n mod 13 -> f(n mod 13) + n]);\n"
+  "    insert(n, leaf) = node(leaf, n, leaf);\n"
+  "    n < m -> insert(n, node(t, m, u)) = node(insert(n, t), m, u);\n"
+  "    n >= m -> insert(n, node(t, m, u)) = node(t, m, insert(n, u));\n"
+  "    build(0, t) = t;\n"
+  "    n > 0 -> build(n, t) = build(Int2Nat(n - 1), insert((n * 7919) mod 1021, t));\n"
+  "    total(leaf) = 0;\n"
+  "    total(node(t, n, u)) = total(t) + n + total(u);\n";
+
+struct workload
+{
+  std::string name;
+  std::string expression;
+  std::size_t range;
+  std::size_t iterations;
+};
+
+const std::vector<workload> WORKLOADS = {
+  {"nat", "fib(n)", 16, 500},
+  {"int", "alternate(n, -7)", 200, 500},
+  {"list", "total(reverse(range(n), []))", 200, 200},
+  {"set", "n mod 17 in to_set(n) && to_set(n) * to_set(n div 2) == to_set(n div 2)", 100, 200},
+  {"fbag", "count(n mod 7, to_bag(n) + to_bag(n div 2))", 200, 400},
+  {"function_update", "update(n, lambda m: Nat. 0)(n mod 13)", 100, 400},
+  {"structured_sort", "total(build(n, leaf))", 200, 400},
+};
+
+int main(int argc, char* argv[])
+{
+  // Accept the rewrite strategy, the name of the output file and a scaling factor for the number of iterations.
+  data::rewrite_strategy strategy = data::jitty;
+  std::string output_filename;
+  std::size_t scale = 1;
+  if (argc > 1)
+  {
+    strategy = data::parse_rewrite_strategy(argv[1]);
+  }
+  if (argc > 2)
+  {
+    output_filename = argv[2];
+  }
+  if (argc > 3)
+  {
+    scale = static_cast<std::size_t>(std::stoul(argv[3]));
+  }
+
+  utilities::enable_performance_counters();
+  const utilities::performance_counter terms_created("atermpp.hashtable.terms_created");
+
+  const data::data_specification dataspec = data::parse_data_specification(DATA_SPECIFICATION);
+  const data::variable n("n", data::sort_nat::nat());
+
+  stopwatch timer;
+  data::rewriter rewr(dataspec, strategy);
+  const double initialisation_time = timer.seconds();
+
+  std::ostringstream out;
+  out << "{\n  \"strategy\": \"" << strategy << "\",\n  \"initialisation_seconds\": " << initialisation_time
+      << ",\n  \"workloads\": {";
+  for (const workload& w: WORKLOADS)
+  {
+    const data::data_expression x = rewr(data::parse_data_expression(w.expression, data::variable_list({n}), dataspec));
+    const std::size_t iterations = w.iterations * scale;
+
+    data::mutable_indexed_substitution<> sigma;
+    data::data_expression result;
+    const std::uint64_t terms_before = terms_created.value();
+    timer.reset();
+    for (std::size_t i = 0; i < iterations; ++i)
+    {
+      sigma[n] = data::sort_nat::nat(i % (w.range + 1));
+      rewr(result, x, sigma);
+    }
+    const double seconds = timer.seconds();
+    const std::uint64_t terms = terms_created.value() - terms_before;
+
+    out << (&w == &WORKLOADS.front() ? "\n    \"" : ",\n    \"") << w.name << "\": { \"rewrites\": " << iterations
+        << ", \"seconds\": " << seconds
+        << ", \"rewrites_per_second\": " << static_cast<double>(iterations) / seconds
+        << ", \"terms_created\": " << terms << " }";
+    std::cerr << w.name << ": " << static_cast<double>(iterations) / seconds << " rewrites/s, " << terms
+              << " terms created\n";
+  }
+  out << "\n  }\n}\n";
+
+  if (output_filename.empty())
+  {
+    std::cout << out.str();
+  }
+  else
+  {
+    std::ofstream(output_filename) << out.str();
+  }
+  return 0;
+}
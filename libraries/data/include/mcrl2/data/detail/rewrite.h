@@ -11,6 +11,8 @@
 #ifndef MCRL2_DATA_DETAIL_REWRITE_H
 #define MCRL2_DATA_DETAIL_REWRITE_H
 
+#include <span>
+
 #include "mcrl2/data/detail/enumerator_identifier_generator.h"
 #include "mcrl2/data/rewrite_strategy.h"
 #include "mcrl2/data/selection.h"
@@ -92,6 +94,35 @@ class Rewriter
      **/
     virtual void rewrite(data_expression& result, const data_expression& term, substitution_type& sigma) = 0;
 
+    /**
+     * \brief Rewrite a sequence of mCRL2 data terms under the same substitution.
+     * \details The normal form of terms[i] is put in results[i]. This default implementation rewrites
+     *          the terms one by one; rewriters override it to set up the substitution and the rewrite
+     *          stack only once for all terms.
+     **/
+    virtual void rewrite_all(std::span<data_expression> results, std::span<const data_expression> terms, substitution_type& sigma)
+    {
+      assert(results.size() == terms.size());
+      for (std::size_t i = 0; i < terms.size(); ++i)
+      {
+        rewrite(results[i], terms[i], sigma);
+      }
+    }
+
+    /**
+     * \brief Rewrite one mCRL2 data term under a sequence of substitutions.
+     * \details The normal form of term under sigmas[i] is put in results[i]. As above, this default
+     *          implementation rewrites the term for each substitution separately.
+     **/
+    virtual void rewrite_all(std::span<data_expression> results, const data_expression& term, std::span<substitution_type> sigmas)
+    {
+      assert(results.size() == sigmas.size());
+      for (std::size_t i = 0; i < sigmas.size(); ++i)
+      {
+        rewrite(results[i], term, sigmas[i]);
+      }
+    }
+
     /**
      * \brief Provide the rewriter with a () operator, such that it can also
      *        rewrite terms using this operator.
@@ -66,6 +66,10 @@ class RewriterJitty: public Rewriter
 
     void rewrite(data_expression& result, const data_expression& term, substitution_type& sigma) override;
 
+    void rewrite_all(std::span<data_expression> results, std::span<const data_expression> terms, substitution_type& sigma) override;
+
+    void rewrite_all(std::span<data_expression> results, const data_expression& term, std::span<substitution_type> sigmas) override;
+
     std::shared_ptr<detail::Rewriter> clone() override { return std::shared_ptr<Rewriter>(new RewriterJitty(*this)); }
 
     const function_symbol& this_term_is_in_normal_form() 
@@ -100,6 +104,10 @@ class RewriterJitty: public Rewriter
 
     void rewrite_aux(data_expression& result, const data_expression& term, substitution_type& sigma);
 
+    // Calls rewrite_term(i) for i in [0, n), setting up rewriting only once for all terms.
+    template <typename RewriteTerm>
+    void rewrite_sequence(std::size_t n, RewriteTerm rewrite_term);
+
     void rewrite_aux_function_symbol(data_expression& result,
       const function_symbol& op,
       const application& term,
@@ -89,6 +89,10 @@ class RewriterCompilingJitty: public Rewriter
 
     void rewrite(data_expression& result, const data_expression& term, substitution_type& sigma) override;
 
+    void rewrite_all(std::span<data_expression> results, std::span<const data_expression> terms, substitution_type& sigma) override;
+
+    void rewrite_all(std::span<data_expression> results, const data_expression& term, std::span<substitution_type> sigmas) override;
+
     // The variable global_sigma is a temporary store to maintain the substitution 
     // sigma during rewriting a single term. It is not a variable for public use.
     substitution_type* global_sigma = nullptr;
@@ -265,6 +269,11 @@ class RewriterCompilingJitty: public Rewriter
     void (*so_rewr_cleanup)();
     void (*so_rewr)(data_expression& result, const data_expression&, RewriterCompilingJitty*);
 
+    // Calls rewrite_term(i) for i in [0, n), setting up rewriting only once for all terms.
+    // If sigma is not nullptr, it is installed as the global substitution once for all terms.
+    template <typename RewriteTerm>
+    void rewrite_sequence(std::size_t n, substitution_type* sigma, RewriteTerm rewrite_term);
+
     void add_base_nfs(nfs_array& a, const function_symbol& opid, std::size_t arity);
     void extend_nfs(nfs_array& a, const function_symbol& opid, std::size_t arity);
     bool opid_is_nf(const function_symbol& opid, std::size_t num_args);
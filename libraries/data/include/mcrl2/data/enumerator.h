@@ -593,6 +593,15 @@ class enumerator_queue
     }
 };
 
+namespace detail
+{
+
+/// \brief The number of elements processed by the enumerator, and the largest size of its queue.
+inline const utilities::performance_counter enumerator_elements_counter("data.enumerator.elements");
+inline const utilities::performance_counter enumerator_queue_size_counter("data.enumerator.max_queue_size", utilities::performance_counter_kind::maximum);
+
+} // namespace detail
+
 /// \brief An enumerator algorithm that generates solutions of a condition.
 template <typename Rewriter = data::rewriter, typename DataRewriter = data::rewriter>
 class enumerator_algorithm
@@ -936,6 +945,7 @@ class enumerator_algorithm
                               Accept accept = Accept()) const
     {
       std::size_t count = 0;
+      std::size_t max_queue_size = P.size();
       while (!P.empty())
       {
         if (count++ >= m_max_count)
@@ -946,8 +956,11 @@ class enumerator_algorithm
         {
           break;
         }
+        max_queue_size = std::max(max_queue_size, P.size());
         P.pop_front();
       }
+      detail::enumerator_elements_counter.add(count);
+      detail::enumerator_queue_size_counter.add(max_queue_size);
       return count;
     }
 
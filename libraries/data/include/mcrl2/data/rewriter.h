@@ -15,10 +15,19 @@
 #include "mcrl2/atermpp/detail/aterm_configuration.h"
 #include "mcrl2/data/detail/rewrite.h"
 #include "mcrl2/data/expression_traits.h"
+#include "mcrl2/utilities/performance_counters.h"
 
 namespace mcrl2::data
 {
 
+namespace detail
+{
+
+/// \brief Counts the number of calls of data::rewriter when performance counters are enabled.
+inline const utilities::performance_counter rewriter_calls_counter("data.rewriter.calls");
+
+} // namespace detail
+
 /// \brief Rewriter class for the mCRL2 Library. It only works for terms of type data_expression
 /// and data_expression_with_variables.
 template < typename Term >
@@ -140,7 +149,7 @@ class rewriter: public basic_rewriter<data_expression>
     /// \brief Create a clone of the rewriter in which the underlying rewriter is copied, and not passed as a shared pointer. 
     /// \details This is useful when the rewriter is used in different parallel processes. One rewriter can only be used sequentially. 
     /// \return A rewriter, with a copy of the underlying jitty, jittyc or jittyp rewriting engine. 
-    rewriter clone()
+    rewriter clone() const
     {
       return rewriter(m_rewriter->clone());
     }
@@ -227,6 +236,7 @@ class rewriter: public basic_rewriter<data_expression>
 #ifdef MCRL2_COUNT_DATA_REWRITE_CALLS
       rewrite_calls++;
 #endif
+      detail::rewriter_calls_counter.add();
 #ifdef MCRL2_PRINT_REWRITE_STEPS
       mCRL2log(log::debug) << "REWRITE " << d << "\n";
 #endif
@@ -236,6 +246,31 @@ class rewriter: public basic_rewriter<data_expression>
 #endif
     }
 
+    /// \brief Rewrites the data expressions in terms under the same substitution, and puts the normal form of
+    ///        terms[i] in results[i]. This is cheaper than rewriting the expressions one by one, as the rewriter
+    ///        is set up only once.
+    /// \pre results and terms have the same size and do not overlap.
+    void operator()(std::span<data_expression> results, std::span<const data_expression> terms, substitution_type& sigma) const
+    {
+#ifdef MCRL2_COUNT_DATA_REWRITE_CALLS
+      rewrite_calls += terms.size();
+#endif
+      detail::rewriter_calls_counter.add(terms.size());
+      m_rewriter->rewrite_all(results, terms, sigma);
+    }
+
+    /// \brief Rewrites the data expression d under each of the substitutions in sigmas, and puts the normal form
+    ///        under sigmas[i] in results[i].
+    /// \pre results and sigmas have the same size.
+    void operator()(std::span<data_expression> results, const data_expression& d, std::span<substitution_type> sigmas) const
+    {
+#ifdef MCRL2_COUNT_DATA_REWRITE_CALLS
+      rewrite_calls += sigmas.size();
+#endif
+      detail::rewriter_calls_counter.add(sigmas.size());
+      m_rewriter->rewrite_all(results, d, sigmas);
+    }
+
     ~rewriter()
     {
 #ifdef MCRL2_COUNT_DATA_REWRITE_CALLS
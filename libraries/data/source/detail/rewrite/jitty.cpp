@@ -912,6 +912,70 @@ void RewriterJitty::rewrite(
   return;
 }
 
+template <typename RewriteTerm>
+void RewriterJitty::rewrite_sequence(std::size_t n, RewriteTerm rewrite_term)
+{
+  if (rewriting_in_progress)
+  {
+    for (std::size_t i=0; i<n; ++i)
+    {
+      rewrite_term(i);
+    }
+    return;
+  }
+
+  // When the stack overflows, it is enlarged and only the term that was being rewritten is
+  // restarted, as the preceding terms are already in normal form.
+  assert(m_rewrite_stack.stack_size()==0);
+  rewriting_in_progress=true;
+  std::size_t i=0;
+  while (i<n)
+  {
+    try
+    {
+      for ( ; i<n; ++i)
+      {
+#ifdef MCRL2_DISPLAY_REWRITE_STATISTICS
+        data::detail::increment_rewrite_count();
+#endif
+        rewrite_term(i);
+      }
+    }
+    catch (recalculate_term_as_stack_is_too_small&)
+    {
+      m_rewrite_stack.reserve_more_space();
+    }
+  }
+  rewriting_in_progress=false;
+  assert(m_rewrite_stack.stack_size()==0);
+}
+
+void RewriterJitty::rewrite_all(
+     std::span<data_expression> results,
+     std::span<const data_expression> terms,
+     substitution_type& sigma)
+{
+  assert(results.size()==terms.size());
+  rewrite_sequence(terms.size(), [&](std::size_t i)
+    {
+      rewrite_aux(results[i], terms[i], sigma);
+      assert(remove_normal_form_function(results[i])==results[i]);
+    });
+}
+
+void RewriterJitty::rewrite_all(
+     std::span<data_expression> results,
+     const data_expression& term,
+     std::span<substitution_type> sigmas)
+{
+  assert(results.size()==sigmas.size());
+  rewrite_sequence(sigmas.size(), [&](std::size_t i)
+    {
+      rewrite_aux(results[i], term, sigmas[i]);
+      assert(remove_normal_form_function(results[i])==results[i]);
+    });
+}
+
 data_expression RewriterJitty::rewrite(
      const data_expression& term,
      substitution_type& sigma)
@@ -23,6 +23,7 @@
 #include "mcrl2/data/detail/rewrite/jittyc.h"
 #include "mcrl2/data/replace.h"
 #include "mcrl2/utilities/basename.h"
+#include "mcrl2/utilities/performance_counters.h"
 #include "mcrl2/utilities/stopwatch.h"
 #include <memory>
 
@@ -40,6 +41,9 @@ using namespace mcrl2::log;
 namespace mcrl2::data::detail
 {
 
+static const utilities::performance_span jittyc_generate_code_span("data.jittyc.generate_code");
+static const utilities::performance_span jittyc_compile_span("data.jittyc.compile");
+
 // Some compilers can only deal with a limited number of nested curly brackets. 
 // This limit can be increased by using -fbracket-depth=C where C is a new constant
 // value. By default this value C often appears to be 256. But not all compilers 
@@ -3005,13 +3009,17 @@ void RewriterCompilingJitty::BuildRewriteSystem()
   }
 
   std::string cpp_file = generate_cpp_filename(reinterpret_cast<std::size_t>(this));
-  generate_code(cpp_file);
+  {
+    utilities::scoped_performance_span generate(jittyc_generate_code_span);
+    generate_code(cpp_file);
+  }
 
   mCRL2log(verbose) << "generated " << cpp_file << " in " << time.time() << "ms, compiling..." << std::endl;
   time.reset();
 
   try
   {
+    utilities::scoped_performance_span compile(jittyc_compile_span);
     rewriter_so->compile(cpp_file);
   }
   catch(std::runtime_error& e)
@@ -3153,6 +3161,74 @@ void RewriterCompilingJitty::rewrite(
   return;
 }
 
+template <typename RewriteTerm>
+void RewriterCompilingJitty::rewrite_sequence(std::size_t n, substitution_type* sigma, RewriteTerm rewrite_term)
+{
+  substitution_type *saved_sigma=global_sigma;
+  global_sigma=sigma;
+  if (rewriting_in_progress)
+  {
+    for (std::size_t i=0; i<n; ++i)
+    {
+      rewrite_term(i);
+    }
+  }
+  else
+  {
+    // When the stack overflows, it is enlarged and only the term that was being rewritten is
+    // restarted, as the preceding terms are already in normal form.
+    rewriting_in_progress=true;
+    std::size_t i=0;
+    while (i<n)
+    {
+      try
+      {
+        for ( ; i<n; ++i)
+        {
+#ifdef MCRL2_DISPLAY_REWRITE_STATISTICS
+          data::detail::increment_rewrite_count();
+#endif
+          rewrite_term(i);
+        }
+      }
+      catch (recalculate_term_as_stack_is_too_small&)
+      {
+        // A nested rewrite with another substitution does not restore global_sigma when it is interrupted.
+        m_rewrite_stack.reserve_more_space();
+        global_sigma=sigma;
+      }
+    }
+    rewriting_in_progress=false;
+    assert(m_rewrite_stack.stack_size()==0);
+  }
+  global_sigma=saved_sigma;
+}
+
+void RewriterCompilingJitty::rewrite_all(
+     std::span<data_expression> results,
+     std::span<const data_expression> terms,
+     substitution_type& sigma)
+{
+  assert(results.size()==terms.size());
+  rewrite_sequence(terms.size(), &sigma, [&](std::size_t i)
+    {
+      so_rewr(results[i], terms[i], this);
+    });
+}
+
+void RewriterCompilingJitty::rewrite_all(
+     std::span<data_expression> results,
+     const data_expression& term,
+     std::span<substitution_type> sigmas)
+{
+  assert(results.size()==sigmas.size());
+  rewrite_sequence(sigmas.size(), nullptr, [&](std::size_t i)
+    {
+      global_sigma=&sigmas[i];
+      so_rewr(results[i], term, this);
+    });
+}
+
 data_expression RewriterCompilingJitty::rewrite(
      const data_expression& term,
      substitution_type& sigma)
@@ -12,6 +12,7 @@
 #define BOOST_TEST_MODULE rewriter_test
 #include "mcrl2/data/detail/one_point_rule_preprocessor.h"
 #include "mcrl2/data/detail/parse_substitution.h"
+#include "mcrl2/data/detail/rewrite_strategies.h"
 #include "mcrl2/data/detail/test_rewriters.h"
 #include "mcrl2/data/print.h"
 #include "mcrl2/data/rewriter.h"
@@ -256,3 +257,51 @@ BOOST_AUTO_TEST_CASE(test_main)
   test_equality_on_functions();
   test_enumeration_of_functions();
 }
+
+// Checks that rewriting a batch of expressions gives the same normal forms as rewriting them one by one.
+BOOST_AUTO_TEST_CASE(test_rewrite_all)
+{
+  data_specification data_spec = parse_data_specification("map f: Nat -> List(Nat); var n: Nat; eqn f(n) = if(n == 0, [], n |> f(Int2Nat(n - 1)));");
+  const variable m("m", sort_nat::nat());
+  const variable n("n", sort_nat::nat());
+  const data::variable_list variables = { m, n };
+  const std::vector<data_expression> terms = {
+    parse_data_expression("m + n", variables, data_spec),
+    parse_data_expression("exists k: Nat. k < m && k > n", variables, data_spec),
+    parse_data_expression("#f(m * n)", variables, data_spec),
+    parse_data_expression("[m, n, m + n]", variables, data_spec)
+  };
+
+  for (const rewrite_strategy strategy: data::detail::get_test_rewrite_strategies(false))
+  {
+    std::clog << "  Strategy: " << strategy << std::endl;
+    rewriter R(data_spec, strategy);
+
+    std::vector<data::rewriter::substitution_type> sigmas(3);
+    for (std::size_t i = 0; i < sigmas.size(); ++i)
+    {
+      sigmas[i][m] = R(sort_nat::nat(10 * i + 3));
+      sigmas[i][n] = R(sort_nat::nat(i));
+    }
+
+    for (data::rewriter::substitution_type& sigma: sigmas)
+    {
+      std::vector<data_expression> results(terms.size());
+      R(results, terms, sigma);
+      for (std::size_t i = 0; i < terms.size(); ++i)
+      {
+        BOOST_CHECK_EQUAL(results[i], R(terms[i], sigma));
+      }
+    }
+
+    for (const data_expression& term: terms)
+    {
+      std::vector<data_expression> results(sigmas.size());
+      R(results, term, sigmas);
+      for (std::size_t i = 0; i < sigmas.size(); ++i)
+      {
+        BOOST_CHECK_EQUAL(results[i], R(term, sigmas[i]));
+      }
+    }
+  }
+}
@@ -247,7 +247,7 @@ protected:
       lps::remove_parameters(super::m_spec, constant_parameters);
 
       // rewrite the specification with substitution sigma
-      lps::rewrite(super::m_spec, R, sigma);
+      lps::rewrite(super::m_spec, R, sigma, super::m_number_of_threads);
     }
 
     /// \brief Runs the constelm algorithm
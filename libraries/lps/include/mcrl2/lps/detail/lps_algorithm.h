@@ -14,6 +14,7 @@
 
 #include "mcrl2/data/rewriter.h"
 #include "mcrl2/lps/detail/instantiate_global_variables.h"
+#include "mcrl2/lps/detail/parallel_summand_map.h"
 #include "mcrl2/lps/rewrite.h"
 
 namespace mcrl2::lps::detail
@@ -28,6 +29,9 @@ class lps_algorithm
     /// \brief The specification that is processed by the algorithm
     Specification& m_spec;
 
+    /// \brief The number of threads that is used for processing the summands
+    std::size_t m_number_of_threads = 1;
+
     void sumelm_find_variables(const action_summand& s, std::set<data::variable>& result) const
     {
       std::set<data::variable> tmp;
@@ -54,7 +58,7 @@ class lps_algorithm
     }
 
     template <typename SummandType>
-    void summand_remove_unused_summand_variables(SummandType& summand_)
+    void summand_remove_unused_summand_variables(SummandType& summand_) const
     {
       data::variable_vector new_summation_variables;
 
@@ -75,6 +79,15 @@ class lps_algorithm
       : m_spec(spec)
     {}
 
+    /// \brief Sets the number of threads that is used for processing the summands.
+    /// \details Algorithms that support multiple threads process the summands independently of each
+    /// other using detail::parallel_summand_update or detail::parallel_summand_map. The result does not
+    /// depend on the number of threads.
+    void set_number_of_threads(std::size_t number_of_threads)
+    {
+      m_number_of_threads = number_of_threads;
+    }
+
     /// \brief Flag for verbose output
     bool verbose() const
     {
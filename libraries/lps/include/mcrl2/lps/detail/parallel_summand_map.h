@@ -0,0 +1,91 @@
+// Author(s): agent
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/lps/detail/parallel_summand_map.h
+/// \brief Functions for processing the summands of an LPS using multiple threads.
+
+#ifndef MCRL2_LPS_DETAIL_PARALLEL_SUMMAND_MAP_H
+#define MCRL2_LPS_DETAIL_PARALLEL_SUMMAND_MAP_H
+
+#include "mcrl2/utilities/detail/parallel_apply.h"
+
+#include <optional>
+#include <vector>
+
+namespace mcrl2::lps::detail
+{
+
+/// \brief Provides a data rewriter for each of the threads in a single call of utilities::detail::parallel_apply.
+/// \details With one thread the rewriter R itself is used. Otherwise thread t uses a clone of R that it creates
+/// on first use. This way the terms that the clone stores in its caches belong to the thread that uses it.
+/// Since the threads of parallel_apply do not survive the call, an object of this class may not be reused for
+/// a subsequent call.
+template <typename DataRewriter>
+class thread_rewriters
+{
+  protected:
+    const DataRewriter& m_rewriter;
+    std::vector<std::optional<DataRewriter>> m_clones;
+
+  public:
+    thread_rewriters(const DataRewriter& R, std::size_t number_of_threads)
+      : m_rewriter(R),
+        m_clones(number_of_threads > 1 ? number_of_threads : 0)
+    {}
+
+    /// \brief Returns the rewriter of the thread with index t.
+    const DataRewriter& operator()(std::size_t t)
+    {
+      if (m_clones.empty())
+      {
+        return m_rewriter;
+      }
+      std::optional<DataRewriter>& clone = m_clones[t];
+      if (!clone)
+      {
+        clone = m_rewriter.clone();
+        clone->thread_initialise();
+      }
+      return *clone;
+    }
+};
+
+/// \brief Calls f(s, t) for each summand s in summands, using number_of_threads threads. The summands are updated
+/// in place, and t is the index of the thread that makes the call.
+template <typename Summand, typename Function>
+void parallel_summand_update(std::vector<Summand>& summands, std::size_t number_of_threads, Function f)
+{
+  utilities::detail::parallel_apply(summands.size(), number_of_threads, [&](std::size_t i, std::size_t t)
+    {
+      f(summands[i], t);
+    });
+}
+
+/// \brief Replaces each summand s in summands by the summands that f(s, result, t) appends to result, using
+/// number_of_threads threads, where t is the index of the thread that makes the call. The order of the resulting
+/// summands does not depend on the number of threads.
+template <typename Summand, typename Function>
+void parallel_summand_map(std::vector<Summand>& summands, std::size_t number_of_threads, Function f)
+{
+  std::vector<std::vector<Summand>> results(summands.size());
+  utilities::detail::parallel_apply(summands.size(), number_of_threads, [&](std::size_t i, std::size_t t)
+    {
+      f(summands[i], results[i], t);
+    });
+
+  std::vector<Summand> result;
+  for (std::vector<Summand>& v: results)
+  {
+    result.insert(result.end(), std::make_move_iterator(v.begin()), std::make_move_iterator(v.end()));
+  }
+  summands.swap(result);
+}
+
+} // namespace mcrl2::lps::detail
+
+#endif // MCRL2_LPS_DETAIL_PARALLEL_SUMMAND_MAP_H
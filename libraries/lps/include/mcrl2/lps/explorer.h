@@ -18,6 +18,7 @@
 #include <condition_variable>
 #include "mcrl2/utilities/detail/io.h"
 #include "mcrl2/utilities/skip.h"
+#include "mcrl2/utilities/stack_array.h"
 #include "mcrl2/atermpp/standard_containers/vector.h"
 #include "mcrl2/atermpp/standard_containers/indexed_set.h"
 #include "mcrl2/atermpp/standard_containers/detail/unordered_map_implementation.h"
@@ -157,10 +158,20 @@ class explorer: public abortable
                        data::mutable_indexed_substitution<>& sigma,
                        const data::rewriter& rewr) const
     {
-      lps::make_state(result, 
-                      v.begin(), 
-                      m_n, 
-                      [&](data::data_expression& result, const data::data_expression& x) { rewr(result, x, sigma); return; });
+      if constexpr (std::is_convertible_v<const DataExpressionSequence&, std::span<const data::data_expression>>)
+      {
+        // Rewrite all arguments with one call of the rewriter, which is then set up only once.
+        MCRL2_DECLARE_STACK_ARRAY(arguments, data::data_expression, m_n);
+        rewr(std::span<data::data_expression>(arguments.data(), m_n), std::span<const data::data_expression>(v).first(m_n), sigma);
+        lps::make_state(result, arguments.begin(), m_n);
+      }
+      else
+      {
+        lps::make_state(result, 
+                        v.begin(), 
+                        m_n, 
+                        [&](data::data_expression& result, const data::data_expression& x) { rewr(result, x, sigma); return; });
+      }
     }
 
     template <typename DataExpressionSequence>
@@ -270,25 +281,42 @@ class explorer: public abortable
                              data::rewriter& rewr) const
     {
       const process::action_list& actions = a.actions();
-      const data::data_expression& time = a.time();
-      return lps::multi_action(
-          process::action_list(
-            actions.begin(),
-            actions.end(),
-            [&](process::action& result, const process::action& a)
-            {
-              const data::data_expression_list& args = a.arguments();
-              process::make_action(result, 
-                                          a.label(), 
-                                          data::data_expression_list(args.begin(), 
-                                                                     args.end(), 
-                                                                     [&](data::data_expression& result, 
-                                                                         const data::data_expression& x) -> void
-                                                                                 { rewr(result, x, sigma); }));
-            }
-          ),
-          a.has_time() ? rewr(time, sigma) : time
-        );
+
+      // The arguments of all actions and the time are rewritten with one call of the rewriter.
+      std::size_t n = a.has_time() ? 1 : 0;
+      for (const process::action& action: actions)
+      {
+        n += action.arguments().size();
+      }
+      if (n == 0)
+      {
+        return a;
+      }
+
+      MCRL2_DECLARE_STACK_ARRAY(arguments, data::data_expression, n);
+      MCRL2_DECLARE_STACK_ARRAY(rewritten_arguments, data::data_expression, n);
+      data::data_expression* last = arguments.begin();
+      for (const process::action& action: actions)
+      {
+        last = std::copy(action.arguments().begin(), action.arguments().end(), last);
+      }
+      if (a.has_time())
+      {
+        *last = a.time();
+      }
+      rewr(std::span<data::data_expression>(rewritten_arguments.data(), n), std::span<const data::data_expression>(arguments.data(), n), sigma);
+
+      MCRL2_DECLARE_STACK_ARRAY(rewritten_actions, process::action, actions.size());
+      const data::data_expression* first = rewritten_arguments.begin();
+      process::action* action_out = rewritten_actions.begin();
+      for (const process::action& action: actions)
+      {
+        const std::size_t arity = action.arguments().size();
+        process::make_action(*action_out++, action.label(), data::data_expression_list(first, first + arity));
+        first += arity;
+      }
+      return lps::multi_action(process::action_list(rewritten_actions.begin(), rewritten_actions.end()),
+                               a.has_time() ? rewritten_arguments[n - 1] : a.time());
     }
 
     void check_enumerator_solution(const data::data_expression& p_expression, // WAS: const enumerator_element& p, 
@@ -853,6 +881,21 @@ class explorer: public abortable
       compute_stochastic_state(result, m_initial_distribution, m_initial_state, m_global_sigma, m_global_rewr, m_global_enumerator);
     }
 
+    // Compute the initial state of a non stochastic specification, taking confluence and time into account.
+    // Should not be used concurrently.
+    void compute_initial_state(state& result)
+    {
+      compute_state(result, m_initial_state, m_global_sigma, m_global_rewr);
+      if (!m_confluent_summands.empty())
+      {
+        result = find_representative(result, m_confluent_summands, m_global_sigma, m_global_rewr, m_global_enumerator, m_global_id_generator);
+      }
+      if constexpr (Timed)
+      {
+        make_timed_state(result, result, data::sort_real::real_zero());
+      }
+    }
+
     // Convenience overload: use internal sigma/rewriter/enumerator
     template <typename DataExpressionSequence>
     void compute_stochastic_state(stochastic_state& result,
@@ -1024,6 +1067,64 @@ class explorer: public abortable
       return generate_transitions(d0, m_global_sigma, m_global_rewr, m_global_enumerator, m_global_id_generator);
     }
 
+    /// \brief Generates the outgoing transitions of state d0 for the regular summand with index summand_index in the
+    /// specification, i.e., the summand index that is reported to examine_transition. For timed specifications the
+    /// target states contain the time of the transition, like the discovered states.
+    /// \details The global substitution, rewriter, enumerator and id_generator are used, so calls must not be made
+    /// concurrently.
+    std::vector<std::pair<lps::multi_action, state_type>> generate_transitions(
+                   const state& d0,
+                   std::size_t summand_index)
+    {
+      auto i = std::lower_bound(m_regular_summands.begin(), m_regular_summands.end(), summand_index,
+                                [](const explorer_summand& summand, std::size_t index) { return summand.index < index; });
+      if (i == m_regular_summands.end() || i->index != summand_index)
+      {
+        throw mcrl2::runtime_error("there is no regular summand with index " + std::to_string(summand_index));
+      }
+
+      data::data_expression_list process_parameter_undo = process_parameter_values(m_global_sigma);
+      std::vector<std::pair<lps::multi_action, state_type>> result;
+      data::add_assignments(m_global_sigma, m_process_parameters, d0);
+      data::data_expression condition;
+      atermpp::aterm key;
+      state_type state;
+#ifdef MCRL2_USE_CONTROL_FLOW
+      auto active_cfg_vertices = compute_active_cfg_vertices(m_global_sigma, m_process_parameters, m_control_flow_graphs);
+#endif
+      generate_transitions(
+        *i,
+        m_confluent_summands,
+        m_global_sigma,
+        m_global_rewr,
+        condition,
+        state,
+        key,
+        m_global_enumerator,
+        m_global_id_generator,
+#ifdef MCRL2_USE_CONTROL_FLOW
+        active_cfg_vertices,
+#endif
+        [&](const lps::multi_action& a, const state_type& d1)
+        {
+          if constexpr (Timed && !Stochastic)
+          {
+            const data::data_expression& t = d0[m_n];
+            state_type d1_;
+            make_timed_state(d1_, d1, a.has_time() ? a.time() : t);
+            result.emplace_back(lps::multi_action(a.actions(), a.time()), d1_);
+          }
+          else
+          {
+            result.emplace_back(lps::multi_action(a.actions(), a.time()), d1);
+          }
+        }
+      );
+      data::remove_assignments(m_global_sigma, i->variables);
+      set_process_parameter_values(process_parameter_undo, m_global_sigma);
+      return result;
+    }
+
     /// \brief Generates outgoing transitions for a given state.
     std::vector<std::pair<lps::multi_action, state>> generate_transitions(
               const data::data_expression_list& init,
@@ -1187,6 +1288,11 @@ class explorer: public abortable
       return m_confluent_summands;
     }
 
+    const explorer_options& options() const
+    {
+      return m_options;
+    }
+
     const std::vector<data::variable>& process_parameters() const
     {
       return m_process_parameters;
@@ -15,9 +15,20 @@
 #ifndef MCRL2_LPS_EXPLORER_H
 #include "mcrl2/lps/explorer.h"
 #endif
+#include "mcrl2/utilities/performance_counters.h"
 
 namespace mcrl2::lps
 {
+    namespace detail
+    {
+      /// \brief The exploration of a batch of states that a thread has taken from the global todo set.
+      inline const utilities::performance_span explorer_explore_span("lps.explorer.explore");
+      /// \brief The time that a thread waits for exclusive access to the global state.
+      inline const utilities::performance_span explorer_lock_span("lps.explorer.wait_for_lock");
+      /// \brief The time that a thread waits until the global todo set is filled.
+      inline const utilities::performance_span explorer_idle_span("lps.explorer.wait_for_work");
+    } // namespace detail
+
     template <bool Stochastic, bool Timed, typename Specification>
     template <
       typename StateType,
@@ -57,6 +68,7 @@ namespace mcrl2::lps
 
       if (mcrl2::utilities::detail::GlobalThreadSafe && m_options.number_of_threads > 1)
       {
+        utilities::scoped_performance_span wait_for_lock(detail::explorer_lock_span);
         m_exclusive_state_access.lock();
       }
       
@@ -73,6 +85,7 @@ namespace mcrl2::lps
             m_exclusive_state_access.unlock();
           }
 
+          utilities::scoped_performance_span explore(detail::explorer_explore_span);
           while (!thread_todo->empty() && !m_must_abort.load(std::memory_order_relaxed))
           { 
             thread_todo->choose_element(current_state);
@@ -174,6 +187,7 @@ namespace mcrl2::lps
               {
                 if (mcrl2::utilities::detail::GlobalThreadSafe && m_options.number_of_threads > 1)
                 {
+                  utilities::scoped_performance_span wait_for_lock(detail::explorer_lock_span);
                   m_exclusive_state_access.lock();
                 }
 
@@ -209,6 +223,7 @@ namespace mcrl2::lps
         assert(thread_todo->empty() || m_must_abort);
         if (todo->empty())
         {
+          utilities::scoped_performance_span wait_for_work(detail::explorer_idle_span);
           std::unique_lock<std::mutex> lock(m_global_todo_buffer_mutex);  
           // Atomic decrement and compare is essential) 
           if (1==number_of_active_processes.fetch_sub(1))
@@ -227,6 +242,7 @@ namespace mcrl2::lps
         }
         if (mcrl2::utilities::detail::GlobalThreadSafe && m_options.number_of_threads > 1)
         {
+          utilities::scoped_performance_span wait_for_lock(detail::explorer_lock_span);
           m_exclusive_state_access.lock();
         }
       } 
@@ -365,15 +381,7 @@ namespace mcrl2::lps
       }
       else
       {
-        compute_state(s0,m_initial_state,m_global_sigma, m_global_rewr);
-        if (!m_confluent_summands.empty())
-        {
-          s0 = find_representative(s0, m_confluent_summands, m_global_sigma, m_global_rewr, m_global_enumerator, m_global_id_generator);
-        }
-        if constexpr (Timed)
-        {
-          make_timed_state(s0, s0, data::sort_real::real_zero());
-        }
+        compute_initial_state(s0);
       }
       generate_state_space(recursive, s0, m_regular_summands, m_confluent_summands, m_discovered, discover_state, 
                            examine_transition, start_state, finish_state, discover_initial_state);
@@ -45,6 +45,7 @@ struct explorer_options
   bool save_at_end = false;
   bool dfs_recursive = false;
   bool discard_lts_state_labels = false;
+  bool compress_lts = false;
   bool rewrite_actions = true;    // If false, this option prevents rewriting actions.
                                   // Rewriting actions is only needed if they occur in the
                                   // generated lts, or in traces. 
@@ -93,6 +94,7 @@ std::ostream& operator<<(std::ostream& out, const explorer_options& options)
   out << "detect-divergence = " << std::boolalpha << options.detect_divergence << std::endl;
   out << "detect-action = " << std::boolalpha << options.detect_action << std::endl;
   out << "discard-lts-state-labels = " << std::boolalpha << options.discard_lts_state_labels << std::endl;
+  out << "compress-lts = " << std::boolalpha << options.compress_lts << std::endl;
   out << "save-error-trace = " << std::boolalpha << options.save_error_trace << std::endl;
   out << "generate-traces = " << std::boolalpha << options.generate_traces << std::endl;
   out << "suppress-progress-messages = " << std::boolalpha << options.suppress_progress_messages << std::endl;
@@ -21,7 +21,9 @@
 #include "mcrl2/lps/sumelm.h"
 #include "mcrl2/process/action_label.h"
 #include "mcrl2/process/process_expression.h"
+#include "mcrl2/utilities/detail/parallel_apply.h"
 
+#include <memory>
 #include <optional>
 
 namespace mcrl2::lps
@@ -410,39 +412,48 @@ public:
       bool nodeltaelimination,
       bool ignore_time)
   {
-    assert(!(m_is_allow && m_is_block));
+    apply({ this }, action_summands, deadlock_summands, nosumelm, nodeltaelimination, ignore_time);
+  }
+
+  /// Apply the communication composition to a list of action summands, using algorithms.size() threads.
+  ///
+  /// The action summands are distributed over the threads, and thread t uses algorithms[t]. The algorithms must be
+  /// constructed with the same arguments, except for the data rewriter. The result does not depend on the number of
+  /// threads.
+  static void apply(const std::vector<apply_communication_algorithm*>& algorithms,
+      stochastic_action_summand_vector& action_summands,
+      deadlock_summand_vector& deadlock_summands,
+      bool nosumelm,
+      bool nodeltaelimination,
+      bool ignore_time)
+  {
+    assert(!algorithms.empty());
+    const apply_communication_algorithm& algorithm = *algorithms.front();
+    assert(!(algorithm.m_is_allow && algorithm.m_is_block));
 
     /* We follow the implementation of Muck van Weerdenburg, described in
        a note: Calculation of communication with open terms. */
 
-    mCRL2log(mcrl2::log::verbose) << (m_is_allow
+    mCRL2log(mcrl2::log::verbose) << (algorithm.m_is_allow
                                           ? "- calculating the communication operator modulo the allow operator on "
-                                      : m_is_block
+                                      : algorithm.m_is_block
                                           ? "- calculating the communication operator modulo the block operator on "
                                           : "- calculating the communication operator on ")
                                   << action_summands.size() << " action summands";
 
     [[maybe_unused]]
     lps_statistics_t lps_statistics_before = get_statistics(action_summands, deadlock_summands);
-    // number of summands filtered out after construction of intermediate result (all potential results of communication
-    // that may be allowed/are not blocked)
-    [[maybe_unused]]
-    std::size_t disallowed_summands = 0;      // removed by allow
-    [[maybe_unused]]
-    std::size_t blocked_summands = 0;         // removed by block
-    [[maybe_unused]]
-    std::size_t false_condition_summands = 0; // removed because condition is false
 
-    mCRL2log(mcrl2::log::trace) << "Calculating communication operator using a set of " << m_communications.size()
+    mCRL2log(mcrl2::log::trace) << "Calculating communication operator using a set of " << algorithm.m_communications.size()
                                 << " communication expressions." << std::endl;
     mCRL2log(mcrl2::log::trace) << "Communication expressions: " << std::endl
-                                << core::detail::print_set(m_communications) << std::endl;
-    mCRL2log(mcrl2::log::trace) << "Allow list: " << std::endl << core::detail::print_set(m_allowlist) << std::endl;
+                                << core::detail::print_set(algorithm.m_communications) << std::endl;
+    mCRL2log(mcrl2::log::trace) << "Allow list: " << std::endl << core::detail::print_set(algorithm.m_allowlist) << std::endl;
 
     deadlock_summand_vector resulting_deadlock_summands;
     deadlock_summands.swap(resulting_deadlock_summands);
 
-    const bool inline_allow = m_is_allow || m_is_block;
+    const bool inline_allow = algorithm.m_is_allow || algorithm.m_is_block;
     if (inline_allow)
     {
       // Inline allow is only supported for ignore_time,
@@ -451,17 +462,28 @@ public:
       deadlock_summands.emplace_back(data::variable_list(), data::sort_bool::true_(), deadlock());
     }
 
+    // The summands resulting from action_summands[i] are stored in results[i], such that the order of the summands
+    // does not depend on the scheduling of the threads.
+    std::vector<summand_result> results(action_summands.size());
+    utilities::detail::parallel_apply(action_summands.size(), algorithms.size(), [&](std::size_t i, std::size_t t)
+      {
+        algorithms[t]->apply(action_summands[i], nosumelm, results[i]);
+      });
+
     stochastic_action_summand_vector resulting_action_summands;
 
-    for (const stochastic_action_summand& smmnd : action_summands)
-    {
-      const data::variable_list& sumvars = smmnd.summation_variables();
-      const process::action_list& multiaction = smmnd.multi_action().actions();
-      const data::data_expression& time = smmnd.multi_action().time();
-      const data::data_expression& condition = smmnd.condition();
-      const data::assignment_list& nextstate = smmnd.assignments();
-      const stochastic_distribution& dist = smmnd.distribution();
+    // number of summands filtered out after construction of intermediate result (all potential results of communication
+    // that may be allowed/are not blocked)
+    [[maybe_unused]]
+    std::size_t disallowed_summands = 0;      // removed by allow
+    [[maybe_unused]]
+    std::size_t blocked_summands = 0;         // removed by block
+    [[maybe_unused]]
+    std::size_t false_condition_summands = 0; // removed because condition is false
 
+    for (std::size_t i = 0; i < action_summands.size(); ++i)
+    {
+      const stochastic_action_summand& smmnd = action_summands[i];
       if (!inline_allow)
       {
         /* Recall a delta summand for every non delta summand.
@@ -474,6 +496,10 @@ public:
          * later on, and will in general reduce the number of delta
          * summands in the whole system */
 
+        const data::variable_list& sumvars = smmnd.summation_variables();
+        const data::data_expression& time = smmnd.multi_action().time();
+        const data::data_expression& condition = smmnd.condition();
+
         // Create new list of summand variables containing only those that occur in the condition or the timestamp.
         data::variable_list newsumvars;
         atermpp::make_term_list(
@@ -487,78 +513,11 @@ public:
         resulting_deadlock_summands.emplace_back(newsumvars, condition, deadlock(time));
       }
 
-      /* the multiactionconditionlist is a list containing
-         tuples, with a multiaction and the condition,
-         expressing whether the multiaction can happen. All
-         conditions exclude each other. Furthermore, the list
-         is not empty. If no communications can take place,
-         the original multiaction is delivered, with condition
-         true. */
-
-      // We calculate the communication operator on the multiaction in this single summand. As the actions in the
-      // multiaction can be parameterized with open data expressions, for every subset of applicable communication
-      // expressions this list in principle contains one summand (unless the condition can be rewritten to false, in
-      // which case it is omitted).
-
-      mCRL2log(mcrl2::log::trace) << "Calculating communication on multiaction with " << multiaction.size()
-                                  << " actions." << std::endl;
-      mCRL2log(mcrl2::log::trace) << "  Multiaction: " << process::pp(multiaction) << std::endl;
-
-      const tuple_list multiactionconditionlist = apply(multiaction);
-
-      mCRL2log(mcrl2::log::trace) << "Calculating communication on multiaction with " << multiaction.size()
-                                  << " actions results in " << multiactionconditionlist.size() << " potential summands"
-                                  << std::endl;
-
-      for (std::size_t i = 0; i < multiactionconditionlist.size(); ++i)
-      {
-        const process::action_list& multiaction = multiactionconditionlist.actions[i];
-
-        if (m_is_allow && !allow_(m_allow_cache, multiaction, m_terminationAction))
-        {
-          if constexpr (EnableLineariseStatistics) {
-            ++disallowed_summands;
-          }
-
-          continue;
-        }
-        if (m_is_block && encap(m_allowlist, multiaction))
-        {
-          if constexpr (EnableLineariseStatistics) {
-            ++blocked_summands;
-          }
-          continue;
-        }
-
-        const data::data_expression communicationcondition = m_data_rewriter(multiactionconditionlist.conditions[i]);
-
-        const data::data_expression newcondition = m_data_rewriter(data::lazy::and_(condition, communicationcondition));
-        stochastic_action_summand new_summand(sumvars,
-            newcondition,
-            smmnd.multi_action().has_time() ? multi_action(multiaction, smmnd.multi_action().time())
-                                            : multi_action(multiaction),
-            nextstate,
-            dist);
-        if (!nosumelm)
-        {
-          if (sumelm(new_summand))
-          {
-            new_summand.condition() = m_data_rewriter(new_summand.condition());
-          }
-        }
-        if constexpr (EnableLineariseStatistics)
-        {
-          if (new_summand.condition() == data::sort_bool::false_())
-          {
-            ++false_condition_summands;
-          }
-        }
-
-        if (new_summand.condition() != data::sort_bool::false_())
-        {
-          resulting_action_summands.push_back(new_summand);
-        }
-      }
+      summand_result& result = results[i];
+      resulting_action_summands.insert(resulting_action_summands.end(), result.action_summands.begin(), result.action_summands.end());
+      disallowed_summands += result.disallowed_summands;
+      blocked_summands += result.blocked_summands;
+      false_condition_summands += result.false_condition_summands;
     }
 
     action_summands.swap(resulting_action_summands);
@@ -575,7 +534,7 @@ public:
     if constexpr (EnableLineariseStatistics)
     {
       lps_statistics_t lps_statistics_after = get_statistics(action_summands, deadlock_summands);
-      std::cout << log_comm_application(lps_statistics_before,
+      std::cout << algorithm.log_comm_application(lps_statistics_before,
           lps_statistics_after,
           disallowed_summands,
           blocked_summands,
@@ -588,6 +547,98 @@ public:
 
 protected:
 
+  // The summands that result from applying the communication operator to a single action summand.
+  struct summand_result
+  {
+    stochastic_action_summand_vector action_summands;
+    std::size_t disallowed_summands = 0;
+    std::size_t blocked_summands = 0;
+    std::size_t false_condition_summands = 0;
+  };
+
+  /// Apply the communication composition to the action summand smmnd, and store the resulting summands in result.
+  void apply(const stochastic_action_summand& smmnd, bool nosumelm, summand_result& result)
+  {
+    const data::variable_list& sumvars = smmnd.summation_variables();
+    const process::action_list& multiaction = smmnd.multi_action().actions();
+    const data::data_expression& condition = smmnd.condition();
+    const data::assignment_list& nextstate = smmnd.assignments();
+    const stochastic_distribution& dist = smmnd.distribution();
+
+    /* the multiactionconditionlist is a list containing
+       tuples, with a multiaction and the condition,
+       expressing whether the multiaction can happen. All
+       conditions exclude each other. Furthermore, the list
+       is not empty. If no communications can take place,
+       the original multiaction is delivered, with condition
+       true. */
+
+    // We calculate the communication operator on the multiaction in this single summand. As the actions in the
+    // multiaction can be parameterized with open data expressions, for every subset of applicable communication
+    // expressions this list in principle contains one summand (unless the condition can be rewritten to false, in
+    // which case it is omitted).
+
+    mCRL2log(mcrl2::log::trace) << "Calculating communication on multiaction with " << multiaction.size()
+                                << " actions." << std::endl;
+    mCRL2log(mcrl2::log::trace) << "  Multiaction: " << process::pp(multiaction) << std::endl;
+
+    const tuple_list multiactionconditionlist = apply(multiaction);
+
+    mCRL2log(mcrl2::log::trace) << "Calculating communication on multiaction with " << multiaction.size()
+                                << " actions results in " << multiactionconditionlist.size() << " potential summands"
+                                << std::endl;
+
+    for (std::size_t i = 0; i < multiactionconditionlist.size(); ++i)
+    {
+      const process::action_list& multiaction = multiactionconditionlist.actions[i];
+
+      if (m_is_allow && !allow_(m_allow_cache, multiaction, m_terminationAction))
+      {
+        if constexpr (EnableLineariseStatistics) {
+          ++result.disallowed_summands;
+        }
+
+        continue;
+      }
+      if (m_is_block && encap(m_allowlist, multiaction))
+      {
+        if constexpr (EnableLineariseStatistics) {
+          ++result.blocked_summands;
+        }
+        continue;
+      }
+
+      const data::data_expression communicationcondition = m_data_rewriter(multiactionconditionlist.conditions[i]);
+
+      const data::data_expression newcondition = m_data_rewriter(data::lazy::and_(condition, communicationcondition));
+      stochastic_action_summand new_summand(sumvars,
+          newcondition,
+          smmnd.multi_action().has_time() ? multi_action(multiaction, smmnd.multi_action().time())
+                                          : multi_action(multiaction),
+          nextstate,
+          dist);
+      if (!nosumelm)
+      {
+        if (sumelm(new_summand))
+        {
+          new_summand.condition() = m_data_rewriter(new_summand.condition());
+        }
+      }
+      if constexpr (EnableLineariseStatistics)
+      {
+        if (new_summand.condition() == data::sort_bool::false_())
+        {
+          ++result.false_condition_summands;
+        }
+      }
+
+      if (new_summand.condition() != data::sort_bool::false_())
+      {
+        result.action_summands.push_back(new_summand);
+      }
+    }
+  }
+
   const process::action& m_terminationAction;
   DataRewriter& m_data_rewriter;
   const process::communication_expression_list m_communications;
@@ -926,6 +977,31 @@ inline void communicationcomposition(const process::communication_expression_lis
       .apply(action_summands, deadlock_summands, nosumelm, nodeltaelimination, ignore_time);
 }
 
+/// \brief Applies the communication operator to the action summands using RewriteTerms.size() threads, where the
+/// i-th thread uses RewriteTerms[i] to simplify expressions. The result does not depend on the number of threads.
+inline void communicationcomposition(const process::communication_expression_list& communications,
+    const process::action_name_multiset_list& allowlist, // This is a list of list of identifierstring.
+    const bool is_allow, // If is_allow or is_block is set, perform inline allow/block filtering.
+    const bool is_block,
+    stochastic_action_summand_vector& action_summands,
+    deadlock_summand_vector& deadlock_summands,
+    const process::action& terminationAction,
+    const bool nosumelm,
+    const bool nodeltaelimination,
+    const bool ignore_time,
+    const std::vector<std::function<data::data_expression(const data::data_expression&)>>& RewriteTerms)
+{
+  using algorithm_type = detail::apply_communication_algorithm<const std::function<data::data_expression(const data::data_expression&)>>;
+  std::vector<std::unique_ptr<algorithm_type>> algorithms;
+  std::vector<algorithm_type*> algorithm_pointers;
+  for (const auto& RewriteTerm: RewriteTerms)
+  {
+    algorithms.push_back(std::make_unique<algorithm_type>(terminationAction, RewriteTerm, communications, allowlist, is_allow, is_block));
+    algorithm_pointers.push_back(algorithms.back().get());
+  }
+  algorithm_type::apply(algorithm_pointers, action_summands, deadlock_summands, nosumelm, nodeltaelimination, ignore_time);
+}
+
 } // namespace mcrl2::lps
 
 
@@ -22,8 +22,10 @@
 #include "mcrl2/lps/resolve_name_clashes.h"
 #include "mcrl2/lps/symbolic_lts.h"
 #include "mcrl2/lps/detail/replace_global_variables.h"
+#include "mcrl2/symbolic/checkpoint.h"
 #include "mcrl2/symbolic/ordering.h"
 #include "mcrl2/symbolic/print.h"
+#include "mcrl2/symbolic/saturation.h"
 #include "mcrl2/symbolic/symbolic_reachability.h"
 #include "mcrl2/utilities/stopwatch.h"
 
@@ -31,6 +33,7 @@
 
 #include <chrono>
 #include <iomanip>
+#include <memory>
 #include <boost/dynamic_bitset.hpp>
 
 namespace mcrl2::lps {
@@ -53,6 +56,7 @@ class lpsreach_algorithm
     std::vector<boost::dynamic_bitset<>> m_group_patterns;
     std::vector<std::size_t> m_variable_order;
     symbolic_lts m_lts;
+    std::unique_ptr<symbolic::saturation_algorithm<lps_summand_group>> m_saturation;
     
     /// \brief Rewrites all arguments of the given action.
     template<typename Rewriter, data::IsSubstitution Substitution>
@@ -113,6 +117,40 @@ class lpsreach_algorithm
       return symbolic::print_size(L, m_options.print_exact, m_options.print_nodesize);
     }
 
+    void save_checkpoint(const symbolic::reachability_checkpoint& checkpoint)
+    {
+      stopwatch timer;
+      symbolic::save_reachability_checkpoint(m_options.checkpoint_file, checkpoint, m_lts.process_parameters, m_lts.data_index, m_lts.summand_groups,
+        [&](atermpp::aterm_ostream& aterm_stream, utilities::obitstream& bitstream)
+        {
+          bitstream.write_integer(m_lts.action_index.size());
+          for (const auto& action: m_lts.action_index)
+          {
+            aterm_stream << action;
+          }
+        });
+      mCRL2log(log::verbose) << "saved checkpoint after " << checkpoint.iteration << " iterations to " << m_options.checkpoint_file
+                             << " (time = " << std::setprecision(2) << std::fixed << timer.seconds() << "s)" << std::endl;
+    }
+
+    symbolic::reachability_checkpoint load_checkpoint()
+    {
+      symbolic::reachability_checkpoint result = symbolic::load_reachability_checkpoint(m_options.checkpoint_file, m_lts.process_parameters, m_lts.data_index, m_lts.summand_groups,
+        [&](atermpp::aterm_istream& aterm_stream, utilities::ibitstream& bitstream)
+        {
+          m_lts.action_index.clear();
+          std::size_t number_of_action_labels = bitstream.read_integer();
+          for (std::size_t i = 0; i < number_of_action_labels; ++i)
+          {
+            lps::multi_action action;
+            aterm_stream >> action;
+            m_lts.action_index.insert(action);
+          }
+        });
+      mCRL2log(log::verbose) << "resuming from checkpoint " << m_options.checkpoint_file << " after " << result.iteration << " iterations" << std::endl;
+      return result;
+    }
+
   public:
     lpsreach_algorithm(const lps::specification& lpsspec, const symbolic::symbolic_reachability_options& options_)
       : m_options(options_),
@@ -141,6 +179,11 @@ class lpsreach_algorithm
 
       m_variable_order = symbolic::compute_variable_order(m_options.variable_order, m_lts.process_parameters.size(), m_summand_patterns);
       mCRL2log(log::debug) << "variable order = " << core::detail::print_list(m_variable_order) << std::endl;
+      mCRL2log(log::verbose) << "event span of the variable order = " << symbolic::event_span(m_summand_patterns, m_variable_order) << std::endl;
+      if (m_options.info)
+      {
+        mCRL2log(log::info) << symbolic::print_event_span_report(m_summand_patterns, m_variable_order, m_options.variable_order);
+      }
       m_summand_patterns = symbolic::reorder_read_write_patterns(m_summand_patterns, m_variable_order);
 
       m_lts.process_parameters = symbolic::permute_copy(m_lts.process_parameters, m_variable_order);
@@ -224,47 +267,27 @@ class lpsreach_algorithm
       }
       else
       {
-        // saturation and chaining
-        todo1 = todo;
-        ldd todo1_old; // the old todo set.
-
-        for (std::size_t i = 0; i < R.size(); i++)
+        // Saturation computes all states reachable from visited and todo at once, and learns the transitions
+        // on the fly. It therefore ignores chaining and learn_transitions.
+        if (!m_saturation)
         {
-          if (learn_transitions)
-          {
-            ldd proj = project(todo1, R[i].Ip);
-            learn_successors(i, R[i], m_options.cached ? minus(proj, R[i].Ldomain) : proj);
-
-            mCRL2log(log::trace) << "L =\n" << print_relation(m_lts.data_index, R[i].L, R[i].read, R[i].write) << std::endl;
-          }
-
-          // Apply one transition relation repeatedly.
-          do
-          {
-            todo1_old = todo1;
-            todo1 = union_(todo1, relprod_impl(todo1, R[i], i));
-          }
-          while (todo1 != todo1_old);
-
-          if (detect_deadlocks)
-          {
-            potential_deadlocks = minus(potential_deadlocks, relprev(todo1, R[i].L, R[i].Ir, potential_deadlocks));
-          }
+          m_saturation = std::make_unique<symbolic::saturation_algorithm<lps_summand_group>>(R, m_lts.process_parameters.size(),
+            [this](std::size_t i, lps_summand_group& group, const ldd& X)
+            {
+              learn_successors(i, group, m_options.cached ? minus(X, group.Ldomain) : X);
+            });
+        }
 
-          // Apply all previously learned transition relations repeatedly.
-          if (m_options.chaining)
+        ldd reachable = m_saturation->saturate(union_(visited, todo));
+        if (detect_deadlocks)
+        {
+          potential_deadlocks = minus(reachable, visited);
+          for (std::size_t i = 0; i < R.size(); i++)
           {
-            do
-            {
-              todo1_old = todo1;
-              for (std::size_t j = 0; j <= i; j++)
-              {
-                todo1 = union_(todo1, relprod_impl(todo1, R[j], j));
-              }
-            }
-            while (todo1 != todo1_old);
+            potential_deadlocks = minus(potential_deadlocks, relprev(reachable, R[i].L, R[i].Ir, potential_deadlocks));
           }
         }
+        return std::make_tuple(reachable, empty_set(), potential_deadlocks);
       }
 
       // after all transition groups are applied the remaining potential deadlocks are actual deadlocks.
@@ -287,6 +310,16 @@ class lpsreach_algorithm
       ldd deadlocks = empty_set();
       ldd potential_deadlocks = empty_set();
 
+      if (m_options.resume)
+      {
+        symbolic::reachability_checkpoint checkpoint = load_checkpoint();
+        iteration_count = checkpoint.iteration;
+        visited = checkpoint.visited;
+        todo = checkpoint.todo;
+        deadlocks = checkpoint.deadlocks;
+      }
+      stopwatch checkpoint_timer;
+
       while (todo != empty_set() && (m_options.max_iterations == 0 || iteration_count < m_options.max_iterations))
       {
         stopwatch loop_start;
@@ -305,6 +338,12 @@ class lpsreach_algorithm
           mCRL2log(log::verbose) << "found " << std::setw(12) << print_size(deadlocks) << " deadlocks" << std::endl;
         }
 
+        if (!m_options.checkpoint_file.empty() && todo != empty_set() && checkpoint_timer.seconds() >= static_cast<double>(m_options.checkpoint_interval))
+        {
+          save_checkpoint({iteration_count, visited, todo, deadlocks});
+          checkpoint_timer.reset();
+        }
+
         sylvan::sylvan_stats_report(stderr);
       }
 
@@ -14,6 +14,7 @@
 
 #include "mcrl2/data/rewrite.h"
 #include "mcrl2/lps/builder.h"
+#include "mcrl2/lps/detail/parallel_summand_map.h"
 
 namespace mcrl2::lps {
 
@@ -77,6 +78,43 @@ T rewrite(const T& x,
 }
 //--- end generated lps rewrite code ---//
 
+/// \brief Rewrites the data expressions of the linear process specification x, and distributes the summands
+/// over number_of_threads threads. Each thread uses its own clone of the rewriter R.
+template <typename Specification, typename DataRewriter>
+void rewrite(Specification& x, const DataRewriter& R, std::size_t number_of_threads)
+{
+  {
+    detail::thread_rewriters<DataRewriter> rewriters(R, number_of_threads);
+    detail::parallel_summand_update(x.process().action_summands(), number_of_threads,
+      [&](auto& summand, std::size_t t) { lps::rewrite(summand, rewriters(t)); });
+  }
+  {
+    detail::thread_rewriters<DataRewriter> rewriters(R, number_of_threads);
+    detail::parallel_summand_update(x.process().deadlock_summands(), number_of_threads,
+      [&](auto& summand, std::size_t t) { lps::rewrite(summand, rewriters(t)); });
+  }
+  x.initial_process() = lps::rewrite(x.initial_process(), R);
+}
+
+/// \brief Rewrites the data expressions of the linear process specification x, and applies the substitution
+/// sigma on the fly. The summands are distributed over number_of_threads threads, and each thread uses its own
+/// clone of the rewriter R.
+template <typename Specification, typename DataRewriter, data::IsSubstitution Substitution>
+void rewrite(Specification& x, const DataRewriter& R, const Substitution& sigma, std::size_t number_of_threads)
+{
+  {
+    detail::thread_rewriters<DataRewriter> rewriters(R, number_of_threads);
+    detail::parallel_summand_update(x.process().action_summands(), number_of_threads,
+      [&](auto& summand, std::size_t t) { lps::rewrite(summand, rewriters(t), sigma); });
+  }
+  {
+    detail::thread_rewriters<DataRewriter> rewriters(R, number_of_threads);
+    detail::parallel_summand_update(x.process().deadlock_summands(), number_of_threads,
+      [&](auto& summand, std::size_t t) { lps::rewrite(summand, rewriters(t), sigma); });
+  }
+  x.initial_process() = lps::rewrite(x.initial_process(), R, sigma);
+}
+
 } // namespace mcrl2::lps
 
 
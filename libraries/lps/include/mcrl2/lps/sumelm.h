@@ -22,6 +22,8 @@
 #include "mcrl2/data/find_equalities.h"
 #include "mcrl2/lps/decluster.h"
 
+#include <algorithm>
+
 namespace mcrl2::lps
 {
 
@@ -61,25 +63,25 @@ class sumelm_algorithm: public detail::lps_algorithm<Specification>
         decluster_algorithm<Specification>(m_spec).run();
       }
 
-      m_removed = 0; // Re-initialise number of removed variables for a fresh run.
-
-      for (action_summand& s: m_spec.process().action_summands())
-      {
-        (*this)(s);
-      }
+      // The number of removed variables per thread.
+      std::vector<std::size_t> removed(std::max(super::m_number_of_threads, std::size_t(1)), 0);
+      auto eliminate_summand = [&](auto& s, std::size_t t) { removed[t] += eliminate(s); };
+      detail::parallel_summand_update(m_spec.process().action_summands(), super::m_number_of_threads, eliminate_summand);
+      detail::parallel_summand_update(m_spec.process().deadlock_summands(), super::m_number_of_threads, eliminate_summand);
 
-      for (deadlock_summand& s: m_spec.process().deadlock_summands())
+      m_removed = 0; // Re-initialise number of removed variables for a fresh run.
+      for (std::size_t n: removed)
       {
-        (*this)(s);
+        m_removed += n;
       }
 
       mCRL2log(log::verbose) << "Removed " << m_removed << " summation variables" << std::endl;
     }
 
     /// \brief Apply the sum elimination lemma to summand s.
-    /// \param s an action_summand.
+    /// \return The number of removed summation variables.
     template <class Summand>
-    void operator()(Summand& s)
+    std::size_t eliminate(Summand& s) const
     {
       std::map<data::variable, std::set<data::data_expression> > equalities = data::find_equalities(s.condition());
       auto [sigma,remaining_variables] = data::make_one_point_rule_substitution(equalities, s.summation_variables());
@@ -95,7 +97,15 @@ class sumelm_algorithm: public detail::lps_algorithm<Specification>
       }
 
       super::summand_remove_unused_summand_variables(s);
-      m_removed += original_num_vars - s.summation_variables().size();
+      return original_num_vars - s.summation_variables().size();
+    }
+
+    /// \brief Apply the sum elimination lemma to summand s.
+    /// \param s an action_summand.
+    template <class Summand>
+    void operator()(Summand& s)
+    {
+      m_removed += eliminate(s);
     }
 
     /// \brief Returns the amount of removed summation variables.
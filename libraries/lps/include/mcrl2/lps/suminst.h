@@ -18,6 +18,9 @@
 
 #include "mcrl2/lps/detail/lps_algorithm.h"
 
+#include <atomic>
+#include <memory>
+
 namespace mcrl2::lps
 {
 
@@ -61,12 +64,15 @@ class suminst_algorithm: public detail::lps_algorithm<Specification>
     data::enumerator_identifier_generator m_id_generator;
 
     /// Statistiscs for verbose output
-    std::size_t m_processed = 0;
-    std::size_t m_deleted = 0;
-    std::size_t m_added = 0;
+    std::atomic<std::size_t> m_processed = 0;
+    std::atomic<std::size_t> m_deleted = 0;
+    std::atomic<std::size_t> m_added = 0;
 
     template <typename SummandType, typename Container>
-    std::size_t instantiate_summand(const SummandType& s, Container& result)
+    std::size_t instantiate_summand(const SummandType& s,
+                                    Container& result,
+                                    const DataRewriter& rewr,
+                                    const data::enumerator_algorithm<>& enumerator) const
     {
       using namespace data;
       std::size_t nr_summands = 0; // Counter for the number of new summands, used for verbose output
@@ -105,16 +111,16 @@ class suminst_algorithm: public detail::lps_algorithm<Specification>
         {
           mCRL2log(log::debug) << "enumerating variables " << vl << " in condition: " << data::pp(s.condition()) << std::endl;
           data::mutable_indexed_substitution<> local_sigma;
-          m_enumerator.enumerate(enumerator_element(vl, s.condition()),
+          enumerator.enumerate(enumerator_element(vl, s.condition()),
                                  local_sigma,
                                  [&](const enumerator_element& p)
                                  {
                                    mutable_indexed_substitution<> sigma;
-                                   p.add_assignments(vl, sigma, m_rewriter);
+                                   p.add_assignments(vl, sigma, rewr);
                                    mCRL2log(log::debug) << "substitutions: " << sigma << std::endl;
                                    SummandType t(s);
                                    t.summation_variables() = new_summation_variables;
-                                   lps::rewrite(t, m_rewriter, sigma);
+                                   lps::rewrite(t, rewr, sigma);
                                    result.push_back(t);
                                    ++nr_summands;
                                    return false;
@@ -138,41 +144,77 @@ class suminst_algorithm: public detail::lps_algorithm<Specification>
       return nr_summands;
     }
 
-    bool must_instantiate(const action_summand_type& summand)
+    bool must_instantiate(const action_summand_type& summand) const
     {
       return !m_tau_summands_only || summand.is_tau();
     }
 
-    bool must_instantiate(const deadlock_summand& )
+    bool must_instantiate(const deadlock_summand& ) const
     {
       return !m_tau_summands_only;
     }
 
-    template <typename SummandListType, typename Container>
-    void run(const SummandListType& list, Container& result)
+    template <typename Summand>
+    void run(std::vector<Summand>& summands)
     {
-      for (typename SummandListType::const_iterator i = list.begin(); i != list.end(); ++i)
+      if (super::m_number_of_threads <= 1)
       {
-        if (must_instantiate(*i))
+        std::vector<Summand> result;
+        for (const Summand& s: summands)
         {
-          std::size_t newsummands = instantiate_summand(*i, result);
-          if (newsummands > 0)
-          {
-            m_added += newsummands - 1;
-          }
-          else
+          run(s, result, m_rewriter, m_enumerator, m_id_generator);
+        }
+        summands.swap(result);
+        return;
+      }
+
+      // Each thread uses its own rewriter, and an enumerator with its own identifier generator.
+      // The identifier generators are copies of m_id_generator, and are reset for every
+      // summand, so the names of the variables that the enumerator introduces in lambda
+      // and set expressions are the same as in the sequential case, whichever thread
+      // instantiates the summand.
+      detail::thread_rewriters<DataRewriter> rewriters(m_rewriter, super::m_number_of_threads);
+      std::vector<std::unique_ptr<data::enumerator_identifier_generator>> id_generators(super::m_number_of_threads);
+      std::vector<std::unique_ptr<data::enumerator_algorithm<>>> enumerators(super::m_number_of_threads);
+      detail::parallel_summand_map(summands, super::m_number_of_threads, [&](const Summand& s, std::vector<Summand>& result, std::size_t t)
+        {
+          const DataRewriter& rewr = rewriters(t);
+          if (!enumerators[t])
           {
-            ++m_deleted;
+            id_generators[t] = std::make_unique<data::enumerator_identifier_generator>(m_id_generator);
+            enumerators[t] = std::make_unique<data::enumerator_algorithm<>>(rewr, m_spec.data(), rewr, *id_generators[t], false);
           }
+          run(s, result, rewr, *enumerators[t], *id_generators[t]);
+        });
+    }
+
+    template <typename Summand>
+    void run(const Summand& s,
+             std::vector<Summand>& result,
+             const DataRewriter& rewr,
+             const data::enumerator_algorithm<>& enumerator,
+             data::enumerator_identifier_generator& id_generator)
+    {
+      if (must_instantiate(s))
+      {
+        id_generator.clear();
+        std::size_t newsummands = instantiate_summand(s, result, rewr, enumerator);
+        if (newsummands > 0)
+        {
+          m_added += newsummands - 1;
         }
         else
         {
-          result.push_back(*i);
+          ++m_deleted;
         }
-        ++m_processed;
-        mCRL2log(log::status) << "Replaced " << m_processed << " summands by " << (m_processed + m_added - m_deleted)
-                              << " summands (" << m_deleted << " were deleted)" << std::endl;
       }
+      else
+      {
+        result.push_back(s);
+      }
+      ++m_processed;
+      mCRL2log(log::status) << "Replaced " << m_processed << " summands by " << (m_processed + m_added - m_deleted)
+                            << " summands (" << m_deleted << " were deleted)" << std::endl;
     }
 
   public:
@@ -195,15 +237,11 @@ class suminst_algorithm: public detail::lps_algorithm<Specification>
 
     void run()
     {
-      action_summand_vector_type action_summands;
-      deadlock_summand_vector deadlock_summands;
       m_added = 0;
       m_deleted = 0;
       m_processed = 0;
-      run(m_spec.process().action_summands(), action_summands);
-      run(m_spec.process().deadlock_summands(), deadlock_summands);
-      m_spec.process().action_summands().swap(action_summands);
-      m_spec.process().deadlock_summands().swap(deadlock_summands);
+      run(m_spec.process().action_summands());
+      run(m_spec.process().deadlock_summands());
       mCRL2log(log::status) << std::endl;
     }
 
@@ -33,6 +33,7 @@
 //#define MCRL2_LOG_LPS_LINEARISE_STATISTICS 1
 
 //mCRL2 data
+#include <optional>
 #include <ranges>
 
 #include "mcrl2/atermpp/aterm.h"
@@ -59,6 +60,9 @@
 #include "mcrl2/process/balance_nesting_depth.h"
 #include "mcrl2/process/process_expression.h"
 
+// Utilities.
+#include "mcrl2/utilities/detail/parallel_apply.h"
+
 
 // For Aterm library extension functions
 using namespace atermpp;
@@ -544,6 +548,43 @@ class specification_basic_type
       return t;
     }
 
+    /// \brief Returns one rewrite function for each of the options.number_of_threads threads.
+    /// \details The t-th function may only be used by the thread with index t in a single call of
+    ///          mcrl2::utilities::detail::parallel_apply. With one thread, RewriteTerm is used.
+    std::vector<std::function<data_expression(const data_expression&)>> thread_rewrite_functions()
+    {
+      if (options.number_of_threads <= 1 || options.norewrite)
+      {
+        return { [this](const data_expression& t) { return RewriteTerm(t); } };
+      }
+
+      if (fresh_equation_added)
+      {
+        rewr=rewriter(data,options.rewrite_strategy);
+        fresh_equation_added=false;
+      }
+
+      // Each thread clones rewr itself on first use. The terms in the caches of a clone are then registered
+      // with the thread that uses it, which is required as the rewriter modifies these caches while rewriting.
+      std::shared_ptr<std::vector<std::optional<rewriter>>> clones=
+                     std::make_shared<std::vector<std::optional<rewriter>>>(options.number_of_threads);
+      std::vector<std::function<data_expression(const data_expression&)>> result;
+      for (std::size_t i=0; i<options.number_of_threads; ++i)
+      {
+        result.emplace_back([this, clones, i](const data_expression& t)
+          {
+            std::optional<rewriter>& clone=(*clones)[i];
+            if (!clone)
+            {
+              clone=rewr.clone();
+              clone->thread_initialise();
+            }
+            return (*clone)(t);
+          });
+      }
+      return result;
+    }
+
     data_expression_list RewriteTermList(const data_expression_list& t)
     {
       data_expression_vector v;
@@ -7753,9 +7794,14 @@ class specification_basic_type
         allow_cache = lps::detail::make_allow_list_cache(allowlist);
       }
 
-      // First combine the action summands.
-      for (const stochastic_action_summand& summand1: action_summands1)
+      // First combine the action summands. The pairs of summands are combined in parallel. The summands that
+      // result from action_summands1[i] are stored in results[i], such that their order does not depend on the
+      // number of threads.
+      const std::vector<std::function<data_expression(const data_expression&)>> rewriters=thread_rewrite_functions();
+      std::vector<stochastic_action_summand_vector> results(action_summands1.size());
+      mcrl2::utilities::detail::parallel_apply(action_summands1.size(), rewriters.size(), [&](std::size_t i, std::size_t t)
       {
+        const stochastic_action_summand& summand1=action_summands1[i];
         const variable_list& sumvars1=summand1.summation_variables();
         const action_list multiaction1=summand1.multi_action().actions();
         const data_expression& actiontime1=summand1.multi_action().time();
@@ -7828,11 +7874,11 @@ class specification_basic_type
                                               distribution1.variables()+distribution2.variables(),
                                               real_times_optimized(distribution1.distribution(),distribution2.distribution()));
 
-            condition3=RewriteTerm(condition3);
+            condition3=rewriters[t](condition3);
             if (condition3!=sort_bool::false_())
             {
               assert(std::is_sorted(multiaction3.begin(), multiaction3.end()));
-              action_summands.emplace_back(allsums,
+              results[i].emplace_back(allsums,
                   condition3,
                   has_time3 ? multi_action(multiaction3, action_time3) : multi_action(multiaction3),
                   nextstate3,
@@ -7840,6 +7886,11 @@ class specification_basic_type
             }
           }
         }
+      });
+
+      for (const stochastic_action_summand_vector& result: results)
+      {
+        action_summands.insert(action_summands.end(), result.begin(), result.end());
       }
     }
 
@@ -8378,7 +8429,7 @@ class specification_basic_type
         {
           generateLPEmCRLterm(action_summands,deadlock_summands,comm(par).operand(),
                                 regular,rename_variables,pars,init,initial_stochastic_distribution,ultimate_delay_condition);
-          communicationcomposition(comm(par).comm_set(),allow(t).allow_set(),true,false,action_summands,deadlock_summands,terminationAction,options.nosumelm,options.nodeltaelimination,options.ignore_time,[this](const data::data_expression& e) { return RewriteTerm(e); });
+          communicationcomposition(comm(par).comm_set(),allow(t).allow_set(),true,false,action_summands,deadlock_summands,terminationAction,options.nosumelm,options.nodeltaelimination,options.ignore_time,thread_rewrite_functions());
           return;
         }
 
@@ -8422,7 +8473,7 @@ class specification_basic_type
                                 regular,rename_variables,pars,init,initial_stochastic_distribution,ultimate_delay_condition);
           // Encode the actions of the block list in one multi action.
           communicationcomposition(comm(par).comm_set(),action_name_multiset_list( { action_name_multiset(block(t).block_set())} ),
-                                                     false,true,action_summands,deadlock_summands,terminationAction,options.nosumelm,options.nodeltaelimination,options.ignore_time,[this](const data::data_expression& e) { return RewriteTerm(e); });
+                                                     false,true,action_summands,deadlock_summands,terminationAction,options.nosumelm,options.nodeltaelimination,options.ignore_time,thread_rewrite_functions());
           return;
         }
 
@@ -8444,7 +8495,7 @@ class specification_basic_type
       {
         generateLPEmCRLterm(action_summands,deadlock_summands,comm(t).operand(),
                               regular,rename_variables,pars,init,initial_stochastic_distribution,ultimate_delay_condition);
-        communicationcomposition(comm(t).comm_set(),action_name_multiset_list(),false,false,action_summands,deadlock_summands,terminationAction,options.nosumelm,options.nodeltaelimination,options.ignore_time,[this](const data::data_expression& e) { return RewriteTerm(e); });
+        communicationcomposition(comm(t).comm_set(),action_name_multiset_list(),false,false,action_summands,deadlock_summands,terminationAction,options.nosumelm,options.nodeltaelimination,options.ignore_time,thread_rewrite_functions());
         return;
       }
 
@@ -470,3 +470,37 @@ BOOST_AUTO_TEST_CASE(bug_report_1576)
   run_linearisation_test_case(report_1576, false);
 }
 
+
+// Checks that the result of the linearisation does not depend on the number of threads.
+BOOST_AUTO_TEST_CASE(test_threads)
+{
+  const std::string spec_comm =
+    "act s1, r1, c1, s2, r2, c2: Nat;\n"
+    "    done;\n"
+    "proc P(n: Nat) = sum m: Nat. (m < 3) -> s1(m).P(n + m) + r2(n).P(0) + (n > 5) -> done.P(n);\n"
+    "     Q(n: Nat) = sum m: Nat. r1(m).Q(m) + s2(n).Q(n + 1);\n"
+    "init allow({c1, c2, done}, comm({s1|r1 -> c1, s2|r2 -> c2}, P(0) || Q(1) || Q(2)));\n";
+
+  const std::string spec_block =
+    "act a, b, c: Bool;\n"
+    "proc P(x: Bool) = a(x).P(!x) + b(x).P(x);\n"
+    "     Q(y: Bool) = sum z: Bool. b(z).Q(y && z) + c(y).Q(!y);\n"
+    "init block({a}, comm({a|b -> c}, P(true) || Q(false) || P(false)));\n";
+
+  const std::string spec_timed =
+    "act a, b, c;\n"
+    "proc P(t: Real) = a@t.P(t + 1) + b.P(t);\n"
+    "     Q = b.Q + c@3.Q;\n"
+    "init comm({a|b -> c}, P(1) || Q);\n";
+
+  std::size_t number_of_threads = mcrl2::utilities::detail::GlobalThreadSafe ? 4 : 1;
+  for (const std::string& spec: { spec_comm, spec_block, spec_timed })
+  {
+    t_lin_options options;
+    options.ignore_time = spec != spec_timed;
+    const std::string expected_result = lps::pp(linearise(spec, options));
+    options.number_of_threads = number_of_threads;
+    const std::string result = lps::pp(linearise(spec, options));
+    BOOST_CHECK_EQUAL(result, expected_result);
+  }
+}
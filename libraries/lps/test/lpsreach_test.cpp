@@ -0,0 +1,120 @@
+// Author(s): agent
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file lpsreach_test.cpp
+/// \brief Tests for the symbolic reachability algorithm.
+
+#define BOOST_TEST_MODULE lpsreach_test
+#include <boost/test/included/unit_test.hpp>
+
+BOOST_AUTO_TEST_CASE(dummy_test)
+{
+  // This is an empty test since at least one test is required.
+}
+
+#ifdef MCRL2_ENABLE_SYLVAN
+
+#include "mcrl2/lps/linearise.h"
+#include "mcrl2/lps/lpsreach.h"
+#include "mcrl2/symbolic/test_utility.h"
+
+using namespace mcrl2;
+
+static double number_of_states(const lps::specification& lpsspec, bool saturation, bool chaining)
+{
+  symbolic::symbolic_reachability_options options;
+  options.saturation = saturation;
+  options.chaining = chaining;
+  options.summand_groups = "none";
+  options.variable_order = "none";
+  lps::lpsreach_algorithm algorithm(lpsspec, options);
+  return sylvan::ldds::satcount(algorithm.run());
+}
+
+// The algorithm must run inside a Lace task, since the transitions are learned by Lace workers.
+// NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
+TASK_DECL_0(bool, saturation_test_task);
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#define saturation_test_task(a) RUN(saturation_test_task, a)
+
+// NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
+TASK_IMPL_0(bool, saturation_test_task)
+{
+  // Three independent counters and a summand that synchronises two of them.
+  const std::string text =
+    "act a, b, c, sync;\n"
+    "proc P(x, y, z: Nat) =\n"
+    "  (x < 4) -> a . P(x = x + 1)\n"
+    "+ (y < 3) -> b . P(y = y + 1)\n"
+    "+ (z < 5) -> c . P(z = z + 1)\n"
+    "+ (x == 4 && z > 0) -> sync . P(x = 0, z = Int2Nat(z - 1));\n"
+    "init P(0, 0, 0);\n";
+  const lps::specification lpsspec = lps::remove_stochastic_operators(lps::linearise(text));
+
+  const double expected = number_of_states(lpsspec, false, false);
+  BOOST_CHECK_EQUAL(expected, 5.0 * 4.0 * 6.0);
+  BOOST_CHECK_EQUAL(number_of_states(lpsspec, true, false), expected);
+  BOOST_CHECK_EQUAL(number_of_states(lpsspec, true, true), expected);
+  return true;
+}
+
+BOOST_AUTO_TEST_CASE(saturation_test)
+{
+  symbolic::initialise_sylvan();
+  saturation_test_task();
+  symbolic::quit_sylvan();
+}
+
+// NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
+TASK_DECL_0(bool, checkpoint_test_task);
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#define checkpoint_test_task(a) RUN(checkpoint_test_task, a)
+
+// NOLINTNEXTLINE(cppcoreguidelines-pro-type-cstyle-cast)
+TASK_IMPL_0(bool, checkpoint_test_task)
+{
+  const std::string text =
+    "act a, b: Nat;\n"
+    "proc P(x, y: Nat) =\n"
+    "  (x < 6) -> a(x) . P(x = x + 1)\n"
+    "+ (y < 7 && x > 2) -> b(y) . P(y = y + 1);\n"
+    "init P(0, 0);\n";
+  const lps::specification lpsspec = lps::remove_stochastic_operators(lps::linearise(text));
+  const std::string filename = "lpsreach_checkpoint_test.ckpt";
+
+  symbolic::symbolic_reachability_options options;
+  options.summand_groups = "none";
+  options.variable_order = "none";
+  options.checkpoint_file = filename;
+  options.checkpoint_interval = 0;
+
+  // Stop after a few iterations, such that the last checkpoint is not the final state space.
+  options.max_iterations = 4;
+  {
+    lps::lpsreach_algorithm algorithm(lpsspec, options);
+    BOOST_CHECK(sylvan::ldds::satcount(algorithm.run()) < 35.0);
+  }
+
+  options.max_iterations = 0;
+  options.resume = true;
+  lps::lpsreach_algorithm algorithm(lpsspec, options);
+  BOOST_CHECK_EQUAL(sylvan::ldds::satcount(algorithm.run()), 35.0); // 3 states with x < 3 and 4 * 8 with x >= 3
+  BOOST_CHECK_EQUAL(algorithm.action_index().size(), 6u + 7u);
+
+  std::remove(filename.c_str());
+  return true;
+}
+
+BOOST_AUTO_TEST_CASE(checkpoint_test)
+{
+  symbolic::initialise_sylvan();
+  checkpoint_test_task();
+  symbolic::quit_sylvan();
+}
+
+#endif // MCRL2_ENABLE_SYLVAN
@@ -398,3 +398,30 @@ BOOST_AUTO_TEST_CASE(test_whr_clause)
 }
 
 
+///Sum elimination with multiple threads must give the same result as with a single thread
+BOOST_AUTO_TEST_CASE(test_threads)
+{
+  std::clog << "Test case 13 (threads)" << std::endl;
+  const std::string text(
+    "act a,b:Nat;\n"
+    "proc P(n:Nat) = sum x:Nat . (x == n) -> a(x) . P(x + 1)\n"
+    "              + sum x,y:Nat . (x == 3 && y == x + n) -> b(y) . P(x)\n"
+    "              + sum x:Nat . (n == x || x > 2) -> a(n) . P(n)\n"
+    "              + sum x,y:Nat . (x == y) -> delta @ x\n"
+    "              + sum x:Nat . (n > x) -> b(x) . P(0);\n"
+    "init P(0);\n"
+  );
+
+  specification s0 = parse_linear_process_specification(text);
+  specification s1 = s0;
+  sumelm_algorithm<> algorithm1(s1);
+  algorithm1.run();
+
+  specification s2 = s0;
+  sumelm_algorithm<> algorithm2(s2);
+  algorithm2.set_number_of_threads(mcrl2::utilities::detail::GlobalThreadSafe ? 4 : 1);
+  algorithm2.run();
+
+  BOOST_CHECK_EQUAL(lps::pp(s1), lps::pp(s2));
+  BOOST_CHECK_EQUAL(algorithm1.removed(), algorithm2.removed());
+}
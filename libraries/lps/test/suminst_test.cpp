@@ -11,6 +11,7 @@
 
 #define BOOST_TEST_MODULE suminst_test
 #include <boost/test/included/unit_test.hpp>
+#include <regex>
 
 #include "mcrl2/lps/linearise.h"
 #include "mcrl2/lps/suminst.h"
@@ -206,6 +207,71 @@ void test_case_7()
   BOOST_CHECK(sum_count == 1);
 }
 
+// Check that instantiating with multiple threads gives the same result as with a single thread
+void test_threads()
+{
+  const std::string text(
+    "sort D = struct d1|d2|d3;\n"
+    "act a:D;\n"
+    "    b:D#D;\n"
+    "    c;\n"
+    "proc P(x:D, n:Nat) = sum d:D . (d != x) -> a(d) . P(d, n + 1)\n"
+    "                   + sum d,e:D . (d == e) -> b(d, e) . P(e, n)\n"
+    "                   + sum d:D, m:Nat . (m < n) -> b(d, x) . P(x, m)\n"
+    "                   + sum d:D . (d == x) -> c . delta\n"
+    "                   + sum d:D . (n > 2 && d == d1) -> delta;\n"
+    "init P(d1, 0);\n"
+  );
+
+  specification s0=remove_stochastic_operators(linearise(text));
+  rewriter r(s0.data());
+  specification s1(s0);
+  suminst_algorithm<rewriter, specification>(s1, r).run();
+
+  std::size_t number_of_threads = mcrl2::utilities::detail::GlobalThreadSafe ? 4 : 1;
+  specification s2(s0);
+  suminst_algorithm<rewriter, specification> algorithm(s2, r);
+  algorithm.set_number_of_threads(number_of_threads);
+  algorithm.run();
+  BOOST_CHECK_EQUAL(lps::pp(s1), lps::pp(s2));
+}
+
+// Removes the sequence number from the names of the variables that an enumerator introduces,
+// as every instance of the algorithm uses its own identifier generator
+std::string remove_generator_prefix(const std::string& text)
+{
+  return std::regex_replace(text, std::regex("\\bx_[0-9]+_"), "x_");
+}
+
+// Check that the names of the variables in the lambda expressions that are obtained by
+// instantiating a function sort do not depend on the number of threads
+void test_threads_function_sort()
+{
+  const std::string text(
+    "sort D = struct d1|d2;\n"
+    "act a:D->Bool;\n"
+    "    b:D#(D->Bool);\n"
+    "proc P(x:D) = sum f:D->Bool . f(x) -> a(f) . P(d1)\n"
+    "            + sum f:D->Bool . !f(x) -> a(f) . P(d2)\n"
+    "            + sum f:D->Bool . b(x, f) . P(x)\n"
+    "            + sum f,g:D->Bool . (f(d1) && g(d2)) -> b(x, f) . a(g) . P(x);\n"
+    "init P(d1);\n"
+  );
+
+  specification s0=remove_stochastic_operators(linearise(text));
+  rewriter r(s0.data());
+  specification s1(s0);
+  suminst_algorithm<rewriter, specification>(s1, r).run();
+  BOOST_CHECK(s1.process().action_summands().size() > s0.process().action_summands().size());
+
+  std::size_t number_of_threads = mcrl2::utilities::detail::GlobalThreadSafe ? 4 : 1;
+  specification s2(s0);
+  suminst_algorithm<rewriter, specification> algorithm(s2, r);
+  algorithm.set_number_of_threads(number_of_threads);
+  algorithm.run();
+  BOOST_CHECK_EQUAL(remove_generator_prefix(lps::pp(s1)), remove_generator_prefix(lps::pp(s2)));
+}
+
 BOOST_AUTO_TEST_CASE(test_main)
 {
   std::clog << "test case 1" << std::endl;
@@ -220,5 +286,9 @@ BOOST_AUTO_TEST_CASE(test_main)
   test_case_5();
   std::clog << "test case 6" << std::endl;
   test_case_6();
+  std::clog << "test threads" << std::endl;
+  test_threads();
+  std::clog << "test threads with a function sort" << std::endl;
+  test_threads_function_sort();
 }
 
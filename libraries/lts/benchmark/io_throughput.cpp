@@ -0,0 +1,72 @@
+// Author(s): agent
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file io_throughput.cpp
+/// \brief Measures the time to write and read a large lts in the binary format.
+
+#include "mcrl2/atermpp/aterm_io_binary.h"
+#include "mcrl2/lts/lts_io.h"
+#include "mcrl2/utilities/stopwatch.h"
+
+#include <sstream>
+
+using namespace mcrl2;
+
+int main(int argc, char* argv[])
+{
+  // Accept one argument for the number of states.
+  std::size_t number_of_states = 1000000;
+  if (argc > 1)
+  {
+    number_of_states = static_cast<std::size_t>(std::stoul(argv[1]));
+  }
+
+  // An lts with parameterised actions and state labels, and four transitions per state.
+  lts::lts_lts_t l;
+  l.set_process_parameters(data::variable_list({data::variable("x", data::sort_nat::nat()), data::variable("y", data::sort_nat::nat())}));
+  const process::action_label a(core::identifier_string("a"), data::sort_expression_list({data::sort_nat::nat()}));
+  const std::size_t number_of_actions = 1000;
+  for (std::size_t i = 0; i < number_of_actions; ++i)
+  {
+    const process::action_list actions{process::action(a, data::data_expression_list({data::sort_nat::nat(i)}))};
+    l.add_action(lts::action_label_lts(lps::multi_action(actions)));
+  }
+
+  for (std::size_t i = 0; i < number_of_states; ++i)
+  {
+    l.add_state(lts::state_label_lts(data::data_expression_vector({data::sort_nat::nat(i % 1000), data::sort_nat::nat(i / 1000)})));
+    for (std::size_t j = 1; j <= 4; ++j)
+    {
+      l.add_transition(lts::transition(i, (i * j) % number_of_actions, (i * 7 + j * 13) % number_of_states));
+    }
+  }
+
+  std::stringstream stream;
+  stopwatch timer;
+  {
+    atermpp::binary_aterm_ostream output(stream);
+    output << l;
+  }
+  const double write_time = timer.seconds();
+
+  timer.reset();
+  lts::lts_lts_t result;
+  {
+    atermpp::binary_aterm_istream input(stream);
+    input >> result;
+  }
+  const double read_time = timer.seconds();
+
+  const double megabytes = static_cast<double>(stream.str().size()) / (1024 * 1024);
+  std::cerr << "size: " << megabytes << " MiB\n";
+  std::cerr << "write: " << write_time << " s (" << megabytes / write_time << " MiB/s)\n";
+  std::cerr << "read: " << read_time << " s (" << megabytes / read_time << " MiB/s)\n";
+  std::cerr << "time: " << write_time + read_time << std::endl;
+
+  return result.num_transitions() == l.num_transitions() ? 0 : 1;
+}
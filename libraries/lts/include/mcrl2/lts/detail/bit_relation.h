@@ -0,0 +1,257 @@
+// Author(s): agent
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file lts/detail/bit_relation.h
+/// \brief A binary relation stored as a matrix of bits.
+/// \details All rows are stored consecutively in one vector of 64 bit words, where
+///          each row is padded to a whole number of words. Operations on complete
+///          rows work word by word, in plain loops that the compiler vectorises.
+
+#ifndef MCRL2_LTS_DETAIL_BIT_RELATION_H
+#define MCRL2_LTS_DETAIL_BIT_RELATION_H
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+namespace mcrl2::lts::detail
+{
+
+/// \brief A relation on {0,...,rows-1} x {0,...,columns-1}, stored as packed bits.
+/// \details Rows can be added at the end, but the number of columns is fixed when
+///          the relation is assigned.
+class bit_relation
+{
+  public:
+    using word_type = std::uint64_t;
+    static constexpr std::size_t bits_per_word = 64;
+
+    /// \brief Constant that is returned by find_next when there is no next element.
+    static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+  protected:
+    std::size_t m_rows = 0;
+    std::size_t m_columns = 0;
+    std::size_t m_words_per_row = 0;
+    std::vector<word_type> m_words;
+
+    static word_type mask(const std::size_t j)
+    {
+      return word_type(1) << (j % bits_per_word);
+    }
+
+    word_type* row_begin(const std::size_t i)
+    {
+      assert(i < m_rows);
+      return m_words.data() + i*m_words_per_row;
+    }
+
+    const word_type* row_begin(const std::size_t i) const
+    {
+      assert(i < m_rows);
+      return m_words.data() + i*m_words_per_row;
+    }
+
+  public:
+    bit_relation() = default;
+
+    bit_relation(const std::size_t rows, const std::size_t columns)
+    {
+      assign(rows, columns);
+    }
+
+    /// \brief Make this the empty relation of the given dimensions.
+    void assign(const std::size_t rows, const std::size_t columns)
+    {
+      m_rows = rows;
+      m_columns = columns;
+      m_words_per_row = (columns + bits_per_word - 1) / bits_per_word;
+      m_words.assign(m_rows*m_words_per_row, 0);
+    }
+
+    std::size_t rows() const
+    {
+      return m_rows;
+    }
+
+    std::size_t columns() const
+    {
+      return m_columns;
+    }
+
+    bool test(const std::size_t i, const std::size_t j) const
+    {
+      assert(j < m_columns);
+      return (row_begin(i)[j / bits_per_word] & mask(j)) != 0;
+    }
+
+    void set(const std::size_t i, const std::size_t j)
+    {
+      assert(j < m_columns);
+      row_begin(i)[j / bits_per_word] |= mask(j);
+    }
+
+    void reset(const std::size_t i, const std::size_t j)
+    {
+      assert(j < m_columns);
+      row_begin(i)[j / bits_per_word] &= ~mask(j);
+    }
+
+    void set(const std::size_t i, const std::size_t j, const bool value)
+    {
+      if (value)
+      {
+        set(i, j);
+      }
+      else
+      {
+        reset(i, j);
+      }
+    }
+
+    /// \brief Add a copy of row i as a new last row.
+    void push_back_row(const std::size_t i)
+    {
+      assert(i < m_rows);
+      m_words.resize(m_words.size() + m_words_per_row);
+      ++m_rows;
+      std::copy(row_begin(i), row_begin(i) + m_words_per_row, row_begin(m_rows-1));
+    }
+
+    /// \brief Returns true iff row i of this relation and row j of other have an element in common.
+    bool intersects(const std::size_t i, const bit_relation& other, const std::size_t j) const
+    {
+      assert(m_words_per_row == other.m_words_per_row);
+      const word_type* a = row_begin(i);
+      const word_type* b = other.row_begin(j);
+      word_type result = 0;
+      for (std::size_t k = 0; k < m_words_per_row; ++k)
+      {
+        result |= a[k] & b[k];
+      }
+      return result != 0;
+    }
+
+    /// \brief Row i becomes the union of row i and row j of other.
+    void row_or(const std::size_t i, const bit_relation& other, const std::size_t j)
+    {
+      assert(m_words_per_row == other.m_words_per_row);
+      word_type* a = row_begin(i);
+      const word_type* b = other.row_begin(j);
+      for (std::size_t k = 0; k < m_words_per_row; ++k)
+      {
+        a[k] |= b[k];
+      }
+    }
+
+    /// \brief Row i becomes the intersection of row i and row j of other.
+    void row_and(const std::size_t i, const bit_relation& other, const std::size_t j)
+    {
+      assert(m_words_per_row == other.m_words_per_row);
+      word_type* a = row_begin(i);
+      const word_type* b = other.row_begin(j);
+      for (std::size_t k = 0; k < m_words_per_row; ++k)
+      {
+        a[k] &= b[k];
+      }
+    }
+
+    /// \brief Row i becomes row i minus row j of other.
+    void row_andnot(const std::size_t i, const bit_relation& other, const std::size_t j)
+    {
+      assert(m_words_per_row == other.m_words_per_row);
+      word_type* a = row_begin(i);
+      const word_type* b = other.row_begin(j);
+      for (std::size_t k = 0; k < m_words_per_row; ++k)
+      {
+        a[k] &= ~b[k];
+      }
+    }
+
+    /// \brief The number of elements in row i.
+    std::size_t count(const std::size_t i) const
+    {
+      const word_type* a = row_begin(i);
+      std::size_t result = 0;
+      for (std::size_t k = 0; k < m_words_per_row; ++k)
+      {
+        result += static_cast<std::size_t>(std::popcount(a[k]));
+      }
+      return result;
+    }
+
+    /// \brief The number of pairs in the relation.
+    std::size_t count() const
+    {
+      std::size_t result = 0;
+      for (const word_type w: m_words)
+      {
+        result += static_cast<std::size_t>(std::popcount(w));
+      }
+      return result;
+    }
+
+    /// \brief The smallest j' >= j such that (i,j') is in the relation, or npos if it does not exist.
+    std::size_t find_next(const std::size_t i, const std::size_t j) const
+    {
+      if (j >= m_columns)
+      {
+        return npos;
+      }
+      const word_type* a = row_begin(i);
+      std::size_t k = j / bits_per_word;
+      word_type w = a[k] & (~word_type(0) << (j % bits_per_word));
+      while (w == 0)
+      {
+        ++k;
+        if (k == m_words_per_row)
+        {
+          return npos;
+        }
+        w = a[k];
+      }
+      return k*bits_per_word + static_cast<std::size_t>(std::countr_zero(w));
+    }
+
+    /// \brief Applies f to each j such that (i,j) is in the relation, in increasing order.
+    /// \details The function f may remove (i,j) from the relation, but must not add elements to row i.
+    template <typename FUNCTION>
+    void for_each_in_row(const std::size_t i, FUNCTION f) const
+    {
+      const word_type* a = row_begin(i);
+      for (std::size_t k = 0; k < m_words_per_row; ++k)
+      {
+        word_type w = a[k];
+        while (w != 0)
+        {
+          f(k*bits_per_word + static_cast<std::size_t>(std::countr_zero(w)));
+          w &= w - 1;
+        }
+      }
+    }
+
+    /// \brief The number of bytes used to store the relation.
+    std::size_t memory_usage() const
+    {
+      return m_words.capacity()*sizeof(word_type);
+    }
+
+    void swap(bit_relation& other) noexcept
+    {
+      std::swap(m_rows, other.m_rows);
+      std::swap(m_columns, other.m_columns);
+      std::swap(m_words_per_row, other.m_words_per_row);
+      m_words.swap(other.m_words);
+    }
+};
+
+} // namespace mcrl2::lts::detail
+
+#endif // MCRL2_LTS_DETAIL_BIT_RELATION_H
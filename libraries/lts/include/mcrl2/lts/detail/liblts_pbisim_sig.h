@@ -0,0 +1,459 @@
+// Author(s): agent
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file lts/detail/liblts_pbisim_sig.h
+/// \brief Probabilistic bisimulation reduction by parallel signature refinement.
+
+#ifndef MCRL2_LTS_DETAIL_LIBLTS_PBISIM_SIG_H
+#define MCRL2_LTS_DETAIL_LIBLTS_PBISIM_SIG_H
+
+#include <algorithm>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+#include "mcrl2/lts/detail/liblts_plts_merge.h"
+#include "mcrl2/lts/detail/lts_convert.h"
+#include "mcrl2/utilities/detail/parallel_apply.h"
+#include "mcrl2/utilities/execution_timer.h"
+#include "mcrl2/utilities/hash_utility.h"
+#include "mcrl2/utilities/probabilistic_arbitrary_precision_fraction.h"
+
+namespace mcrl2::lts::detail
+{
+
+/// \brief Returns p as a fraction of which the enumerator and denominator have no common factors, such that equal
+///        probabilities have equal representations.
+inline utilities::probabilistic_arbitrary_precision_fraction normalised_probability(const utilities::probabilistic_arbitrary_precision_fraction& p)
+{
+  utilities::big_natural_number enumerator = p.enumerator();
+  utilities::big_natural_number denominator = p.denominator();
+  utilities::probabilistic_arbitrary_precision_fraction::remove_common_factors(enumerator, denominator);
+  return utilities::probabilistic_arbitrary_precision_fraction(enumerator, denominator);
+}
+
+inline utilities::probabilistic_arbitrary_precision_fraction normalised_probability(const lps::probabilistic_data_expression& p)
+{
+  return normalised_probability(translate_probability_data_to_arbitrary_size_probability(p));
+}
+
+template <class LTS_TYPE>
+class prob_bisim_partitioner_sig
+{
+  public:
+    /** \brief Creates a probabilistic bisimulation partitioner for a PLTS.
+     *  \details The partition of the states is refined by signatures until it is stable. The signature of a state
+     *   consists of its block and the pairs of an action label and the class of a target distribution. Two
+     *   distributions are in the same class iff they assign the same probability to every block. The signatures
+     *   of all states and distributions are computed in parallel, using exact fractions for the probabilities.
+     *   The number of rounds is bounded by the number of states, but is typically small.
+     */
+    prob_bisim_partitioner_sig(LTS_TYPE& l, utilities::execution_timer& timer, std::size_t number_of_threads = 1)
+      : aut(l),
+        m_number_of_threads(std::max<std::size_t>(number_of_threads, 1))
+    {
+      mCRL2log(log::verbose) << "Probabilistic bisimulation partitioner created for "
+                  << l.num_states() << " states and " <<
+                  l.num_transitions() << " transitions, using " << m_number_of_threads << " thread(s)\n";
+      timer.start("bisimulation_reduce (sig)");
+      create_compressed_representation();
+      refine_partition_until_it_becomes_stable();
+      timer.finish("bisimulation_reduce (sig)");
+    }
+
+    /** \brief Gives the number of bisimulation equivalence classes of the LTS.
+    *  \return The number of bisimulation equivalence classes of the LTS.
+    */
+    std::size_t num_eq_classes() const
+    {
+      return m_number_of_blocks;
+    }
+
+    /** \brief Gives the bisimulation equivalence class number of a state.
+     *  \param[in] s A state number.
+     *  \return The number of the bisimulation equivalence class to which \e s belongs. */
+    std::size_t get_eq_class(const std::size_t s) const
+    {
+      assert(s < m_block.size());
+      return m_block[s];
+    }
+
+    /** \brief Gives the class number of a probabilistic state.
+    *  \param[in] d A probabilistic state number. The number of probabilistic states of the LTS refers to
+    *               the initial probabilistic state.
+    *  \return The number of the class of equivalent probabilistic states to which \e d belongs. */
+    std::size_t get_eq_probabilistic_class(const std::size_t d) const
+    {
+      assert(d < m_distribution_class.size());
+      return m_distribution_class[d];
+    }
+
+    /** \brief Replaces the transition relation of the current lts by the transitions
+    *         of the bisimulation reduced transition system.
+    * \pre The bisimulation equivalence classes have been computed. */
+    void replace_transitions()
+    {
+      std::vector<transition> resulting_transitions;
+      resulting_transitions.reserve(aut.num_transitions());
+      for (const transition& t: aut.get_transitions())
+      {
+        resulting_transitions.emplace_back(get_eq_class(t.from()), t.label(), get_eq_probabilistic_class(t.to()));
+      }
+      std::sort(resulting_transitions.begin(), resulting_transitions.end());
+      resulting_transitions.erase(std::unique(resulting_transitions.begin(), resulting_transitions.end()), resulting_transitions.end());
+
+      aut.clear_transitions();
+      for (const transition& t: resulting_transitions)
+      {
+        aut.add_transition(t);
+      }
+    }
+
+    /** \brief Replaces the probabilistic states of the current lts by the probabilistic
+    *         states of the bisimulation reduced transition system.
+    * \pre The bisimulation classes have been computed. */
+    void replace_probabilistic_states()
+    {
+      // Take the first probabilistic state of every class as its representative. The classes are numbered in the
+      // order of their first occurrence, so only the last class can consist of the initial probabilistic state alone,
+      // in which case it is not added as the initial probabilistic state is set separately.
+      std::vector<std::size_t> representative;
+      representative.reserve(m_number_of_distribution_classes);
+      for (std::size_t d = 0; d < aut.num_probabilistic_states(); ++d)
+      {
+        if (m_distribution_class[d] == representative.size())
+        {
+          representative.push_back(d);
+        }
+      }
+
+      std::vector<typename LTS_TYPE::probabilistic_state_t> new_probabilistic_states;
+      new_probabilistic_states.reserve(representative.size());
+      for (std::size_t d: representative)
+      {
+        new_probabilistic_states.push_back(calculate_new_probabilistic_state(aut.probabilistic_state(d)));
+      }
+      typename LTS_TYPE::probabilistic_state_t new_initial_probabilistic_state =
+        calculate_new_probabilistic_state(aut.initial_probabilistic_state());
+
+      aut.clear_probabilistic_states();
+      for (const typename LTS_TYPE::probabilistic_state_t& new_ps: new_probabilistic_states)
+      {
+        aut.add_probabilistic_state(new_ps);
+      }
+      aut.set_initial_probabilistic_state(new_initial_probabilistic_state);
+    }
+
+    /** \brief Returns whether two probabilistic states are in the same class.
+    *  \param[in] d A probabilistic state number.
+    *  \param[in] e A probabilistic state number.
+    *  \retval true if \e d and \e e are probabilistic bisimilar;
+    *  \retval false otherwise. */
+    bool in_same_probabilistic_class_sig(const std::size_t d, const std::size_t e) const
+    {
+      return get_eq_probabilistic_class(d) == get_eq_probabilistic_class(e);
+    }
+
+  protected:
+    using probability_type = utilities::probabilistic_arbitrary_precision_fraction;
+
+    // The probability that a distribution assigns to each block, sorted on blocks.
+    using distribution_signature = std::vector<std::pair<std::size_t, probability_type>>;
+
+    // The block of a state, followed by the sorted pairs of a label and the class of a target distribution.
+    using state_signature = std::vector<std::pair<std::size_t, std::size_t>>;
+
+    // The number of states or distributions for which the signatures are computed by one task.
+    static constexpr std::size_t task_size = 1024;
+
+    LTS_TYPE& aut;
+    std::size_t m_number_of_threads;
+
+    // The outgoing transitions of state s as pairs of a label and a distribution, in
+    // [m_transition_offsets[s], m_transition_offsets[s+1]).
+    std::vector<std::size_t> m_transition_offsets;
+    std::vector<std::pair<std::size_t, std::size_t>> m_transitions;
+
+    // The states and normalised probabilities of distribution d in [m_distribution_offsets[d], m_distribution_offsets[d+1]).
+    // The last distribution is the initial probabilistic state.
+    std::vector<std::size_t> m_distribution_offsets;
+    std::vector<std::size_t> m_distribution_states;
+    std::vector<probability_type> m_distribution_probabilities;
+
+    std::vector<std::size_t> m_block;
+    std::size_t m_number_of_blocks = 0;
+    std::vector<std::size_t> m_distribution_class;
+    std::size_t m_number_of_distribution_classes = 0;
+
+    const typename LTS_TYPE::probabilistic_state_t& probabilistic_state(std::size_t d) const
+    {
+      return d < aut.num_probabilistic_states() ? aut.probabilistic_state(d) : aut.initial_probabilistic_state();
+    }
+
+    void create_compressed_representation()
+    {
+      const std::size_t n = aut.num_states();
+      m_transition_offsets.assign(n + 1, 0);
+      for (const transition& t: aut.get_transitions())
+      {
+        m_transition_offsets[t.from() + 1]++;
+      }
+      for (std::size_t s = 0; s < n; ++s)
+      {
+        m_transition_offsets[s + 1] += m_transition_offsets[s];
+      }
+      m_transitions.resize(aut.num_transitions());
+      std::vector<std::size_t> position(m_transition_offsets.begin(), m_transition_offsets.end() - 1);
+      for (const transition& t: aut.get_transitions())
+      {
+        m_transitions[position[t.from()]++] = std::make_pair(t.label(), t.to());
+      }
+
+      // The probabilities are converted to normalised fractions once, such that they can be added and hashed
+      // in parallel without accessing the probabilities of the lts.
+      const std::size_t number_of_distributions = aut.num_probabilistic_states() + 1;
+      m_distribution_offsets.reserve(number_of_distributions + 1);
+      m_distribution_offsets.push_back(0);
+      for (std::size_t d = 0; d < number_of_distributions; ++d)
+      {
+        const typename LTS_TYPE::probabilistic_state_t& ps = probabilistic_state(d);
+        if (ps.size() <= 1)
+        {
+          m_distribution_states.push_back(ps.get());
+          m_distribution_probabilities.push_back(probability_type::one());
+        }
+        else
+        {
+          for (const typename LTS_TYPE::probabilistic_state_t::state_probability_pair& p: ps)
+          {
+            m_distribution_states.push_back(p.state());
+            m_distribution_probabilities.push_back(normalised_probability(p.probability()));
+          }
+        }
+        m_distribution_offsets.push_back(m_distribution_states.size());
+      }
+    }
+
+    // Computes signatures[i] = compute(i) for all i in parallel.
+    template <typename Signature, typename ComputeSignature>
+    void compute_signatures(std::vector<Signature>& signatures, ComputeSignature compute) const
+    {
+      const std::size_t number_of_tasks = (signatures.size() + task_size - 1) / task_size;
+      utilities::detail::parallel_apply(number_of_tasks, m_number_of_threads, [&](std::size_t task, std::size_t)
+        {
+          for (std::size_t i = task * task_size; i < std::min(signatures.size(), (task + 1) * task_size); ++i)
+          {
+            compute(i, signatures[i]);
+          }
+        });
+    }
+
+    // Assigns consecutive numbers to the distinct signatures, and returns the number of distinct signatures.
+    template <typename Signature, typename HashSignature>
+    std::size_t number_signatures(const std::vector<Signature>& signatures, HashSignature hash_signature, std::vector<std::size_t>& result) const
+    {
+      std::vector<std::size_t> hashes(signatures.size());
+      compute_signatures(hashes, [&](std::size_t i, std::size_t& h) { h = hash_signature(signatures[i]); });
+
+      // The keys of the map are the indices of the first signature with a given value.
+      auto hash = [&](std::size_t i) { return hashes[i]; };
+      auto equal = [&](std::size_t i, std::size_t j) { return signatures[i] == signatures[j]; };
+      std::unordered_map<std::size_t, std::size_t, decltype(hash), decltype(equal)> numbers(signatures.size(), hash, equal);
+
+      result.resize(signatures.size());
+      for (std::size_t i = 0; i < signatures.size(); ++i)
+      {
+        result[i] = numbers.emplace(i, numbers.size()).first->second;
+      }
+      return numbers.size();
+    }
+
+    void compute_distribution_classes()
+    {
+      std::vector<distribution_signature> signatures(m_distribution_offsets.size() - 1);
+      compute_signatures(signatures, [&](std::size_t d, distribution_signature& signature)
+        {
+          signature.clear();
+          for (std::size_t i = m_distribution_offsets[d]; i < m_distribution_offsets[d + 1]; ++i)
+          {
+            signature.emplace_back(m_block[m_distribution_states[i]], m_distribution_probabilities[i]);
+          }
+          std::sort(signature.begin(), signature.end(),
+                    [](const auto& x, const auto& y) { return x.first < y.first; });
+
+          // Add the probabilities of states in the same block, which keeps the fractions normalised.
+          auto last = signature.begin();
+          for (auto i = signature.begin() + 1; i < signature.end(); ++i)
+          {
+            if (i->first == last->first)
+            {
+              last->second = last->second + i->second;
+            }
+            else if (++last != i)
+            {
+              *last = std::move(*i);
+            }
+          }
+          signature.erase(last + 1, signature.end());
+        });
+
+      m_number_of_distribution_classes = number_signatures(signatures, [](const distribution_signature& signature)
+        {
+          std::size_t hash = 0;
+          for (const auto& [block, probability]: signature)
+          {
+            hash = utilities::detail::hash_combine(hash, block);
+            hash = utilities::detail::hash_combine(hash, std::hash<probability_type>()(probability));
+          }
+          return hash;
+        }, m_distribution_class);
+    }
+
+    // Returns the number of blocks of the refined partition.
+    std::size_t refine_blocks()
+    {
+      std::vector<state_signature> signatures(aut.num_states());
+      compute_signatures(signatures, [&](std::size_t s, state_signature& signature)
+        {
+          signature.clear();
+          for (std::size_t i = m_transition_offsets[s]; i < m_transition_offsets[s + 1]; ++i)
+          {
+            signature.emplace_back(m_transitions[i].first, m_distribution_class[m_transitions[i].second]);
+          }
+          std::sort(signature.begin(), signature.end());
+          signature.erase(std::unique(signature.begin(), signature.end()), signature.end());
+          signature.emplace(signature.begin(), m_block[s], 0);
+        });
+
+      return number_signatures(signatures, [](const state_signature& signature)
+        {
+          std::size_t hash = 0;
+          for (const auto& [label, distribution_class]: signature)
+          {
+            hash = utilities::detail::hash_combine(hash, label);
+            hash = utilities::detail::hash_combine(hash, distribution_class);
+          }
+          return hash;
+        }, m_block);
+    }
+
+    void refine_partition_until_it_becomes_stable()
+    {
+      m_block.assign(aut.num_states(), 0);
+      m_number_of_blocks = aut.num_states() > 0 ? 1 : 0;
+
+      std::size_t rounds = 0;
+      while (true)
+      {
+        compute_distribution_classes();
+        const std::size_t number_of_blocks = refine_blocks();
+        rounds++;
+        mCRL2log(log::debug) << "Round " << rounds << ": " << number_of_blocks << " blocks and "
+                             << m_number_of_distribution_classes << " distribution classes.\n";
+
+        // As the old block is part of the signature, the partition is only refined. If the number of blocks did
+        // not change, neither did the partition, and the distribution classes are consistent with it.
+        if (number_of_blocks == m_number_of_blocks)
+        {
+          break;
+        }
+        m_number_of_blocks = number_of_blocks;
+      }
+      mCRL2log(log::verbose) << "Signature refinement finished after " << rounds << " rounds.\n";
+    }
+
+    typename LTS_TYPE::probabilistic_state_t calculate_new_probabilistic_state(const typename LTS_TYPE::probabilistic_state_t& ps) const
+    {
+      typename LTS_TYPE::probabilistic_state_t new_prob_state;
+      if (ps.size() <= 1)
+      {
+        new_prob_state.set(get_eq_class(ps.get()));
+        return new_prob_state;
+      }
+
+      std::map<std::size_t, typename LTS_TYPE::probabilistic_state_t::probability_t> prob_state_map;
+      for (const typename LTS_TYPE::probabilistic_state_t::state_probability_pair& sp_pair: ps)
+      {
+        auto [i, inserted] = prob_state_map.emplace(get_eq_class(sp_pair.state()), sp_pair.probability());
+        if (!inserted)
+        {
+          i->second = i->second + sp_pair.probability();
+        }
+      }
+
+      if (prob_state_map.size() == 1) // There is only one state with probability one.
+      {
+        new_prob_state.set(prob_state_map.begin()->first);
+      }
+      else
+      {
+        for (const auto& [state, probability]: prob_state_map)
+        {
+          new_prob_state.add(state, probability);
+        }
+      }
+      return new_prob_state;
+    }
+};
+
+
+/** \brief Reduce transition system l with respect to probabilistic bisimulation, using signature refinement.
+* \param[in/out] l The transition system that is reduced.
+* \param[in] number_of_threads The number of threads that compute signatures.
+*/
+template < class LTS_TYPE>
+void probabilistic_bisimulation_reduce_sig(LTS_TYPE& l, utilities::execution_timer& timer, std::size_t number_of_threads = 1)
+{
+  detail::prob_bisim_partitioner_sig<LTS_TYPE> prob_bisim_part(l, timer, number_of_threads);
+
+  // Clear the state labels of the LTS l
+  l.clear_state_labels();
+
+  // Assign the reduced LTS
+  l.set_num_states(prob_bisim_part.num_eq_classes());
+  prob_bisim_part.replace_transitions();
+  prob_bisim_part.replace_probabilistic_states();
+}
+
+/** \brief Checks whether the two initial states of two plts's are probabilistic bisimilar, using signature refinement.
+* \details This lts and the lts l2 are not usable anymore after this call.
+* \param[in/out] l1 A first probabilistic transition system.
+* \param[in/out] l2 A second probabilistic transition system.
+* \retval True iff the initial states of the current transition system and l2 are probabilistic bisimilar */
+template < class LTS_TYPE>
+bool destructive_probabilistic_bisimulation_compare_sig(LTS_TYPE& l1, LTS_TYPE& l2, utilities::execution_timer& timer, std::size_t number_of_threads = 1)
+{
+  // Merge states
+  mcrl2::lts::detail::plts_merge(l1, l2);
+  l2.clear(); // No use for l2 anymore.
+
+  // The last two probabilistic states are the initial states of l2 and l1 in the merged plts.
+  const std::size_t initial_probabilistic_state_key_l2 = l1.num_probabilistic_states() - 1;
+  const std::size_t initial_probabilistic_state_key_l1 = l1.num_probabilistic_states() - 2;
+
+  detail::prob_bisim_partitioner_sig<LTS_TYPE> prob_bisim_part(l1, timer, number_of_threads);
+
+  return prob_bisim_part.in_same_probabilistic_class_sig(initial_probabilistic_state_key_l2,
+                                                         initial_probabilistic_state_key_l1);
+}
+
+/** \brief Checks whether the two initial states of two plts's are probabilistic bisimilar, using signature refinement.
+* \param[in] l1 A first transition system.
+* \param[in] l2 A second transistion system.
+* \retval True iff the initial states of the current transition system and l2 are probabilistic bisimilar */
+template < class LTS_TYPE>
+bool probabilistic_bisimulation_compare_sig(const LTS_TYPE& l1, const LTS_TYPE& l2, utilities::execution_timer& timer, std::size_t number_of_threads = 1)
+{
+  LTS_TYPE l1_copy(l1);
+  LTS_TYPE l2_copy(l2);
+  return destructive_probabilistic_bisimulation_compare_sig(l1_copy, l2_copy, timer, number_of_threads);
+}
+
+} // namespace mcrl2::lts::detail
+
+#endif // MCRL2_LTS_DETAIL_LIBLTS_PBISIM_SIG_H
@@ -21,7 +21,8 @@ template <class LTS_TYPE>
   class ready_sim_partitioner : public sim_partitioner<LTS_TYPE>
 {
  public:
-  ready_sim_partitioner(LTS_TYPE& l) : sim_partitioner<LTS_TYPE>(l)
+  ready_sim_partitioner(LTS_TYPE& l, std::size_t number_of_threads = 1)
+    : sim_partitioner<LTS_TYPE>(l, number_of_threads)
   {
     exists2 = new hash_table2(1000);
     forall2 = new hash_table2(1000);
@@ -256,9 +257,9 @@ void ready_sim_partitioner<LTS_TYPE>::updatei()
         {
           for (alpha = 0; alpha < s_Pi; ++alpha)
           {
-            if (Q[alpha][beta] && !forall2->find(alpha, l))
+            if (Q.test(alpha,beta) && !forall2->find(alpha, l))
             {
-              Q[alpha][beta] = false;
+              Q.reset(alpha,beta);
             }
           }
         }
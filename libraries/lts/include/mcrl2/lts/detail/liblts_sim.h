@@ -11,7 +11,10 @@
 
 #ifndef LIBLTS_SIM_H
 #define LIBLTS_SIM_H
+#include <thread>
+#include "mcrl2/utilities/configuration.h"
 #include "mcrl2/lts/lts_utilities.h"
+#include "mcrl2/lts/detail/bit_relation.h"
 #include "mcrl2/lts/detail/sim_hashtable.h"
 #include "mcrl2/lts/lts_aut.h"
 #include "mcrl2/lts/lts_fsm.h"
@@ -25,8 +28,10 @@ class sim_partitioner
 {
   public:
     /** Creates a partitioner for an LTS.
-     * \param[in] l Pointer to the LTS. */
-    sim_partitioner(LTS_TYPE& l);
+     * \param[in] l Pointer to the LTS.
+     * \param[in] number_of_threads The number of threads that is used for
+     *            the operations on the relations that can be done in parallel. */
+    sim_partitioner(LTS_TYPE& l, std::size_t number_of_threads = 1);
 
     /** Destroys this partitioner. */
     virtual ~sim_partitioner();
@@ -94,6 +99,7 @@ class sim_partitioner
     };
 
     LTS_TYPE& aut;
+    std::size_t m_number_of_threads;
     mcrl2::lts::outgoing_transitions_per_state_action_t trans_index;
     std::size_t s_Sigma = 0UL;
     std::size_t s_Pi = 0UL;
@@ -105,14 +111,18 @@ class sim_partitioner
     std::vector< std::vector<std::size_t> > children;
     std::vector<ptrdiff_t> contents_t;
     std::vector<ptrdiff_t> contents_u;
-    std::vector< std::vector<bool> > stable;
+    bit_relation stable;
     hash_table3* exists;
     hash_table3* forall;
-    std::vector< std::vector<std::size_t> > pre_exists;
-    std::vector< std::vector<std::size_t> > pre_forall;
+
+    /* pre_exists[pre_index(l,gamma)] upto pre_exists[pre_index(l,gamma+1)] are the
+     * positions in exists of the elements (alpha,l,gamma), and similarly for forall. */
+    std::size_t pre_stride = 0UL;
+    std::vector<std::size_t> pre_exists;
+    std::vector<std::size_t> pre_forall;
     hash_table3* match;
-    std::vector< std::vector<bool> > P;
-    std::vector< std::vector<bool> > Q;
+    bit_relation P;
+    bit_relation Q;
 
     /* auxiliary variables */
     std::vector<std::size_t> touched_blocks;
@@ -120,6 +130,22 @@ class sim_partitioner
 
     void initialise_datastructures();
 
+    std::size_t pre_index(std::size_t l,std::size_t gamma) const
+    {
+      return l*pre_stride + gamma;
+    }
+
+    /* Split [0,n) into consecutive ranges, one per available thread, and apply
+     * f(first,last) to each of them. Calls of f for different ranges must be
+     * independent. */
+    template <typename FUNCTION>
+    void parallel_ranges(std::size_t n,FUNCTION f);
+
+    /* Apply f to all i in [0,n), distributing the work over the available threads.
+     * Calls of f for different i must be independent. */
+    template <typename FUNCTION>
+    void parallel_for(std::size_t n,FUNCTION f);
+
     void refine(bool& change);
     void update();
 
@@ -132,16 +158,16 @@ class sim_partitioner
 
     void initialise_Sigma(std::size_t gamma,std::size_t l);
     void initialise_Pi(std::size_t gamma,std::size_t l);
-    void filter(std::size_t S,std::vector< std::vector<bool> >& R,bool B);
+    void filter(std::size_t S,const bit_relation& R,bool B);
     void cleanup(std::size_t alpha,std::size_t beta);
-    void initialise_pre_EA();
+    void initialise_pre_EA(std::size_t S);
     void induce_P_on_Pi();
 
     std::string print_Sigma_P();
     std::string print_Pi_Q();
     std::string print_Sigma();
     std::string print_Pi();
-    std::string print_relation(std::size_t s,std::vector< std::vector<bool> >& R);
+    std::string print_relation(std::size_t s,const bit_relation& R);
     std::string print_block(std::size_t b);
     std::string print_structure(hash_table3* struc);
     std::string print_reverse_topological_sort(const std::vector<std::size_t>& Sort);
@@ -152,8 +178,9 @@ class sim_partitioner
 #define UNIVERSAL_PART (0)
 
 template <class LTS_TYPE>
-sim_partitioner<LTS_TYPE>::sim_partitioner(LTS_TYPE& l)
-  : aut(l)
+sim_partitioner<LTS_TYPE>::sim_partitioner(LTS_TYPE& l, std::size_t number_of_threads)
+  : aut(l),
+    m_number_of_threads(std::max<std::size_t>(1,number_of_threads))
 {
   match  = new hash_table3(1000);
   exists = new hash_table3(1000);
@@ -168,6 +195,49 @@ sim_partitioner<LTS_TYPE>::~sim_partitioner()
   delete forall;
 }
 
+template <class LTS_TYPE>
+template <typename FUNCTION>
+void sim_partitioner<LTS_TYPE>::parallel_ranges(std::size_t n,FUNCTION f)
+{
+  /* Only use threads if there is a reasonable amount of work for each of them */
+  constexpr std::size_t minimal_work_per_thread = 64;
+  const std::size_t threads = std::min(m_number_of_threads,
+                                       std::max<std::size_t>(1,n/minimal_work_per_thread));
+  if (!mcrl2::utilities::detail::GlobalThreadSafe || threads == 1)
+  {
+    f(0,n);
+    return;
+  }
+
+  const std::size_t chunk = (n+threads-1)/threads;
+  std::vector<std::thread> workers;
+  workers.reserve(threads);
+  for (std::size_t t = 0; t < threads; ++t)
+  {
+    workers.emplace_back([&f,t,chunk,n]()
+    {
+      f(std::min(n,t*chunk),std::min(n,(t+1)*chunk));
+    });
+  }
+  for (std::thread& worker: workers)
+  {
+    worker.join();
+  }
+}
+
+template <class LTS_TYPE>
+template <typename FUNCTION>
+void sim_partitioner<LTS_TYPE>::parallel_for(std::size_t n,FUNCTION f)
+{
+  parallel_ranges(n,[&f](std::size_t first,std::size_t last)
+  {
+    for (std::size_t i = first; i < last; ++i)
+    {
+      f(i);
+    }
+  });
+}
+
 /* ----------------- PARTITIONING ALGORITHM ------------------------- */
 
 template <class LTS_TYPE>
@@ -273,12 +343,11 @@ void sim_partitioner<LTS_TYPE>::initialise_datastructures()
   /* initialise P and children */
   std::vector<std::size_t> vi;
   children.assign(s_Sigma,vi);
-  std::vector<bool> vb(s_Sigma,false);
-  P.assign(s_Sigma,vb);
+  P.assign(s_Sigma,s_Sigma);
   for (std::size_t i = 0; i < s_Sigma; ++i)
   {
     children[i].push_back(i);
-    P[i][i] = true;
+    P.set(i,i);
   }
 
   mCRL2log(log::debug) << "--------------------- INITIALISATION ---------------------------" << std::endl;
@@ -379,15 +448,11 @@ void sim_partitioner<LTS_TYPE>::refine(bool& change)
   }
 
   /* Some local variables */
-  std::vector<bool> v_false(s_Sigma,false);
   std::vector<std::size_t>::iterator alphai;
   std::vector<std::size_t>::iterator last;
   std::vector<std::size_t>::iterator gammai;
-  std::vector<std::vector<bool>>::iterator stable_alpha;
-  std::vector<std::vector<bool>>::iterator P_gamma;
   bool stable_alpha_gamma;
   std::size_t gamma;
-  std::size_t delta;
   std::size_t l;
 
   /* The main loop */
@@ -397,7 +462,7 @@ void sim_partitioner<LTS_TYPE>::refine(bool& change)
     mCRL2log(log::debug) << "Label = \"" << mcrl2::lts::pp(aut.action_label(l)) << "\"" << std::endl;
 
     /* reset the stable function */
-    stable.assign(s_Pi,v_false);
+    stable.assign(s_Pi,s_Sigma);
 
     /* iterate over the reverse topological sorting */
     for (gammai = Sort.begin(); gammai != Sort.end(); ++gammai)
@@ -412,19 +477,10 @@ void sim_partitioner<LTS_TYPE>::refine(bool& change)
       for (alphai = touched_blocks.begin(); alphai != last; ++alphai)
       {
         alpha = *alphai;
-        /* compute stable(alpha,gamma); use a local boolean variable for
-         * efficiency */
-        stable_alpha_gamma = false;
-        stable_alpha = stable.begin() + static_cast<std::ptrdiff_t>(alpha);
-        P_gamma = P.begin() + static_cast<std::ptrdiff_t>(gamma);
-        for (delta = 0; delta < s_Sigma && !stable_alpha_gamma; ++delta)
-        {
-          if ((*stable_alpha)[delta] && (*P_gamma)[delta])
-          {
-            stable_alpha_gamma = true;
-          }
-        }
-        (*stable_alpha)[gamma] = stable_alpha_gamma;
+        /* compute stable(alpha,gamma), i.e., whether there is a delta
+         * with stable(alpha,delta) and gamma P delta */
+        stable_alpha_gamma = stable.intersects(alpha,P,gamma);
+        stable.set(alpha,gamma,stable_alpha_gamma);
         if (!stable_alpha_gamma)
         {
           /* if alpha -l->A gamma then alpha cannot be split */
@@ -435,7 +491,7 @@ void sim_partitioner<LTS_TYPE>::refine(bool& change)
 
             children[parent[alpha]].push_back(s_Pi);
             parent.push_back(parent[alpha]);
-            stable.push_back(*stable_alpha);
+            stable.push_back_row(alpha);
             block_touched.push_back(false);
             contents_t.push_back(LIST_END);
 
@@ -451,7 +507,7 @@ void sim_partitioner<LTS_TYPE>::refine(bool& change)
             }
             ++s_Pi;
           }
-          stable[alpha][gamma] = true;
+          stable.set(alpha,gamma);
         }
         untouch(alpha);
       }
@@ -477,9 +533,9 @@ void sim_partitioner<LTS_TYPE>::dfs_visit(std::size_t u,std::vector<bool>& visit
     std::vector<std::size_t> &Sort)
 {
   visited[u] = true;
-  for (std::size_t v = 0; v < s_Sigma; ++v)
+  for (std::size_t v = P.find_next(u,0); v != bit_relation::npos; v = P.find_next(u,v+1))
   {
-    if (!visited[v] && P[u][v])
+    if (!visited[v])
     {
       dfs_visit(v,visited,Sort);
     }
@@ -557,15 +613,13 @@ void sim_partitioner<LTS_TYPE>::update()
 
   induce_P_on_Pi();
 
-  initialise_pre_EA();
+  initialise_pre_EA(s_Sigma);
 
   /* Compute the pre_exists and pre_forall functions */
   for (l = 0; l < aut.num_action_labels(); ++l)
   {
-    pre_exists[l].reserve(s_Sigma + 1);
-    pre_forall[l].reserve(s_Sigma + 1);
-    pre_exists[l].push_back(exists->get_num_elements());
-    pre_forall[l].push_back(forall->get_num_elements());
+    pre_exists.push_back(exists->get_num_elements());
+    pre_forall.push_back(forall->get_num_elements());
     for (gamma = 0; gamma < s_Sigma; ++gamma)
     {
       touched_blocks.clear();
@@ -581,8 +635,8 @@ void sim_partitioner<LTS_TYPE>::update()
         }
         untouch(alpha);
       }
-      pre_exists[l].push_back(exists->get_num_elements());
-      pre_forall[l].push_back(forall->get_num_elements());
+      pre_exists.push_back(exists->get_num_elements());
+      pre_forall.push_back(forall->get_num_elements());
     }
   }
 
@@ -597,15 +651,13 @@ void sim_partitioner<LTS_TYPE>::update()
   filter(s_Sigma,P,false);
 
 
-  initialise_pre_EA();
+  initialise_pre_EA(s_Pi);
 
   /* Compute the pre_exists and pre_forall functions */
   for (l = 0; l < aut.num_action_labels(); ++l)
   {
-    pre_exists[l].reserve(s_Pi + 1);
-    pre_forall[l].reserve(s_Pi + 1);
-    pre_exists[l].push_back(exists->get_num_elements());
-    pre_forall[l].push_back(forall->get_num_elements());
+    pre_exists.push_back(exists->get_num_elements());
+    pre_forall.push_back(forall->get_num_elements());
     for (gamma = 0; gamma < s_Pi; ++gamma)
     {
       touched_blocks.clear();
@@ -621,8 +673,8 @@ void sim_partitioner<LTS_TYPE>::update()
         }
         untouch(alpha);
       }
-      pre_exists[l].push_back(exists->get_num_elements());
-      pre_forall[l].push_back(forall->get_num_elements());
+      pre_exists.push_back(exists->get_num_elements());
+      pre_forall.push_back(forall->get_num_elements());
     }
   }
 
@@ -638,41 +690,43 @@ void sim_partitioner<LTS_TYPE>::update()
 }
 
 template <class LTS_TYPE>
-void sim_partitioner<LTS_TYPE>::initialise_pre_EA()
+void sim_partitioner<LTS_TYPE>::initialise_pre_EA(std::size_t S)
 {
-  /* Initialise the pre_exists and pre_forall data structures */
+  /* Initialise the pre_exists and pre_forall data structures for
+   * S blocks */
   exists->clear();
   forall->clear();
-  std::vector<std::size_t> v;
-  pre_exists.assign(aut.num_action_labels(),v);
-  pre_forall.assign(aut.num_action_labels(),v);
+  pre_stride = S + 1;
+  pre_exists.clear();
+  pre_forall.clear();
+  pre_exists.reserve(aut.num_action_labels()*pre_stride);
+  pre_forall.reserve(aut.num_action_labels()*pre_stride);
 }
 
 template <class LTS_TYPE>
 void sim_partitioner<LTS_TYPE>::induce_P_on_Pi()
 {
-  /* Compute the relation induced on Pi by P, store it in Q */
-  std::vector<bool> v(s_Pi,false);
-  Q.assign(s_Pi,v);
-
-  std::size_t alpha;
-  std::size_t beta;
-  std::vector< std::vector<bool> >::iterator P_parent_alpha;
-  for (alpha = 0; alpha < s_Pi; ++alpha)
+  /* Compute the relation induced on Pi by P, store it in Q. The row
+   * of alpha consists of the children of the blocks related by P to
+   * the parent of alpha. */
+  Q.assign(s_Pi,s_Pi);
+  parallel_for(s_Pi,[this](std::size_t alpha)
   {
-    P_parent_alpha = P.begin() + parent[alpha];
-    for (beta = 0; beta < s_Pi; ++beta)
+    P.for_each_in_row(parent[alpha],[&](std::size_t delta)
     {
-      Q[alpha][beta] = (*P_parent_alpha)[parent[beta]];
-    }
-  }
+      for (const std::size_t beta: children[delta])
+      {
+        Q.set(alpha,beta);
+      }
+    });
+  });
 }
 
 
 /* ----------------- FILTER ----------------------------------------- */
 
 template <class LTS_TYPE>
-void sim_partitioner<LTS_TYPE>::filter(std::size_t S,std::vector< std::vector<bool> > &R,
+void sim_partitioner<LTS_TYPE>::filter(std::size_t S,const bit_relation& R,
                                        bool B)
 {
   /* Initialise the match function */
@@ -688,13 +742,13 @@ void sim_partitioner<LTS_TYPE>::filter(std::size_t S,std::vector< std::vector<bo
   {
     for (delta = 0; delta < S; ++delta)
     {
-      etrans.set_end(pre_exists[l][delta+1]);
-      for (etrans.set(pre_exists[l][delta]); !etrans.is_end(); ++etrans)
+      etrans.set_end(pre_exists[pre_index(l,delta+1)]);
+      for (etrans.set(pre_exists[pre_index(l,delta)]); !etrans.is_end(); ++etrans)
       {
         beta = etrans.get_x();
         for (gamma = 0; gamma < S; ++gamma)
         {
-          if (R[gamma][delta])
+          if (R.test(gamma,delta))
           {
             match->add(l,beta,gamma);
           }
@@ -703,25 +757,55 @@ void sim_partitioner<LTS_TYPE>::filter(std::size_t S,std::vector< std::vector<bo
     }
   }
 
+  if (!B)
+  {
+    /* Without cleanup, only row alpha of Q is changed when considering
+     * alpha, and match is not changed. So, the rows of Q can be
+     * filtered independently. Each thread handles a range of rows. */
+    parallel_ranges(s_Pi,[&,S](std::size_t first,std::size_t last)
+    {
+      hash_table3_iterator atrans(forall);
+      for (std::size_t l = 0; l < aut.num_action_labels(); ++l)
+      {
+        for (std::size_t gamma = 0; gamma < S; ++gamma)
+        {
+          atrans.set_end(pre_forall[pre_index(l,gamma+1)]);
+          for (atrans.set(pre_forall[pre_index(l,gamma)]); !atrans.is_end(); ++atrans)
+          {
+            const std::size_t alpha = atrans.get_x();
+            if (first <= alpha && alpha < last)
+            {
+              Q.for_each_in_row(alpha,[&](std::size_t beta)
+              {
+                if (!match->find(l,beta,gamma))
+                {
+                  Q.reset(alpha,beta);
+                }
+              });
+            }
+          }
+        }
+      }
+    });
+    return;
+  }
+
   hash_table3_iterator atrans(forall);
   /* The main for loop */
   for (l = 0; l < aut.num_action_labels(); ++l)
   {
     for (gamma = 0; gamma < S; ++gamma)
     {
-      atrans.set_end(pre_forall[l][gamma+1]);
-      for (atrans.set(pre_forall[l][gamma]); !atrans.is_end(); ++atrans)
+      atrans.set_end(pre_forall[pre_index(l,gamma+1)]);
+      for (atrans.set(pre_forall[pre_index(l,gamma)]); !atrans.is_end(); ++atrans)
       {
         alpha = atrans.get_x();
-        for (beta = 0; beta < s_Pi; ++beta)
+        for (beta = Q.find_next(alpha,0); beta != bit_relation::npos; beta = Q.find_next(alpha,beta+1))
         {
-          if (Q[alpha][beta] && !match->find(l,beta,gamma))
+          if (!match->find(l,beta,gamma))
           {
-            Q[alpha][beta] = false;
-            if (B)
-            {
-              cleanup(alpha,beta);
-            }
+            Q.reset(alpha,beta);
+            cleanup(alpha,beta);
           }
         }
       }
@@ -743,15 +827,16 @@ void sim_partitioner<LTS_TYPE>::cleanup(std::size_t alpha,std::size_t beta)
   hash_table3_iterator beta1i(exists);
   for (l = 0; l < aut.num_action_labels(); ++l)
   {
-    alpha1i.set_end(pre_forall[l][alpha+1]);
-    beta1i.set_end(pre_exists[l][beta+1]);
-    for (beta1i.set(pre_exists[l][beta]); !beta1i.is_end(); ++beta1i)
+    alpha1i.set_end(pre_forall[pre_index(l,alpha+1)]);
+    beta1i.set_end(pre_exists[pre_index(l,beta+1)]);
+    for (beta1i.set(pre_exists[pre_index(l,beta)]); !beta1i.is_end(); ++beta1i)
     {
       beta1 = beta1i.get_x();
       match_l_beta1_alpha = false;
-      for (delta = 0; delta < s_Pi && !match_l_beta1_alpha; ++delta)
+      for (delta = Q.find_next(alpha,0); delta != bit_relation::npos && !match_l_beta1_alpha;
+           delta = Q.find_next(alpha,delta+1))
       {
-        if (exists->find(beta1,l,delta) && Q[alpha][delta])
+        if (exists->find(beta1,l,delta))
         {
           match_l_beta1_alpha = true;
         }
@@ -759,13 +844,13 @@ void sim_partitioner<LTS_TYPE>::cleanup(std::size_t alpha,std::size_t beta)
       if (!match_l_beta1_alpha)
       {
         match->remove(l,beta1,alpha);
-        for (alpha1i.set(pre_forall[l][alpha]); !alpha1i.is_end();
+        for (alpha1i.set(pre_forall[pre_index(l,alpha)]); !alpha1i.is_end();
              ++alpha1i)
         {
           alpha1 = alpha1i.get_x();
-          if (Q[alpha1][beta1])
+          if (Q.test(alpha1,beta1))
           {
-            Q[alpha1][beta1] = false;
+            Q.reset(alpha1,beta1);
             cleanup(alpha1,beta1);
           }
         }
@@ -800,21 +885,21 @@ std::vector < mcrl2::lts::transition> sim_partitioner<LTS_TYPE>::get_transitions
       // first compute for which alpha the latter statement does not
       // hold
       pre_sim.assign(s_Pi,false);
-      for (gamma = 0; gamma < s_Pi; ++gamma)
+      for (gamma = Q.find_next(beta,0); gamma != bit_relation::npos; gamma = Q.find_next(beta,gamma+1))
       {
         // only consider gammas that are unequal to beta
-        if (gamma != beta && Q[beta][gamma])
+        if (gamma != beta)
         {
-          alphai.set_end(pre_exists[l][gamma+1]);
-          for (alphai.set(pre_exists[l][gamma]); !alphai.is_end();
+          alphai.set_end(pre_exists[pre_index(l,gamma+1)]);
+          for (alphai.set(pre_exists[pre_index(l,gamma)]); !alphai.is_end();
                ++alphai)
           {
             pre_sim[alphai.get_x()] = true;
           }
         }
       }
-      gammai.set_end(pre_forall[l][beta+1]);
-      for (gammai.set(pre_forall[l][beta]); !gammai.is_end(); ++gammai)
+      gammai.set_end(pre_forall[pre_index(l,beta+1)]);
+      for (gammai.set(pre_forall[pre_index(l,beta)]); !gammai.is_end(); ++gammai)
       {
         gamma = gammai.get_x();
         if (!pre_sim[gamma])
@@ -843,7 +928,7 @@ std::size_t sim_partitioner<LTS_TYPE>::get_eq_class(std::size_t s) const
 template <class LTS_TYPE>
 bool sim_partitioner<LTS_TYPE>::in_preorder(std::size_t s,std::size_t t) const
 {
-  return Q[block_Pi[s]][block_Pi[t]];
+  return Q.test(block_Pi[s],block_Pi[t]);
 }
 
 template <class LTS_TYPE>
@@ -922,7 +1007,7 @@ std::string sim_partitioner<LTS_TYPE>::print_block(std::size_t b)
 
 template <class LTS_TYPE>
 std::string sim_partitioner<LTS_TYPE>::print_relation(std::size_t s,
-    std::vector< std::vector<bool> > &R)
+    const bit_relation& R)
 {
   using namespace mcrl2::core;
   std::stringstream result;
@@ -933,7 +1018,7 @@ std::string sim_partitioner<LTS_TYPE>::print_relation(std::size_t s,
   {
     for (gamma = 0; gamma < s; ++gamma)
     {
-      if (R[beta][gamma])
+      if (R.test(beta,gamma))
       {
         result << "(" << beta << "," << gamma << "),";
       }
@@ -0,0 +1,391 @@
+// Author(s): agent
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file lts/detail/liblts_tau_closure.h
+/// \brief A compact representation of the non reflexive transitive closure of the
+///        internal steps of a labelled transition system.
+
+#ifndef MCRL2_LTS_DETAIL_LIBLTS_TAU_CLOSURE_H
+#define MCRL2_LTS_DETAIL_LIBLTS_TAU_CLOSURE_H
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <thread>
+#include "mcrl2/utilities/configuration.h"
+#include "mcrl2/lts/detail/liblts_scc.h"
+
+namespace mcrl2::lts::detail
+{
+
+/// \brief The non reflexive transitive closure of the tau transitions of an lts.
+/// \details The closure is not stored per state. Instead, the states are first partitioned
+///          into strongly connected components of tau transitions using the scc_partitioner.
+///          The tau transitions between different components form a directed acyclic graph.
+///          For each component the set of components reachable in one or more steps
+///          is stored as a sorted row in one flat vector (compressed sparse row format).
+///          States t reachable from a state s by one or more tau steps are then exactly
+///          the states in the components in the row of the component of s, together with the
+///          states in the component of s itself if this component contains a tau cycle.
+///
+///          Rows are calculated bottom up over the acyclic graph. All components with
+///          the same height in this graph are independent and are calculated in parallel
+///          if more than one thread is requested. Unions are calculated using a bitset
+///          per thread, which avoids the node allocations of sets of states.
+///
+///          If forward is false, the closure is calculated for the reversed tau transitions,
+///          i.e., for each state s it contains the states t such that t can reach s by
+///          one or more tau steps.
+class tau_closure
+{
+  public:
+    using state_type = std::size_t;
+    using scc_type = std::size_t;
+
+  protected:
+    // The component of each state.
+    std::vector<scc_type> m_scc_of_state;
+
+    // The states per component in compressed sparse row format.
+    std::vector<std::size_t> m_member_index;
+    std::vector<state_type> m_members;
+
+    // Indicates whether a component contains a tau cycle, in which case each state in
+    // this component can reach all states in this component in one or more steps.
+    std::vector<bool> m_cyclic;
+
+    // The components reachable in one or more steps, for each component the row
+    // m_closure[m_row_begin[c]] upto m_closure[m_row_end[c]] in sorted order.
+    std::vector<std::size_t> m_row_begin;
+    std::vector<std::size_t> m_row_end;
+    std::vector<scc_type> m_closure;
+
+    // A bitset with one bit per component that is used to calculate unions of rows.
+    class scratch_bitset
+    {
+      protected:
+        std::vector<std::uint64_t> m_words;
+
+      public:
+        explicit scratch_bitset(std::size_t size)
+          : m_words((size+63)/64, 0)
+        {}
+
+        // Set the bit for c and return true iff it was not set before.
+        bool insert(std::size_t c)
+        {
+          const std::uint64_t mask = std::uint64_t(1) << (c % 64);
+          std::uint64_t& word = m_words[c / 64];
+          const bool result = (word & mask) == 0;
+          word |= mask;
+          return result;
+        }
+
+        void erase(std::size_t c)
+        {
+          m_words[c / 64] &= ~(std::uint64_t(1) << (c % 64));
+        }
+    };
+
+    // Calculate the row of component c into result, given the direct successors of all components
+    // in dag_index/dag. The rows of all successors of c must already have been calculated.
+    void calculate_row(const scc_type c,
+                       const std::vector<std::size_t>& dag_index,
+                       const std::vector<scc_type>& dag,
+                       scratch_bitset& seen,
+                       std::vector<scc_type>& result) const
+    {
+      result.clear();
+      for (std::size_t i = dag_index[c]; i < dag_index[c+1]; ++i)
+      {
+        const scc_type d = dag[i];
+        if (seen.insert(d))
+        {
+          result.push_back(d);
+        }
+        for (std::size_t j = m_row_begin[d]; j < m_row_end[d]; ++j)
+        {
+          if (seen.insert(m_closure[j]))
+          {
+            result.push_back(m_closure[j]);
+          }
+        }
+      }
+      for (const scc_type d: result)
+      {
+        seen.erase(d);
+      }
+      std::sort(result.begin(), result.end());
+    }
+
+  public:
+    /// \brief Calculate the non reflexive transitive tau closure of l.
+    /// \param l The transition system. The function l.is_tau applied to the hidden label map
+    ///        is used to determine whether a transition is internal. The lts is not changed.
+    /// \param forward If true, the closure contains the states reachable from a state. Otherwise
+    ///        it contains the states from which a state can be reached.
+    /// \param number_of_threads The number of threads used to calculate the closure.
+    template <class LTS_TYPE>
+    tau_closure(LTS_TYPE& l, const bool forward, const std::size_t number_of_threads = 1)
+    {
+      const std::size_t num_states = l.num_states();
+
+      // Collapse the tau loops. The scc_partitioner numbers the components such that
+      // for each tau transition s -tau-> t in different components the number of the
+      // component of t is lower than that of s.
+      std::size_t num_sccs = 0;
+      m_scc_of_state.resize(num_states);
+      {
+        scc_partitioner<LTS_TYPE> partitioner(l);
+        num_sccs = partitioner.num_eq_classes();
+        for (state_type s = 0; s < num_states; ++s)
+        {
+          m_scc_of_state[s] = partitioner.get_eq_class(s);
+        }
+      }
+
+      m_member_index.assign(num_sccs+1, 0);
+      for (state_type s = 0; s < num_states; ++s)
+      {
+        m_member_index[m_scc_of_state[s]+1]++;
+      }
+      for (scc_type c = 0; c < num_sccs; ++c)
+      {
+        m_member_index[c+1] += m_member_index[c];
+      }
+      m_members.resize(num_states);
+      {
+        std::vector<std::size_t> position(m_member_index.begin(), m_member_index.end()-1);
+        for (state_type s = 0; s < num_states; ++s)
+        {
+          m_members[position[m_scc_of_state[s]]++] = s;
+        }
+      }
+
+      // Construct the acyclic graph of tau transitions between components, in the requested direction.
+      m_cyclic.assign(num_sccs, false);
+      std::vector<std::size_t> dag_index(num_sccs+1, 0);
+      for (const transition& t: l.get_transitions())
+      {
+        if (l.is_tau(l.apply_hidden_label_map(t.label())))
+        {
+          const scc_type from = m_scc_of_state[forward ? t.from() : t.to()];
+          const scc_type to = m_scc_of_state[forward ? t.to() : t.from()];
+          if (from == to)
+          {
+            m_cyclic[from] = true;
+          }
+          else
+          {
+            dag_index[from+1]++;
+          }
+        }
+      }
+      for (scc_type c = 0; c < num_sccs; ++c)
+      {
+        dag_index[c+1] += dag_index[c];
+      }
+      std::vector<scc_type> dag(dag_index[num_sccs]);
+      {
+        std::vector<std::size_t> position(dag_index.begin(), dag_index.end()-1);
+        for (const transition& t: l.get_transitions())
+        {
+          if (l.is_tau(l.apply_hidden_label_map(t.label())))
+          {
+            const scc_type from = m_scc_of_state[forward ? t.from() : t.to()];
+            const scc_type to = m_scc_of_state[forward ? t.to() : t.from()];
+            if (from != to)
+            {
+              dag[position[from]++] = to;
+            }
+          }
+        }
+      }
+
+      // Determine the height of each component in the acyclic graph. Successors have a lower
+      // number in the forward direction and a higher number in the backward direction.
+      std::vector<std::size_t> height(num_sccs, 0);
+      std::size_t max_height = 0;
+      for (std::size_t i = 0; i < num_sccs; ++i)
+      {
+        const scc_type c = forward ? i : num_sccs-1-i;
+        for (std::size_t j = dag_index[c]; j < dag_index[c+1]; ++j)
+        {
+          assert(forward ? dag[j] < c : dag[j] > c);
+          height[c] = std::max(height[c], height[dag[j]]+1);
+        }
+        max_height = std::max(max_height, height[c]);
+      }
+
+      // Group the components per height.
+      std::vector<std::size_t> level_index(num_sccs == 0 ? 1 : max_height+2, 0);
+      for (scc_type c = 0; c < num_sccs; ++c)
+      {
+        level_index[height[c]+1]++;
+      }
+      for (std::size_t h = 0; h+1 < level_index.size(); ++h)
+      {
+        level_index[h+1] += level_index[h];
+      }
+      std::vector<scc_type> levels(num_sccs);
+      {
+        std::vector<std::size_t> position(level_index.begin(), level_index.end()-1);
+        for (scc_type c = 0; c < num_sccs; ++c)
+        {
+          levels[position[height[c]]++] = c;
+        }
+      }
+      std::vector<std::size_t>().swap(height);
+
+      // Calculate the rows level by level. Within a level the rows are calculated by several threads
+      // if the level is sufficiently large, each thread writing into its own buffer. The buffers
+      // are appended to m_closure after all threads have finished.
+      constexpr std::size_t minimal_work_per_thread = 256;
+      const std::size_t threads = std::max<std::size_t>(1, number_of_threads);
+      m_row_begin.assign(num_sccs, 0);
+      m_row_end.assign(num_sccs, 0);
+      std::vector<scratch_bitset> seen(threads, scratch_bitset(num_sccs));
+      std::vector<std::vector<scc_type>> buffers(threads);
+      std::vector<std::vector<std::size_t>> row_sizes(threads);
+
+      for (std::size_t h = 0; h+1 < level_index.size(); ++h)
+      {
+        const std::size_t first = level_index[h];
+        const std::size_t last = level_index[h+1];
+        const std::size_t used_threads = std::min(threads, std::max<std::size_t>(1, (last-first)/minimal_work_per_thread));
+        const std::size_t chunk = (last-first+used_threads-1)/used_threads;
+
+        auto calculate_rows = [&](const std::size_t thread_index)
+        {
+          std::vector<scc_type>& buffer = buffers[thread_index];
+          std::vector<std::size_t>& sizes = row_sizes[thread_index];
+          std::vector<scc_type> row;
+          buffer.clear();
+          sizes.clear();
+          for (std::size_t i = first+thread_index*chunk; i < std::min(last, first+(thread_index+1)*chunk); ++i)
+          {
+            calculate_row(levels[i], dag_index, dag, seen[thread_index], row);
+            buffer.insert(buffer.end(), row.begin(), row.end());
+            sizes.push_back(row.size());
+          }
+        };
+
+        if (mcrl2::utilities::detail::GlobalThreadSafe && used_threads > 1)
+        {
+          std::vector<std::thread> workers;
+          workers.reserve(used_threads);
+          for (std::size_t i = 0; i < used_threads; ++i)
+          {
+            workers.emplace_back(calculate_rows, i);
+          }
+          for (std::thread& worker: workers)
+          {
+            worker.join();
+          }
+        }
+        else
+        {
+          for (std::size_t i = 0; i < used_threads; ++i)
+          {
+            calculate_rows(i);
+          }
+        }
+
+        std::size_t i = first;
+        for (std::size_t thread_index = 0; thread_index < used_threads; ++thread_index)
+        {
+          std::size_t offset = m_closure.size();
+          m_closure.insert(m_closure.end(), buffers[thread_index].begin(), buffers[thread_index].end());
+          for (const std::size_t size: row_sizes[thread_index])
+          {
+            m_row_begin[levels[i]] = offset;
+            offset += size;
+            m_row_end[levels[i]] = offset;
+            ++i;
+          }
+        }
+        assert(i == last);
+      }
+      m_closure.shrink_to_fit();
+    }
+
+    /// \brief The number of strongly connected components of tau transitions.
+    std::size_t num_sccs() const
+    {
+      return m_member_index.size()-1;
+    }
+
+    /// \brief The strongly connected component to which state s belongs.
+    scc_type scc(const state_type s) const
+    {
+      return m_scc_of_state[s];
+    }
+
+    /// \brief Returns true iff the states of component c can reach each other in one or more tau steps.
+    bool is_cyclic(const scc_type c) const
+    {
+      return m_cyclic[c];
+    }
+
+    /// \brief The number of pairs of states (s,t) such that t is reachable from s in one or more tau steps.
+    /// \details Indicates the number of transitions that are generated by a full closure.
+    std::size_t size() const
+    {
+      std::size_t result = 0;
+      for (scc_type c = 0; c < num_sccs(); ++c)
+      {
+        std::size_t reachable = m_cyclic[c] ? m_member_index[c+1]-m_member_index[c] : 0;
+        for (std::size_t j = m_row_begin[c]; j < m_row_end[c]; ++j)
+        {
+          reachable += m_member_index[m_closure[j]+1]-m_member_index[m_closure[j]];
+        }
+        result += reachable*(m_member_index[c+1]-m_member_index[c]);
+      }
+      return result;
+    }
+
+    /// \brief Applies f to all states reachable from s in one or more tau steps, or all states that can
+    ///        reach s in one or more steps if the closure was constructed backward.
+    /// \details Each state is visited exactly once, but not in a particular order.
+    template <typename FUNCTION>
+    void for_each_reachable_state(const state_type s, FUNCTION f) const
+    {
+      const scc_type c = m_scc_of_state[s];
+      if (m_cyclic[c])
+      {
+        for (std::size_t i = m_member_index[c]; i < m_member_index[c+1]; ++i)
+        {
+          f(m_members[i]);
+        }
+      }
+      for (std::size_t j = m_row_begin[c]; j < m_row_end[c]; ++j)
+      {
+        const scc_type d = m_closure[j];
+        for (std::size_t i = m_member_index[d]; i < m_member_index[d+1]; ++i)
+        {
+          f(m_members[i]);
+        }
+      }
+    }
+
+    /// \brief Returns true iff t is reachable from s in one or more steps (reversed if the closure is backward).
+    bool reachable(const state_type s, const state_type t) const
+    {
+      const scc_type c = m_scc_of_state[s];
+      const scc_type d = m_scc_of_state[t];
+      if (c == d)
+      {
+        return m_cyclic[c];
+      }
+      return std::binary_search(m_closure.begin()+m_row_begin[c], m_closure.begin()+m_row_end[c], d);
+    }
+};
+
+} // namespace mcrl2::lts::detail
+
+#endif // MCRL2_LTS_DETAIL_LIBLTS_TAU_CLOSURE_H
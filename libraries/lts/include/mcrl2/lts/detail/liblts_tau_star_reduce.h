@@ -12,6 +12,7 @@
 #define MCRL2_LTS_DETAIL_LIBLTS_TAU_STAR_REDUCE_H
 
 #include "mcrl2/lts/lts_utilities.h"
+#include "mcrl2/lts/detail/liblts_tau_closure.h"
 
 namespace mcrl2::lts::detail
 {
@@ -21,9 +22,30 @@ namespace mcrl2::lts::detail
 
 enum t_reach { unknown, reached, explored };
 
+/// \brief Sorts the transitions and removes duplicates.
+inline void sort_and_remove_duplicate_transitions(std::vector<transition>& transitions)
+{
+  std::sort(transitions.begin(), transitions.end());
+  transitions.erase(std::unique(transitions.begin(), transitions.end()), transitions.end());
+}
+
+/// \brief Adds a transition to a vector of transitions, in which duplicates are removed
+///        whenever the vector has doubled in size since the last removal.
+inline void add_transition_compacting(std::vector<transition>& transitions, std::size_t& compacted_size, const transition& t)
+{
+  transitions.push_back(t);
+  if (transitions.size() > 2*compacted_size+1024)
+  {
+    sort_and_remove_duplicate_transitions(transitions);
+    compacted_size = transitions.size();
+  }
+}
+
 /// \brief This procedure calculates the transitive tau
 ///        closure as a separate vector of transitions, for
 ///        a given transition system.
+/// \details The closure is calculated using a tau_closure. This function is only
+///          intended for small transition systems, as the result is stored explicitly.
 /// \parameter l A labelled transition system
 /// \parameter forward A boolean that indicates whether the resulting closure
 //             points forward, to the next state, or backward, to the previous state.
@@ -38,93 +60,57 @@ std::map < std::size_t,
 {
   using state_t = typename lts<STATE_LABEL_T, ACTION_LABEL_T, LTS_BASE_CLASS>::states_size_type;
 
-  using map_from_states_to_states = std::map<state_t, std::set<state_t>>;
-  map_from_states_to_states resulting_tau_transitions;
-
-  // Copy the internal transitions into the result.
-  for(std::vector < mcrl2::lts::transition>::const_iterator i=l.get_transitions().begin(); i!=l.get_transitions().end(); ++i)
+  std::map<state_t, std::set<state_t>> resulting_tau_transitions;
+  const tau_closure closure(l, forward);
+  for (state_t s = 0; s < l.num_states(); ++s)
   {
-    if (l.is_tau(l.apply_hidden_label_map(i->label())))
+    closure.for_each_reachable_state(s, [&](const state_t t)
     {
-      if (forward) 
-      { 
-        resulting_tau_transitions[i->from()].insert(i->to());
-      }
-      else
-      {
-        resulting_tau_transitions[i->to()].insert(i->from());
-      }
-    }
-  }
-
-  bool new_state_added=true;
-  while (new_state_added)
-  {
-    new_state_added=false;
-    for(typename map_from_states_to_states::iterator i=resulting_tau_transitions.begin(); 
-                       i!=resulting_tau_transitions.end(); ++i)
-    {
-      const std::set<std::size_t>& outgoing_states= i->second;
-      std::set<std::size_t> new_outgoing_states=outgoing_states;
-      for (unsigned long outgoing_state: outgoing_states)
-      {
-        new_outgoing_states.insert(resulting_tau_transitions[outgoing_state].begin(),
-          resulting_tau_transitions[outgoing_state].end());
-      }
-      if (i->second.size()<new_outgoing_states.size())
-      { 
-        i->second=new_outgoing_states;
-        new_state_added=true;
-      }
-    }
+      resulting_tau_transitions[s].insert(t);
+    });
   }
-
   return resulting_tau_transitions;
 }
 
 
 template < class STATE_LABEL_T, class ACTION_LABEL_T, class LTS_BASE_CLASS >
-void reflexive_transitive_tau_closure(lts<STATE_LABEL_T, ACTION_LABEL_T, LTS_BASE_CLASS>& l)
-// This method assumes there are no tau loops!
+void reflexive_transitive_tau_closure(lts<STATE_LABEL_T, ACTION_LABEL_T, LTS_BASE_CLASS>& l,
+                                      const std::size_t number_of_threads = 1)
 {
   using state_t = typename lts<STATE_LABEL_T, ACTION_LABEL_T, LTS_BASE_CLASS>::states_size_type;
-  const std::vector < transition >& original_transitions=l.get_transitions();
-  std::set < transition> new_transitions;
+  std::vector < transition > new_transitions;
+  std::size_t compacted_size = 0;
 
   // Add for every tau*.a tau* transitions sequence a single transition a;
-  std::map <state_t, std::set <state_t> > backward_tau_closure=calculate_non_reflexive_transitive_tau_closure(l,false);
-  std::map <state_t, std::set <state_t> > forward_tau_closure=calculate_non_reflexive_transitive_tau_closure(l,true);
-  for(const transition& t: original_transitions)
   {
-    new_transitions.insert(t);
-    std::set<state_t>& new_from_states=backward_tau_closure[t.from()];
-    std::set<state_t>& new_to_states=forward_tau_closure[t.to()];
-    for(typename std::set<state_t>::const_iterator j_from=new_from_states.begin(); j_from!=new_from_states.end(); ++j_from)
+    const tau_closure backward_tau_closure(l, false, number_of_threads);
+    const tau_closure forward_tau_closure(l, true, number_of_threads);
+    for(const transition& t: l.get_transitions())
     {
-      new_transitions.insert(transition(*j_from,t.label(),t.to()));
-      for(typename std::set<state_t>::const_iterator j_to=new_to_states.begin(); j_to!=new_to_states.end(); ++j_to)
+      add_transition_compacting(new_transitions, compacted_size, t);
+      backward_tau_closure.for_each_reachable_state(t.from(), [&](const state_t from)
       {
-        new_transitions.insert(transition(*j_from,t.label(),*j_to));
-      }
-    }
-    for(typename std::set<state_t>::const_iterator j_to=new_to_states.begin(); j_to!=new_to_states.end(); ++j_to)
-    {
-      new_transitions.insert(transition(t.from(),t.label(),*j_to));
+        add_transition_compacting(new_transitions, compacted_size, transition(from, t.label(), t.to()));
+        forward_tau_closure.for_each_reachable_state(t.to(), [&](const state_t to)
+        {
+          add_transition_compacting(new_transitions, compacted_size, transition(from, t.label(), to));
+        });
+      });
+      forward_tau_closure.for_each_reachable_state(t.to(), [&](const state_t to)
+      {
+        add_transition_compacting(new_transitions, compacted_size, transition(t.from(), t.label(), to));
+      });
     }
   }
 
-  l.clear_transitions();
-
   for(state_t i=0; i<l.num_states(); ++i)
   {
-    new_transitions.insert(transition(i,l.tau_label_index(),i));
-  }
-  
-  // Add the newly generated transitions
-  for (const auto& new_transition: new_transitions)
-  {
-    l.add_transition(new_transition);
+    add_transition_compacting(new_transitions, compacted_size, transition(i,l.tau_label_index(),i));
   }
+  sort_and_remove_duplicate_transitions(new_transitions);
+
+  l.clear_transitions();
+  l.get_transitions().swap(new_transitions);
 }
 
 
@@ -236,42 +222,32 @@ void remove_redundant_transitions(lts<STATE_LABEL_T, ACTION_LABEL_T, LTS_BASE_CL
 
 
 template < class STATE_LABEL_T, class ACTION_LABEL_T, class LTS_BASE_CLASS >
-void tau_star_reduce(lts< STATE_LABEL_T, ACTION_LABEL_T, LTS_BASE_CLASS >& l)
-// This method assumes there are no tau loops!
+void tau_star_reduce(lts< STATE_LABEL_T, ACTION_LABEL_T, LTS_BASE_CLASS >& l, const std::size_t number_of_threads = 1)
 {
   using state_t = typename lts<STATE_LABEL_T, ACTION_LABEL_T, LTS_BASE_CLASS>::states_size_type;
-  std::vector < transition >& original_transitions=l.get_transitions();
-  std::set < transition> new_transitions;
-
-  // Add all the original non tau transitions.
-  for (const auto& original_transition: original_transitions)
-  {
-    if (!l.is_tau(l.apply_hidden_label_map(original_transition.label())))
-    {
-      new_transitions.insert(original_transition);
-    }
-  }
+  std::vector < transition > new_transitions;
+  std::size_t compacted_size = 0;
 
-  // Add for every tau*.a transitions sequence a single transition a, provided a is not tau.
-  std::map <state_t, std::set <state_t> > backward_tau_closure=calculate_non_reflexive_transitive_tau_closure(l,false);
-  for (const auto& original_transition: original_transitions)
+  // Add all the original non tau transitions, and for every tau*.a transitions sequence 
+  // a single transition a, provided a is not tau.
   {
-    if (!l.is_tau(l.apply_hidden_label_map(original_transition.label())))
+    const tau_closure backward_tau_closure(l, false, number_of_threads);
+    for (const transition& t: l.get_transitions())
     {
-      std::set<state_t>& new_from_states = backward_tau_closure[original_transition.from()];
-      for(typename std::set<state_t>::const_iterator j=new_from_states.begin(); j!=new_from_states.end(); ++j)
+      if (!l.is_tau(l.apply_hidden_label_map(t.label())))
       {
-        new_transitions.insert(transition(*j, original_transition.label(), original_transition.to()));
+        add_transition_compacting(new_transitions, compacted_size, t);
+        backward_tau_closure.for_each_reachable_state(t.from(), [&](const state_t from)
+        {
+          add_transition_compacting(new_transitions, compacted_size, transition(from, t.label(), t.to()));
+        });
       }
     }
   }
+  sort_and_remove_duplicate_transitions(new_transitions);
+
   l.clear_transitions();
-  
-  // Add the newly generated transitions
-  for (const auto& new_transition: new_transitions)
-  {
-    l.add_transition(new_transition);
-  }
+  l.get_transitions().swap(new_transitions);
 
   reachability_check(l, true); // Remove unreachable parts.
 }
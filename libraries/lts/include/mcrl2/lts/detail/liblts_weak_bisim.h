@@ -27,11 +27,13 @@ namespace mcrl2::lts::detail
 /** \brief Reduce LTS l with respect to (divergence-preserving) weak bisimulation.
  * \param[in/out] l The transition system that is reduced.
  * \param[in] preserve_divergences Indicates whether loops of internal actions on states must be preserved. If false
- *            these are removed. If true these are preserved.  */
+ *            these are removed. If true these are preserved.
+ * \param[in] number_of_threads The number of threads used to calculate the transitive tau closure. */
 template < class LTS_TYPE>
 void weak_bisimulation_reduce(
   LTS_TYPE& l,
-  const bool preserve_divergences = false)
+  const bool preserve_divergences = false,
+  const std::size_t number_of_threads = 1)
 {
   if (1 < l.num_states())
   {
@@ -45,7 +47,7 @@ void weak_bisimulation_reduce(
   }
   if (1 < l.num_states())
   {
-    reflexive_transitive_tau_closure(l);                      // Apply transitive tau closure to l.
+    reflexive_transitive_tau_closure(l, number_of_threads);   // Apply transitive tau closure to l.
     bisimulation_reduce_dnj(l, false, false);                 // Apply strong bisimulation to l.
   }
   scc_reduce(l);                                              // Remove tau loops.
@@ -66,15 +68,17 @@ void weak_bisimulation_reduce(
  * \param[in/out] l1 A first transition system.
  * \param[in/out] l2 A second transistion system.
  * \param[preserve_divergences] If true and branching is true, preserve tau loops on states.
+ * \param[number_of_threads] The number of threads used to calculate the transitive tau closures.
  * \retval True iff the initial states of the current transition system and l2 are (divergence preserving) (branching) bisimilar */
 template < class LTS_TYPE>
 bool destructive_weak_bisimulation_compare(
   LTS_TYPE& l1,
   LTS_TYPE& l2,
-  const bool preserve_divergences=false)
+  const bool preserve_divergences=false,
+  const std::size_t number_of_threads = 1)
 {
-  weak_bisimulation_reduce(l1,preserve_divergences);
-  weak_bisimulation_reduce(l2,preserve_divergences);
+  weak_bisimulation_reduce(l1,preserve_divergences,number_of_threads);
+  weak_bisimulation_reduce(l2,preserve_divergences,number_of_threads);
   return destructive_bisimulation_compare_dnj(l1,l2);
 }
 
@@ -90,17 +94,20 @@ bool destructive_weak_bisimulation_compare(
  * \param[in/out] l1 A first transition system.
  * \param[in/out] l2 A second transistion system.
  * \param[preserve_divergences] If true and branching is true, preserve tau loops on states.
+ * \param[number_of_threads] The number of threads used to calculate the transitive tau closures.
  * \retval True iff the initial states of the current transition system and l2 are (divergence preserving) (branching) bisimilar */
 template < class LTS_TYPE>
 bool weak_bisimulation_compare(
   const LTS_TYPE& l1,
   const LTS_TYPE& l2,
-  const bool preserve_divergences = false)
+  const bool preserve_divergences = false,
+  const std::size_t number_of_threads = 1)
 {
   LTS_TYPE l1_copy(l1);
   LTS_TYPE l2_copy(l2);
   return destructive_weak_bisimulation_compare(l1_copy, l2_copy,
-                                                         preserve_divergences);
+                                                         preserve_divergences,
+                                                         number_of_threads);
 }
 
 }
@@ -0,0 +1,178 @@
+// Author(s): agent
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/lts/detail/lts_columnar_io.h
+/// \brief A columnar binary encoding of .lts files.
+/// \details The file starts with a magic string, followed by a section with all terms (the data
+///          specification, process parameters, action labels, state labels and initial state) as a
+///          binary aterm stream. The transitions follow in blocks, sorted on their source state. A block
+///          stores the sources, labels and targets in three separate columns: sources as differences
+///          with the previous source, labels as is and targets as difference with their source, all
+///          as variable width integers. The file ends with an index that gives the offset and the range
+///          of source states of every block, such that the outgoing transitions of a state can be read
+///          without reading the whole file.
+
+#ifndef MCRL2_LTS_DETAIL_LTS_COLUMNAR_IO_H
+#define MCRL2_LTS_DETAIL_LTS_COLUMNAR_IO_H
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "mcrl2/lts/lts_lts.h"
+
+namespace mcrl2::lts::detail
+{
+
+/// \brief The first bytes of every file in the columnar format.
+constexpr char columnar_lts_magic[] = "mCRL2LTC";
+constexpr std::size_t columnar_lts_magic_size = sizeof(columnar_lts_magic) - 1;
+constexpr std::uint64_t columnar_lts_version = 1;
+
+/// \brief The default number of transitions in a block.
+constexpr std::size_t columnar_lts_block_size = 1 << 16;
+
+/// \brief Writes value as eight bytes, least significant byte first.
+inline void write_uint64(std::ostream& stream, std::uint64_t value)
+{
+  char buffer[8];
+  for (std::size_t i = 0; i < 8; ++i)
+  {
+    buffer[i] = static_cast<char>((value >> (8*i)) & 0xff);
+  }
+  stream.write(buffer, 8);
+}
+
+/// \brief Reads a value that is written by write_uint64.
+inline std::uint64_t read_uint64(std::istream& stream)
+{
+  unsigned char buffer[8];
+  stream.read(reinterpret_cast<char*>(buffer), 8);
+  if (stream.gcount() != 8)
+  {
+    throw mcrl2::runtime_error("Unexpected end of an lts file.");
+  }
+  std::uint64_t result = 0;
+  for (std::size_t i = 0; i < 8; ++i)
+  {
+    result |= static_cast<std::uint64_t>(buffer[i]) << (8*i);
+  }
+  return result;
+}
+
+/// \brief Appends value to buffer as a variable width integer of seven bits per byte.
+inline void write_varint(std::vector<std::uint8_t>& buffer, std::uint64_t value)
+{
+  while (value >= 0x80)
+  {
+    buffer.push_back(static_cast<std::uint8_t>(value | 0x80));
+    value >>= 7;
+  }
+  buffer.push_back(static_cast<std::uint8_t>(value));
+}
+
+/// \brief Reads a variable width integer at position in buffer, and advances position.
+inline std::uint64_t read_varint(const std::uint8_t* buffer, std::size_t size, std::size_t& position)
+{
+  std::uint64_t result = 0;
+  for (unsigned int shift = 0; shift < 64; shift += 7)
+  {
+    if (position >= size)
+    {
+      throw mcrl2::runtime_error("Unexpected end of a transition block in a columnar lts file.");
+    }
+    const std::uint8_t byte = buffer[position++];
+    result |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0)
+    {
+      return result;
+    }
+  }
+  throw mcrl2::runtime_error("Invalid integer in a transition block in a columnar lts file.");
+}
+
+/// \brief Maps signed integers to unsigned integers such that values close to zero are small.
+inline std::uint64_t zigzag_encode(std::int64_t value)
+{
+  return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+}
+
+inline std::int64_t zigzag_decode(std::uint64_t value)
+{
+  return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+}
+
+/// \brief The location and the range of source states of a block of transitions.
+struct columnar_block_info
+{
+  std::uint64_t offset;     ///< The position of the block in the file.
+  std::uint64_t first_from; ///< The smallest source state in the block.
+  std::uint64_t last_from;  ///< The largest source state in the block.
+  std::uint64_t size;       ///< The number of transitions in the block.
+};
+
+/// \brief The extension of files that are saved in the columnar format. They are read as .lts files.
+constexpr char columnar_lts_extension[] = "ltsc";
+
+/// \brief Returns true iff the filename has the extension of the columnar format.
+inline bool has_columnar_lts_extension(const std::string& filename)
+{
+  const std::string::size_type pos = filename.find_last_of('.');
+  return pos != std::string::npos && filename.substr(pos + 1) == columnar_lts_extension;
+}
+
+/// \brief Returns true iff the file starts with the magic string of the columnar format.
+bool is_columnar_lts_file(const std::string& filename);
+
+/// \brief Writes the lts in the columnar format.
+/// \param block_size The maximal number of transitions per block.
+void write_columnar_lts(std::ostream& stream, const lts_lts_t& lts, std::size_t block_size = columnar_lts_block_size);
+
+/// \brief Reads an lts in the columnar format. The lts must be empty.
+void read_columnar_lts(std::istream& stream, lts_lts_t& lts);
+
+/// \brief Random access to the transitions in a file in the columnar format.
+/// \details Only the header and the block index are read when the file is opened. The
+///          transitions of a state are obtained by decoding the blocks that contain its source.
+class columnar_lts_file
+{
+  protected:
+    mutable std::ifstream m_stream;
+    std::size_t m_number_of_states = 0;
+    std::size_t m_number_of_transitions = 0;
+    std::vector<columnar_block_info> m_blocks;
+
+  public:
+    explicit columnar_lts_file(const std::string& filename);
+
+    std::size_t num_states() const
+    {
+      return m_number_of_states;
+    }
+
+    std::size_t num_transitions() const
+    {
+      return m_number_of_transitions;
+    }
+
+    const std::vector<columnar_block_info>& blocks() const
+    {
+      return m_blocks;
+    }
+
+    /// \brief Appends the transitions of the given block to result.
+    void read_block(std::size_t block, std::vector<transition>& result) const;
+
+    /// \brief The transitions with the given source state, ordered on label and target.
+    std::vector<transition> outgoing_transitions(std::size_t state) const;
+};
+
+} // namespace mcrl2::lts::detail
+
+#endif // MCRL2_LTS_DETAIL_LTS_COLUMNAR_IO_H
@@ -0,0 +1,962 @@
+// Author(s): agent
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/lts/distributed_state_space_generator.h
+/// \brief State space generation with several worker processes.
+/// \details Every worker process owns the states whose structural hash is equal to
+///          its index modulo the number of workers. A worker explores its own states
+///          with its own copy of the explorer and rewriter, and sends successor states
+///          that are owned by another worker to that worker in batches. Termination is
+///          detected with Safra's token based algorithm. When all workers are done, the
+///          parts of the state space are merged by the parent process.
+
+#ifndef MCRL2_LTS_DISTRIBUTED_STATE_SPACE_GENERATOR_H
+#define MCRL2_LTS_DISTRIBUTED_STATE_SPACE_GENERATOR_H
+
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <fstream>
+#include <numeric>
+#include <sstream>
+
+#include "mcrl2/atermpp/aterm_io_binary.h"
+#include "mcrl2/data/detail/io.h"
+#include "mcrl2/lps/explorer.h"
+#include "mcrl2/lts/lts_builder.h"
+#include "mcrl2/utilities/hash_utility.h"
+#include "mcrl2/utilities/platform.h"
+
+#ifndef MCRL2_PLATFORM_WINDOWS
+  #include <fcntl.h>
+  #include <poll.h>
+  #include <sys/socket.h>
+  #include <sys/wait.h>
+  #include <unistd.h>
+#endif
+
+namespace mcrl2::lts
+{
+
+namespace detail
+{
+
+/// \brief A hash of a term that only depends on its structure.
+/// \details Term addresses and the indices of function symbols differ between processes, so
+///          unlike std::hash this can be used to decide which worker owns a state. The last
+///          argument of an OpId is its index, and is therefore skipped.
+inline std::size_t structural_hash(const atermpp::aterm& t)
+{
+  if (t.type_is_int())
+  {
+    return std::hash<std::size_t>()(atermpp::down_cast<atermpp::aterm_int>(t).value());
+  }
+  const atermpp::function_symbol& f = t.function();
+  std::size_t result = utilities::detail::hash_combine(std::hash<std::string>()(f.name()), f.arity());
+  const std::size_t arity = (f == core::detail::function_symbol_OpId() ? f.arity() - 1 : f.arity());
+  for (std::size_t i = 0; i < arity; ++i)
+  {
+    result = utilities::detail::hash_combine(result, structural_hash(t[i]));
+  }
+  return result;
+}
+
+#ifndef MCRL2_PLATFORM_WINDOWS
+
+/// \brief The kinds of messages that are exchanged between workers.
+enum class distributed_message_type : unsigned char
+{
+  states = 0,    ///< A batch of (source index, action, target state) triples for the receiver.
+  token = 1,     ///< The termination detection token.
+  terminate = 2, ///< All workers are passive and there are no messages in transit.
+  abort = 3      ///< Sent by the parent process to every worker when generation is aborted.
+};
+
+/// \brief The abort message, which has an empty payload. It is written with a single send, as
+///        it is sent from a signal handler.
+constexpr char distributed_abort_message[] = { static_cast<char>(distributed_message_type::abort), 0, 0, 0, 0, 0, 0, 0, 0 };
+
+/// \brief A bidirectional channel of messages between two workers over a non blocking socket.
+/// \details Messages consist of a one byte type and an eight byte little endian payload length,
+///          followed by the payload. Writes are buffered and flushed when the socket accepts data,
+///          such that two workers that send to each other at the same time cannot deadlock.
+class message_channel
+{
+  public:
+    /// The flags for send, such that writing to a closed socket does not raise SIGPIPE.
+#ifdef MSG_NOSIGNAL
+    static constexpr int send_flags = MSG_NOSIGNAL;
+#else
+    static constexpr int send_flags = 0;
+#endif
+
+  protected:
+    static constexpr std::size_t header_size = 9;
+
+    int m_fd;
+    std::string m_input;
+    std::size_t m_input_begin = 0;
+    std::string m_output;
+    std::size_t m_output_begin = 0;
+
+  public:
+    explicit message_channel(int fd)
+      : m_fd(fd)
+    {
+      if (fcntl(m_fd, F_SETFL, fcntl(m_fd, F_GETFL) | O_NONBLOCK) == -1)
+      {
+        throw mcrl2::runtime_error(std::string("Could not make socket non blocking: ") + std::strerror(errno));
+      }
+#ifndef MSG_NOSIGNAL
+      // Without MSG_NOSIGNAL, writing to a socket that is closed by the other side must not raise SIGPIPE either.
+      const int on = 1;
+      setsockopt(m_fd, SOL_SOCKET, SO_NOSIGPIPE, &on, sizeof(on));
+#endif
+    }
+
+    message_channel(const message_channel&) = delete;
+    message_channel& operator=(const message_channel&) = delete;
+
+    ~message_channel()
+    {
+      close(m_fd);
+    }
+
+    int fd() const
+    {
+      return m_fd;
+    }
+
+    /// \brief Append a message to the output buffer.
+    void send(distributed_message_type type, const std::string& payload)
+    {
+      m_output.push_back(static_cast<char>(type));
+      std::uint64_t length = payload.size();
+      for (std::size_t i = 0; i < 8; ++i)
+      {
+        m_output.push_back(static_cast<char>((length >> (8*i)) & 0xff));
+      }
+      m_output.append(payload);
+    }
+
+    bool has_pending_output() const
+    {
+      return m_output_begin < m_output.size();
+    }
+
+    /// \brief Write as much of the output buffer as the socket accepts without blocking.
+    /// \returns False iff the other side closed the connection, in which case the output is discarded.
+    bool flush()
+    {
+      while (has_pending_output())
+      {
+        ssize_t n = ::send(m_fd, m_output.data() + m_output_begin, m_output.size() - m_output_begin, send_flags);
+        if (n < 0)
+        {
+          if (errno == EINTR)
+          {
+            continue;
+          }
+          if (errno == EAGAIN || errno == EWOULDBLOCK)
+          {
+            break;
+          }
+          if (errno == EPIPE || errno == ECONNRESET)
+          {
+            m_output.clear();
+            m_output_begin = 0;
+            return false;
+          }
+          throw mcrl2::runtime_error(std::string("Could not send a message to another worker: ") + std::strerror(errno));
+        }
+        m_output_begin += static_cast<std::size_t>(n);
+      }
+      if (m_output_begin == m_output.size())
+      {
+        m_output.clear();
+        m_output_begin = 0;
+      }
+      return true;
+    }
+
+    /// \brief Read everything that is available on the socket without blocking.
+    /// \returns False iff the other side closed the connection.
+    bool receive()
+    {
+      char buffer[65536];
+      while (true)
+      {
+        ssize_t n = read(m_fd, buffer, sizeof(buffer));
+        if (n < 0)
+        {
+          if (errno == EINTR)
+          {
+            continue;
+          }
+          if (errno == EAGAIN || errno == EWOULDBLOCK)
+          {
+            return true;
+          }
+          throw mcrl2::runtime_error(std::string("Could not receive a message from another worker: ") + std::strerror(errno));
+        }
+        if (n == 0)
+        {
+          return false;
+        }
+        m_input.append(buffer, static_cast<std::size_t>(n));
+      }
+    }
+
+    /// \brief Extract the next complete message from the input buffer, if there is one.
+    bool next_message(distributed_message_type& type, std::string& payload)
+    {
+      const std::size_t available = m_input.size() - m_input_begin;
+      if (available < header_size)
+      {
+        return false;
+      }
+      std::uint64_t length = 0;
+      for (std::size_t i = 0; i < 8; ++i)
+      {
+        length |= static_cast<std::uint64_t>(static_cast<unsigned char>(m_input[m_input_begin + 1 + i])) << (8*i);
+      }
+      if (available < header_size + length)
+      {
+        return false;
+      }
+      type = static_cast<distributed_message_type>(m_input[m_input_begin]);
+      payload.assign(m_input, m_input_begin + header_size, length);
+      m_input_begin += header_size + length;
+      if (m_input_begin == m_input.size())
+      {
+        m_input.clear();
+        m_input_begin = 0;
+      }
+      else if (m_input_begin > (1 << 20))
+      {
+        m_input.erase(0, m_input_begin);
+        m_input_begin = 0;
+      }
+      return true;
+    }
+};
+
+/// \brief The work of one process in distributed state space generation.
+template <bool Timed, typename Specification>
+class distributed_worker
+{
+  public:
+    using explorer_type = lps::explorer<false, Timed, Specification>;
+
+  protected:
+    /// \brief A transition of which the target is owned by this worker.
+    struct incoming_transition
+    {
+      std::size_t from_worker;
+      std::size_t from;
+      std::size_t label;
+      std::size_t to;
+    };
+
+    /// \brief Successors for one other worker that have not been sent yet.
+    struct outgoing_batch
+    {
+      std::unique_ptr<std::ostringstream> buffer;
+      std::unique_ptr<atermpp::binary_aterm_ostream> stream;
+      std::size_t size = 0;
+    };
+
+    static constexpr std::size_t batch_size = 1024;
+    static constexpr std::size_t states_per_round = 64;
+
+    explorer_type& m_explorer;
+    const std::size_t m_id;
+    const std::size_t m_number_of_workers;
+    const std::atomic<bool>& m_must_abort;
+    std::vector<std::unique_ptr<message_channel>> m_channels; // m_channels[m_id] is not used.
+    std::unique_ptr<message_channel> m_parent; // Only used to receive an abort message.
+    std::vector<bool> m_closed; // The workers that closed their connection to this worker.
+    std::vector<outgoing_batch> m_batches;
+
+    atermpp::indexed_set<lps::state> m_states;
+    atermpp::indexed_set<atermpp::aterm> m_actions;
+    std::vector<incoming_transition> m_transitions;
+    std::deque<std::size_t> m_todo;
+
+    // Safra's termination detection.
+    long m_message_count = 0; // The number of sent minus the number of received batches.
+    bool m_black; // Worker 0 starts black, as termination cannot be concluded before a first round of the token.
+    bool m_has_token;
+    long m_token_count = 0;
+    bool m_token_black = false;
+    bool m_terminated = false;
+    bool m_aborted = false;
+
+    std::size_t owner(const lps::state& s) const
+    {
+      return structural_hash(s) % m_number_of_workers;
+    }
+
+    std::size_t add_state(const lps::state& s)
+    {
+      auto [index, inserted] = m_states.insert(s);
+      if (inserted)
+      {
+        m_todo.push_back(index);
+      }
+      return index;
+    }
+
+    void add_to_batch(std::size_t worker, std::size_t from, const lps::multi_action& a, const lps::state& s)
+    {
+      outgoing_batch& batch = m_batches[worker];
+      if (!batch.stream)
+      {
+        batch.buffer = std::make_unique<std::ostringstream>();
+        batch.stream = std::make_unique<atermpp::binary_aterm_ostream>(*batch.buffer);
+        *batch.stream << data::detail::remove_index_impl;
+      }
+      *batch.stream << atermpp::aterm_int(from);
+      *batch.stream << a;
+      *batch.stream << s;
+      if (++batch.size == batch_size)
+      {
+        send_batch(worker);
+      }
+    }
+
+    void send_batch(std::size_t worker)
+    {
+      outgoing_batch& batch = m_batches[worker];
+      if (batch.size == 0)
+      {
+        return;
+      }
+      batch.stream.reset(); // Writes the end of the stream.
+      m_channels[worker]->send(distributed_message_type::states, batch.buffer->str());
+      batch.buffer.reset();
+      batch.size = 0;
+      m_message_count++;
+    }
+
+    void receive_batch(std::size_t sender, const std::string& payload)
+    {
+      m_message_count--;
+      m_black = true;
+      std::istringstream buffer(payload);
+      atermpp::binary_aterm_istream stream(buffer);
+      stream >> data::detail::add_index_impl;
+      atermpp::aterm from;
+      atermpp::aterm a;
+      atermpp::aterm s;
+      while (true)
+      {
+        stream.get(from);
+        if (!from.defined())
+        {
+          break;
+        }
+        stream.get(a);
+        stream.get(s);
+        std::size_t to = add_state(atermpp::down_cast<lps::state>(s));
+        std::size_t label = m_actions.insert(a).first;
+        m_transitions.push_back({sender, atermpp::down_cast<atermpp::aterm_int>(from).value(), label, to});
+      }
+    }
+
+    void explore_state(std::size_t from)
+    {
+      const lps::state s = m_states.at(from);
+      for (const auto& t: m_explorer.out_edges(s))
+      {
+        std::size_t worker = owner(t.state);
+        if (worker == m_id)
+        {
+          std::size_t to = add_state(t.state);
+          std::size_t label = m_actions.insert(t.action).first;
+          m_transitions.push_back({m_id, from, label, to});
+        }
+        else
+        {
+          add_to_batch(worker, from, t.action, t.state);
+        }
+      }
+    }
+
+    void send_token(long count, bool black)
+    {
+      std::string payload = std::to_string(count) + (black ? " b" : " w");
+      m_channels[(m_id + 1) % m_number_of_workers]->send(distributed_message_type::token, payload);
+      m_has_token = false;
+    }
+
+    void receive_token(const std::string& payload)
+    {
+      std::istringstream in(payload);
+      std::string colour;
+      in >> m_token_count >> colour;
+      m_token_black = (colour == "b");
+      m_has_token = true;
+    }
+
+    /// \brief Called when this worker is passive and holds the token.
+    void pass_token()
+    {
+      if (m_id == 0)
+      {
+        if (!m_token_black && !m_black && m_token_count + m_message_count == 0)
+        {
+          for (std::size_t i = 1; i < m_number_of_workers; ++i)
+          {
+            m_channels[i]->send(distributed_message_type::terminate, std::string());
+          }
+          m_terminated = true;
+          return;
+        }
+        m_black = false;
+        send_token(0, false);
+      }
+      else
+      {
+        send_token(m_token_count + m_message_count, m_token_black || m_black);
+        m_black = false;
+      }
+    }
+
+    void handle_messages()
+    {
+      distributed_message_type type;
+      std::string payload;
+      for (std::size_t i = 0; i < m_number_of_workers; ++i)
+      {
+        if (i == m_id)
+        {
+          continue;
+        }
+        while (m_channels[i]->next_message(type, payload))
+        {
+          switch (type)
+          {
+            case distributed_message_type::states: receive_batch(i, payload); break;
+            case distributed_message_type::token: receive_token(payload); break;
+            case distributed_message_type::terminate: m_terminated = true; break;
+            case distributed_message_type::abort: break;
+          }
+        }
+      }
+    }
+
+    /// \brief Read the messages of the parent process, and throw if generation is aborted.
+    void check_abort()
+    {
+      if (!m_parent->receive())
+      {
+        m_aborted = true; // The parent process has stopped.
+      }
+      distributed_message_type type;
+      std::string payload;
+      while (m_parent->next_message(type, payload))
+      {
+        m_aborted = m_aborted || type == distributed_message_type::abort;
+      }
+      if (m_aborted || m_must_abort)
+      {
+        throw mcrl2::runtime_error("State space generation was aborted.");
+      }
+    }
+
+    /// \brief Wait until data can be exchanged with one of the other workers, and exchange it.
+    void exchange(bool block)
+    {
+      std::vector<pollfd> fds;
+      std::vector<std::size_t> workers; // The worker of each element of fds, except the first.
+      fds.push_back(pollfd{m_parent->fd(), POLLIN, 0});
+      for (std::size_t i = 0; i < m_number_of_workers; ++i)
+      {
+        if (i != m_id && !m_closed[i])
+        {
+          short events = POLLIN;
+          if (m_channels[i]->has_pending_output())
+          {
+            events |= POLLOUT;
+          }
+          fds.push_back(pollfd{m_channels[i]->fd(), events, 0});
+          workers.push_back(i);
+        }
+      }
+
+      int n = poll(fds.data(), fds.size(), block ? -1 : 0);
+      if (n < 0)
+      {
+        if (errno == EINTR)
+        {
+          return;
+        }
+        throw mcrl2::runtime_error(std::string("Waiting for other workers failed: ") + std::strerror(errno));
+      }
+
+      // An abort message takes precedence, as other workers may stop because of it.
+      if (fds[0].revents & (POLLIN | POLLHUP | POLLERR))
+      {
+        check_abort();
+      }
+
+      for (std::size_t j = 1; j < fds.size(); ++j)
+      {
+        const std::size_t i = workers[j - 1];
+        bool open = true;
+        if (fds[j].revents & POLLOUT)
+        {
+          open = m_channels[i]->flush();
+        }
+        if (fds[j].revents & (POLLIN | POLLHUP | POLLERR))
+        {
+          open = m_channels[i]->receive() && open;
+        }
+        m_closed[i] = !open;
+      }
+      handle_messages();
+
+      // A worker only stops after worker 0 has sent it the termination message, and worker 0
+      // sends that message to all workers before it stops. So a worker that stopped before this
+      // worker has received the termination message stopped unexpectedly if it is worker 0, or if
+      // this is worker 0. Another worker may have received its termination message earlier.
+      if (!m_terminated)
+      {
+        for (std::size_t i = 0; i < m_number_of_workers; ++i)
+        {
+          if (m_closed[i] && (i == 0 || m_id == 0))
+          {
+            throw mcrl2::runtime_error("Worker " + std::to_string(i) + " stopped unexpectedly.");
+          }
+        }
+      }
+    }
+
+    bool has_pending_output() const
+    {
+      for (std::size_t i = 0; i < m_number_of_workers; ++i)
+      {
+        if (i != m_id && !m_closed[i] && m_channels[i]->has_pending_output())
+        {
+          return true;
+        }
+      }
+      return false;
+    }
+
+  public:
+    distributed_worker(explorer_type& explorer,
+                       std::size_t id,
+                       std::size_t number_of_workers,
+                       std::vector<std::unique_ptr<message_channel>> channels,
+                       std::unique_ptr<message_channel> parent,
+                       const std::atomic<bool>& must_abort)
+      : m_explorer(explorer),
+        m_id(id),
+        m_number_of_workers(number_of_workers),
+        m_must_abort(must_abort),
+        m_channels(std::move(channels)),
+        m_parent(std::move(parent)),
+        m_closed(number_of_workers, false),
+        m_batches(number_of_workers),
+        m_black(id == 0),
+        m_has_token(id == 0)
+    {}
+
+    /// \brief Explore all states owned by this worker that are reachable from initial_state.
+    void run(const lps::state& initial_state)
+    {
+      if (owner(initial_state) == m_id)
+      {
+        add_state(initial_state);
+      }
+
+      while (!m_terminated)
+      {
+        check_abort();
+
+        for (std::size_t k = 0; k < states_per_round && !m_todo.empty(); ++k)
+        {
+          std::size_t from = m_todo.front();
+          m_todo.pop_front();
+          explore_state(from);
+        }
+
+        if (m_number_of_workers == 1)
+        {
+          m_terminated = m_todo.empty();
+          continue;
+        }
+
+        const bool passive = m_todo.empty();
+        if (passive)
+        {
+          for (std::size_t i = 0; i < m_number_of_workers; ++i)
+          {
+            if (i != m_id)
+            {
+              send_batch(i);
+            }
+          }
+          if (m_has_token)
+          {
+            pass_token();
+          }
+        }
+        for (std::size_t i = 0; i < m_number_of_workers; ++i)
+        {
+          if (i != m_id)
+          {
+            // A closed connection is detected when receiving, after the pending messages are handled.
+            m_channels[i]->flush();
+          }
+        }
+        if (!m_terminated)
+        {
+          exchange(passive && m_todo.empty());
+        }
+      }
+
+      // Make sure that the other workers receive the termination messages.
+      while (has_pending_output())
+      {
+        exchange(true);
+      }
+    }
+
+    /// \brief Write the explored part of the state space to a file.
+    /// \details The file contains the number of states and transitions, optionally followed by
+    ///          the states, the actions and the transitions themselves.
+    void save(const std::string& filename, bool write_lts) const
+    {
+      std::ofstream out(filename, std::ios_base::binary);
+      atermpp::binary_aterm_ostream stream(out);
+      stream << data::detail::remove_index_impl;
+      stream << atermpp::aterm_int(m_states.size());
+      stream << atermpp::aterm_int(m_transitions.size());
+      if (!write_lts)
+      {
+        return;
+      }
+      for (const lps::state& s: m_states)
+      {
+        stream << s;
+      }
+      stream << atermpp::aterm_int(m_actions.size());
+      for (const atermpp::aterm& a: m_actions)
+      {
+        stream << a;
+      }
+      for (const incoming_transition& t: m_transitions)
+      {
+        stream << atermpp::aterm_int(t.from_worker);
+        stream << atermpp::aterm_int(t.from);
+        stream << atermpp::aterm_int(t.label);
+        stream << atermpp::aterm_int(t.to);
+      }
+    }
+};
+
+#endif // MCRL2_PLATFORM_WINDOWS
+
+} // namespace detail
+
+/// \brief Generates a state space with a number of worker processes, each of which owns part of the states.
+/// \details Only available on POSIX platforms, and only for non stochastic specifications.
+template <bool Timed, typename Specification>
+class distributed_state_space_generator: public lps::abortable
+{
+  public:
+    using explorer_type = lps::explorer<false, Timed, Specification>;
+
+  protected:
+    explorer_type& m_explorer;
+    std::size_t m_number_of_processes;
+    std::atomic<bool> m_must_abort = false;
+
+#ifndef MCRL2_PLATFORM_WINDOWS
+    // The sockets over which the parent process sends an abort message to each worker.
+    std::vector<int> m_control_sockets;
+
+    void close_control_sockets()
+    {
+      for (int& fd: m_control_sockets)
+      {
+        if (fd != -1)
+        {
+          close(fd);
+          fd = -1;
+        }
+      }
+    }
+
+    /// \brief Merge the parts that are written by the workers into the builder.
+    /// \param order The workers in the order in which their states are numbered. The first worker owns the initial state.
+    void merge(const std::vector<std::string>& filenames, const std::vector<std::size_t>& order, lts_builder& builder, bool write_lts)
+    {
+      const std::size_t n = filenames.size();
+      std::vector<std::unique_ptr<std::ifstream>> files(n);
+      std::vector<std::unique_ptr<atermpp::binary_aterm_istream>> streams(n);
+      std::vector<std::size_t> state_count(n);
+      std::vector<std::size_t> transition_count(n);
+      for (std::size_t i = 0; i < n; ++i)
+      {
+        files[i] = std::make_unique<std::ifstream>(filenames[i], std::ios_base::binary);
+        streams[i] = std::make_unique<atermpp::binary_aterm_istream>(*files[i]);
+        *streams[i] >> data::detail::add_index_impl;
+        atermpp::aterm_int count;
+        *streams[i] >> count;
+        state_count[i] = count.value();
+        *streams[i] >> count;
+        transition_count[i] = count.value();
+      }
+
+      std::vector<std::size_t> offset(n);
+      std::size_t total_states = 0;
+      for (std::size_t i: order)
+      {
+        offset[i] = total_states;
+        total_states += state_count[i];
+      }
+      std::size_t total_transitions = std::accumulate(transition_count.begin(), transition_count.end(), std::size_t(0));
+      mCRL2log(log::verbose) << "Done with state space generation ("
+                             << total_states << " state" << ((total_states == 1)?"":"s")
+                             << " and " << total_transitions << " transition" << ((total_transitions == 1)?"":"s") << ")" << std::endl;
+
+      if (!write_lts)
+      {
+        return;
+      }
+
+      lts_builder::indexed_set_for_states_type state_map;
+      atermpp::aterm t;
+      for (std::size_t i: order)
+      {
+        for (std::size_t k = 0; k < state_count[i]; ++k)
+        {
+          streams[i]->get(t);
+          [[maybe_unused]] auto [index, inserted] = state_map.insert(atermpp::down_cast<lps::state>(t));
+          assert(inserted && index == offset[i] + k);
+        }
+      }
+
+      for (std::size_t i = 0; i < n; ++i)
+      {
+        atermpp::aterm_int count;
+        *streams[i] >> count;
+        std::vector<lps::multi_action> actions;
+        for (std::size_t k = 0; k < count.value(); ++k)
+        {
+          streams[i]->get(t);
+          actions.push_back(atermpp::down_cast<lps::multi_action>(t));
+        }
+        atermpp::aterm_int from_worker;
+        atermpp::aterm_int from;
+        atermpp::aterm_int label;
+        atermpp::aterm_int to;
+        for (std::size_t k = 0; k < transition_count[i]; ++k)
+        {
+          *streams[i] >> from_worker >> from >> label >> to;
+          builder.add_transition(offset[from_worker.value()] + from.value(), actions[label.value()], offset[i] + to.value(), 1);
+        }
+      }
+      builder.finalize(state_map, Timed);
+    }
+#endif
+
+  public:
+    distributed_state_space_generator(explorer_type& explorer, std::size_t number_of_processes)
+      : m_explorer(explorer),
+        m_number_of_processes(number_of_processes)
+    {
+      if (m_number_of_processes == 0)
+      {
+        throw mcrl2::runtime_error("The number of processes must be at least one.");
+      }
+    }
+
+    /// \brief Abort generation, and send an abort message to all workers.
+    /// \details This is called from a signal handler, and therefore only uses send.
+    void abort() override
+    {
+      m_must_abort = true;
+#ifndef MCRL2_PLATFORM_WINDOWS
+      for (int fd: m_control_sockets)
+      {
+        if (fd != -1)
+        {
+          ::send(fd, detail::distributed_abort_message, sizeof(detail::distributed_abort_message), MSG_DONTWAIT | detail::message_channel::send_flags);
+        }
+      }
+#endif
+    }
+
+    /// \brief Generate the state space and add it to the builder.
+    /// \param write_lts If false, only the numbers of states and transitions are reported.
+    bool explore(lts_builder& builder, bool write_lts = true)
+    {
+#ifdef MCRL2_PLATFORM_WINDOWS
+      (void)builder;
+      (void)write_lts;
+      throw mcrl2::runtime_error("Distributed state space generation is not supported on this platform.");
+#else
+      lps::state initial_state;
+      m_explorer.compute_initial_state(initial_state);
+      const std::size_t n = m_number_of_processes;
+
+      // Connect every pair of workers with a socket; worker i uses sockets[i][j] to talk to worker j.
+      std::vector<std::vector<int>> sockets(n, std::vector<int>(n, -1));
+      for (std::size_t i = 0; i < n; ++i)
+      {
+        for (std::size_t j = i + 1; j < n; ++j)
+        {
+          int fds[2];
+          if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == -1)
+          {
+            throw mcrl2::runtime_error(std::string("Could not create a socket between workers: ") + std::strerror(errno));
+          }
+          sockets[i][j] = fds[0];
+          sockets[j][i] = fds[1];
+        }
+      }
+
+      // The parent keeps one end of a socket to each worker, to send an abort message.
+      std::vector<int> worker_control_sockets(n, -1);
+      m_control_sockets.assign(n, -1);
+      for (std::size_t i = 0; i < n; ++i)
+      {
+        int fds[2];
+        if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == -1)
+        {
+          throw mcrl2::runtime_error(std::string("Could not create a socket to a worker: ") + std::strerror(errno));
+        }
+        m_control_sockets[i] = fds[0];
+        worker_control_sockets[i] = fds[1];
+      }
+
+      const std::filesystem::path directory = std::filesystem::temp_directory_path() / ("mcrl2-distributed-" + std::to_string(getpid()));
+      std::filesystem::create_directories(directory);
+      std::vector<std::string> filenames;
+      for (std::size_t i = 0; i < n; ++i)
+      {
+        filenames.push_back((directory / ("worker" + std::to_string(i))).string());
+      }
+
+      mCRL2log(log::verbose) << "Generating the state space with " << n << " worker processes." << std::endl;
+      std::cout.flush();
+      std::cerr.flush();
+
+      std::vector<pid_t> workers;
+      for (std::size_t i = 0; i < n; ++i)
+      {
+        pid_t pid = fork();
+        if (pid == -1)
+        {
+          throw mcrl2::runtime_error(std::string("Could not start a worker process: ") + std::strerror(errno));
+        }
+        if (pid == 0)
+        {
+          // The worker does not return from this block. It uses _exit, such that the resources of the
+          // parent process, such as the compiled rewriter, are not cleaned up by the worker.
+          int status = 0;
+          try
+          {
+            std::vector<std::unique_ptr<detail::message_channel>> channels(n);
+            for (std::size_t j = 0; j < n; ++j)
+            {
+              for (std::size_t k = 0; k < n; ++k)
+              {
+                if (j != i && k != j && sockets[j][k] != -1)
+                {
+                  close(sockets[j][k]);
+                }
+              }
+              if (j != i)
+              {
+                channels[j] = std::make_unique<detail::message_channel>(sockets[i][j]);
+                close(worker_control_sockets[j]);
+              }
+            }
+            close_control_sockets();
+            auto parent = std::make_unique<detail::message_channel>(worker_control_sockets[i]);
+            detail::distributed_worker<Timed, Specification> worker(m_explorer, i, n, std::move(channels), std::move(parent), m_must_abort);
+            worker.run(initial_state);
+            worker.save(filenames[i], write_lts);
+          }
+          catch (const std::exception& e)
+          {
+            mCRL2log(log::error) << "Worker " << i << ": " << e.what() << std::endl;
+            status = 1;
+          }
+          std::cout.flush();
+          std::cerr.flush();
+          _exit(status);
+        }
+        workers.push_back(pid);
+      }
+
+      for (const std::vector<int>& row: sockets)
+      {
+        for (int fd: row)
+        {
+          if (fd != -1)
+          {
+            close(fd);
+          }
+        }
+      }
+      for (int fd: worker_control_sockets)
+      {
+        close(fd);
+      }
+
+      bool success = true;
+      for (pid_t pid: workers)
+      {
+        int status;
+        while (waitpid(pid, &status, 0) == -1)
+        {
+          if (errno != EINTR)
+          {
+            throw mcrl2::runtime_error(std::string("Could not wait for a worker process: ") + std::strerror(errno));
+          }
+        }
+        success = success && WIFEXITED(status) && WEXITSTATUS(status) == 0;
+      }
+      close_control_sockets();
+
+      if (success)
+      {
+        std::vector<std::size_t> order;
+        order.push_back(detail::structural_hash(initial_state) % n);
+        for (std::size_t i = 0; i < n; ++i)
+        {
+          if (i != order.front())
+          {
+            order.push_back(i);
+          }
+        }
+        merge(filenames, order, builder, write_lts);
+      }
+      std::filesystem::remove_all(directory);
+
+      if (!success)
+      {
+        throw mcrl2::runtime_error("Distributed state space generation failed.");
+      }
+      return true;
+#endif
+    }
+};
+
+} // namespace mcrl2::lts
+
+#endif // MCRL2_LTS_DISTRIBUTED_STATE_SPACE_GENERATOR_H
@@ -0,0 +1,404 @@
+// Author(s): agent
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/lts/incremental_state_space_generator.h
+/// \brief State space generation that reuses the state space of a previous version of a specification.
+/// \details The summands and data equations of the previous and the current specification are
+///          compared. A function symbol is changed if its equations differ, or if its equations
+///          use a changed function symbol. A summand is changed if it has no identical counterpart
+///          in the other specification, or if it uses a changed function symbol. The outgoing
+///          transitions of a state of the previous state space are reused if the state contains
+///          no changed function symbol and none of the changed summands of the previous
+///          specification is enabled in it. In that case only the changed summands of the current
+///          specification are explored. All other states are explored completely.
+///
+///          The previous state space must be the complete, unreduced output of lps2lts for the
+///          previous specification, saved in .lts format with state labels.
+
+#ifndef MCRL2_LTS_INCREMENTAL_STATE_SPACE_GENERATOR_H
+#define MCRL2_LTS_INCREMENTAL_STATE_SPACE_GENERATOR_H
+
+#include <atomic>
+#include <map>
+#include <tuple>
+
+#include "mcrl2/data/find.h"
+#include "mcrl2/lps/explorer.h"
+#include "mcrl2/lps/find.h"
+#include "mcrl2/lts/lts_builder.h"
+#include "mcrl2/lts/lts_lts.h"
+
+namespace mcrl2::lts
+{
+
+namespace detail
+{
+
+/// \brief The difference between the summands of two linear process specifications.
+struct summand_difference
+{
+  /// \brief If false, the specifications are too different to reuse anything.
+  bool comparable = true;
+
+  /// \brief The reason why the specifications are not comparable.
+  std::string reason;
+
+  /// \brief Indices of the action summands of the previous specification that are changed.
+  std::vector<std::size_t> removed;
+
+  /// \brief Indices of the action summands of the current specification that are changed.
+  std::vector<std::size_t> added;
+
+  /// \brief Function symbols whose rewrite rules differ between the two specifications.
+  std::set<data::function_symbol> changed_function_symbols;
+};
+
+/// \brief Returns the function symbol at the head of the left hand side of an equation, or an
+/// undefined function symbol if there is none.
+inline data::function_symbol equation_head(const data::data_equation& eq)
+{
+  data::data_expression head = eq.lhs();
+  while (data::is_application(head))
+  {
+    head = atermpp::down_cast<data::application>(head).head();
+  }
+  return data::is_function_symbol(head) ? atermpp::down_cast<data::function_symbol>(head) : data::function_symbol();
+}
+
+/// \brief Computes the function symbols of which the rewrite rules differ in the data specifications.
+/// \details The result is closed under dependency: a function symbol with an equation that contains
+/// a changed function symbol is changed as well.
+inline std::set<data::function_symbol> changed_function_symbols(const data::data_specification& dataspec1,
+                                                                const data::data_specification& dataspec2)
+{
+  std::set<data::function_symbol> result;
+  const std::set<data::data_equation>& equations1 = dataspec1.equations();
+  const std::set<data::data_equation>& equations2 = dataspec2.equations();
+  std::vector<data::data_equation> difference;
+  std::set_symmetric_difference(equations1.begin(), equations1.end(), equations2.begin(), equations2.end(),
+                                std::back_inserter(difference));
+  for (const data::data_equation& eq: difference)
+  {
+    result.insert(equation_head(eq));
+  }
+  if (result.empty())
+  {
+    return result;
+  }
+
+  std::vector<std::pair<data::function_symbol, std::set<data::function_symbol>>> dependencies;
+  for (const std::set<data::data_equation>* equations: {&equations1, &equations2})
+  {
+    for (const data::data_equation& eq: *equations)
+    {
+      dependencies.emplace_back(equation_head(eq), data::find_function_symbols(eq));
+    }
+  }
+  bool stable = false;
+  while (!stable)
+  {
+    stable = true;
+    for (const auto& [head, symbols]: dependencies)
+    {
+      if (!result.contains(head) &&
+          std::any_of(symbols.begin(), symbols.end(), [&](const data::function_symbol& f) { return result.contains(f); }))
+      {
+        result.insert(head);
+        stable = false;
+      }
+    }
+  }
+  return result;
+}
+
+/// \brief Returns true if the expressions in x contain a function symbol in symbols.
+template <typename T>
+bool contains_function_symbol(const T& x, const std::set<data::function_symbol>& symbols)
+{
+  if (symbols.empty())
+  {
+    return false;
+  }
+  std::set<data::function_symbol> occurring = lps::find_function_symbols(x);
+  return std::any_of(occurring.begin(), occurring.end(), [&](const data::function_symbol& f) { return symbols.contains(f); });
+}
+
+/// \brief Computes which action summands of the previous specification old_lpsspec are removed, and
+/// which action summands of the current specification lpsspec are added.
+/// \details Summands are compared syntactically, as a multiset. A summand that uses a function
+/// symbol whose rewrite rules changed is both removed and added.
+inline summand_difference compare_summands(const lps::specification& old_lpsspec, const lps::specification& lpsspec)
+{
+  summand_difference result;
+  const data::data_specification& old_dataspec = old_lpsspec.data();
+  const data::data_specification& dataspec = lpsspec.data();
+
+  // Sorts that only occur in the current specification may be added, but the constructors of the
+  // sorts of the previous specification must be the same, as they determine the enumerated values.
+  std::map<data::sort_expression, std::set<data::function_symbol>> constructors;
+  for (const data::function_symbol& f: dataspec.constructors())
+  {
+    constructors[f.sort().target_sort()].insert(f);
+  }
+  std::map<data::sort_expression, std::set<data::function_symbol>> old_constructors;
+  for (const data::function_symbol& f: old_dataspec.constructors())
+  {
+    old_constructors[f.sort().target_sort()].insert(f);
+  }
+  for (const auto& [sort, functions]: old_constructors)
+  {
+    if (constructors[sort] != functions)
+    {
+      result.comparable = false;
+      result.reason = "the constructors of sort " + data::pp(sort) + " are different";
+      return result;
+    }
+  }
+  const data::variable_list& process_parameters = lpsspec.process().process_parameters();
+  if (old_lpsspec.process().process_parameters() != process_parameters)
+  {
+    result.comparable = false;
+    result.reason = "the process parameters are different";
+    return result;
+  }
+
+  result.changed_function_symbols = changed_function_symbols(old_dataspec, dataspec);
+
+  using summand_key = std::tuple<data::variable_list, data::data_expression, process::action_list, data::data_expression, data::data_expression_list>;
+  auto key = [&](const lps::action_summand& summand)
+  {
+    return summand_key(summand.summation_variables(),
+                       summand.condition(),
+                       summand.multi_action().actions(),
+                       summand.multi_action().time(),
+                       summand.next_state(process_parameters));
+  };
+
+  std::map<summand_key, std::vector<std::size_t>> old_summands;
+  const lps::action_summand_vector& old_action_summands = old_lpsspec.process().action_summands();
+  for (std::size_t i = old_action_summands.size(); i-- > 0; )
+  {
+    if (contains_function_symbol(old_action_summands[i], result.changed_function_symbols))
+    {
+      result.removed.push_back(i);
+    }
+    else
+    {
+      old_summands[key(old_action_summands[i])].push_back(i);
+    }
+  }
+
+  const lps::action_summand_vector& action_summands = lpsspec.process().action_summands();
+  for (std::size_t i = 0; i < action_summands.size(); ++i)
+  {
+    auto j = old_summands.end();
+    if (!contains_function_symbol(action_summands[i], result.changed_function_symbols))
+    {
+      j = old_summands.find(key(action_summands[i]));
+    }
+    if (j == old_summands.end() || j->second.empty())
+    {
+      result.added.push_back(i);
+    }
+    else
+    {
+      j->second.pop_back();
+    }
+  }
+
+  for (const auto& [_, indices]: old_summands)
+  {
+    result.removed.insert(result.removed.end(), indices.begin(), indices.end());
+  }
+  std::sort(result.removed.begin(), result.removed.end());
+  return result;
+}
+
+} // namespace detail
+
+/// \brief Generates the state space of a specification, reusing the state space of a previous version of it.
+/// \details Only untimed, non stochastic specifications without confluence reduction are supported.
+/// Both explorers must be single threaded.
+class incremental_state_space_generator: public lps::abortable
+{
+  public:
+    using explorer_type = lps::explorer<false, false, lps::specification>;
+
+  protected:
+    explorer_type& m_old_explorer;
+    explorer_type& m_explorer;
+    detail::summand_difference m_difference;
+    std::atomic<bool> m_must_abort = false;
+
+  public:
+    /// \brief Constructor.
+    /// \param old_lpsspec The previous specification.
+    /// \param lpsspec The current specification.
+    /// \param old_explorer An explorer for the previous specification.
+    /// \param explorer An explorer for the current specification.
+    incremental_state_space_generator(const lps::specification& old_lpsspec,
+                                      const lps::specification& lpsspec,
+                                      explorer_type& old_explorer,
+                                      explorer_type& explorer)
+      : m_old_explorer(old_explorer),
+        m_explorer(explorer),
+        m_difference(detail::compare_summands(old_lpsspec, lpsspec))
+    {
+      // The transitions of a changed summand are generated per summand, which is not possible for a
+      // confluent summand. Moreover, confluent summands determine the representatives of all states.
+      auto is_changed = [](const std::vector<lps::explorer_summand>& summands, const std::vector<std::size_t>& changed)
+      {
+        return std::any_of(summands.begin(), summands.end(), [&](const lps::explorer_summand& summand)
+          {
+            return std::find(changed.begin(), changed.end(), summand.index) != changed.end();
+          });
+      };
+      if (m_difference.comparable &&
+          (is_changed(m_old_explorer.confluent_summands(), m_difference.removed) ||
+           is_changed(m_explorer.confluent_summands(), m_difference.added)))
+      {
+        m_difference.comparable = false;
+        m_difference.reason = "a confluent summand, with action " + m_explorer.options().confluence_action + ", is changed";
+      }
+    }
+
+    void abort() override
+    {
+      m_must_abort = true;
+    }
+
+    /// \brief The difference between the previous and the current specification.
+    const detail::summand_difference& difference() const
+    {
+      return m_difference;
+    }
+
+    /// \brief Generate the state space and add it to the builder.
+    /// \param old_lts The state space of the previous specification.
+    bool explore(const lts_lts_t& old_lts, lts_builder& builder)
+    {
+      bool reuse = m_difference.comparable;
+      if (!reuse)
+      {
+        mCRL2log(log::warning) << "The previous state space cannot be reused, because " << m_difference.reason << "." << std::endl;
+      }
+      else if (!old_lts.has_state_info() || old_lts.num_state_labels() != old_lts.num_states())
+      {
+        throw mcrl2::runtime_error("The previous state space does not contain state labels.");
+      }
+      else
+      {
+        mCRL2log(log::verbose) << m_difference.removed.size() << " summand" << (m_difference.removed.size() == 1 ? " is" : "s are")
+                               << " removed and " << m_difference.added.size() << " summand" << (m_difference.added.size() == 1 ? " is" : "s are")
+                               << " added; " << m_difference.changed_function_symbols.size() << " function symbol"
+                               << (m_difference.changed_function_symbols.size() == 1 ? " has" : "s have") << " different rewrite rules." << std::endl;
+      }
+
+      // Index the states of the previous state space, and store its transitions per source state.
+      atermpp::indexed_set<lps::state> old_states;
+      std::vector<lps::multi_action> old_actions;
+      std::vector<std::size_t> old_offsets;
+      std::vector<std::pair<std::size_t, std::size_t>> old_transitions;
+      if (reuse)
+      {
+        for (std::size_t i = 0; i < old_lts.num_states(); ++i)
+        {
+          const state_label_lts& label = old_lts.state_label(i);
+          if (label.size() != 1)
+          {
+            throw mcrl2::runtime_error("State " + std::to_string(i) + " of the previous state space does not have a single state vector as label.");
+          }
+          if (!old_states.insert(label.front()).second)
+          {
+            throw mcrl2::runtime_error("The state vector of state " + std::to_string(i) + " of the previous state space occurs more than once.");
+          }
+        }
+        for (std::size_t i = 0; i < old_lts.num_action_labels(); ++i)
+        {
+          old_actions.emplace_back(old_lts.action_label(i));
+        }
+        old_offsets.resize(old_lts.num_states() + 1, 0);
+        for (const transition& t: old_lts.get_transitions())
+        {
+          old_offsets[t.from() + 1]++;
+        }
+        for (std::size_t i = 0; i < old_lts.num_states(); ++i)
+        {
+          old_offsets[i + 1] += old_offsets[i];
+        }
+        old_transitions.resize(old_lts.num_transitions());
+        std::vector<std::size_t> position(old_offsets.begin(), old_offsets.end() - 1);
+        for (const transition& t: old_lts.get_transitions())
+        {
+          old_transitions[position[t.from()]++] = std::make_pair(t.label(), t.to());
+        }
+      }
+
+      lts_builder::indexed_set_for_states_type state_map;
+      std::size_t number_of_transitions = 0;
+      std::size_t reused_states = 0;
+      auto add_transition = [&](std::size_t from, const lps::multi_action& a, const lps::state& to)
+      {
+        builder.add_transition(from, a, state_map.insert(to).first);
+        number_of_transitions++;
+      };
+
+      lps::state s0;
+      m_explorer.compute_initial_state(s0);
+      state_map.insert(s0);
+      for (std::size_t i = 0; i < state_map.size(); ++i)
+      {
+        if (m_must_abort)
+        {
+          mCRL2log(log::verbose) << "State space generation was aborted." << std::endl;
+          break;
+        }
+        const lps::state s = state_map[i];
+        std::size_t k = reuse ? old_states.index(s) : atermpp::indexed_set<lps::state>::npos;
+        bool reuse_state = k != atermpp::indexed_set<lps::state>::npos &&
+                           !detail::contains_function_symbol(data::data_expression_list(s.begin(), s.end()), m_difference.changed_function_symbols) &&
+                           std::none_of(m_difference.removed.begin(), m_difference.removed.end(),
+                                        [&](std::size_t j) { return !m_old_explorer.generate_transitions(s, j).empty(); });
+        if (reuse_state)
+        {
+          reused_states++;
+          for (std::size_t j = old_offsets[k]; j < old_offsets[k + 1]; ++j)
+          {
+            add_transition(i, old_actions[old_transitions[j].first], old_states[old_transitions[j].second]);
+          }
+          for (std::size_t j: m_difference.added)
+          {
+            for (const auto& [a, t]: m_explorer.generate_transitions(s, j))
+            {
+              add_transition(i, a, t);
+            }
+          }
+        }
+        else
+        {
+          for (const auto& [a, t]: m_explorer.generate_transitions(s))
+          {
+            add_transition(i, a, t);
+          }
+        }
+      }
+
+      mCRL2log(log::verbose) << "Done with state space generation ("
+                             << state_map.size() << " state" << ((state_map.size() == 1)?"":"s")
+                             << " and " << number_of_transitions << " transition" << ((number_of_transitions == 1)?"":"s")
+                             << "); the transitions of " << reused_states << " state" << ((reused_states == 1)?" were":"s were")
+                             << " reused and " << state_map.size() - reused_states << " state"
+                             << ((state_map.size() - reused_states == 1)?" was":"s were") << " explored." << std::endl;
+      builder.finalize(state_map, false);
+      return !m_must_abort;
+    }
+};
+
+} // namespace mcrl2::lts
+
+#endif // MCRL2_LTS_INCREMENTAL_STATE_SPACE_GENERATOR_H
@@ -44,9 +44,10 @@ namespace mcrl2::lts
  * \param[in] l A labelled transition system that must be reduced.
  * \param[in] eq The equivalence with respect to which the LTS will be
  *            reduced.
+ * \param[in] number_of_threads The number of threads that the reduction may use.
  **/
 template <class LTS_TYPE>
-void reduce(LTS_TYPE& l, lts_equivalence eq);
+void reduce(LTS_TYPE& l, lts_equivalence eq, std::size_t number_of_threads = 1);
 
 /** \brief Checks whether this LTS is equivalent to another LTS.
  * \param[in] l1 The first LTS that will be compared.
@@ -55,6 +56,7 @@ void reduce(LTS_TYPE& l, lts_equivalence eq);
  *            compared.
  * \param[in] generate_counter_examples Whether to generate a counter example
  * \param[in] counter_example_file The file to store the counter example in
+ * \param[in] number_of_threads The number of threads that the comparison may use.
  * \retval true if the LTSs are found to be equivalent.
  * \retval false otherwise.
  * \warning This function alters the internal data structure of
@@ -68,7 +70,8 @@ bool destructive_compare(LTS_TYPE& l1,
                          const lts_equivalence eq,
                          const bool generate_counter_examples = false,
                          const std::string& counter_example_file = std::string(),
-                         const bool structured_output = false)
+                         const bool structured_output = false,
+                         const std::size_t number_of_threads = 1)
 {
   // Merge this LTS and l and store the result in this LTS.
   // In the resulting LTS, the initial state i of l will have the
@@ -172,7 +175,7 @@ bool destructive_compare(LTS_TYPE& l1,
       {
         mCRL2log(log::warning) << "Cannot generate counter examples for weak bisimulation\n";
       }
-      return detail::destructive_weak_bisimulation_compare(l1,l2,false);
+      return detail::destructive_weak_bisimulation_compare(l1,l2,false,number_of_threads);
     }
     case lts_eq_divergence_preserving_weak_bisim:
     {
@@ -180,7 +183,7 @@ bool destructive_compare(LTS_TYPE& l1,
       {
         mCRL2log(log::warning) << "Cannot generate counter examples for divergence-preserving weak bisimulation\n";
       }
-      return detail::destructive_weak_bisimulation_compare(l1,l2, true);
+      return detail::destructive_weak_bisimulation_compare(l1,l2, true,number_of_threads);
     }
     case lts_eq_sim:
     {
@@ -192,7 +195,7 @@ bool destructive_compare(LTS_TYPE& l1,
       std::size_t init_l2 = l2.initial_state() + l1.num_states();
       detail::merge(l1,l2);
       l2.clear(); // l2 is not needed anymore.
-      detail::sim_partitioner<LTS_TYPE> sp(l1);
+      detail::sim_partitioner<LTS_TYPE> sp(l1, number_of_threads);
       sp.partitioning_algorithm();
 
       return sp.in_same_class(l1.initial_state(),init_l2);
@@ -207,7 +210,7 @@ bool destructive_compare(LTS_TYPE& l1,
       std::size_t init_l2 = l2.initial_state() + l1.num_states();
       detail::merge(l1,l2);
       l2.clear(); // l2 is not needed anymore.
-      detail::ready_sim_partitioner<LTS_TYPE> rsp(l1);
+      detail::ready_sim_partitioner<LTS_TYPE> rsp(l1, number_of_threads);
       rsp.partitioning_algorithm();
 
       return rsp.in_same_class(l1.initial_state(),init_l2);
@@ -234,11 +237,11 @@ bool destructive_compare(LTS_TYPE& l1,
       if (generate_counter_examples)
       {
         detail::bisimulation_reduce_gj(l1,true,false); // Branching bisimulation reduction.
-        detail::tau_star_reduce(l1);
+        detail::tau_star_reduce(l1, number_of_threads);
         detail::bisimulation_reduce_gj(l1,false);
         determinise(l1); 
         detail::bisimulation_reduce_gj(l2,true,false);
-        detail::tau_star_reduce(l2);
+        detail::tau_star_reduce(l2, number_of_threads);
         detail::bisimulation_reduce_gj(l2,false);
         determinise(l2);
         return detail::destructive_branching_bisimulation_compare_minimal_depth(l1, l2, counter_example_file);
@@ -246,13 +249,13 @@ bool destructive_compare(LTS_TYPE& l1,
 
       // Eliminate silent steps and determinise first LTS
       detail::bisimulation_reduce_gj(l1,true,false);
-      detail::tau_star_reduce(l1);
+      detail::tau_star_reduce(l1, number_of_threads);
       detail::bisimulation_reduce_gj(l1,false);
       determinise(l1);
 
       // Eliminate silent steps and determinise second LTS
       detail::bisimulation_reduce_gj(l2,true,false);
-      detail::tau_star_reduce(l2);
+      detail::tau_star_reduce(l2, number_of_threads);
       detail::bisimulation_reduce_gj(l2,false);
       determinise(l2);
 
@@ -279,6 +282,7 @@ bool destructive_compare(LTS_TYPE& l1,
  *            compared.
  * \param[in] generate_counter_examples Whether to generate a counter example
  * \param[in] counter_example_file The file to store the counter example in
+ * \param[in] number_of_threads The number of threads that the comparison may use.
  * \retval true if the LTSs are found to be equivalent.
  * \retval false otherwise.
  */
@@ -288,7 +292,8 @@ bool compare(const LTS_TYPE& l1,
   lts_equivalence eq,
   bool generate_counter_examples = false,
   const std::string& counter_example_file = "",
-  bool structured_output = false);
+  bool structured_output = false,
+  std::size_t number_of_threads = 1);
 
 /** \brief Checks whether this LTS is smaller than another LTS according
  * to a preorder.
@@ -301,6 +306,7 @@ bool compare(const LTS_TYPE& l1,
  * \param[in] strategy Choose breadth-first or depth-first for exploration strategy
  *            of the antichain algorithms.
  * \param[in] preprocess Whether to allow preprocessing of the given LTSs.
+ * \param[in] number_of_threads The number of threads that the comparison may use.
  * \retval true if LTS \a l1 is smaller than LTS \a l2 according to
  * preorder \a pre.
  * \retval false otherwise.
@@ -319,7 +325,8 @@ bool destructive_compare(LTS_TYPE& l1,
   const std::string& counter_example_file = "",
   bool structured_output = false,
   lps::exploration_strategy strategy = lps::es_breadth,
-  bool preprocess = true);
+  bool preprocess = true,
+  std::size_t number_of_threads = 1);
 
 /** \brief Checks whether this LTS is smaller than another LTS according
  * to a preorder.
@@ -331,6 +338,7 @@ bool destructive_compare(LTS_TYPE& l1,
  * \param[in] strategy Choose breadth-first or depth-first for exploration strategy
  *            of the antichain algorithms.
  * \param[in] preprocess Whether to allow preprocessing of the given LTSs.
+ * \param[in] number_of_threads The number of threads that the comparison may use.
  * \retval true if this LTS is smaller than LTS \a l according to
  * preorder \a pre.
  * \retval false otherwise.
@@ -343,7 +351,8 @@ bool compare(const LTS_TYPE& l1,
   const std::string& counter_example_file = "",
   bool structured_output = false,
   lps::exploration_strategy strategy = lps::es_breadth,
-  bool preprocess = true);
+  bool preprocess = true,
+  std::size_t number_of_threads = 1);
 
 /** \brief Determinises this LTS. */
 template <class LTS_TYPE>
@@ -647,7 +656,7 @@ void merge(LTS_TYPE& l1, const LTS_TYPE& l2)
 
 
 template <class LTS_TYPE>
-void reduce(LTS_TYPE& l,lts_equivalence eq)
+void reduce(LTS_TYPE& l, lts_equivalence eq, const std::size_t number_of_threads)
 {
 
   switch (eq)
@@ -764,7 +773,7 @@ void reduce(LTS_TYPE& l,lts_equivalence eq)
     }
     case lts_eq_weak_bisim:
     {
-      detail::weak_bisimulation_reduce(l,false);
+      detail::weak_bisimulation_reduce(l,false,number_of_threads);
       return;
     }
     /*
@@ -785,13 +794,13 @@ void reduce(LTS_TYPE& l,lts_equivalence eq)
     */
     case lts_eq_divergence_preserving_weak_bisim:
     {
-      detail::weak_bisimulation_reduce(l,true);
+      detail::weak_bisimulation_reduce(l,true,number_of_threads);
       return;
     }
     case lts_eq_sim:
     {
       // Run the partitioning algorithm on this LTS
-      detail::sim_partitioner<LTS_TYPE> sp(l);
+      detail::sim_partitioner<LTS_TYPE> sp(l, number_of_threads);
       sp.partitioning_algorithm();
 
       // Clear this LTS, but keep the labels
@@ -818,7 +827,7 @@ void reduce(LTS_TYPE& l,lts_equivalence eq)
     case lts_eq_ready_sim:
     {
       // Run the partitioning algorithm on this LTS
-      detail::ready_sim_partitioner<LTS_TYPE> rsp(l);
+      detail::ready_sim_partitioner<LTS_TYPE> rsp(l, number_of_threads);
       rsp.partitioning_algorithm();
 
       // Clear this LTS, but keep the labels
@@ -850,7 +859,7 @@ void reduce(LTS_TYPE& l,lts_equivalence eq)
     case lts_eq_weak_trace:
     {
       detail::bisimulation_reduce_gj(l,true,false);
-      detail::tau_star_reduce(l);
+      detail::tau_star_reduce(l, number_of_threads);
       detail::bisimulation_reduce_gj(l,false);
       determinise(l);
       detail::bisimulation_reduce_gj(l,false);
@@ -859,7 +868,7 @@ void reduce(LTS_TYPE& l,lts_equivalence eq)
     case lts_red_tau_star:
     {
       detail::bisimulation_reduce_gj(l,true,false);
-      detail::tau_star_reduce(l);
+      detail::tau_star_reduce(l, number_of_threads);
       detail::bisimulation_reduce_gj(l,false);
       return;
     }
@@ -879,7 +888,7 @@ void reduce(LTS_TYPE& l,lts_equivalence eq)
 }
 
 template <class LTS_TYPE>
-bool compare(const LTS_TYPE& l1, const LTS_TYPE& l2, const lts_equivalence eq, const bool generate_counter_examples, const std::string& counter_example_file, const bool structured_output)
+bool compare(const LTS_TYPE& l1, const LTS_TYPE& l2, const lts_equivalence eq, const bool generate_counter_examples, const std::string& counter_example_file, const bool structured_output, const std::size_t number_of_threads)
 {
   switch (eq)
   {
@@ -888,21 +897,21 @@ bool compare(const LTS_TYPE& l1, const LTS_TYPE& l2, const lts_equivalence eq, c
     default:
       LTS_TYPE l1_copy(l1);
       LTS_TYPE l2_copy(l2);
-      return destructive_compare(l1_copy, l2_copy, eq ,generate_counter_examples, counter_example_file, structured_output);
+      return destructive_compare(l1_copy, l2_copy, eq ,generate_counter_examples, counter_example_file, structured_output, number_of_threads);
   }
   return false;
 }
 
 template <class LTS_TYPE>
-bool compare(const LTS_TYPE& l1, const LTS_TYPE& l2, const lts_preorder pre, const bool generate_counter_example, const std::string& counter_example_file, const bool structured_output, const lps::exploration_strategy strategy, const bool preprocess)
+bool compare(const LTS_TYPE& l1, const LTS_TYPE& l2, const lts_preorder pre, const bool generate_counter_example, const std::string& counter_example_file, const bool structured_output, const lps::exploration_strategy strategy, const bool preprocess, const std::size_t number_of_threads)
 {
   LTS_TYPE l1_copy(l1);
   LTS_TYPE l2_copy(l2);
-  return destructive_compare(l1_copy, l2_copy, pre, generate_counter_example, counter_example_file, structured_output, strategy, preprocess);
+  return destructive_compare(l1_copy, l2_copy, pre, generate_counter_example, counter_example_file, structured_output, strategy, preprocess, number_of_threads);
 }
 
 template <class LTS_TYPE>
-bool destructive_compare(LTS_TYPE& l1, LTS_TYPE& l2, const lts_preorder pre, const bool generate_counter_example, const std::string& counter_example_file, const bool structured_output, const lps::exploration_strategy strategy, const bool preprocess)
+bool destructive_compare(LTS_TYPE& l1, LTS_TYPE& l2, const lts_preorder pre, const bool generate_counter_example, const std::string& counter_example_file, const bool structured_output, const lps::exploration_strategy strategy, const bool preprocess, const std::size_t number_of_threads)
 {
   switch (pre)
   {
@@ -919,7 +928,7 @@ bool destructive_compare(LTS_TYPE& l1, LTS_TYPE& l2, const lts_preorder pre, con
       l2.clear();
 
       // Run the partitioning algorithm on this merged LTS
-      detail::sim_partitioner<LTS_TYPE> sp(l1);
+      detail::sim_partitioner<LTS_TYPE> sp(l1, number_of_threads);
       sp.partitioning_algorithm();
 
       return sp.in_preorder(l1.initial_state(),init_l2);
@@ -937,7 +946,7 @@ bool destructive_compare(LTS_TYPE& l1, LTS_TYPE& l2, const lts_preorder pre, con
       l2.clear();
 
       // Run the partitioning algorithm on this prepropcessed LTS
-      detail::ready_sim_partitioner<LTS_TYPE> rsp(l1);
+      detail::ready_sim_partitioner<LTS_TYPE> rsp(l1, number_of_threads);
       rsp.partitioning_algorithm();
 
       return rsp.in_preorder(l1.initial_state(),init_l2);
@@ -961,20 +970,20 @@ bool destructive_compare(LTS_TYPE& l1, LTS_TYPE& l2, const lts_preorder pre, con
       detail::bisimulation_reduce_gj(l2,false);
 
       // Trace preorder now corresponds to simulation preorder
-      return destructive_compare(l1, l2, lts_preorder::lts_pre_sim, generate_counter_example, counter_example_file, structured_output, strategy);
+      return destructive_compare(l1, l2, lts_preorder::lts_pre_sim, generate_counter_example, counter_example_file, structured_output, strategy, preprocess, number_of_threads);
     }
     case lts_preorder::lts_pre_weak_trace:
     {
       // Eliminate silent steps of first LTS
       detail::bisimulation_reduce_gj(l1,true,false);
-      detail::tau_star_reduce(l1);
+      detail::tau_star_reduce(l1, number_of_threads);
 
       // Eliminate silent steps of second LTS
       detail::bisimulation_reduce_gj(l2,true,false);
-      detail::tau_star_reduce(l2);
+      detail::tau_star_reduce(l2, number_of_threads);
 
       // Weak trace preorder now corresponds to strong trace preorder
-      return destructive_compare(l1, l2, lts_preorder::lts_pre_trace, generate_counter_example, counter_example_file, structured_output, strategy);
+      return destructive_compare(l1, l2, lts_preorder::lts_pre_trace, generate_counter_example, counter_example_file, structured_output, strategy, preprocess, number_of_threads);
     }
     case lts_preorder::lts_pre_trace_anti_chain:
     {
@@ -189,6 +189,7 @@ class lts_lts_builder: public lts_builder
   protected:
     lts_lts_t m_lts;
     bool m_discard_state_labels = false;
+    bool m_compress = false;
     std::mutex m_exclusive_transition_access;
 
   public:
@@ -196,9 +197,11 @@ class lts_lts_builder: public lts_builder
       const data::data_specification& dataspec,
       const process::action_label_list& action_labels,
       const data::variable_list& process_parameters,
-      bool discard_state_labels = false
+      bool discard_state_labels = false,
+      bool compress = false
     )
-     : m_discard_state_labels(discard_state_labels)
+     : m_discard_state_labels(discard_state_labels),
+       m_compress(compress)
     {
       m_lts.set_data(dataspec);
       m_lts.set_process_parameters(process_parameters);
@@ -254,7 +257,7 @@ class lts_lts_builder: public lts_builder
 
     void save(const std::string& filename) override
     {
-      m_lts.save(filename);
+      m_lts.save(filename, m_compress);
     }
 };
 
@@ -272,7 +275,8 @@ class lts_lts_disk_builder: public lts_builder
       const data::data_specification& dataspec,
       const process::action_label_list& action_labels,
       const data::variable_list& process_parameters,
-      bool discard_state_labels = false
+      bool discard_state_labels = false,
+      bool compress = false
     )
      : m_discard_state_labels(discard_state_labels)
     {
@@ -287,7 +291,7 @@ class lts_lts_disk_builder: public lts_builder
 
         mCRL2log(log::verbose) << "writing state space in LTS format to '" << filename << "'." << std::endl;
       }
-      stream = std::make_unique<atermpp::binary_aterm_ostream>(to_stdout ? std::cout : fstream);
+      stream = std::make_unique<atermpp::binary_aterm_ostream>(to_stdout ? std::cout : fstream, compress);
 
       mcrl2::lts::write_lts_header(*stream, dataspec, process_parameters, action_labels);
     }
@@ -388,11 +392,11 @@ std::unique_ptr<lts_builder> create_lts_builder(const lps::specification& lpsspe
     {
       if (options.save_at_end)
       {
-        return std::make_unique<lts_lts_builder>(lpsspec.data(), lpsspec.action_labels(), lpsspec.process().process_parameters(), options.discard_lts_state_labels);
+        return std::make_unique<lts_lts_builder>(lpsspec.data(), lpsspec.action_labels(), lpsspec.process().process_parameters(), options.discard_lts_state_labels, options.compress_lts);
       }
       else
       {
-        return std::make_unique<lts_lts_disk_builder>(output_filename, lpsspec.data(), lpsspec.action_labels(), lpsspec.process().process_parameters(), options.discard_lts_state_labels);
+        return std::make_unique<lts_lts_disk_builder>(output_filename, lpsspec.data(), lpsspec.action_labels(), lpsspec.process().process_parameters(), options.discard_lts_state_labels, options.compress_lts);
       }
     }
     default: return std::make_unique<lts_none_builder>();
@@ -381,8 +381,9 @@ class lts_lts_t : public lts< state_label_lts, action_label_lts, detail::lts_lts
     /** \brief Save the labelled transition system to file.
      *  \details If the filename is empty, the result is read from stdin.
      *  \param[in] filename Name of the file from which this lts is read.
+     *  \param[in] compress Whether the lts is compressed, which only applies to the .lts format.
      */
-    void save(const std::string& filename) const;
+    void save(const std::string& filename, bool compress = false) const;
 };
 
 /** \brief This class contains probabilistic labelled transition systems in .lts format.
@@ -409,8 +410,9 @@ class probabilistic_lts_lts_t :
     /** \brief Save the labelled transition system to file.
      *  \details If the filename is empty, the result is read from stdin.
      *  \param[in] filename Name of the file from which this lts is read.
+     *  \param[in] compress Whether the lts is compressed, which only applies to the .lts format.
      */
-    void save(const std::string& filename) const;
+    void save(const std::string& filename, bool compress = false) const;
 };
 } // namespace mcrl2::lts
 
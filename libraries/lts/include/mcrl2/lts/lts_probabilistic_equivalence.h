@@ -30,13 +30,15 @@ enum lts_probabilistic_equivalence
 {
   lts_probabilistic_eq_none,             /**< Unknown or no equivalence */
   lts_probabilistic_bisim_bem,          /**< Probabilistic bisimulation equivalence using the O(mn (log n + log m)) algorithm [Bier] */
-  lts_probabilistic_bisim_grv           /**< Probabilistic bisimulation equivalence using the O(m(log n)) algorithm by Groote, Rivera Verduzco and de Vink */
+  lts_probabilistic_bisim_grv,          /**< Probabilistic bisimulation equivalence using the O(m(log n)) algorithm by Groote, Rivera Verduzco and de Vink */
+  lts_probabilistic_bisim_sig           /**< Probabilistic bisimulation equivalence using parallel signature refinement */
 };
 
 /** \brief Determines the equivalence from a string.
  * \details The following strings may be used:
  * \li "none" for identity equivalence;
  * \li "pbisim" for Probabilistic bisimulation equivalence using the O(mn (log n + log m)) algorithm [Bier];
+ * \li "pbisim-sig" for Probabilistic bisimulation equivalence using parallel signature refinement;
  *
  * \param[in] s The string specifying the equivalence.
  * \return The equivalence type specified by \a s.
@@ -56,6 +58,10 @@ lts_probabilistic_equivalence parse_probabilistic_equivalence(const std::string&
   {
 	  return lts_probabilistic_bisim_grv;
   }
+  else if (s == "pbisim-sig")
+  {
+    return lts_probabilistic_bisim_sig;
+  }
   else
   {
     throw mcrl2::runtime_error("Unknown equivalence " + s + ".");
@@ -94,6 +100,8 @@ inline std::string print_probabilistic_equivalence(const lts_probabilistic_equiv
       return "pbisim-bem";
     case lts_probabilistic_bisim_grv:
       return "pbisim";
+    case lts_probabilistic_bisim_sig:
+      return "pbisim-sig";
     default:
       throw mcrl2::runtime_error("Unknown equivalence.");
   }
@@ -121,6 +129,8 @@ inline std::string description(const lts_probabilistic_equivalence& eq)
       return "probabilistic bisimulation equivalence using the O(mn (log n + log m)) algorithm by Baier, Engelen and Majster-Cederbaum, 2000";
 	case lts_probabilistic_bisim_grv:
 		return "probabilistic bisimulation equivalence using the O(m(log n)) algorithm by Groote, Rivera-Verduzco and de Vink, 2017";
+    case lts_probabilistic_bisim_sig:
+      return "probabilistic bisimulation equivalence using signature refinement, of which the signatures are computed in parallel";
     default:
       throw mcrl2::runtime_error("Unknown equivalence.");
   }
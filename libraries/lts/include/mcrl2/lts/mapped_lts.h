@@ -0,0 +1,198 @@
+// Author(s): agent
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/lts/mapped_lts.h
+/// \brief A read only labelled transition system that is mapped into memory from a file.
+/// \details The file format is flat: after a header of 64 bit words follow the transitions,
+///          sorted on source state and stored with the memory layout of lts::transition, the
+///          index of the first outgoing transition of every state, and two binary aterm streams
+///          with the action labels and the state labels. The transitions and the index are used
+///          directly from the mapped file, so opening even a very large file is immediate.
+
+#ifndef MCRL2_LTS_MAPPED_LTS_H
+#define MCRL2_LTS_MAPPED_LTS_H
+
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "mcrl2/lts/lts_lts.h"
+
+namespace mcrl2::lts
+{
+
+namespace detail
+{
+
+/// \brief The first bytes of every file in the mapped format.
+constexpr char mapped_lts_magic[] = "mCRL2LTM";
+constexpr std::uint64_t mapped_lts_version = 1;
+
+/// \brief The extension of files that are saved in the mapped format. They are read as .lts files.
+constexpr char mapped_lts_extension[] = "ltsm";
+
+/// \brief Returns true iff the filename has the extension of the mapped format.
+inline bool has_mapped_lts_extension(const std::string& filename)
+{
+  const std::string::size_type pos = filename.find_last_of('.');
+  return pos != std::string::npos && filename.substr(pos + 1) == mapped_lts_extension;
+}
+
+/// \brief Returns true iff the file starts with the magic string of the mapped format.
+bool is_mapped_lts_file(const std::string& filename);
+
+/// \brief Writes the lts in the mapped format.
+void write_mapped_lts(std::ostream& stream, const lts_lts_t& lts);
+
+} // namespace detail
+
+/// \brief A read only view on an lts in a file in the mapped format.
+/// \details The interface follows that of lts and of outgoing_transitions_per_state_t: the
+///          outgoing transitions of a state s are get_transitions()[lowerbound(s)...upperbound(s)).
+///          Action labels are read when the file is opened, state labels when they are first used.
+class mapped_lts
+{
+  public:
+    using states_size_type = std::size_t;
+    using labels_size_type = std::size_t;
+    using transitions_size_type = std::size_t;
+
+  protected:
+    const std::uint64_t* m_words = nullptr;
+    std::size_t m_size = 0; // The size of the file in bytes.
+    std::vector<std::uint64_t> m_buffer; // Used on platforms without mmap.
+
+    std::size_t m_num_states = 0;
+    std::size_t m_num_transitions = 0;
+    std::size_t m_num_state_labels = 0;
+    std::size_t m_initial_state = 0;
+    const transition* m_transitions = nullptr;
+    const std::uint64_t* m_indices = nullptr;
+
+    data::data_specification m_data;
+    data::variable_list m_parameters;
+    process::action_label_list m_action_label_declarations;
+    std::vector<action_label_lts> m_action_labels;
+    mutable std::vector<state_label_lts> m_state_labels;
+    std::size_t m_state_labels_offset = 0;
+    std::size_t m_state_labels_size = 0;
+
+    void read_state_labels() const;
+    void unmap();
+
+  public:
+    /// \brief Map the file with the given name into memory.
+    explicit mapped_lts(const std::string& filename);
+
+    mapped_lts(const mapped_lts&) = delete;
+    mapped_lts& operator=(const mapped_lts&) = delete;
+
+    ~mapped_lts();
+
+    states_size_type num_states() const
+    {
+      return m_num_states;
+    }
+
+    transitions_size_type num_transitions() const
+    {
+      return m_num_transitions;
+    }
+
+    labels_size_type num_action_labels() const
+    {
+      return m_action_labels.size();
+    }
+
+    states_size_type num_state_labels() const
+    {
+      return m_num_state_labels;
+    }
+
+    bool has_state_info() const
+    {
+      return m_num_state_labels > 0;
+    }
+
+    states_size_type initial_state() const
+    {
+      return m_initial_state;
+    }
+
+    /// \brief The transitions, sorted on source, label and target.
+    std::span<const transition> get_transitions() const
+    {
+      return std::span<const transition>(m_transitions, m_num_transitions);
+    }
+
+    /// \brief The index of the first outgoing transition of s in get_transitions().
+    std::size_t lowerbound(const states_size_type s) const
+    {
+      assert(s < m_num_states);
+      return m_indices[s];
+    }
+
+    /// \brief The index just after the last outgoing transition of s in get_transitions().
+    std::size_t upperbound(const states_size_type s) const
+    {
+      assert(s < m_num_states);
+      return m_indices[s + 1];
+    }
+
+    /// \brief The outgoing transitions of s, sorted on label and target.
+    std::span<const transition> outgoing_transitions(const states_size_type s) const
+    {
+      return get_transitions().subspan(lowerbound(s), upperbound(s) - lowerbound(s));
+    }
+
+    bool is_tau(const labels_size_type label) const
+    {
+      return label == const_tau_label_index;
+    }
+
+    const std::vector<action_label_lts>& action_labels() const
+    {
+      return m_action_labels;
+    }
+
+    const action_label_lts& action_label(const labels_size_type label) const
+    {
+      assert(label < m_action_labels.size());
+      return m_action_labels[label];
+    }
+
+    const state_label_lts& state_label(const states_size_type s) const
+    {
+      read_state_labels();
+      assert(s < m_state_labels.size());
+      return m_state_labels[s];
+    }
+
+    const data::data_specification& data() const
+    {
+      return m_data;
+    }
+
+    const data::variable_list& process_parameters() const
+    {
+      return m_parameters;
+    }
+
+    const process::action_label_list& action_label_declarations() const
+    {
+      return m_action_label_declarations;
+    }
+
+    /// \brief Copies the contents into an lts that owns its transitions and labels.
+    void copy_to(lts_lts_t& result) const;
+};
+
+} // namespace mcrl2::lts
+
+#endif // MCRL2_LTS_MAPPED_LTS_H
@@ -0,0 +1,771 @@
+// Author(s): agent
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/lts/probabilistic_reachability.h
+/// \brief Computes minimal and maximal reachability probabilities of probabilistic LTSs.
+/// \details A probabilistic LTS is interpreted as a Markov decision process, in which each outgoing transition
+///          of a state is a choice of the scheduler, leading to a probability distribution over states. The
+///          question is the minimal or maximal probability, over all schedulers, that a transition with one of
+///          a set of target action labels is eventually taken. The LTS is first stored as a sparse matrix in
+///          compressed row form, on which value iteration, interval iteration or policy iteration is performed.
+
+#ifndef MCRL2_LTS_PROBABILISTIC_REACHABILITY_H
+#define MCRL2_LTS_PROBABILISTIC_REACHABILITY_H
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "mcrl2/lts/detail/lts_convert.h"
+#include "mcrl2/utilities/detail/parallel_apply.h"
+#include "mcrl2/utilities/logger.h"
+#include "mcrl2/utilities/probabilistic_arbitrary_precision_fraction.h"
+
+namespace mcrl2::lts
+{
+
+/// \brief The methods to compute reachability probabilities.
+enum class reachability_method
+{
+  value_iteration,    ///< Iterate the Bellman operator from below until the values are stable.
+  interval_iteration, ///< Iterate from below and from above until both bounds are close.
+  policy_iteration    ///< Alternately evaluate and improve a memoryless scheduler.
+};
+
+inline reachability_method parse_reachability_method(const std::string& s)
+{
+  if (s == "value")
+  {
+    return reachability_method::value_iteration;
+  }
+  else if (s == "interval")
+  {
+    return reachability_method::interval_iteration;
+  }
+  else if (s == "policy")
+  {
+    return reachability_method::policy_iteration;
+  }
+  throw mcrl2::runtime_error("Unknown reachability method " + s + ".");
+}
+
+inline std::string print_reachability_method(reachability_method method)
+{
+  switch (method)
+  {
+    case reachability_method::value_iteration: return "value";
+    case reachability_method::interval_iteration: return "interval";
+    case reachability_method::policy_iteration: return "policy";
+  }
+  throw mcrl2::runtime_error("Unknown reachability method.");
+}
+
+inline std::string description(reachability_method method)
+{
+  switch (method)
+  {
+    case reachability_method::value_iteration: return "value iteration";
+    case reachability_method::interval_iteration: return "interval iteration, which gives guaranteed error bounds";
+    case reachability_method::policy_iteration: return "policy iteration";
+  }
+  throw mcrl2::runtime_error("Unknown reachability method.");
+}
+
+inline std::istream& operator>>(std::istream& is, reachability_method& method)
+{
+  try
+  {
+    std::string s;
+    is >> s;
+    method = parse_reachability_method(s);
+  }
+  catch (mcrl2::runtime_error&)
+  {
+    is.setstate(std::ios_base::failbit);
+  }
+  return is;
+}
+
+inline std::ostream& operator<<(std::ostream& os, reachability_method method)
+{
+  return os << print_reachability_method(method);
+}
+
+struct probabilistic_reachability_options
+{
+  reachability_method method = reachability_method::value_iteration;
+  bool maximise = true;            ///< Compute maximal instead of minimal probabilities.
+  double epsilon = 1e-6;           ///< The required absolute precision.
+  std::size_t max_iterations = 1000000;
+  std::size_t number_of_threads = 1;
+};
+
+namespace detail
+{
+
+/// \brief Converts a fraction to a double. The enumerator and denominator can be too large for a double, so only
+///        their leading digits are divided, and the result is scaled by the difference in their numbers of digits.
+inline double probability_to_double(const utilities::probabilistic_arbitrary_precision_fraction& p)
+{
+  constexpr std::size_t significant_digits = 18;
+  const std::string enumerator = utilities::pp(p.enumerator());
+  const std::string denominator = utilities::pp(p.denominator());
+  const std::size_t enumerator_digits = std::min(enumerator.size(), significant_digits);
+  const std::size_t denominator_digits = std::min(denominator.size(), significant_digits);
+  const long exponent = static_cast<long>(enumerator.size() - enumerator_digits) - static_cast<long>(denominator.size() - denominator_digits);
+  const long double quotient = std::stold(enumerator.substr(0, enumerator_digits)) / std::stold(denominator.substr(0, denominator_digits));
+  return static_cast<double>(quotient * std::pow(10.0L, static_cast<long double>(exponent)));
+}
+
+inline double probability_to_double(const lps::probabilistic_data_expression& p)
+{
+  return probability_to_double(translate_probability_data_to_arbitrary_size_probability(p));
+}
+
+} // namespace detail
+
+/// \brief A probabilistic LTS in compressed row form.
+/// \details The choices of state s are [state_offsets[s], state_offsets[s+1]). A choice c either takes a target
+///          transition, in which case choice_values[c] is 1 and it has no successors, or it leads to the states
+///          columns[k] with probability values[k] for k in [choice_offsets[c], choice_offsets[c+1]).
+struct probabilistic_reachability_matrix
+{
+  std::vector<std::size_t> state_offsets{0};
+  std::vector<std::size_t> choice_offsets{0};
+  std::vector<double> choice_values;
+  std::vector<std::size_t> columns;
+  std::vector<double> values;
+
+  /// \brief The initial distribution as pairs of a state and its probability.
+  std::vector<std::pair<std::size_t, double>> initial_distribution;
+
+  std::size_t num_states() const
+  {
+    return state_offsets.size() - 1;
+  }
+
+  std::size_t num_choices() const
+  {
+    return choice_values.size();
+  }
+
+  bool is_target(std::size_t c) const
+  {
+    return choice_values[c] != 0.0;
+  }
+};
+
+/// \brief Stores the probabilistic LTS l as a matrix, where the transitions with a label a for which
+///        target_labels[a] holds are the target transitions.
+template <class LTS_TYPE>
+probabilistic_reachability_matrix make_reachability_matrix(const LTS_TYPE& l, const std::vector<bool>& target_labels)
+{
+  probabilistic_reachability_matrix result;
+  const std::size_t n = l.num_states();
+
+  std::vector<std::size_t> out_degree(n, 0);
+  for (const transition& t: l.get_transitions())
+  {
+    out_degree[t.from()]++;
+  }
+  result.state_offsets.resize(n + 1);
+  for (std::size_t s = 0; s < n; ++s)
+  {
+    result.state_offsets[s + 1] = result.state_offsets[s] + out_degree[s];
+  }
+
+  // Sort the transitions on their source state by a counting sort.
+  std::vector<std::size_t> order(l.num_transitions());
+  std::vector<std::size_t> next(result.state_offsets.begin(), result.state_offsets.end() - 1);
+  for (std::size_t i = 0; i < l.num_transitions(); ++i)
+  {
+    order[next[l.get_transitions()[i].from()]++] = i;
+  }
+
+  auto add_successors = [&](const typename LTS_TYPE::probabilistic_state_t& p, auto add)
+  {
+    if (p.size() == 0)
+    {
+      add(p.get(), 1.0);
+    }
+    else
+    {
+      for (const auto& q: p)
+      {
+        add(q.state(), detail::probability_to_double(q.probability()));
+      }
+    }
+  };
+
+  result.choice_values.reserve(order.size());
+  result.choice_offsets.reserve(order.size() + 1);
+  for (std::size_t i: order)
+  {
+    const transition& t = l.get_transitions()[i];
+    if (target_labels[t.label()])
+    {
+      result.choice_values.push_back(1.0);
+    }
+    else
+    {
+      result.choice_values.push_back(0.0);
+      add_successors(l.probabilistic_state(t.to()), [&](std::size_t s, double p)
+        {
+          result.columns.push_back(s);
+          result.values.push_back(p);
+        });
+    }
+    result.choice_offsets.push_back(result.columns.size());
+  }
+
+  add_successors(l.initial_probabilistic_state(), [&](std::size_t s, double p)
+    {
+      result.initial_distribution.emplace_back(s, p);
+    });
+  return result;
+}
+
+/// \brief Computes the minimal or maximal probability for each state to eventually take a target transition.
+class probabilistic_reachability_algorithm
+{
+  protected:
+    static constexpr std::size_t block_size = 4096;
+
+    const probabilistic_reachability_matrix& m_matrix;
+    probabilistic_reachability_options m_options;
+
+    // The states for which the probability is not known to be 0 after the graph based precomputation.
+    std::vector<bool> m_maybe;
+
+    // The maximal end components among the maybe states, which are only needed for the upper bound of interval
+    // iteration when maximising. For each end component the states and the choices that leave it.
+    std::vector<std::vector<std::size_t>> m_end_components;
+    std::vector<std::vector<std::size_t>> m_end_component_exits;
+
+    std::size_t m_iterations = 0;
+
+    double choice_value(std::size_t c, const std::vector<double>& x) const
+    {
+      const std::size_t* columns = m_matrix.columns.data();
+      const double* values = m_matrix.values.data();
+      double result = m_matrix.choice_values[c];
+      for (std::size_t k = m_matrix.choice_offsets[c]; k < m_matrix.choice_offsets[c + 1]; ++k)
+      {
+        result += values[k] * x[columns[k]];
+      }
+      return result;
+    }
+
+    bool better(double v, double w) const
+    {
+      return m_options.maximise ? v > w : v < w;
+    }
+
+    // Returns the optimal value over the choices of the maybe state s.
+    double bellman(std::size_t s, const std::vector<double>& x) const
+    {
+      std::size_t first = m_matrix.state_offsets[s];
+      std::size_t last = m_matrix.state_offsets[s + 1];
+      double result = choice_value(first, x);
+      for (std::size_t c = first + 1; c < last; ++c)
+      {
+        double v = choice_value(c, x);
+        if (better(v, result))
+        {
+          result = v;
+        }
+      }
+      return result;
+    }
+
+    // Calls f(begin, end) on blocks of states using multiple threads, and returns the maximum of the results.
+    template <typename Function>
+    double parallel_max(Function f) const
+    {
+      const std::size_t n = m_matrix.num_states();
+      const std::size_t number_of_blocks = (n + block_size - 1) / block_size;
+      std::vector<double> result(number_of_blocks, 0.0);
+      utilities::detail::parallel_apply(number_of_blocks, m_options.number_of_threads, [&](std::size_t b, std::size_t)
+        {
+          result[b] = f(b * block_size, std::min(n, (b + 1) * block_size));
+        });
+      return result.empty() ? 0.0 : *std::max_element(result.begin(), result.end());
+    }
+
+    // Sets y to the Bellman operator applied to x, and returns the largest difference between x and y.
+    double bellman_sweep(const std::vector<double>& x, std::vector<double>& y) const
+    {
+      return parallel_max([&](std::size_t begin, std::size_t end)
+        {
+          double diff = 0.0;
+          for (std::size_t s = begin; s < end; ++s)
+          {
+            y[s] = m_maybe[s] ? bellman(s, x) : 0.0;
+            diff = std::max(diff, std::abs(y[s] - x[s]));
+          }
+          return diff;
+        });
+    }
+
+    // Computes the states whose probability is 0. When maximising these are the states from which no target
+    // transition is reachable. When minimising these are the states from which a scheduler can avoid the target
+    // transitions forever; the complement is the least set R that contains each state with at least one choice,
+    // all of whose choices are target transitions or have a successor in R.
+    void compute_maybe_states()
+    {
+      const std::size_t n = m_matrix.num_states();
+      m_maybe.assign(n, false);
+
+      // Predecessors of the states, as pairs of a choice and its source state.
+      std::vector<std::size_t> choice_source(m_matrix.num_choices());
+      std::vector<std::size_t> pred_offsets(n + 1, 0);
+      for (std::size_t s = 0; s < n; ++s)
+      {
+        for (std::size_t c = m_matrix.state_offsets[s]; c < m_matrix.state_offsets[s + 1]; ++c)
+        {
+          choice_source[c] = s;
+          for (std::size_t k = m_matrix.choice_offsets[c]; k < m_matrix.choice_offsets[c + 1]; ++k)
+          {
+            pred_offsets[m_matrix.columns[k] + 1]++;
+          }
+        }
+      }
+      for (std::size_t s = 0; s < n; ++s)
+      {
+        pred_offsets[s + 1] += pred_offsets[s];
+      }
+      std::vector<std::size_t> predecessors(pred_offsets.back());
+      std::vector<std::size_t> next(pred_offsets.begin(), pred_offsets.end() - 1);
+      for (std::size_t c = 0; c < m_matrix.num_choices(); ++c)
+      {
+        for (std::size_t k = m_matrix.choice_offsets[c]; k < m_matrix.choice_offsets[c + 1]; ++k)
+        {
+          predecessors[next[m_matrix.columns[k]]++] = c;
+        }
+      }
+
+      // For minimisation, the number of choices of each state that do not yet have a successor in the set.
+      std::vector<std::size_t> open_choices(n);
+      std::vector<bool> choice_done(m_matrix.num_choices(), false);
+      std::vector<std::size_t> todo;
+      for (std::size_t s = 0; s < n; ++s)
+      {
+        open_choices[s] = m_matrix.state_offsets[s + 1] - m_matrix.state_offsets[s];
+        for (std::size_t c = m_matrix.state_offsets[s]; c < m_matrix.state_offsets[s + 1]; ++c)
+        {
+          if (m_matrix.is_target(c))
+          {
+            choice_done[c] = true;
+            open_choices[s]--;
+          }
+        }
+        bool has_target = open_choices[s] < m_matrix.state_offsets[s + 1] - m_matrix.state_offsets[s];
+        if (m_options.maximise ? has_target : (has_target && open_choices[s] == 0))
+        {
+          m_maybe[s] = true;
+          todo.push_back(s);
+        }
+      }
+
+      while (!todo.empty())
+      {
+        std::size_t t = todo.back();
+        todo.pop_back();
+        for (std::size_t k = pred_offsets[t]; k < pred_offsets[t + 1]; ++k)
+        {
+          std::size_t c = predecessors[k];
+          std::size_t s = choice_source[c];
+          if (m_maybe[s] || choice_done[c])
+          {
+            continue;
+          }
+          choice_done[c] = true;
+          if (m_options.maximise || --open_choices[s] == 0)
+          {
+            m_maybe[s] = true;
+            todo.push_back(s);
+          }
+        }
+      }
+    }
+
+    // Computes the strongly connected components of the maybe states, using only the active choices. Returns
+    // for each maybe state the index of its component.
+    std::vector<std::size_t> compute_sccs(const std::vector<bool>& candidate, const std::vector<bool>& active) const
+    {
+      constexpr std::size_t undefined = std::numeric_limits<std::size_t>::max();
+      const std::size_t n = m_matrix.num_states();
+      std::vector<std::size_t> index(n, undefined);
+      std::vector<std::size_t> lowlink(n, 0);
+      std::vector<std::size_t> component(n, undefined);
+      std::vector<std::size_t> stack;
+      std::size_t next_index = 0;
+      std::size_t next_component = 0;
+
+      // The depth first search stack contains a state, and the choice and the entry that are visited next.
+      struct frame
+      {
+        std::size_t state;
+        std::size_t choice;
+        std::size_t entry;
+      };
+      std::vector<frame> dfs;
+
+      auto visit = [&](std::size_t s)
+      {
+        index[s] = lowlink[s] = next_index++;
+        stack.push_back(s);
+        std::size_t c = m_matrix.state_offsets[s];
+        dfs.push_back(frame{s, c, c < m_matrix.state_offsets[s + 1] ? m_matrix.choice_offsets[c] : 0});
+      };
+
+      for (std::size_t root = 0; root < n; ++root)
+      {
+        if (!candidate[root] || index[root] != undefined)
+        {
+          continue;
+        }
+        visit(root);
+        while (!dfs.empty())
+        {
+          frame& f = dfs.back();
+          std::size_t s = f.state;
+          if (f.choice < m_matrix.state_offsets[s + 1])
+          {
+            if (!active[f.choice] || f.entry == m_matrix.choice_offsets[f.choice + 1])
+            {
+              f.choice++;
+              if (f.choice < m_matrix.state_offsets[s + 1])
+              {
+                f.entry = m_matrix.choice_offsets[f.choice];
+              }
+              continue;
+            }
+            std::size_t t = m_matrix.columns[f.entry++];
+            if (index[t] == undefined)
+            {
+              visit(t);
+            }
+            else if (component[t] == undefined)
+            {
+              lowlink[s] = std::min(lowlink[s], index[t]);
+            }
+            continue;
+          }
+
+          // All successors of s have been visited.
+          dfs.pop_back();
+          if (!dfs.empty())
+          {
+            std::size_t parent = dfs.back().state;
+            lowlink[parent] = std::min(lowlink[parent], lowlink[s]);
+          }
+          if (lowlink[s] == index[s])
+          {
+            std::size_t t;
+            do
+            {
+              t = stack.back();
+              stack.pop_back();
+              component[t] = next_component;
+            }
+            while (t != s);
+            next_component++;
+          }
+        }
+      }
+      return component;
+    }
+
+    // Computes the maximal end components among the maybe states by repeatedly removing the choices that leave
+    // their strongly connected component, and the states without remaining choices.
+    void compute_end_components()
+    {
+      const std::size_t n = m_matrix.num_states();
+      std::vector<bool> candidate = m_maybe;
+      std::vector<bool> active(m_matrix.num_choices(), false);
+      std::vector<std::size_t> component;
+
+      bool changed = true;
+      while (changed)
+      {
+        changed = false;
+        for (std::size_t s = 0; s < n; ++s)
+        {
+          if (!candidate[s])
+          {
+            continue;
+          }
+          bool has_active_choice = false;
+          for (std::size_t c = m_matrix.state_offsets[s]; c < m_matrix.state_offsets[s + 1]; ++c)
+          {
+            bool stays = !m_matrix.is_target(c) && (component.empty() || active[c]);
+            for (std::size_t k = m_matrix.choice_offsets[c]; stays && k < m_matrix.choice_offsets[c + 1]; ++k)
+            {
+              std::size_t t = m_matrix.columns[k];
+              stays = candidate[t] && (component.empty() || component[t] == component[s]);
+            }
+            changed = changed || active[c] != stays;
+            active[c] = stays;
+            has_active_choice = has_active_choice || stays;
+          }
+          if (!has_active_choice)
+          {
+            candidate[s] = false;
+            changed = true;
+          }
+        }
+        component = compute_sccs(candidate, active);
+      }
+
+      std::vector<std::size_t> component_index(n, std::numeric_limits<std::size_t>::max());
+      for (std::size_t s = 0; s < n; ++s)
+      {
+        if (!candidate[s])
+        {
+          continue;
+        }
+        std::size_t& i = component_index[component[s]];
+        if (i == std::numeric_limits<std::size_t>::max())
+        {
+          i = m_end_components.size();
+          m_end_components.emplace_back();
+          m_end_component_exits.emplace_back();
+        }
+        m_end_components[i].push_back(s);
+        for (std::size_t c = m_matrix.state_offsets[s]; c < m_matrix.state_offsets[s + 1]; ++c)
+        {
+          if (!active[c])
+          {
+            m_end_component_exits[i].push_back(c);
+          }
+        }
+      }
+      mCRL2log(log::verbose) << "Found " << m_end_components.size() << " maximal end components." << std::endl;
+    }
+
+    // Lowers the values of the states in each end component to the best value of a choice leaving it. Without
+    // this, the upper bound of interval iteration does not converge in the presence of end components.
+    // The exits of one end component can lead to the states of another, so all best values are computed before any
+    // of them is applied.
+    void deflate(std::vector<double>& x) const
+    {
+      std::vector<double> best(m_end_components.size(), 0.0);
+      utilities::detail::parallel_apply(m_end_components.size(), m_options.number_of_threads, [&](std::size_t i, std::size_t)
+        {
+          for (std::size_t c: m_end_component_exits[i])
+          {
+            best[i] = std::max(best[i], choice_value(c, x));
+          }
+        });
+      for (std::size_t i = 0; i < m_end_components.size(); ++i)
+      {
+        for (std::size_t s: m_end_components[i])
+        {
+          x[s] = std::min(x[s], best[i]);
+        }
+      }
+    }
+
+    bool iteration_limit_reached()
+    {
+      if (++m_iterations > m_options.max_iterations)
+      {
+        mCRL2log(log::warning) << "The maximal number of iterations (" << m_options.max_iterations << ") was reached before convergence." << std::endl;
+        return true;
+      }
+      return false;
+    }
+
+    std::vector<double> value_iteration()
+    {
+      std::vector<double> x(m_matrix.num_states(), 0.0);
+      std::vector<double> y(m_matrix.num_states(), 0.0);
+      while (!iteration_limit_reached())
+      {
+        double diff = bellman_sweep(x, y);
+        x.swap(y);
+        mCRL2log(log::debug) << "Iteration " << m_iterations << ": difference " << diff << std::endl;
+        if (diff <= m_options.epsilon)
+        {
+          break;
+        }
+      }
+      return x;
+    }
+
+    std::vector<double> interval_iteration()
+    {
+      if (m_options.maximise)
+      {
+        compute_end_components();
+      }
+      const std::size_t n = m_matrix.num_states();
+      std::vector<double> lower(n, 0.0);
+      std::vector<double> upper(n, 0.0);
+      for (std::size_t s = 0; s < n; ++s)
+      {
+        upper[s] = m_maybe[s] ? 1.0 : 0.0;
+      }
+      std::vector<double> next(n, 0.0);
+      while (!iteration_limit_reached())
+      {
+        bellman_sweep(lower, next);
+        lower.swap(next);
+        bellman_sweep(upper, next);
+        upper.swap(next);
+        if (m_options.maximise)
+        {
+          deflate(upper);
+        }
+        double gap = parallel_max([&](std::size_t begin, std::size_t end)
+          {
+            double result = 0.0;
+            for (std::size_t s = begin; s < end; ++s)
+            {
+              result = std::max(result, upper[s] - lower[s]);
+            }
+            return result;
+          });
+        mCRL2log(log::debug) << "Iteration " << m_iterations << ": gap " << gap << std::endl;
+        if (gap <= 2 * m_options.epsilon)
+        {
+          break;
+        }
+      }
+      for (std::size_t s = 0; s < n; ++s)
+      {
+        lower[s] = (lower[s] + upper[s]) / 2;
+      }
+      return lower;
+    }
+
+    std::vector<double> policy_iteration()
+    {
+      const std::size_t n = m_matrix.num_states();
+      std::vector<std::size_t> policy(n);
+      for (std::size_t s = 0; s < n; ++s)
+      {
+        policy[s] = m_matrix.state_offsets[s];
+      }
+      std::vector<double> x(n, 0.0);
+      std::vector<double> y(n, 0.0);
+      while (true)
+      {
+        // Evaluate the current policy, starting from the values of the previous policy. For maximisation the
+        // values increase to the least fixed point, which is the value of the policy also if it has end components.
+        while (!iteration_limit_reached())
+        {
+          double diff = parallel_max([&](std::size_t begin, std::size_t end)
+            {
+              double result = 0.0;
+              for (std::size_t s = begin; s < end; ++s)
+              {
+                y[s] = m_maybe[s] ? choice_value(policy[s], x) : 0.0;
+                result = std::max(result, std::abs(y[s] - x[s]));
+              }
+              return result;
+            });
+          x.swap(y);
+          if (diff <= m_options.epsilon / 2)
+          {
+            break;
+          }
+        }
+        if (m_iterations > m_options.max_iterations)
+        {
+          return x;
+        }
+
+        // Improve the policy. A choice only replaces the current one if it is better by more than the precision
+        // of the evaluation, which guarantees termination.
+        double changed = parallel_max([&](std::size_t begin, std::size_t end)
+          {
+            double result = 0.0;
+            for (std::size_t s = begin; s < end; ++s)
+            {
+              if (!m_maybe[s])
+              {
+                continue;
+              }
+              double current = choice_value(policy[s], x);
+              for (std::size_t c = m_matrix.state_offsets[s]; c < m_matrix.state_offsets[s + 1]; ++c)
+              {
+                double v = choice_value(c, x);
+                if (better(v, current) && std::abs(v - current) > m_options.epsilon)
+                {
+                  policy[s] = c;
+                  current = v;
+                  result = 1.0;
+                }
+              }
+            }
+            return result;
+          });
+        mCRL2log(log::debug) << "Policy improvement after " << m_iterations << " iterations" << (changed > 0.0 ? "" : " is stable") << std::endl;
+        if (changed == 0.0)
+        {
+          return x;
+        }
+      }
+    }
+
+  public:
+    probabilistic_reachability_algorithm(const probabilistic_reachability_matrix& matrix,
+                                         const probabilistic_reachability_options& options)
+      : m_matrix(matrix), m_options(options)
+    {}
+
+    /// \brief Returns for each state the minimal or maximal probability to eventually take a target transition.
+    std::vector<double> run()
+    {
+      m_iterations = 0;
+      compute_maybe_states();
+      mCRL2log(log::verbose) << "There are " << std::count(m_maybe.begin(), m_maybe.end(), true) << " of the "
+                             << m_matrix.num_states() << " states with a probability that may be positive." << std::endl;
+      std::vector<double> result;
+      switch (m_options.method)
+      {
+        case reachability_method::value_iteration: result = value_iteration(); break;
+        case reachability_method::interval_iteration: result = interval_iteration(); break;
+        case reachability_method::policy_iteration: result = policy_iteration(); break;
+      }
+      mCRL2log(log::verbose) << "Computed the probabilities using " << description(m_options.method) << " in "
+                             << m_iterations << " iterations." << std::endl;
+      return result;
+    }
+
+    /// \brief Returns the number of iterations of the last run.
+    std::size_t iterations() const
+    {
+      return m_iterations;
+    }
+};
+
+/// \brief Returns the minimal or maximal probability that the probabilistic LTS l, starting in its initial
+///        distribution, eventually takes a transition with a label a for which target_labels[a] holds.
+template <class LTS_TYPE>
+double reachability_probability(const LTS_TYPE& l,
+                                const std::vector<bool>& target_labels,
+                                const probabilistic_reachability_options& options)
+{
+  probabilistic_reachability_matrix matrix = make_reachability_matrix(l, target_labels);
+  std::vector<double> x = probabilistic_reachability_algorithm(matrix, options).run();
+  double result = 0.0;
+  for (const auto& [s, p]: matrix.initial_distribution)
+  {
+    result += p * x[s];
+  }
+  return result;
+}
+
+} // namespace mcrl2::lts
+
+#endif // MCRL2_LTS_PROBABILISTIC_REACHABILITY_H
@@ -15,6 +15,8 @@
 #include "mcrl2/lps/explorer.h"
 #include "mcrl2/lts/trace.h"
 
+#include <array>
+#include <bit>
 #include <forward_list>
 
 namespace mcrl2::lts 
@@ -80,38 +82,135 @@ void save_traces(
   }
 }
 
-// Facility for constructing a trace to a given state.
+// Stores for each state index the index of the state from which it was discovered, together with the index of
+// the summand of the discovering transition. The entries are stored in blocks of increasing size that are allocated
+// on demand, such that entries can be written by multiple threads without locking, provided that each entry is
+// written by one thread.
+class parent_table
+{
+  public:
+    static constexpr std::size_t undefined = std::numeric_limits<std::size_t>::max();
+
+    struct entry
+    {
+      std::size_t parent = undefined;
+      std::size_t summand = undefined;
+    };
+
+  protected:
+    // Block b contains the entries with indices [(2^b - 1) * first_block_size, (2^(b+1) - 1) * first_block_size).
+    static constexpr std::size_t first_block_size = 1024;
+    static constexpr std::size_t number_of_blocks = 48;
+
+    std::array<std::atomic<entry*>, number_of_blocks> m_blocks{};
+
+    static std::size_t block_size(std::size_t b)
+    {
+      return first_block_size << b;
+    }
+
+    // Returns the block and the offset in the block of index i.
+    static std::pair<std::size_t, std::size_t> position(std::size_t i)
+    {
+      std::size_t k = i / first_block_size + 1;
+      std::size_t b = std::bit_width(k) - 1;
+      return { b, i - ((std::size_t(1) << b) - 1) * first_block_size };
+    }
+
+    entry* block(std::size_t b)
+    {
+      entry* result = m_blocks[b].load(std::memory_order_acquire);
+      if (result == nullptr)
+      {
+        entry* new_block = new entry[block_size(b)];
+        if (m_blocks[b].compare_exchange_strong(result, new_block, std::memory_order_acq_rel))
+        {
+          result = new_block;
+        }
+        else
+        {
+          delete[] new_block; // another thread allocated the block first
+        }
+      }
+      return result;
+    }
+
+  public:
+    parent_table() = default;
+    parent_table(const parent_table&) = delete;
+    parent_table& operator=(const parent_table&) = delete;
+
+    ~parent_table()
+    {
+      clear();
+    }
+
+    // Records that state i was discovered from state parent using the given summand.
+    void set(std::size_t i, std::size_t parent, std::size_t summand)
+    {
+      auto [b, offset] = position(i);
+      assert(b < number_of_blocks);
+      entry& e = block(b)[offset];
+      e.parent = parent;
+      e.summand = summand;
+    }
+
+    // Returns the entry of state i. The parent is undefined if nothing was recorded for i.
+    entry get(std::size_t i) const
+    {
+      auto [b, offset] = position(i);
+      const entry* blk = b < number_of_blocks ? m_blocks[b].load(std::memory_order_acquire) : nullptr;
+      return blk == nullptr ? entry() : blk[offset];
+    }
+
+    // Must not be called concurrently with set.
+    void clear()
+    {
+      for (std::atomic<entry*>& blk: m_blocks)
+      {
+        delete[] blk.exchange(nullptr);
+      }
+    }
+};
+
+// Facility for constructing a trace to a given state. Only the indices of the parent state and of the summand are
+// recorded for each discovered state. The actions of a trace are recomputed by generating the transitions of a
+// single summand for each step.
 template <typename Explorer>
 class trace_constructor
 {
   protected:
     Explorer& m_explorer;
-    std::map<lps::state, lps::state> m_backpointers;
+    parent_table m_parents;
+
+    // The indices of the states that were discovered by each thread since its last call of examine_transition.
+    std::vector<std::vector<std::size_t>> m_newly_discovered;
+
+    // Trace reconstruction uses the global rewriter of the explorer.
+    std::mutex m_mutex;
 
-    // Finds a transition s0 --a--> s1, and returns a.
-    lps::multi_action find_action(const lps::state& s0, 
-                                  const lps::state& s1)
+    // Finds a transition s0 --a--> s1 generated by the summand with index summand_index, and returns a.
+    lps::multi_action find_action(const lps::state& s0,
+                                  const lps::state& s1,
+                                  std::size_t summand_index)
     {
-      if constexpr (Explorer::is_stochastic)
+      for (const auto& [a, t]: m_explorer.generate_transitions(s0, summand_index))
       {
-        for (const std::pair<lps::multi_action, lps::stochastic_state>& t: m_explorer.generate_transitions(s0))
+        if constexpr (Explorer::is_stochastic)
         {
-          for (const lps::state& s: t.second.states)
+          for (const lps::state& s: t.states)
           {
             if (s == s1)
             {
-              return t.first;
+              return a;
             }
           }
         }
-      }
-      else
-      {
-        for (const std::pair<lps::multi_action, lps::state>& t: m_explorer.generate_transitions(s0))
+        else
         {
-          if (t.second == s1)
+          if (t == s1)
           {
-            return t.first;
+            return a;
           }
         }
       }
@@ -119,47 +218,82 @@ class trace_constructor
     }
 
   public:
-    explicit trace_constructor(Explorer& explorer_)
-      : m_explorer(explorer_)
+    trace_constructor(Explorer& explorer_, std::size_t number_of_threads)
+      : m_explorer(explorer_),
+        m_newly_discovered(number_of_threads + 1) // Threads are numbered from 1 to n.
     {}
 
-    // Constructs a trace ending in s, using the backpointers map.
-    class trace construct_trace(const lps::state& s)
+    // Constructs a trace ending in the state with index s_index, using the parent table.
+    class trace construct_trace(std::size_t s_index)
     {
-      std::deque<lps::state> states{ s };
+      std::lock_guard<std::mutex> guard(m_mutex);
+      const auto& states = m_explorer.state_map();
+      std::deque<std::size_t> path{ s_index };
       std::deque<lps::multi_action> actions;
       while (true)
       {
-        const lps::state& s1 = states.front();
-        auto i = m_backpointers.find(s1);
-        if (i == m_backpointers.end())
+        parent_table::entry e = m_parents.get(path.front());
+        if (e.parent == parent_table::undefined)
         {
           break;
         }
-        const lps::state& s0 = i->second;
-        states.push_front(s0);
-        actions.push_front(find_action(s0, s1));
+        actions.push_front(find_action(states.at(e.parent), states.at(path.front()), e.summand));
+        path.push_front(e.parent);
       }
 
       class trace tr;
       for (std::size_t i = 0; i < actions.size(); i++)
       {
-        tr.set_state(states[i]);
+        tr.set_state(states.at(path[i]));
         tr.add_action(actions[i]);
       }
-      tr.set_state(states.back());
+      tr.set_state(states.at(path.back()));
       return tr;
     }
 
-    // Adds a back pointer for the given edge
-    void add_edge(const lps::state& s0, const lps::state& s1)
+    // Must be called before the outgoing transitions of a state are explored by the given thread.
+    void start_state(std::size_t thread_index)
+    {
+      m_newly_discovered[thread_index].clear();
+    }
+
+    // Must be called when the state with index s_index is discovered by the given thread.
+    void discover_state(std::size_t thread_index, std::size_t s_index)
+    {
+      m_newly_discovered[thread_index].push_back(s_index);
+    }
+
+    // Records the parents of the states that were discovered by the transition s0 --> s1, generated by the summand with
+    // index summand_index. States that are discovered before any state is explored, i.e. the initial states, have no parent.
+    void examine_transition(std::size_t thread_index, std::size_t s0_index, std::size_t s1_index, std::size_t summand_index)
     {
-      m_backpointers[s1] = s0;
+      std::vector<std::size_t>& discovered = m_newly_discovered[thread_index];
+      if (!discovered.empty() && discovered.back() == s1_index)
+      {
+        m_parents.set(s1_index, s0_index, summand_index);
+        discovered.clear();
+      }
+    }
+
+    void examine_transition(std::size_t thread_index, std::size_t s0_index, const std::list<std::size_t>& s1_index, std::size_t summand_index)
+    {
+      for (std::size_t i: m_newly_discovered[thread_index])
+      {
+        if (std::find(s1_index.begin(), s1_index.end(), i) != s1_index.end())
+        {
+          m_parents.set(i, s0_index, summand_index);
+        }
+      }
+      m_newly_discovered[thread_index].clear();
     }
 
     void clear()
     {
-      m_backpointers.clear();
+      m_parents.clear();
+      for (std::vector<std::size_t>& v: m_newly_discovered)
+      {
+        v.clear();
+      }
     }
 
     // Providing access to the explorer should perhaps be avoided.
@@ -255,7 +389,7 @@ class action_detector
       mCRL2log(log::info) << "Action '" + lps::pp(a) + "' found (state index: " + std::to_string(s0_index) + ")";
       if (m_trace_count < m_max_trace_count)
       {
-        class trace tr = m_trace_constructor.construct_trace(s0);
+        class trace tr = m_trace_constructor.construct_trace(s0_index);
         tr.add_action(a);
         tr.set_state(s1);
         std::string filename = create_filename(a);
@@ -296,7 +430,7 @@ class deadlock_detector
       mCRL2log(log::info) << "Deadlock found (state index: " + std::to_string(s_index) + ")";
       if (m_trace_count < m_max_trace_count)
       {
-        class trace tr = m_trace_constructor.construct_trace(s);
+        class trace tr = m_trace_constructor.construct_trace(s_index);
         std::string filename = filename_prefix + "_dlk_" + std::to_string(m_trace_count++) + ".trc";
         save_trace(tr, filename);
       }
@@ -353,7 +487,7 @@ class nondeterminism_detector
         mCRL2log(log::info) << "Nondeterministic state found (state index: " + std::to_string(s0_index) + ")";
         if (m_trace_count < m_max_trace_count)
         {
-          class trace tr = m_trace_constructor.construct_trace(s0);
+          class trace tr = m_trace_constructor.construct_trace(s0_index);
           tr.add_action(a);
           tr.set_state(s1);
           std::string filename = filename_prefix + "_nondeterministic_" + std::to_string(m_trace_count++) + ".trc";
@@ -383,7 +517,6 @@ class divergence_detector
   protected:
     Explorer& explorer;
     const std::string& filename_prefix;
-    trace_constructor<Explorer> m_local_trace_constructor;
     utilities::unordered_map<lps::state, std::size_t> m_divergent_states;
     std::vector<lps::explorer_summand> m_regular_summands;
     std::vector<lps::explorer_summand> m_confluent_summands;
@@ -400,7 +533,6 @@ class divergence_detector
     )
       : explorer(explorer_),
         filename_prefix(filename_prefix_),
-        m_local_trace_constructor(explorer),
         m_max_trace_count(max_trace_count)
     {
       using utilities::detail::contains;
@@ -441,7 +573,6 @@ class divergence_detector
 
       bool result = false;
       divergence_detector_mutex.lock();
-      m_local_trace_constructor.clear();
 
       auto q = m_divergent_states.find(s);
       if (q != m_divergent_states.end())
@@ -475,8 +606,9 @@ class divergence_detector
             mCRL2log(log::info) << "Divergent state found (state index: " + std::to_string(s_index) + ")";
             if (m_trace_count < m_max_trace_count)
             {
-              class trace tr = global_trace_constructor.construct_trace(s);
-              class trace tr_loop = m_local_trace_constructor.construct_trace(s0);
+              class trace tr = global_trace_constructor.construct_trace(s_index);
+              class trace tr_loop;
+              tr_loop.set_state(s0);
               for (const lps::state& u: tr_loop.states())
               {
                 m_divergent_states[u] = s_index;
@@ -511,8 +643,9 @@ class divergence_detector
             mCRL2log(log::info) << "Divergent state found (state index: " + std::to_string(s_index) + ")";
             if (m_trace_count < m_max_trace_count)
             {
-              class trace tr = global_trace_constructor.construct_trace(s);
-              class trace tr_loop = m_local_trace_constructor.construct_trace(s0);
+              class trace tr = global_trace_constructor.construct_trace(s_index);
+              class trace tr_loop;
+              tr_loop.set_state(s0);
               for (const lps::state& u: tr_loop.states())
               {
                 m_divergent_states[u] = s_index;
@@ -667,7 +800,7 @@ struct state_space_generator
   state_space_generator(const Specification& lpsspec, const lps::explorer_options& options_, explorer_type& explorer_)
     : options(options_),
       explorer(explorer_),
-      m_trace_constructor(explorer),
+      m_trace_constructor(explorer, options.number_of_threads),
       m_action_detector(lpsspec, m_trace_constructor, options.trace_actions, options.trace_multiactions, options.trace_prefix, options.max_traces),
       m_deadlock_detector(m_trace_constructor, options.trace_prefix, options.max_traces),
       m_nondeterminism_detector(m_trace_constructor, options.trace_prefix, options.number_of_threads, options.max_traces),
@@ -699,7 +832,7 @@ struct state_space_generator
   bool explore(LTSBuilder& builder)
   {
     std::vector<aligned_bool> has_outgoing_transitions(options.number_of_threads+1); // thread indices start at 1. 
-    const lps::state* source = nullptr;
+    std::size_t source_index = 0;
 
     try
     {
@@ -709,9 +842,9 @@ struct state_space_generator
         // discover_state
         [&](const std::size_t thread_index, const lps::state& s, std::size_t s_index)
         {
-          if (options.generate_traces && source)
+          if (options.generate_traces)
           {
-            m_trace_constructor.add_edge(*source, s);
+            m_trace_constructor.discover_state(thread_index, s_index);
           }
           if (options.detect_divergence)
           {
@@ -750,6 +883,10 @@ struct state_space_generator
           {
             builder.add_transition(s0_index, a, s1_index, number_of_threads);
           }
+          if (options.generate_traces)
+          {
+            m_trace_constructor.examine_transition(thread_index, s0_index, s1_index, summand_index);
+          }
           assert(thread_index<has_outgoing_transitions.size());
           has_outgoing_transitions[thread_index].m_bool = true;
           if (options.detect_action)
@@ -767,10 +904,14 @@ struct state_space_generator
         },
 
         // start_state
-        [&](const std::size_t thread_index, const lps::state& s, std::size_t /* s_index */)
+        [&](const std::size_t thread_index, const lps::state& /* s */, std::size_t s_index)
         {
           if (options.number_of_threads == 1) {
-            source = &s;
+            source_index = s_index;
+          }
+          if (options.generate_traces)
+          {
+            m_trace_constructor.start_state(thread_index);
           }
 
           assert(thread_index<has_outgoing_transitions.size());
@@ -813,8 +954,7 @@ struct state_space_generator
       mCRL2log(log::error) << "Error while exploring state space: " << e.what() << ".\n";
       if (options.save_error_trace)
       {
-        const lps::state& s = *source;
-        class trace tr = m_trace_constructor.construct_trace(s);
+        class trace tr = m_trace_constructor.construct_trace(source_index);
         std::string filename = options.trace_prefix + "_error.trc";
         detail::save_trace(tr, filename);
       }
@@ -201,6 +201,7 @@ class stochastic_lts_lts_builder: public stochastic_lts_builder
   protected:
     probabilistic_lts_lts_t m_lts;
     bool m_discard_state_labels = false;
+    bool m_compress = false;
     probabilistic_state<std::size_t, lps::probabilistic_data_expression> m_initial_state;
     std::mutex m_exclusive_transition_access;
 
@@ -209,9 +210,11 @@ class stochastic_lts_lts_builder: public stochastic_lts_builder
       const data::data_specification& dataspec,
       const process::action_label_list& action_labels,
       const data::variable_list& process_parameters,
-      bool discard_state_labels = false
+      bool discard_state_labels = false,
+      bool compress = false
     )
-      : m_discard_state_labels(discard_state_labels)
+      : m_discard_state_labels(discard_state_labels),
+        m_compress(compress)
     {
       m_lts.set_data(dataspec);
       m_lts.set_process_parameters(process_parameters);
@@ -298,7 +301,7 @@ class stochastic_lts_lts_builder: public stochastic_lts_builder
     // Save the LTS to a file
     void save(const std::string& filename) override
     {
-      m_lts.save(filename);
+      m_lts.save(filename, m_compress);
     }
 };
 
@@ -324,7 +327,7 @@ std::unique_ptr<stochastic_lts_builder> create_stochastic_lts_builder(const lps:
   switch (output_format)
   {
     case lts_aut: return std::make_unique<stochastic_lts_aut_builder>();
-    case lts_lts: return std::make_unique<stochastic_lts_lts_builder>(lpsspec.data(), lpsspec.action_labels(), lpsspec.process().process_parameters(), options.discard_lts_state_labels);
+    case lts_lts: return std::make_unique<stochastic_lts_lts_builder>(lpsspec.data(), lpsspec.action_labels(), lpsspec.process().process_parameters(), options.discard_lts_state_labels, options.compress_lts);
     case lts_fsm: return std::make_unique<stochastic_lts_fsm_builder>(lpsspec.data(), lpsspec.action_labels(), lpsspec.process().process_parameters());
     default: return std::make_unique<stochastic_lts_none_builder>();
   }
@@ -47,6 +47,22 @@ lts_type guess_format(std::string const& s, const bool be_verbose/*=true*/)
       }
       return lts_lts;
     }
+    else if (ext == "ltsc")
+    {
+      if (be_verbose)
+      {
+        mCRL2log(verbose) << "Detected .ltsc extension (columnar .lts).\n";
+      }
+      return lts_lts;
+    }
+    else if (ext == "ltsm")
+    {
+      if (be_verbose)
+      {
+        mCRL2log(verbose) << "Detected .ltsm extension (mapped .lts).\n";
+      }
+      return lts_lts;
+    }
     else if (ext == "fsm")
     {
       if (be_verbose)
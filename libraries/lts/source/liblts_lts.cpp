@@ -16,6 +16,9 @@
 
 #include "mcrl2/lts/lts_lts.h"
 #include "mcrl2/lts/lts_io.h"
+#include "mcrl2/lts/detail/liblts_swap_to_from_probabilistic_lts.h"
+#include "mcrl2/lts/detail/lts_columnar_io.h"
+#include "mcrl2/lts/mapped_lts.h"
 
 
 namespace mcrl2::lts
@@ -391,7 +394,7 @@ static void write_lts(atermpp::aterm_ostream& stream, const LTS& lts)
 }
 
 template <class LTS_TRANSITION_SYSTEM>
-static void write_to_lts(const LTS_TRANSITION_SYSTEM& lts, const std::string& filename)
+static void write_to_lts(const LTS_TRANSITION_SYSTEM& lts, const std::string& filename, bool compress)
 {
   static_assert(std::is_same_v<LTS_TRANSITION_SYSTEM, probabilistic_lts_lts_t>
                     || std::is_same_v<LTS_TRANSITION_SYSTEM, lts_lts_t>,
@@ -410,7 +413,7 @@ static void write_to_lts(const LTS_TRANSITION_SYSTEM& lts, const std::string& fi
 
   try
   {
-    atermpp::binary_aterm_ostream stream(to_stdout ? std::cout : fstream);
+    atermpp::binary_aterm_ostream stream(to_stdout ? std::cout : fstream, compress);
     stream << lts;
   }
   catch (const std::exception& ex)
@@ -499,27 +502,78 @@ void write_initial_state(atermpp::aterm_ostream& stream, std::size_t index)
   stream << probabilistic_lts_lts_t::probabilistic_state_t(index);
 }
 
-void probabilistic_lts_lts_t::save(const std::string& filename) const
+void probabilistic_lts_lts_t::save(const std::string& filename, bool compress) const
 {
   mCRL2log(log::verbose) << "Starting to save a probabilistic lts to the file " << filename << ".\n";
-  detail::write_to_lts(*this, filename);
+  detail::write_to_lts(*this, filename, compress);
 }
 
-void lts_lts_t::save(std::string const& filename) const
+void lts_lts_t::save(std::string const& filename, bool compress) const
 {
   mCRL2log(log::verbose) << "Starting to save an lts to the file " << filename << ".\n";
-  detail::write_to_lts(*this, filename);
+  if (compress && (detail::has_columnar_lts_extension(filename) || detail::has_mapped_lts_extension(filename)))
+  {
+    throw mcrl2::runtime_error("Compression is only supported for .lts files, and cannot be used for " + filename + ".");
+  }
+  if (detail::has_columnar_lts_extension(filename))
+  {
+    std::ofstream fstream(filename, std::ofstream::out | std::ofstream::binary);
+    if (fstream.fail())
+    {
+      throw mcrl2::runtime_error("Fail to open file " + filename + " for writing.");
+    }
+    detail::write_columnar_lts(fstream, *this);
+    return;
+  }
+  if (detail::has_mapped_lts_extension(filename))
+  {
+    std::ofstream fstream(filename, std::ofstream::out | std::ofstream::binary);
+    if (fstream.fail())
+    {
+      throw mcrl2::runtime_error("Fail to open file " + filename + " for writing.");
+    }
+    detail::write_mapped_lts(fstream, *this);
+    return;
+  }
+  detail::write_to_lts(*this, filename, compress);
 }
 
 void probabilistic_lts_lts_t::load(const std::string& filename)
 {
   mCRL2log(log::verbose) << "Starting to load a probabilistic lts from the file " << filename << ".\n";
+  if (!filename.empty() && (detail::is_columnar_lts_file(filename) || detail::is_mapped_lts_file(filename)))
+  {
+    // The columnar and mapped formats only contain non probabilistic transition systems.
+    lts_lts_t l;
+    l.load(filename);
+    detail::translate_to_probabilistic_lts(l, *this);
+    return;
+  }
   detail::read_from_lts(*this, filename);
 }
 
 void lts_lts_t::load(const std::string& filename)
 {
   mCRL2log(log::verbose) << "Starting to load an lts from the file " << filename << ".\n";
+  if (!filename.empty() && detail::is_columnar_lts_file(filename))
+  {
+    std::ifstream fstream(filename, std::ifstream::in | std::ifstream::binary);
+    try
+    {
+      detail::read_columnar_lts(fstream, *this);
+    }
+    catch (const std::exception& ex)
+    {
+      mCRL2log(log::error) << ex.what() << "\n";
+      throw mcrl2::runtime_error("Fail to correctly read an lts from the file " + filename + ".");
+    }
+    return;
+  }
+  if (!filename.empty() && detail::is_mapped_lts_file(filename))
+  {
+    mapped_lts(filename).copy_to(*this);
+    return;
+  }
   detail::read_from_lts(*this, filename);
 }
 
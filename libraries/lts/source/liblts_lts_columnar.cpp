@@ -0,0 +1,368 @@
+// Author(s): agent
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file liblts_lts_columnar.cpp
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+
+#include "mcrl2/atermpp/aterm_io_binary.h"
+#include "mcrl2/data/detail/io.h"
+#include "mcrl2/lts/detail/lts_columnar_io.h"
+
+namespace mcrl2::lts::detail
+{
+
+static void read_magic(std::istream& stream)
+{
+  char magic[columnar_lts_magic_size];
+  stream.read(magic, columnar_lts_magic_size);
+  if (stream.gcount() != static_cast<std::streamsize>(columnar_lts_magic_size) ||
+      std::memcmp(magic, columnar_lts_magic, columnar_lts_magic_size) != 0)
+  {
+    throw mcrl2::runtime_error("The stream does not contain an lts in the columnar format.");
+  }
+  if (read_uint64(stream) != columnar_lts_version)
+  {
+    throw mcrl2::runtime_error("The columnar lts file has an unsupported version.");
+  }
+}
+
+/// \brief The number of bytes from the current position to the end of the stream.
+static std::uint64_t remaining_size(std::istream& stream)
+{
+  const std::istream::pos_type position = stream.tellg();
+  stream.seekg(0, std::ios_base::end);
+  const std::istream::pos_type end = stream.tellg();
+  stream.seekg(position);
+  if (position == std::istream::pos_type(-1) || end == std::istream::pos_type(-1) || end < position)
+  {
+    throw mcrl2::runtime_error("Cannot determine the size of a columnar lts file.");
+  }
+  return static_cast<std::uint64_t>(end - position);
+}
+
+/// \brief Reads the size of a section, which must not exceed the remainder of the file, as it
+///        is used to allocate memory before the section is read.
+static std::size_t read_section_size(std::istream& stream)
+{
+  const std::uint64_t size = read_uint64(stream);
+  if (size > remaining_size(stream))
+  {
+    throw mcrl2::runtime_error("A section of a columnar lts file exceeds the size of the file.");
+  }
+  return size;
+}
+
+/// \brief Encodes the transitions in [begin, end), which are sorted on their source, as one block.
+static void encode_block(std::vector<std::uint8_t>& buffer,
+                         std::vector<transition>::const_iterator begin,
+                         std::vector<transition>::const_iterator end)
+{
+  buffer.clear();
+  write_varint(buffer, static_cast<std::uint64_t>(end - begin));
+  std::size_t previous = begin->from();
+  write_varint(buffer, previous);
+  for (auto i = begin; i != end; ++i)
+  {
+    write_varint(buffer, i->from() - previous);
+    previous = i->from();
+  }
+  for (auto i = begin; i != end; ++i)
+  {
+    write_varint(buffer, i->label());
+  }
+  for (auto i = begin; i != end; ++i)
+  {
+    write_varint(buffer, zigzag_encode(static_cast<std::int64_t>(i->to()) - static_cast<std::int64_t>(i->from())));
+  }
+}
+
+/// \brief Decodes one block and appends its transitions to result.
+static void decode_block(const std::uint8_t* buffer, std::size_t size, std::vector<transition>& result)
+{
+  std::size_t position = 0;
+  const std::size_t count = read_varint(buffer, size, position);
+  std::size_t from = read_varint(buffer, size, position);
+  // Every transition takes at least one byte for each of its three varints. This bounds
+  // the count before it is used to allocate memory.
+  if (count > (size - position) / 3)
+  {
+    throw mcrl2::runtime_error("The number of transitions in a block of a columnar lts file exceeds its size.");
+  }
+  const std::size_t first = result.size();
+  result.resize(first + count);
+  for (std::size_t i = first; i < first + count; ++i)
+  {
+    from += read_varint(buffer, size, position);
+    result[i].set_from(from);
+  }
+  for (std::size_t i = first; i < first + count; ++i)
+  {
+    result[i].set_label(read_varint(buffer, size, position));
+  }
+  for (std::size_t i = first; i < first + count; ++i)
+  {
+    result[i].set_to(static_cast<std::size_t>(static_cast<std::int64_t>(result[i].from()) + zigzag_decode(read_varint(buffer, size, position))));
+  }
+}
+
+bool is_columnar_lts_file(const std::string& filename)
+{
+  std::ifstream stream(filename, std::ifstream::in | std::ifstream::binary);
+  char magic[columnar_lts_magic_size];
+  stream.read(magic, columnar_lts_magic_size);
+  return stream.gcount() == static_cast<std::streamsize>(columnar_lts_magic_size) &&
+         std::memcmp(magic, columnar_lts_magic, columnar_lts_magic_size) == 0;
+}
+
+void write_columnar_lts(std::ostream& stream, const lts_lts_t& lts, std::size_t block_size)
+{
+  assert(block_size > 0);
+  stream.write(columnar_lts_magic, columnar_lts_magic_size);
+  write_uint64(stream, columnar_lts_version);
+
+  // All terms are written to one binary aterm stream, which is preceded by its length.
+  std::ostringstream terms;
+  {
+    atermpp::binary_aterm_ostream term_stream(terms);
+    term_stream << data::detail::remove_index_impl;
+    term_stream << lts.data();
+    term_stream << lts.process_parameters();
+    term_stream << lts.action_label_declarations();
+    term_stream << atermpp::aterm_int(lts.num_action_labels());
+    for (std::size_t i = 0; i < lts.num_action_labels(); ++i)
+    {
+      term_stream << lts.action_label(i);
+    }
+    term_stream << atermpp::aterm_int(lts.has_state_info() ? lts.num_state_labels() : 0);
+    if (lts.has_state_info())
+    {
+      for (std::size_t i = 0; i < lts.num_state_labels(); ++i)
+      {
+        term_stream << lts.state_label(i);
+      }
+    }
+    term_stream << atermpp::aterm_int(lts.initial_state());
+  }
+  const std::string term_section = terms.str();
+  write_uint64(stream, term_section.size());
+  stream.write(term_section.data(), static_cast<std::streamsize>(term_section.size()));
+
+  // Sort a copy of the transitions on their source, and apply the hidden label map.
+  std::vector<transition> transitions = lts.get_transitions();
+  for (transition& t: transitions)
+  {
+    t.set_label(lts.apply_hidden_label_map(t.label()));
+  }
+  std::sort(transitions.begin(), transitions.end());
+
+  const std::size_t number_of_blocks = (transitions.size() + block_size - 1) / block_size;
+  write_uint64(stream, lts.num_states());
+  write_uint64(stream, transitions.size());
+  write_uint64(stream, number_of_blocks);
+
+  std::uint64_t offset = columnar_lts_magic_size + 8 + 8 + term_section.size() + 3*8;
+  std::vector<columnar_block_info> index;
+  std::vector<std::uint8_t> buffer;
+  for (std::size_t begin = 0; begin < transitions.size(); begin += block_size)
+  {
+    const std::size_t end = std::min(begin + block_size, transitions.size());
+    encode_block(buffer, transitions.begin() + begin, transitions.begin() + end);
+    index.push_back({offset, transitions[begin].from(), transitions[end - 1].from(), end - begin});
+    write_uint64(stream, buffer.size());
+    stream.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+    offset += 8 + buffer.size();
+  }
+
+  for (const columnar_block_info& block: index)
+  {
+    write_uint64(stream, block.offset);
+    write_uint64(stream, block.first_from);
+    write_uint64(stream, block.last_from);
+    write_uint64(stream, block.size);
+  }
+  write_uint64(stream, offset);
+
+  if (stream.fail())
+  {
+    throw mcrl2::runtime_error("Failed to write a columnar lts.");
+  }
+}
+
+void read_columnar_lts(std::istream& stream, lts_lts_t& lts)
+{
+  read_magic(stream);
+
+  const std::size_t term_section_size = read_section_size(stream);
+  std::string term_section(term_section_size, '\0');
+  stream.read(term_section.data(), static_cast<std::streamsize>(term_section_size));
+  if (stream.gcount() != static_cast<std::streamsize>(term_section_size))
+  {
+    throw mcrl2::runtime_error("Unexpected end of a columnar lts file.");
+  }
+
+  std::size_t initial_state;
+  {
+    std::istringstream terms(term_section);
+    atermpp::binary_aterm_istream term_stream(terms);
+    term_stream >> data::detail::add_index_impl;
+
+    data::data_specification spec;
+    data::variable_list parameters;
+    process::action_label_list action_labels;
+    term_stream >> spec;
+    term_stream >> parameters;
+    term_stream >> action_labels;
+    lts.set_data(spec);
+    lts.set_process_parameters(parameters);
+    lts.set_action_label_declarations(action_labels);
+
+    atermpp::aterm_int count;
+    term_stream >> count;
+    // Every action label takes at least one byte of the term section.
+    if (count.value() > term_section_size)
+    {
+      throw mcrl2::runtime_error("The number of action labels in the columnar lts file exceeds its size.");
+    }
+    lts.set_num_action_labels(count.value());
+    action_label_lts action;
+    for (std::size_t i = 0; i < count.value(); ++i)
+    {
+      term_stream >> action;
+      if (i != 0)
+      {
+        lts.set_action_label(i, action);
+      }
+    }
+
+    term_stream >> count;
+    atermpp::aterm label;
+    for (std::size_t i = 0; i < count.value(); ++i)
+    {
+      term_stream >> label;
+      lts.add_state(reinterpret_cast<const state_label_lts&>(label));
+    }
+
+    term_stream >> count;
+    initial_state = count.value();
+  }
+
+  const std::size_t number_of_states = read_uint64(stream);
+  const std::size_t number_of_transitions = read_uint64(stream);
+  const std::size_t number_of_blocks = read_uint64(stream);
+
+  // A block takes at least eight bytes for its size, and a transition at least three bytes.
+  const std::uint64_t remaining = remaining_size(stream);
+  if (number_of_blocks > remaining / 8 || number_of_transitions > remaining / 3)
+  {
+    throw mcrl2::runtime_error("The number of transitions in the columnar lts file exceeds its size.");
+  }
+
+  // Every block is preceded by its size in bytes, and is read with a single read.
+  std::vector<std::uint8_t> buffer;
+  std::vector<transition>& transitions = lts.get_transitions();
+  transitions.reserve(number_of_transitions);
+  for (std::size_t i = 0; i < number_of_blocks; ++i)
+  {
+    buffer.resize(read_section_size(stream));
+    stream.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+    if (stream.gcount() != static_cast<std::streamsize>(buffer.size()))
+    {
+      throw mcrl2::runtime_error("Unexpected end of a columnar lts file.");
+    }
+    decode_block(buffer.data(), buffer.size(), transitions);
+  }
+
+  if (transitions.size() != number_of_transitions)
+  {
+    throw mcrl2::runtime_error("The number of transitions in the columnar lts file is not correct.");
+  }
+
+  // The header is not trusted, as states and labels are used as indices by the users of an lts.
+  if (initial_state >= number_of_states ||
+      (lts.has_state_info() && lts.num_state_labels() != number_of_states) ||
+      std::any_of(transitions.begin(), transitions.end(), [&](const transition& t)
+                  { return t.from() >= number_of_states || t.to() >= number_of_states || t.label() >= lts.num_action_labels(); }))
+  {
+    throw mcrl2::runtime_error("The columnar lts file refers to a state or an action label that does not exist.");
+  }
+
+  lts.set_num_states(number_of_states, lts.has_state_info());
+  lts.set_initial_state(initial_state);
+}
+
+columnar_lts_file::columnar_lts_file(const std::string& filename)
+  : m_stream(filename, std::ifstream::in | std::ifstream::binary)
+{
+  if (!m_stream)
+  {
+    throw mcrl2::runtime_error("Fail to open file " + filename + " to read an lts.");
+  }
+  read_magic(m_stream);
+  const std::size_t term_section_size = read_section_size(m_stream);
+  m_stream.seekg(static_cast<std::streamoff>(term_section_size), std::ios_base::cur);
+  m_number_of_states = read_uint64(m_stream);
+  m_number_of_transitions = read_uint64(m_stream);
+  const std::size_t number_of_blocks = read_uint64(m_stream);
+
+  m_stream.seekg(-8, std::ios_base::end);
+  const std::uint64_t index_offset = read_uint64(m_stream);
+  const std::uint64_t file_size = static_cast<std::uint64_t>(m_stream.tellg());
+  // Every block has four words in the index, which ends with the word holding its offset.
+  if (index_offset > file_size - 8 || number_of_blocks > (file_size - 8 - index_offset) / 32)
+  {
+    throw mcrl2::runtime_error("The block index of the columnar lts file " + filename + " exceeds the size of the file.");
+  }
+  m_stream.seekg(static_cast<std::streamoff>(index_offset));
+  m_blocks.resize(number_of_blocks);
+  for (columnar_block_info& block: m_blocks)
+  {
+    block.offset = read_uint64(m_stream);
+    block.first_from = read_uint64(m_stream);
+    block.last_from = read_uint64(m_stream);
+    block.size = read_uint64(m_stream);
+  }
+}
+
+void columnar_lts_file::read_block(std::size_t block, std::vector<transition>& result) const
+{
+  assert(block < m_blocks.size());
+  m_stream.seekg(static_cast<std::streamoff>(m_blocks[block].offset));
+  std::vector<std::uint8_t> buffer(read_section_size(m_stream));
+  m_stream.read(reinterpret_cast<char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+  if (m_stream.gcount() != static_cast<std::streamsize>(buffer.size()))
+  {
+    throw mcrl2::runtime_error("Unexpected end of a columnar lts file.");
+  }
+  decode_block(buffer.data(), buffer.size(), result);
+}
+
+std::vector<transition> columnar_lts_file::outgoing_transitions(std::size_t state) const
+{
+  std::vector<transition> result;
+  auto block = std::lower_bound(m_blocks.begin(), m_blocks.end(), state,
+                                [](const columnar_block_info& b, std::size_t s) { return b.last_from < s; });
+  std::vector<transition> buffer;
+  for (; block != m_blocks.end() && block->first_from <= state; ++block)
+  {
+    buffer.clear();
+    read_block(static_cast<std::size_t>(block - m_blocks.begin()), buffer);
+    for (const transition& t: buffer)
+    {
+      if (t.from() == state)
+      {
+        result.push_back(t);
+      }
+    }
+  }
+  return result;
+}
+
+} // namespace mcrl2::lts::detail
@@ -0,0 +1,340 @@
+// Author(s): agent
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file liblts_mapped.cpp
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <sstream>
+
+#include "mcrl2/atermpp/aterm_io_binary.h"
+#include "mcrl2/data/detail/io.h"
+#include "mcrl2/lts/detail/lts_columnar_io.h"
+#include "mcrl2/lts/mapped_lts.h"
+#include "mcrl2/utilities/platform.h"
+
+#ifndef MCRL2_PLATFORM_WINDOWS
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+namespace mcrl2::lts
+{
+
+// The transitions in the file are used as lts::transition objects directly.
+static_assert(sizeof(transition) == 3*sizeof(std::uint64_t) && std::is_standard_layout_v<transition>,
+              "The mapped lts format requires that a transition consists of three 64 bit integers.");
+
+namespace detail
+{
+
+// The header consists of the following 64 bit words.
+enum mapped_lts_header_word
+{
+  mapped_magic,
+  mapped_version,
+  mapped_num_states,
+  mapped_num_transitions,
+  mapped_num_state_labels,
+  mapped_initial_state,
+  mapped_transitions_offset,
+  mapped_indices_offset,
+  mapped_terms_offset,
+  mapped_terms_size,
+  mapped_state_labels_offset,
+  mapped_state_labels_size,
+  mapped_header_size
+};
+
+static std::string write_terms(const std::function<void(atermpp::aterm_ostream&)>& f)
+{
+  std::ostringstream terms;
+  {
+    atermpp::binary_aterm_ostream stream(terms);
+    stream << data::detail::remove_index_impl;
+    f(stream);
+  }
+  return terms.str();
+}
+
+static std::size_t padding(std::size_t size)
+{
+  return (8 - size % 8) % 8;
+}
+
+// Returns whether count elements of element_size bytes starting at offset lie within a
+// file of file_size bytes. The offset must be a multiple of alignment. The
+// comparisons are arranged such that they cannot overflow.
+static bool section_fits(std::uint64_t offset, std::uint64_t count, std::size_t element_size,
+                         std::size_t alignment, std::size_t file_size)
+{
+  return offset % alignment == 0 &&
+         offset <= file_size &&
+         count <= (file_size - offset) / element_size;
+}
+
+bool is_mapped_lts_file(const std::string& filename)
+{
+  std::ifstream stream(filename, std::ifstream::in | std::ifstream::binary);
+  char magic[8];
+  stream.read(magic, 8);
+  return stream.gcount() == 8 && std::memcmp(magic, mapped_lts_magic, 8) == 0;
+}
+
+void write_mapped_lts(std::ostream& stream, const lts_lts_t& lts)
+{
+  std::vector<transition> transitions = lts.get_transitions();
+  for (transition& t: transitions)
+  {
+    t.set_label(lts.apply_hidden_label_map(t.label()));
+  }
+  std::sort(transitions.begin(), transitions.end());
+
+  const std::string terms = write_terms([&](atermpp::aterm_ostream& s)
+    {
+      s << lts.data();
+      s << lts.process_parameters();
+      s << lts.action_label_declarations();
+      s << atermpp::aterm_int(lts.num_action_labels());
+      for (std::size_t i = 0; i < lts.num_action_labels(); ++i)
+      {
+        s << lts.action_label(i);
+      }
+    });
+  const std::size_t num_state_labels = lts.has_state_info() ? lts.num_state_labels() : 0;
+  const std::string state_labels = write_terms([&](atermpp::aterm_ostream& s)
+    {
+      for (std::size_t i = 0; i < num_state_labels; ++i)
+      {
+        s << lts.state_label(i);
+      }
+    });
+
+  std::vector<std::uint64_t> header(mapped_header_size);
+  std::memcpy(&header[mapped_magic], mapped_lts_magic, 8);
+  header[mapped_version] = mapped_lts_version;
+  header[mapped_num_states] = lts.num_states();
+  header[mapped_num_transitions] = transitions.size();
+  header[mapped_num_state_labels] = num_state_labels;
+  header[mapped_initial_state] = lts.initial_state();
+  header[mapped_transitions_offset] = mapped_header_size*8;
+  header[mapped_indices_offset] = header[mapped_transitions_offset] + transitions.size()*sizeof(transition);
+  header[mapped_terms_offset] = header[mapped_indices_offset] + (lts.num_states() + 1)*8;
+  header[mapped_terms_size] = terms.size();
+  header[mapped_state_labels_offset] = header[mapped_terms_offset] + terms.size() + padding(terms.size());
+  header[mapped_state_labels_size] = state_labels.size();
+
+  // The magic string is written as is, the other words in little endian order.
+  stream.write(mapped_lts_magic, 8);
+  for (std::size_t i = mapped_version; i < mapped_header_size; ++i)
+  {
+    write_uint64(stream, header[i]);
+  }
+  for (const transition& t: transitions)
+  {
+    write_uint64(stream, t.from());
+    write_uint64(stream, t.label());
+    write_uint64(stream, t.to());
+  }
+  std::size_t index = 0;
+  for (std::size_t s = 0; s <= lts.num_states(); ++s)
+  {
+    while (index < transitions.size() && transitions[index].from() < s)
+    {
+      ++index;
+    }
+    write_uint64(stream, index);
+  }
+  const char zeroes[8] = {};
+  stream.write(terms.data(), static_cast<std::streamsize>(terms.size()));
+  stream.write(zeroes, static_cast<std::streamsize>(padding(terms.size())));
+  stream.write(state_labels.data(), static_cast<std::streamsize>(state_labels.size()));
+
+  if (stream.fail())
+  {
+    throw mcrl2::runtime_error("Failed to write a mapped lts.");
+  }
+}
+
+} // namespace detail
+
+using namespace detail;
+
+mapped_lts::mapped_lts(const std::string& filename)
+{
+  if constexpr (std::endian::native != std::endian::little)
+  {
+    throw mcrl2::runtime_error("Mapped lts files can only be used on little endian machines.");
+  }
+
+#ifdef MCRL2_PLATFORM_WINDOWS
+  std::ifstream stream(filename, std::ifstream::in | std::ifstream::binary | std::ifstream::ate);
+  if (!stream)
+  {
+    throw mcrl2::runtime_error("Fail to open file " + filename + " to read an lts.");
+  }
+  m_size = static_cast<std::size_t>(stream.tellg());
+  m_buffer.resize((m_size + 7) / 8);
+  stream.seekg(0);
+  stream.read(reinterpret_cast<char*>(m_buffer.data()), static_cast<std::streamsize>(m_size));
+  m_words = m_buffer.data();
+#else
+  int fd = open(filename.c_str(), O_RDONLY);
+  if (fd == -1)
+  {
+    throw mcrl2::runtime_error("Fail to open file " + filename + " to read an lts.");
+  }
+  struct stat status;
+  if (fstat(fd, &status) == -1)
+  {
+    close(fd);
+    throw mcrl2::runtime_error("Fail to determine the size of file " + filename + ".");
+  }
+  m_size = static_cast<std::size_t>(status.st_size);
+  void* data = (m_size == 0 ? MAP_FAILED : mmap(nullptr, m_size, PROT_READ, MAP_SHARED, fd, 0));
+  close(fd);
+  if (data == MAP_FAILED)
+  {
+    throw mcrl2::runtime_error("Fail to map file " + filename + " into memory.");
+  }
+  m_words = static_cast<const std::uint64_t*>(data);
+#endif
+
+  if (m_size < mapped_header_size*8 || std::memcmp(m_words, mapped_lts_magic, 8) != 0)
+  {
+    unmap();
+    throw mcrl2::runtime_error("The file " + filename + " does not contain an lts in the mapped format.");
+  }
+  if (m_words[mapped_version] != mapped_lts_version)
+  {
+    unmap();
+    throw mcrl2::runtime_error("The mapped lts file " + filename + " has an unsupported version.");
+  }
+
+  m_num_states = m_words[mapped_num_states];
+  m_num_transitions = m_words[mapped_num_transitions];
+  m_num_state_labels = m_words[mapped_num_state_labels];
+  m_initial_state = m_words[mapped_initial_state];
+  m_state_labels_offset = m_words[mapped_state_labels_offset];
+  m_state_labels_size = m_words[mapped_state_labels_size];
+  if (m_num_states == std::numeric_limits<std::uint64_t>::max() ||
+      !detail::section_fits(m_words[mapped_transitions_offset], m_num_transitions, sizeof(transition), alignof(transition), m_size) ||
+      !detail::section_fits(m_words[mapped_indices_offset], m_num_states + 1, sizeof(std::uint64_t), alignof(std::uint64_t), m_size) ||
+      !detail::section_fits(m_words[mapped_terms_offset], m_words[mapped_terms_size], 1, 1, m_size) ||
+      !detail::section_fits(m_state_labels_offset, m_state_labels_size, 1, 1, m_size))
+  {
+    unmap();
+    throw mcrl2::runtime_error("The mapped lts file " + filename + " is truncated.");
+  }
+
+  const char* bytes = reinterpret_cast<const char*>(m_words);
+  m_transitions = reinterpret_cast<const transition*>(bytes + m_words[mapped_transitions_offset]);
+  m_indices = reinterpret_cast<const std::uint64_t*>(bytes + m_words[mapped_indices_offset]);
+
+  // The index must be a non decreasing sequence from 0 to the number of transitions,
+  // as outgoing transitions are looked up through it without further checks.
+  if (m_indices[0] != 0 || m_indices[m_num_states] != m_num_transitions ||
+      std::adjacent_find(m_indices, m_indices + m_num_states + 1, std::greater<std::uint64_t>()) != m_indices + m_num_states + 1)
+  {
+    unmap();
+    throw mcrl2::runtime_error("The mapped lts file " + filename + " has an invalid transition index.");
+  }
+
+  try
+  {
+    std::istringstream terms(std::string(bytes + m_words[mapped_terms_offset], m_words[mapped_terms_size]));
+    atermpp::binary_aterm_istream stream(terms);
+    stream >> data::detail::add_index_impl;
+    stream >> m_data;
+    stream >> m_parameters;
+    stream >> m_action_label_declarations;
+    atermpp::aterm_int count;
+    stream >> count;
+    m_action_labels.resize(count.value());
+    for (action_label_lts& a: m_action_labels)
+    {
+      stream >> a;
+    }
+  }
+  catch (...)
+  {
+    unmap();
+    throw;
+  }
+
+  // States and labels are used as indices by the users of a mapped lts, so they are checked once here.
+  if (m_initial_state >= m_num_states ||
+      std::any_of(m_transitions, m_transitions + m_num_transitions, [this](const transition& t)
+                  { return t.from() >= m_num_states || t.to() >= m_num_states || t.label() >= m_action_labels.size(); }))
+  {
+    unmap();
+    throw mcrl2::runtime_error("The mapped lts file " + filename + " refers to a state or an action label that does not exist.");
+  }
+}
+
+mapped_lts::~mapped_lts()
+{
+  unmap();
+}
+
+void mapped_lts::unmap()
+{
+#ifndef MCRL2_PLATFORM_WINDOWS
+  if (m_words != nullptr)
+  {
+    munmap(const_cast<std::uint64_t*>(m_words), m_size);
+  }
+#endif
+  m_words = nullptr;
+}
+
+void mapped_lts::read_state_labels() const
+{
+  if (m_state_labels.size() == m_num_state_labels)
+  {
+    return;
+  }
+  const char* bytes = reinterpret_cast<const char*>(m_words);
+  std::istringstream labels(std::string(bytes + m_state_labels_offset, m_state_labels_size));
+  atermpp::binary_aterm_istream stream(labels);
+  stream >> data::detail::add_index_impl;
+  m_state_labels.clear();
+  m_state_labels.reserve(m_num_state_labels);
+  atermpp::aterm label;
+  for (std::size_t i = 0; i < m_num_state_labels; ++i)
+  {
+    stream >> label;
+    m_state_labels.push_back(reinterpret_cast<const state_label_lts&>(label));
+  }
+}
+
+void mapped_lts::copy_to(lts_lts_t& result) const
+{
+  result.set_data(m_data);
+  result.set_process_parameters(m_parameters);
+  result.set_action_label_declarations(m_action_label_declarations);
+  result.set_num_action_labels(m_action_labels.size());
+  for (std::size_t i = 1; i < m_action_labels.size(); ++i)
+  {
+    result.set_action_label(i, m_action_labels[i]);
+  }
+  for (std::size_t i = 0; i < m_num_state_labels; ++i)
+  {
+    result.add_state(state_label(i));
+  }
+  result.set_num_states(m_num_states, has_state_info());
+  result.get_transitions().assign(m_transitions, m_transitions + m_num_transitions);
+  result.set_initial_state(m_initial_state);
+}
+
+} // namespace mcrl2::lts
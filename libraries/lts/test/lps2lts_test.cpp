@@ -18,6 +18,7 @@
 
 #include "mcrl2/data/detail/rewrite_strategies.h"
 #include "mcrl2/lps/is_stochastic.h"
+#include "mcrl2/lts/incremental_state_space_generator.h"
 #include "mcrl2/lts/state_space_generator.h"
 #include "mcrl2/lts/stochastic_lts_builder.h"
 #include "mcrl2/utilities/test_utilities.h"
@@ -660,3 +661,183 @@ BOOST_AUTO_TEST_CASE(test_whether_action_a_b_and_b_a_are_the_same)   // Related
 }
 
 
+BOOST_AUTO_TEST_CASE(test_deadlock_trace)
+{
+  std::string spec(
+    "act a: Nat;\n"
+    "    b;\n"
+    "proc P(n: Nat) = (n < 3) -> a(n) . P(n + 1)\n"
+    "               + (n == 1) -> b . P(0);\n"
+    "init P(0);\n"
+  );
+  lps::specification lpsspec = lps::parse_linear_process_specification(spec);
+
+  for (lps::exploration_strategy estrategy: { lps::es_breadth, lps::es_depth })
+  {
+    lps::explorer_options options;
+    options.trace_prefix = "lps2lts_test";
+    options.search_strategy = estrategy;
+    options.detect_deadlock = true;
+    options.generate_traces = true;
+    options.max_traces = 1;
+    options.rewrite_actions = true;
+
+    data::rewriter rewr = lps::construct_rewriter(lpsspec, options.rewrite_strategy, options.remove_unused_rewrite_rules);
+    lps::explorer<false, false, lps::specification> explorer(lpsspec, options, rewr);
+    lts::state_space_generator<false, false, lps::specification> generator(lpsspec, options, explorer);
+    auto builder = create_lts_builder(lpsspec, options, lts::lts_none);
+    generator.explore(*builder);
+
+    std::string filename = "lps2lts_test_dlk_0.trc";
+    lts::trace tr(filename);
+    BOOST_CHECK_EQUAL(tr.number_of_actions(), 3u);
+    BOOST_CHECK_EQUAL(tr.number_of_states(), 4u);
+    std::ostringstream out;
+    out << tr;
+    BOOST_CHECK_EQUAL(out.str(), "a(0).a(1).a(2)");
+    std::remove(filename.c_str());
+  }
+}
+
+static lts::lts_lts_t generate_lts_lts(const lps::specification& lpsspec,
+                                      const lps::explorer_options& options,
+                                      const std::string& filename)
+{
+  data::rewriter rewr = lps::construct_rewriter(lpsspec, options.rewrite_strategy, options.remove_unused_rewrite_rules);
+  lps::explorer<false, false, lps::specification> explorer(lpsspec, options, rewr);
+  lts::state_space_generator<false, false, lps::specification> generator(lpsspec, options, explorer);
+  auto builder = create_lts_builder(lpsspec, options, lts::lts_lts);
+  generator.explore(*builder);
+  builder->save(filename);
+  lts::lts_lts_t result;
+  result.load(filename);
+  std::remove(filename.c_str());
+  return result;
+}
+
+static std::multiset<std::string> transition_strings(const lts::lts_lts_t& l)
+{
+  std::multiset<std::string> result;
+  for (const lts::transition& t: l.get_transitions())
+  {
+    result.insert(pp(l.state_label(t.from())) + " -" + pp(l.action_label(t.label())) + "-> " + pp(l.state_label(t.to())));
+  }
+  return result;
+}
+
+static void check_incremental_generation(const std::string& old_spec,
+                                         const std::string& spec,
+                                         std::size_t expected_removed,
+                                         std::size_t expected_added,
+                                         bool expected_comparable = true)
+{
+  lps::specification old_lpsspec = lps::parse_linear_process_specification(old_spec);
+  lps::specification lpsspec = lps::parse_linear_process_specification(spec);
+
+  for (data::rewrite_strategy rstrategy: data::detail::get_test_rewrite_strategies(false))
+  {
+    lps::explorer_options options;
+    options.rewrite_strategy = rstrategy;
+    options.search_strategy = lps::es_breadth;
+    options.rewrite_actions = true;
+    options.save_at_end = true;
+    lts::lts_lts_t old_lts = generate_lts_lts(old_lpsspec, options, "lps2lts_test_incremental_old.lts");
+    lts::lts_lts_t expected = generate_lts_lts(lpsspec, options, "lps2lts_test_incremental_expected.lts");
+
+    data::rewriter old_rewr = lps::construct_rewriter(old_lpsspec, options.rewrite_strategy, options.remove_unused_rewrite_rules);
+    lps::explorer<false, false, lps::specification> old_explorer(old_lpsspec, options, old_rewr);
+    data::rewriter rewr = lps::construct_rewriter(lpsspec, options.rewrite_strategy, options.remove_unused_rewrite_rules);
+    lps::explorer<false, false, lps::specification> explorer(lpsspec, options, rewr);
+    lts::incremental_state_space_generator generator(old_lpsspec, lpsspec, old_explorer, explorer);
+    BOOST_CHECK_EQUAL(generator.difference().comparable, expected_comparable);
+    BOOST_CHECK_EQUAL(generator.difference().removed.size(), expected_removed);
+    BOOST_CHECK_EQUAL(generator.difference().added.size(), expected_added);
+
+    auto builder = create_lts_builder(lpsspec, options, lts::lts_lts);
+    BOOST_CHECK(generator.explore(old_lts, *builder));
+    std::string filename = "lps2lts_test_incremental.lts";
+    builder->save(filename);
+    lts::lts_lts_t result;
+    result.load(filename);
+    std::remove(filename.c_str());
+
+    BOOST_CHECK_EQUAL(result.num_states(), expected.num_states());
+    BOOST_CHECK_EQUAL(result.num_transitions(), expected.num_transitions());
+    BOOST_CHECK(transition_strings(result) == transition_strings(expected));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_incremental_generation)
+{
+  std::string old_spec(
+    "map lim: Nat;\n"
+    "eqn lim = 3;\n"
+    "act a, b: Nat;\n"
+    "    c;\n"
+    "proc P(n: Nat, m: Nat) = (n < lim) -> a(n) . P(n + 1, m)\n"
+    "                       + (n == 1) -> b(m) . P(0, m)\n"
+    "                       + (m < 2) -> c . P(n, m + 1);\n"
+    "init P(0, 0);\n"
+  );
+
+  // A summand is changed.
+  std::string spec1(
+    "map lim: Nat;\n"
+    "eqn lim = 3;\n"
+    "act a, b: Nat;\n"
+    "    c;\n"
+    "proc P(n: Nat, m: Nat) = (n < lim) -> a(n) . P(n + 1, m)\n"
+    "                       + (n == 2) -> b(m) . P(0, m)\n"
+    "                       + (m < 2) -> c . P(n, m + 1);\n"
+    "init P(0, 0);\n"
+  );
+  check_incremental_generation(old_spec, spec1, 1, 1);
+
+  // A data equation is changed, which affects the first summand.
+  std::string spec2(
+    "map lim: Nat;\n"
+    "eqn lim = 5;\n"
+    "act a, b: Nat;\n"
+    "    c;\n"
+    "proc P(n: Nat, m: Nat) = (n < lim) -> a(n) . P(n + 1, m)\n"
+    "                       + (n == 1) -> b(m) . P(0, m)\n"
+    "                       + (m < 2) -> c . P(n, m + 1);\n"
+    "init P(0, 0);\n"
+  );
+  check_incremental_generation(old_spec, spec2, 1, 1);
+
+  // A summand is added.
+  std::string spec3(
+    "map lim: Nat;\n"
+    "eqn lim = 3;\n"
+    "act a, b: Nat;\n"
+    "    c;\n"
+    "proc P(n: Nat, m: Nat) = (n < lim) -> a(n) . P(n + 1, m)\n"
+    "                       + (n == 1) -> b(m) . P(0, m)\n"
+    "                       + (m < 2) -> c . P(n, m + 1)\n"
+    "                       + (m == 2) -> c . P(n, 0);\n"
+    "init P(0, 0);\n"
+  );
+  check_incremental_generation(old_spec, spec3, 0, 1);
+}
+
+BOOST_AUTO_TEST_CASE(test_incremental_generation_confluent_summand)
+{
+  // The summands with action ctau are confluent, so the state space is generated again when one of them changes.
+  std::string old_spec(
+    "act a: Nat;\n"
+    "    ctau;\n"
+    "proc P(n: Nat, m: Nat) = (n < 3) -> a(n) . P(n + 1, m)\n"
+    "                       + (m < 1) -> ctau . P(n, m + 1);\n"
+    "init P(0, 0);\n"
+  );
+
+  std::string spec(
+    "act a: Nat;\n"
+    "    ctau;\n"
+    "proc P(n: Nat, m: Nat) = (n < 3) -> a(n) . P(n + 1, m)\n"
+    "                       + (m < 2) -> ctau . P(n, m + 1);\n"
+    "init P(0, 0);\n"
+  );
+  check_incremental_generation(old_spec, spec, 1, 1, false);
+}
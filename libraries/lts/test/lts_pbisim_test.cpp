@@ -16,6 +16,7 @@
 #include "mcrl2/utilities/probabilistic_arbitrary_precision_fraction.h"
 #include "mcrl2/lts/detail/liblts_pbisim_bem.h"
 #include "mcrl2/lts/detail/liblts_pbisim_grv.h"
+#include "mcrl2/lts/detail/liblts_pbisim_sig.h"
 
 using namespace mcrl2::lts;
 
@@ -36,6 +37,7 @@ void execute_test(const std::string test_name,
   mcrl2::utilities::execution_timer timer;
   probabilistic_lts_aut_t t1 = parse_aut(input_lts);
   probabilistic_lts_aut_t t2=t1;
+  probabilistic_lts_aut_t t3=t1;
   BOOST_CHECK(t1==t2);
   detail::probabilistic_bisimulation_reduce_grv(t1,timer);
   if (t1.num_states()!=expected_number_of_states || t1.num_transitions() != expected_number_of_transitions || t1.num_probabilistic_states()!=expected_number_of_probabilistic_states)
@@ -57,6 +59,16 @@ void execute_test(const std::string test_name,
     BOOST_CHECK(false);
   }
 
+  detail::probabilistic_bisimulation_reduce_sig(t3,timer,2);
+  if (t3.num_states()!=expected_number_of_states || t3.num_transitions() != expected_number_of_transitions || t3.num_probabilistic_states()!=expected_number_of_probabilistic_states)
+  {
+    std::cerr << "The test " << test_name << " failed using signature refinement.\n";
+    std::cerr << "Expected number of states: " << expected_number_of_states << ". Actual number of states: " << t3.num_states() << "\n";
+    std::cerr << "Expected number of transitions: " << expected_number_of_transitions << ". Actual number of transitions: " << t3.num_transitions() << "\n";
+    std::cerr << "Expected number of probabilistic states: " << expected_number_of_probabilistic_states << ". Actual number of probabilistic states: " << t3.num_probabilistic_states() << "\n";
+    BOOST_CHECK(false);
+  }
+
 }
 
 // Example below represents an example using probabilistic lts.
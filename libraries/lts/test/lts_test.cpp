@@ -13,6 +13,9 @@
 #include <boost/test/included/unit_test.hpp>
 
 #include "mcrl2/lts/test/test_reductions.h"
+#include "mcrl2/lts/detail/lts_columnar_io.h"
+#include "mcrl2/lts/lts_io.h"
+#include "mcrl2/lts/mapped_lts.h"
 
 using namespace mcrl2;
 
@@ -842,4 +845,359 @@ BOOST_AUTO_TEST_CASE(hide_actions5)
                        l,expected_label_count, expected_state_count, expected_transition_count));
 }
 
+// Compare the tau closure with a straightforward fixpoint calculation, on an lts
+// with tau loops, a long tau chain and hidden actions.
+BOOST_AUTO_TEST_CASE(tau_closure_test)
+{
+  std::string automaton =
+     "des (0,12,9)\n"
+     "(0,\"tau\",1)\n"
+     "(1,\"tau\",2)\n"
+     "(2,\"tau\",1)\n"
+     "(2,\"a\",3)\n"
+     "(3,\"h\",4)\n"
+     "(4,\"tau\",5)\n"
+     "(5,\"tau\",6)\n"
+     "(6,\"tau\",7)\n"
+     "(7,\"b\",8)\n"
+     "(8,\"tau\",8)\n"
+     "(0,\"tau\",6)\n"
+     "(3,\"tau\",0)\n";
+
+  std::istringstream is(automaton);
+  lts::lts_aut_t l;
+  l.load(is);
+  std::vector<std::string>hidden_actions(1,"h");
+  l.record_hidden_actions(hidden_actions);
+
+  for (const bool forward: { true, false })
+  {
+    std::vector<std::set<std::size_t>> expected(l.num_states());
+    for (const lts::transition& t: l.get_transitions())
+    {
+      if (l.is_tau(l.apply_hidden_label_map(t.label())))
+      {
+        expected[forward ? t.from() : t.to()].insert(forward ? t.to() : t.from());
+      }
+    }
+    bool changed = true;
+    while (changed)
+    {
+      changed = false;
+      for (std::set<std::size_t>& reachable: expected)
+      {
+        const std::size_t old_size = reachable.size();
+        for (const std::size_t s: std::set<std::size_t>(reachable))
+        {
+          reachable.insert(expected[s].begin(), expected[s].end());
+        }
+        changed = changed || reachable.size() != old_size;
+      }
+    }
+
+    for (const std::size_t number_of_threads: { 1, 4 })
+    {
+      const lts::detail::tau_closure closure(l, forward, number_of_threads);
+      std::size_t size = 0;
+      for (std::size_t s = 0; s < l.num_states(); ++s)
+      {
+        std::set<std::size_t> reachable;
+        closure.for_each_reachable_state(s, [&](const std::size_t t) { BOOST_CHECK(reachable.insert(t).second); });
+        BOOST_CHECK(reachable == expected[s]);
+        for (std::size_t t = 0; t < l.num_states(); ++t)
+        {
+          BOOST_CHECK(closure.reachable(s, t) == (expected[s].count(t) > 0));
+        }
+        size += reachable.size();
+      }
+      BOOST_CHECK_EQUAL(closure.size(), size);
+    }
+  }
+
+  // The reductions that use the tau closure must not depend on the number of threads.
+  for (const lts::lts_equivalence eq: { lts::lts_eq_weak_bisim, lts::lts_eq_divergence_preserving_weak_bisim, lts::lts_eq_weak_trace })
+  {
+    lts::lts_aut_t sequential(l);
+    lts::lts_aut_t parallel(l);
+    lts::reduce(sequential, eq, 1);
+    lts::reduce(parallel, eq, 4);
+    BOOST_CHECK_EQUAL(sequential.num_states(), parallel.num_states());
+    BOOST_CHECK_EQUAL(sequential.num_transitions(), parallel.num_transitions());
+    BOOST_CHECK(lts::compare(sequential, parallel, lts::lts_eq_bisim));
+    BOOST_CHECK(lts::compare(l, parallel, eq, false, "", false, 4));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(bit_relation_test)
+{
+  lts::detail::bit_relation R(3, 130);
+  R.set(0, 1);
+  R.set(0, 64);
+  R.set(0, 129);
+  R.set(1, 64);
+  R.push_back_row(0);
+  BOOST_CHECK_EQUAL(R.rows(), 4u);
+  BOOST_CHECK_EQUAL(R.count(3), 3u);
+  BOOST_CHECK(R.intersects(0, R, 1));
+  BOOST_CHECK(!R.intersects(1, R, 2));
+
+  std::vector<std::size_t> elements;
+  for (std::size_t j = R.find_next(0, 0); j != lts::detail::bit_relation::npos; j = R.find_next(0, j+1))
+  {
+    elements.push_back(j);
+  }
+  BOOST_CHECK(elements == std::vector<std::size_t>({ 1, 64, 129 }));
+
+  R.row_andnot(3, R, 1);
+  BOOST_CHECK(!R.test(3, 64) && R.test(3, 1) && R.test(3, 129));
+  R.row_or(2, R, 3);
+  R.row_and(2, R, 1);
+  BOOST_CHECK_EQUAL(R.count(2), 0u);
+  BOOST_CHECK_EQUAL(R.count(), 6u);
+}
+
+// Simulation reduction on an lts with enough blocks to let several threads take part
+// in inducing and filtering the relation on the partition must not depend on the
+// number of threads.
+BOOST_AUTO_TEST_CASE(simulation_threads_test)
+{
+  constexpr std::size_t n = 400;
+  std::ostringstream automaton;
+  automaton << "des (0," << n + n/3 + 1 << "," << n << ")\n";
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    automaton << "(" << i << ",\"a\"," << (7*i + 1) % n << ")\n";
+  }
+  for (std::size_t i = 0; i < n; i += 3)
+  {
+    automaton << "(" << i << ",\"b\"," << (13*i + 5) % n << ")\n";
+  }
+
+  std::istringstream is(automaton.str());
+  lts::lts_aut_t l;
+  l.load(is);
+
+  for (const lts::lts_equivalence eq: { lts::lts_eq_sim, lts::lts_eq_ready_sim })
+  {
+    lts::lts_aut_t sequential(l);
+    lts::lts_aut_t parallel(l);
+    lts::reduce(sequential, eq, 1);
+    lts::reduce(parallel, eq, 4);
+    BOOST_CHECK_EQUAL(sequential.num_states(), parallel.num_states());
+    BOOST_CHECK_EQUAL(sequential.num_transitions(), parallel.num_transitions());
+    BOOST_CHECK(lts::compare(sequential, parallel, lts::lts_eq_bisim));
+    BOOST_CHECK(lts::compare(l, parallel, eq, false, "", false, 4));
+  }
+  BOOST_CHECK(lts::compare(l, l, lts::lts_preorder::lts_pre_sim, false, "", false, lps::es_breadth, true, 4));
+}
+
+// Save an lts in the columnar format, with blocks that are smaller than the number of
+// transitions, and check that it is read back unchanged.
+BOOST_AUTO_TEST_CASE(columnar_lts_test)
+{
+  lts::lts_lts_t l;
+  for (const char* name: { "a", "b", "c" })
+  {
+    const process::action_label label{core::identifier_string(name), data::sort_expression_list()};
+    const process::action_list actions{process::action(label, data::data_expression_list())};
+    l.add_action(lts::action_label_lts(lps::multi_action(actions)));
+  }
+
+  const std::size_t number_of_states = 500;
+  l.set_num_states(number_of_states, false);
+  for (std::size_t i = 0; i < number_of_states; ++i)
+  {
+    l.add_transition(lts::transition(i, (i*7) % 4, (i*31 + 17) % number_of_states));
+    l.add_transition(lts::transition(i, 1, (i + 1) % number_of_states));
+    if (i % 3 == 0)
+    {
+      l.add_transition(lts::transition(i, 2, i / 2));
+    }
+  }
+  l.set_initial_state(3);
+
+  const std::string filename = "columnar_lts_test.ltsc";
+  {
+    std::ofstream out(filename, std::ios_base::binary);
+    lts::detail::write_columnar_lts(out, l, 64);
+  }
+  BOOST_CHECK(lts::detail::is_columnar_lts_file(filename));
+  BOOST_CHECK_EQUAL(lts::detail::guess_format(filename), lts::lts_lts);
+
+  lts::lts_lts_t l2;
+  l2.load(filename);
+  BOOST_CHECK_EQUAL(l2.num_states(), l.num_states());
+  BOOST_CHECK_EQUAL(l2.initial_state(), l.initial_state());
+  BOOST_CHECK_EQUAL(l2.num_action_labels(), l.num_action_labels());
+  for (std::size_t i = 0; i < l.num_action_labels(); ++i)
+  {
+    BOOST_CHECK(l2.action_label(i) == l.action_label(i));
+  }
+  std::vector<lts::transition> expected = l.get_transitions();
+  std::sort(expected.begin(), expected.end());
+  BOOST_CHECK(l2.get_transitions() == expected);
+
+  lts::detail::columnar_lts_file file(filename);
+  BOOST_CHECK_EQUAL(file.num_transitions(), expected.size());
+  BOOST_CHECK(file.blocks().size() > 1);
+  for (std::size_t s: { std::size_t(0), std::size_t(63), std::size_t(300), number_of_states - 1 })
+  {
+    std::vector<lts::transition> outgoing;
+    std::copy_if(expected.begin(), expected.end(), std::back_inserter(outgoing),
+                 [s](const lts::transition& t) { return t.from() == s; });
+    BOOST_CHECK(file.outgoing_transitions(s) == outgoing);
+  }
+
+  std::string contents;
+  {
+    std::ifstream in(filename, std::ios_base::binary);
+    contents.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+  }
+  auto write_corrupted = [&](const std::string& corrupted)
+  {
+    std::ofstream out(filename, std::ios_base::binary);
+    out << corrupted;
+  };
+  auto check_corrupted = [&](std::size_t position, std::uint64_t value)
+  {
+    std::string corrupted = contents;
+    for (std::size_t i = 0; i < 8; ++i)
+    {
+      corrupted[position + i] = static_cast<char>((value >> (8*i)) & 0xff);
+    }
+    write_corrupted(corrupted);
+  };
+
+  // Sizes and counts in the header that exceed the file must be reported before they are
+  // used to allocate memory, and so must a number of states that is too small for the
+  // initial state and the transitions.
+  std::istringstream header(contents.substr(lts::detail::columnar_lts_magic_size + 8, 8));
+  const std::size_t term_section_size = lts::detail::read_uint64(header);
+  const std::size_t counts = lts::detail::columnar_lts_magic_size + 16 + term_section_size;
+  for (const auto& [position, value]: { std::pair<std::size_t, std::uint64_t>(lts::detail::columnar_lts_magic_size + 8, std::uint64_t(1) << 40),
+                                         { counts, 0 }, { counts, 2 },
+                                         { counts + 8, std::uint64_t(1) << 40 }, { counts + 16, std::uint64_t(1) << 40 },
+                                         { counts + 24, std::uint64_t(1) << 40 } })
+  {
+    check_corrupted(position, value);
+    lts::lts_lts_t l3;
+    BOOST_CHECK_THROW(l3.load(filename), mcrl2::runtime_error);
+  }
+  check_corrupted(lts::detail::columnar_lts_magic_size + 8, std::uint64_t(1) << 40);
+  BOOST_CHECK_THROW(lts::detail::columnar_lts_file{filename}, mcrl2::runtime_error);
+  check_corrupted(counts + 16, std::uint64_t(1) << 40);
+  BOOST_CHECK_THROW(lts::detail::columnar_lts_file{filename}, mcrl2::runtime_error);
+  check_corrupted(contents.size() - 8, contents.size());
+  BOOST_CHECK_THROW(lts::detail::columnar_lts_file{filename}, mcrl2::runtime_error);
+
+  // Replace the contents of the first block by a block of the same size that declares far
+  // more transitions than fit in it. This must be reported, instead of allocating memory
+  // for all these transitions.
+  const std::size_t block_offset = file.blocks()[0].offset;
+  std::vector<std::uint8_t> block;
+  lts::detail::write_varint(block, std::uint64_t(1) << 60);
+  lts::detail::write_varint(block, 0);
+  std::copy(block.begin(), block.end(), contents.begin() + block_offset + 8);
+  std::fill(contents.begin() + block_offset + 8 + block.size(), contents.begin() + file.blocks()[1].offset, 0);
+  write_corrupted(contents);
+  lts::lts_lts_t l3;
+  BOOST_CHECK_THROW(l3.load(filename), mcrl2::runtime_error);
+  BOOST_CHECK_THROW(lts::detail::columnar_lts_file(filename).outgoing_transitions(0), mcrl2::runtime_error);
+
+  std::remove(filename.c_str());
+}
+
+BOOST_AUTO_TEST_CASE(mapped_lts_test)
+{
+  lts::lts_lts_t l;
+  for (const char* name: { "a", "b" })
+  {
+    const process::action_label label{core::identifier_string(name), data::sort_expression_list()};
+    const process::action_list actions{process::action(label, data::data_expression_list())};
+    l.add_action(lts::action_label_lts(lps::multi_action(actions)));
+  }
+
+  const std::size_t number_of_states = 100;
+  l.set_num_states(number_of_states, false);
+  for (std::size_t i = 0; i < number_of_states; ++i)
+  {
+    l.add_transition(lts::transition(i, (i*5) % 3, (i*13 + 7) % number_of_states));
+    if (i % 4 != 0)
+    {
+      l.add_transition(lts::transition(i, 2, (i + 1) % number_of_states));
+    }
+  }
+  l.set_initial_state(1);
+
+  const std::string filename = "mapped_lts_test.ltsm";
+  BOOST_CHECK_THROW(l.save(filename, true), mcrl2::runtime_error);
+  l.save(filename);
+  BOOST_CHECK(lts::detail::is_mapped_lts_file(filename));
+  BOOST_CHECK_EQUAL(lts::detail::guess_format(filename), lts::lts_lts);
+
+  std::vector<lts::transition> expected = l.get_transitions();
+  std::sort(expected.begin(), expected.end());
+  {
+    const lts::mapped_lts mapped(filename);
+    BOOST_CHECK_EQUAL(mapped.num_states(), l.num_states());
+    BOOST_CHECK_EQUAL(mapped.initial_state(), l.initial_state());
+    BOOST_CHECK_EQUAL(mapped.num_action_labels(), l.num_action_labels());
+    BOOST_CHECK(!mapped.has_state_info());
+    BOOST_CHECK(std::equal(expected.begin(), expected.end(), mapped.get_transitions().begin(), mapped.get_transitions().end()));
+    for (std::size_t s = 0; s < number_of_states; ++s)
+    {
+      for (const lts::transition& t: mapped.outgoing_transitions(s))
+      {
+        BOOST_CHECK_EQUAL(t.from(), s);
+      }
+    }
+    BOOST_CHECK_EQUAL(mapped.upperbound(number_of_states - 1), expected.size());
+  }
 
+  lts::lts_lts_t l2;
+  l2.load(filename);
+  BOOST_CHECK_EQUAL(l2.num_states(), l.num_states());
+  BOOST_CHECK_EQUAL(l2.initial_state(), l.initial_state());
+  for (std::size_t i = 0; i < l.num_action_labels(); ++i)
+  {
+    BOOST_CHECK(l2.action_label(i) == l.action_label(i));
+  }
+  BOOST_CHECK(l2.get_transitions() == expected);
+
+  // Offsets and sizes in the header that point outside the file, also when adding them
+  // overflows, and a transition index that is out of range must be rejected.
+  std::string contents;
+  {
+    std::ifstream in(filename, std::ios_base::binary);
+    contents.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+  }
+  const std::string corrupted_filename = "mapped_lts_test_corrupted.ltsm";
+  auto check_corrupted = [&](std::size_t position, std::uint64_t value)
+  {
+    std::string corrupted = contents;
+    for (std::size_t i = 0; i < 8; ++i)
+    {
+      corrupted[position + i] = static_cast<char>((value >> (8*i)) & 0xff);
+    }
+    {
+      std::ofstream out(corrupted_filename, std::ios_base::binary);
+      out << corrupted;
+    }
+    BOOST_CHECK_THROW(lts::mapped_lts{corrupted_filename}, mcrl2::runtime_error);
+  };
+  // The header words with the number of states and transitions, and the offsets and sizes of the sections.
+  for (const std::size_t word: { 2, 3, 6, 7, 8, 9, 10, 11 })
+  {
+    check_corrupted(8*word, std::numeric_limits<std::uint64_t>::max() - 7);
+    check_corrupted(8*word, contents.size());
+  }
+  // The index entry of the last state, which directly follows the transitions.
+  check_corrupted(8*12 + expected.size()*sizeof(lts::transition) + 8*number_of_states, expected.size() + 1);
+  // An initial state, and a label and target of the first transition, that do not exist.
+  check_corrupted(8*5, number_of_states);
+  check_corrupted(8*12 + 8, l.num_action_labels());
+  check_corrupted(8*12 + 16, number_of_states);
+  std::remove(corrupted_filename.c_str());
+
+  std::remove(filename.c_str());
+}
@@ -0,0 +1,158 @@
+// Author(s): agent
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file probabilistic_reachability_test.cpp
+/// \brief Tests for the computation of reachability probabilities of probabilistic LTSs.
+
+#define BOOST_TEST_MODULE probabilistic_reachability_test
+#include <boost/test/included/unit_test.hpp>
+
+#include "mcrl2/lts/lts_aut.h"
+#include "mcrl2/lts/probabilistic_reachability.h"
+
+using namespace mcrl2::lts;
+
+static probabilistic_lts_aut_t parse_aut(const std::string& s)
+{
+  std::stringstream is(s);
+  probabilistic_lts_aut_t l;
+  l.load(is);
+  return l;
+}
+
+static std::vector<bool> target_labels(const probabilistic_lts_aut_t& l, const std::string& name)
+{
+  std::vector<bool> result(l.num_action_labels(), false);
+  for (std::size_t i = 0; i < l.num_action_labels(); ++i)
+  {
+    result[i] = pp(l.action_label(i)) == name;
+  }
+  return result;
+}
+
+// From state 0 the scheduler either takes a, which reaches the goal with probability 1/2 unless it returns with
+// c, or it takes b, after which the goal is reached with probability 1. The states 6 and 7 form an end component
+// that can be left with x, which reaches the goal with probability 1/2.
+const std::string mdp =
+"des (0,9,8)\n"
+"(0,\"a\",1 1/2 2)\n"
+"(0,\"b\",3)\n"
+"(1,\"goal\",4)\n"
+"(2,\"c\",0)\n"
+"(2,\"d\",5)\n"
+"(3,\"e\",1 1/4 3)\n"
+"(6,\"h\",7)\n"
+"(7,\"h\",6)\n"
+"(6,\"x\",1 1/2 5)\n";
+
+static void check_probabilities(bool maximise, const std::vector<double>& expected)
+{
+  probabilistic_lts_aut_t l = parse_aut(mdp);
+  probabilistic_reachability_matrix matrix = make_reachability_matrix(l, target_labels(l, "goal"));
+  BOOST_CHECK_EQUAL(matrix.num_states(), 8u);
+  BOOST_CHECK_EQUAL(matrix.num_choices(), 9u);
+
+  for (reachability_method method: { reachability_method::value_iteration,
+                                     reachability_method::interval_iteration,
+                                     reachability_method::policy_iteration })
+  {
+    for (std::size_t threads: { 1, 2 })
+    {
+      probabilistic_reachability_options options;
+      options.method = method;
+      options.maximise = maximise;
+      options.epsilon = 1e-9;
+      options.number_of_threads = threads;
+      std::vector<double> x = probabilistic_reachability_algorithm(matrix, options).run();
+      BOOST_REQUIRE_EQUAL(x.size(), expected.size());
+      for (std::size_t s = 0; s < x.size(); ++s)
+      {
+        BOOST_CHECK_MESSAGE(std::abs(x[s] - expected[s]) < 1e-6,
+          "Method " << method << (maximise ? " (max)" : " (min)") << " computed " << x[s] << " for state " << s << " instead of " << expected[s]);
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(test_maximal_probabilities)
+{
+  check_probabilities(true, { 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.5, 0.5 });
+}
+
+BOOST_AUTO_TEST_CASE(test_minimal_probabilities)
+{
+  check_probabilities(false, { 0.5, 1.0, 0.0, 1.0, 0.0, 0.0, 0.0, 0.0 });
+}
+
+BOOST_AUTO_TEST_CASE(test_initial_distribution)
+{
+  probabilistic_lts_aut_t l = parse_aut(
+    "des (0 1/3 1,3,3)\n"
+    "(0,\"goal\",2)\n"
+    "(1,\"a\",0 1/2 2)\n"
+    "(1,\"b\",2)\n");
+  probabilistic_reachability_options options;
+  options.method = reachability_method::interval_iteration;
+  BOOST_CHECK(std::abs(reachability_probability(l, target_labels(l, "goal"), options) - 2.0 / 3) < 1e-5);
+  options.maximise = false;
+  BOOST_CHECK(std::abs(reachability_probability(l, target_labels(l, "goal"), options) - 1.0 / 3) < 1e-5);
+}
+
+// Fractions of which the enumerator and denominator do not fit in a double.
+BOOST_AUTO_TEST_CASE(test_large_fractions)
+{
+  const std::string power(400, '0');
+  const mcrl2::utilities::probabilistic_arbitrary_precision_fraction p("1" + power + "1", "3" + power + "0");
+  BOOST_CHECK(std::abs(detail::probability_to_double(p) - 1.0 / 3) < 1e-12);
+  const mcrl2::utilities::probabilistic_arbitrary_precision_fraction q("7", "8" + power);
+  BOOST_CHECK_EQUAL(detail::probability_to_double(q), 0.0);
+}
+
+// A chain of end components {2k, 2k+1} that is longer than one block of states. The exit of component k leads to
+// the goal with probability 1/2 and to component k+1 with probability 1/4, so that deflating one component reads
+// the values of the next one.
+BOOST_AUTO_TEST_CASE(test_many_end_components)
+{
+  const std::size_t components = 3000;
+  const std::size_t goal = 2 * components;
+  const std::size_t sink = goal + 2;
+  std::ostringstream aut;
+  aut << "des (0," << 3 * components + 1 << "," << sink + 1 << ")\n";
+  for (std::size_t k = 0; k < components; ++k)
+  {
+    const std::size_t next = (k + 1 < components ? 2 * (k + 1) : sink);
+    aut << "(" << 2 * k << ",\"h\"," << 2 * k + 1 << ")\n";
+    aut << "(" << 2 * k + 1 << ",\"h\"," << 2 * k << ")\n";
+    aut << "(" << 2 * k << ",\"x\"," << goal << " 1/2 " << next << " 1/4 " << sink << ")\n";
+  }
+  aut << "(" << goal << ",\"goal\"," << goal + 1 << ")\n";
+  probabilistic_lts_aut_t l = parse_aut(aut.str());
+  probabilistic_reachability_matrix matrix = make_reachability_matrix(l, target_labels(l, "goal"));
+
+  std::vector<double> expected(components);
+  expected[components - 1] = 0.5;
+  for (std::size_t k = components - 1; k > 0; --k)
+  {
+    expected[k - 1] = 0.5 + 0.25 * expected[k];
+  }
+
+  for (std::size_t threads: { 1, 4 })
+  {
+    probabilistic_reachability_options options;
+    options.method = reachability_method::interval_iteration;
+    options.epsilon = 1e-9;
+    options.number_of_threads = threads;
+    std::vector<double> x = probabilistic_reachability_algorithm(matrix, options).run();
+    BOOST_REQUIRE_EQUAL(x.size(), sink + 1);
+    for (std::size_t k = 0; k < components; ++k)
+    {
+      BOOST_CHECK(std::abs(x[2 * k] - expected[k]) < 1e-6);
+      BOOST_CHECK(std::abs(x[2 * k + 1] - expected[k]) < 1e-6);
+    }
+  }
+}
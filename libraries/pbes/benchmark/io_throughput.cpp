@@ -0,0 +1,73 @@
+// Author(s): agent
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file io_throughput.cpp
+/// \brief Measures the time to write and read a large PBES in the binary format.
+
+#include "mcrl2/pbes/io.h"
+#include "mcrl2/utilities/stopwatch.h"
+
+#include <sstream>
+
+using namespace mcrl2;
+using namespace mcrl2::pbes_system;
+
+int main(int argc, char* argv[])
+{
+  // Accept one argument for the number of equations.
+  std::size_t number_of_equations = 100000;
+  if (argc > 1)
+  {
+    number_of_equations = static_cast<std::size_t>(std::stoul(argv[1]));
+  }
+
+  // A PBES in which every equation depends on two other equations with updated parameters.
+  const data::variable n("n", data::sort_nat::nat());
+  const data::variable b("b", data::sort_bool::bool_());
+  std::vector<core::identifier_string> names;
+  for (std::size_t i = 0; i < number_of_equations; ++i)
+  {
+    names.emplace_back("X" + std::to_string(i));
+  }
+
+  std::vector<pbes_equation> equations;
+  for (std::size_t i = 0; i < number_of_equations; ++i)
+  {
+    const propositional_variable_instantiation next(names[(i + 1) % number_of_equations],
+      data::data_expression_list({data::sort_nat::plus(n, data::sort_nat::nat(1)), data::sort_bool::not_(b)}));
+    const propositional_variable_instantiation jump(names[(i * 7 + 3) % number_of_equations],
+      data::data_expression_list({data::sort_nat::nat(i), b}));
+    const pbes_expression rhs = or_(and_(pbes_expression(data::less(n, data::sort_nat::nat(i))), next), and_(pbes_expression(b), jump));
+    equations.emplace_back(i % 2 == 0 ? fixpoint_symbol::nu() : fixpoint_symbol::mu(),
+                           propositional_variable(names[i], data::variable_list({n, b})),
+                           rhs);
+  }
+
+  data::data_specification dataspec;
+  dataspec.add_context_sort(data::sort_nat::nat());
+  const pbes p(dataspec, equations,
+               propositional_variable_instantiation(names[0], data::data_expression_list({data::sort_nat::nat(0), data::sort_bool::true_()})));
+
+  std::stringstream stream;
+  stopwatch timer;
+  save_pbes(p, stream, pbes_format_internal());
+  const double write_time = timer.seconds();
+
+  timer.reset();
+  pbes result;
+  load_pbes(result, stream, pbes_format_internal());
+  const double read_time = timer.seconds();
+
+  const double megabytes = static_cast<double>(stream.str().size()) / (1024 * 1024);
+  std::cerr << "size: " << megabytes << " MiB\n";
+  std::cerr << "write: " << write_time << " s (" << megabytes / write_time << " MiB/s)\n";
+  std::cerr << "read: " << read_time << " s (" << megabytes / read_time << " MiB/s)\n";
+  std::cerr << "time: " << write_time + read_time << std::endl;
+
+  return result.equations().size() == p.equations().size() ? 0 : 1;
+}
@@ -11,6 +11,7 @@
 #define MCRL2_PBES_CONSTELM_H
 
 #include <ranges>
+#include <unordered_map>
 
 #include "mcrl2/pbes/algorithms.h"
 #include "mcrl2/pbes/pbes_rewriter_type.h"
@@ -440,9 +441,32 @@ class pbes_constelm_algorithm
         /// \brief The propositional variable instantiation that determines the target of the edge
         const propositional_variable_instantiation m_target;
 
+        /// \brief The index of the target vertex
+        std::size_t m_target_index = 0;
+
         const std::set<data::variable> m_conj_context;
         const std::set<data::variable> m_disj_context;
 
+        /// \brief The positions of the parameters of the source that occur in the conjunctive
+        /// and the disjunctive context, respectively
+        std::vector<std::size_t> m_conj_positions;
+        std::vector<std::size_t> m_disj_positions;
+
+        static std::vector<std::size_t> context_positions(const data::variable_list& parameters, const std::set<data::variable>& context)
+        {
+          std::vector<std::size_t> result;
+          std::size_t index = 0;
+          for (const data::variable& par: parameters)
+          {
+            if (context.find(par) != context.end())
+            {
+              result.push_back(index);
+            }
+            index++;
+          }
+          return result;
+        }
+
       public:
         /// \brief Constructor
         edge() = default;
@@ -455,6 +479,7 @@ class pbes_constelm_algorithm
           const propositional_variable& src,
           const qvar_list& qvars,
           const propositional_variable_instantiation& tgt,
+          std::size_t target_index,
           const std::set<data::variable>& conj_context,
           const std::set<data::variable>& disj_context,
           data::data_expression c = data::sort_bool::true_()
@@ -463,8 +488,11 @@ class pbes_constelm_algorithm
         , m_source(src)
         , m_qvars(qvars)
         , m_target(tgt)
+        , m_target_index(target_index)
         , m_conj_context(conj_context)
         , m_disj_context(disj_context)
+        , m_conj_positions(context_positions(src.parameters(), conj_context))
+        , m_disj_positions(context_positions(src.parameters(), disj_context))
         {}
 
         /// \brief Returns a string representation of the edge.
@@ -509,6 +537,12 @@ class pbes_constelm_algorithm
           return m_target;
         }
 
+        /// \brief The index of the vertex of the target of the edge
+        std::size_t target_index() const
+        {
+          return m_target_index;
+        }
+
         /// \brief The condition of the edge
         const data::data_expression& condition() const
         {
@@ -517,14 +551,11 @@ class pbes_constelm_algorithm
 
         /// \brief Try to guess which quantifiers of Q can end up directly
         /// before target, when the quantifier inside rewriter is applied.
-        qvar_list quantifier_inside_approximation(const vertex& source, const DataRewriter& rewr) const
+        /// \param target_parameter Returns the i-th parameter of the target, rewritten with the constraints of source.
+        template <typename TargetParameter>
+        qvar_list quantifier_inside_approximation(const vertex& source, TargetParameter target_parameter) const
         {
           const qvar_list& Q = source.quantified_variables();
-          const data::variable_list& par_def = source.variable().parameters();
-          const constraint_map& constraints = source.constraints();
-
-          data::rewriter::substitution_type sigma;
-          detail::make_constelm_substitution(constraints, sigma);
 
           qvar_list result;
           for (const auto& it: std::ranges::reverse_view(Q))
@@ -533,14 +564,12 @@ class pbes_constelm_algorithm
             const data::variable& var = it.variable();
             // Variable of a universal quantifier cannot occur in the disjunctive context
             // Variable of an existential quantifier cannot occur in the conjunctive context
-            const std::set<data::variable>& context = is_forall ? m_disj_context : m_conj_context;
+            const std::vector<std::size_t>& positions = is_forall ? m_disj_positions : m_conj_positions;
             bool none_occurs_in_context = true;
 
-            auto it_pvi = m_target.parameters().begin();
-            auto it_def = par_def.begin();
-            for (; it_pvi != m_target.parameters().end(); ++it_pvi, ++it_def)
+            for (std::size_t i: positions)
             {
-              if (context.find(*it_def) != context.end() && data::search_free_variable(rewr(*it_pvi, sigma), var))
+              if (i < m_target.parameters().size() && data::search_free_variable(target_parameter(i), var))
               {
                 none_occurs_in_context = false;
                 break;
@@ -696,14 +725,13 @@ class pbes_constelm_algorithm
         }
 
         /// \brief Assign new values to the parameters of this vertex, and update the constraints accordingly.
-        /// The new values have a number of constraints.
-        bool update(const qvar_list& qvars, const data::data_expression_list& e, const constraint_map& e_constraints, const DataRewriter& datar)
+        /// \param parameter Returns the i-th new value, rewritten with the constraints of the source vertex.
+        template <typename Parameter>
+        bool update(const qvar_list& qvars, const data::data_expression_list& e, Parameter parameter)
         {
           bool changed = false;
 
           data::variable_list params = m_variable.parameters();
-          data::rewriter::substitution_type sigma;
-          detail::make_constelm_substitution(e_constraints, sigma);
 
           if (!m_visited)
           {
@@ -715,9 +743,9 @@ class pbes_constelm_algorithm
             // are bound in m_qvars.
             std::vector<data::data_expression> deleted_constraints;
             auto par = params.begin();
-            for (auto i = e.begin(); i != e.end(); ++i, ++par)
+            for (std::size_t i = 0; i < e.size(); ++i, ++par)
             {
-              data::data_expression e1 = datar(*i, sigma);
+              data::data_expression e1 = parameter(i);
               if (bound_in_quantifiers(m_qvars, e1))
               {
                 m_constraints[*par] = e1;
@@ -740,8 +768,8 @@ class pbes_constelm_algorithm
             // Find constraints for which f[i] = e[i] and for which all free
             // variables are bound in m_qvars (which may have changed).
             std::vector<data::data_expression> deleted_constraints;
-            auto i = e.begin();
-            for (auto par = params.begin(); i != e.end(); ++i, ++par)
+            auto par = params.begin();
+            for (std::size_t i = 0; i < e.size(); ++i, ++par)
             {
               auto k = m_constraints.find(*par);
               if(k == m_constraints.end())
@@ -749,7 +777,7 @@ class pbes_constelm_algorithm
                 continue;
               }
               const data::data_expression& fi = k->second;
-              data::data_expression ei = datar(*i, sigma);
+              data::data_expression ei = parameter(i);
               if (fi != ei || !bound_in_quantifiers(m_qvars, fi))
               {
                 changed = true;
@@ -764,19 +792,14 @@ class pbes_constelm_algorithm
         }
     };
 
-    /// \brief The storage type for vertices
-    using vertex_map = std::map<core::identifier_string, vertex>;
+    /// \brief The vertices of the dependency graph, in the order of the equations.
+    std::vector<vertex> m_vertices;
 
-    /// \brief The storage type for edges
-    using edge_map = std::map<core::identifier_string, std::vector<edge>>;
+    /// \brief Maps the name of a propositional variable to the index of its vertex.
+    std::unordered_map<core::identifier_string, std::size_t> m_vertex_index;
 
-    /// \brief The vertices of the dependency graph. They are stored in a map, to
-    /// support searching for a vertex.
-    vertex_map m_vertices;
-
-    /// \brief The edges of the dependency graph. They are stored in a map, to
-    /// easily access all out-edges corresponding to a particular vertex.
-    edge_map m_edges;
+    /// \brief The out-edges of the dependency graph, indexed by the index of their source vertex.
+    std::vector<std::vector<edge>> m_edges;
 
     /// \brief The redundant parameters.
     std::map<core::identifier_string, std::vector<std::size_t> > m_redundant_parameters;
@@ -785,9 +808,9 @@ class pbes_constelm_algorithm
     std::string print_vertices() const
     {
       std::ostringstream out;
-      for (const auto& v: m_vertices)
+      for (const vertex& v: m_vertices)
       {
-        out << v.second.to_string() << std::endl;
+        out << v.to_string() << std::endl;
       }
       return out.str();
     }
@@ -796,7 +819,7 @@ class pbes_constelm_algorithm
     std::string print_edges()
     {
       std::ostringstream out;
-      for (const auto& [source, targets]: m_edges)
+      for (const std::vector<edge>& targets: m_edges)
       {
         for (const edge& e: targets)
         {
@@ -806,7 +829,7 @@ class pbes_constelm_algorithm
       return out.str();
     }
 
-    std::string print_todo_list(const std::deque<propositional_variable>& todo)
+    std::string print_todo_list(const std::deque<std::size_t>& todo)
     {
       std::ostringstream out;
       out << "\n<todo list> [";
@@ -816,7 +839,7 @@ class pbes_constelm_algorithm
         {
           out << ", ";
         }
-        out << core::pp(i->name());
+        out << core::pp(m_vertices[*i].variable().name());
       }
       out << "]" << std::endl;
       return out.str();
@@ -831,20 +854,16 @@ class pbes_constelm_algorithm
       return out.str();
     }
 
-    std::string print_condition(const edge& e, const vertex& u, const pbes_expression& value)
+    std::string print_condition(const edge& e, const data::rewriter::substitution_type& sigma, const pbes_expression& value)
     {
       std::ostringstream out;
-      data::rewriter::substitution_type sigma;
-      detail::make_constelm_substitution(u.constraints(), sigma);
       out << "  <condition           > " << e.condition() << sigma << " to " << value << std::endl;
       return out.str();
     }
 
-    std::string print_evaluation_failure(const edge& e, const vertex& u)
+    std::string print_evaluation_failure(const edge& e, const data::rewriter::substitution_type& sigma)
     {
       std::ostringstream out;
-      data::rewriter::substitution_type sigma;
-      detail::make_constelm_substitution(u.constraints(), sigma);
       out << "\nCould not evaluate condition " << e.condition() << sigma << " to true or false";
       return out.str();
     }
@@ -873,7 +892,7 @@ class pbes_constelm_algorithm
       std::map<propositional_variable, std::vector<data::variable> > result;
       for (const std::pair<const core::identifier_string, std::vector<std::size_t>>& red_pair: m_redundant_parameters)
       {
-        const vertex& v = m_vertices.find(red_pair.first)->second;
+        const vertex& v = m_vertices[m_vertex_index.at(red_pair.first)];
         std::vector<data::variable>& variables = result[v.variable()];
         for (const std::size_t par: red_pair.second)
         {
@@ -892,20 +911,28 @@ class pbes_constelm_algorithm
     void run(pbes& p, bool compute_conditions = false, bool check_quantifiers = true)
     {
       m_vertices.clear();
+      m_vertex_index.clear();
       m_edges.clear();
       m_redundant_parameters.clear();
 
-      // compute the vertices and edges of the dependency graph
-      for (pbes_equation& eqn: p.equations())
+      // compute the vertices of the dependency graph
+      for (const pbes_equation& eqn: p.equations())
       {
-        core::identifier_string name = eqn.variable().name();
-        m_vertices[name] = vertex(eqn.variable());
+        m_vertex_index[eqn.variable().name()] = m_vertices.size();
+        m_vertices.emplace_back(eqn.variable());
+      }
+
+      // compute the edges of the dependency graph
+      m_edges.resize(m_vertices.size());
+      for (std::size_t i = 0; i < p.equations().size(); ++i)
+      {
+        const pbes_equation& eqn = p.equations()[i];
 
         // use an edge_condition_traverser to compute the edges
         detail::edge_condition_traverser f;
         f.apply(eqn.formula());
 
-        std::vector<edge>& edges = m_edges[name];
+        std::vector<edge>& edges = m_edges[i];
         for (const auto& [Q_X_e, details]: f.result())
         {
           const auto& [Q, X_e] = Q_X_e;
@@ -917,57 +944,98 @@ class pbes_constelm_algorithm
             ? data::lazy::join_and(conditions.begin(), conditions.end())
             : data::data_expression(data::sort_bool::true_());
 
-          edges.emplace_back(eqn.variable(), quantifier_list, X_e, conj_FV, disj_FV, condition);
+          edges.emplace_back(eqn.variable(), quantifier_list, X_e, m_vertex_index.at(X_e.name()), conj_FV, disj_FV, condition);
         }
       }
 
-      // initialize the todo list of vertices that need to be processed
+      // initialize the todo list of vertices that need to be processed; a vertex occurs at most once in it
       propositional_variable_instantiation init = p.initial_state();
-      std::deque<propositional_variable> todo;
+      std::deque<std::size_t> todo;
+      std::vector<bool> in_todo(m_vertices.size(), false);
       const data::data_expression_list& e_init = init.parameters();
-      vertex& u_init = m_vertices[init.name()];
-      u_init.update(qvar_list(), e_init, constraint_map(), m_data_rewriter);
-      todo.push_back(u_init.variable());
+      const std::size_t init_index = m_vertex_index.at(init.name());
+      const std::vector<data::data_expression> init_arguments(e_init.begin(), e_init.end());
+      data::rewriter::substitution_type empty_sigma;
+      m_vertices[init_index].update(qvar_list(), e_init, [&](std::size_t i) { return m_data_rewriter(init_arguments[i], empty_sigma); });
+      todo.push_back(init_index);
+      in_todo[init_index] = true;
 
       mCRL2log(log::debug) << "\n--- initial vertices ---\n" << print_vertices();
       mCRL2log(log::debug) << "\n--- edges ---\n" << print_edges();
 
-      // propagate constraints over the edges until the todo list is empty
+      // Propagate constraints over the edges until the todo list is empty. Only the out-edges of
+      // vertices of which the constraints have changed are evaluated. The conditions of the edges are
+      // rewritten at most once for each distinct condition when a vertex is processed.
+      data::rewriter::substitution_type sigma;
+      std::unordered_map<data::data_expression, pbes_expression> condition_cache;
+      std::vector<data::data_expression> target_arguments;
+      std::vector<data::data_expression> target_parameters;
       while (!todo.empty())
       {
         mCRL2log(log::debug) << print_todo_list(todo);
-        propositional_variable var = todo.front();
-
-        // remove all occurrences of var from todo
-        todo.erase(std::remove(todo.begin(), todo.end(), var), todo.end());
+        const std::size_t u_index = todo.front();
+        todo.pop_front();
+        in_todo[u_index] = false;
 
-        const vertex& u = m_vertices[var.name()];
-        const std::vector<edge>& u_edges = m_edges[var.name()];
+        const vertex& u = m_vertices[u_index];
+        sigma.clear();
+        detail::make_constelm_substitution(u.constraints(), sigma);
+        condition_cache.clear();
 
-        for (const edge& e: u_edges)
+        for (const edge& e: m_edges[u_index])
         {
-          vertex& v = m_vertices[e.target().name()];
+          vertex& v = m_vertices[e.target_index()];
           mCRL2log(log::debug) << print_edge_update(e, u, v);
 
-          data::rewriter::substitution_type sigma;
-          detail::make_constelm_substitution(u.constraints(), sigma);
-          pbes_expression needs_update = m_pbes_rewriter(atermpp::down_cast<pbes_expression>(e.condition()), sigma);
-          mCRL2log(log::debug) << print_condition(e, u, needs_update);
+          pbes_expression needs_update = true_();
+          if (!data::sort_bool::is_true_function_symbol(e.condition()))
+          {
+            auto k = condition_cache.find(e.condition());
+            if (k == condition_cache.end())
+            {
+              k = condition_cache.emplace(e.condition(), m_pbes_rewriter(atermpp::down_cast<pbes_expression>(e.condition()), sigma)).first;
+            }
+            needs_update = k->second;
+          }
+          mCRL2log(log::debug) << print_condition(e, sigma, needs_update);
 
           if (!is_false(needs_update) && !is_true(needs_update))
           {
-            mCRL2log(log::debug) << print_evaluation_failure(e, u);
+            mCRL2log(log::debug) << print_evaluation_failure(e, sigma);
           }
           if (!is_false(needs_update))
           {
+            // The parameters of the target are rewritten on demand, and at most once.
+            const data::data_expression_list& e_target = e.target().parameters();
+            target_arguments.assign(e_target.begin(), e_target.end());
+            target_parameters.assign(e_target.size(), data::data_expression());
+            auto target_parameter = [&](std::size_t i) -> const data::data_expression&
+            {
+              if (target_parameters[i] == data::data_expression())
+              {
+                target_parameters[i] = m_data_rewriter(target_arguments[i], sigma);
+              }
+              return target_parameters[i];
+            };
+
             bool changed = v.update(
-                              concat(e.quantifier_inside_approximation(u, m_data_rewriter), e.quantified_variables()),
-                              e.target().parameters(),
-                              u.constraints(),
-                              m_data_rewriter);
+                              concat(e.quantifier_inside_approximation(u, target_parameter), e.quantified_variables()),
+                              e_target,
+                              target_parameter);
             if (changed)
             {
-              todo.push_back(v.variable());
+              if (!in_todo[e.target_index()])
+              {
+                todo.push_back(e.target_index());
+                in_todo[e.target_index()] = true;
+              }
+              if (e.target_index() == u_index)
+              {
+                // The constraints of u have changed, so the substitution must be recomputed.
+                sigma.clear();
+                detail::make_constelm_substitution(u.constraints(), sigma);
+                condition_cache.clear();
+              }
             }
           }
           mCRL2log(log::debug) << "  <target vertex after > " << v.to_string() << "\n";
@@ -980,7 +1048,7 @@ class pbes_constelm_algorithm
       for (const pbes_equation& eqn: p.equations())
       {
         core::identifier_string name = eqn.variable().name();
-        const vertex& v = m_vertices[name];
+        const vertex& v = m_vertices[m_vertex_index.at(name)];
         if (!v.constraints().empty())
         {
           std::vector<std::size_t> r = v.constant_parameter_indices();
@@ -995,7 +1063,7 @@ class pbes_constelm_algorithm
       for (pbes_equation& eqn: p.equations())
       {
         core::identifier_string name = eqn.variable().name();
-        const vertex& v = m_vertices[name];
+        const vertex& v = m_vertices[m_vertex_index.at(name)];
 
         if (!v.constraints().empty())
         {
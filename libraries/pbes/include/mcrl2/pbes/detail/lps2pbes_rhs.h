@@ -18,6 +18,7 @@
 #include "mcrl2/pbes/detail/lps2pbes_par.h"
 #include "mcrl2/pbes/detail/lps2pbes_sat.h"
 #include "mcrl2/pbes/replace.h"
+#include "mcrl2/utilities/detail/parallel_apply.h"
 
 
 
@@ -31,6 +32,7 @@ struct lps2pbes_parameters
   const lps::stochastic_linear_process& lps;
   data::set_identifier_generator& id_generator;
   const data::variable& T;
+  std::size_t number_of_threads = 1; // the number of threads that is used to handle the summands of a modal operator
 
   lps2pbes_parameters(const state_formulas::state_formula& phi0_,
                       const lps::stochastic_linear_process& lps_,
@@ -53,7 +55,7 @@ struct lps2pbes_parameters
                                const lps::multi_action& /* ai */,
                                const data::assignment_list& /* gi */,
                                TermTraits
-                              )
+                              ) const
   {
     using tr = TermTraits;
     if (is_must)
@@ -172,7 +174,7 @@ struct lps2pbes_counter_example_parameters: public lps2pbes_parameters
                                const lps::multi_action& ai,
                                const data::assignment_list& gi,
                                TermTraits
-                              )
+                              ) const
   {
     using tr = TermTraits;
     const data::variable_list& d = lps.process_parameters();
@@ -340,42 +342,56 @@ struct rhs_traverser: public state_formulas::state_formula_traverser<Derived>
   }
 
   // share code between must and may
+  // The summands are handled in three phases. The names generated by Sat and apply_may_must_result depend on the
+  // order in which they are requested, so the first and the last phase are sequential. The substitution of the
+  // right hand side, which is the expensive part, is done in parallel if parameters.number_of_threads > 1. The
+  // result does not depend on the number of threads.
   template <typename MustMayExpression>
   void apply_may_must(const MustMayExpression& x, bool is_must)
   {
     bool timed = is_timed();
-    std::vector<pbes_expression> v;
     pbes_expression rhs_phi = derived().apply_may_must_rhs(x);
     assert(action_formulas::is_action_formula(x.formula()));
     const action_formulas::action_formula& alpha = atermpp::down_cast<const action_formulas::action_formula>(x.formula());
+    const auto& summands = parameters.lps.action_summands();
 
-    for (const lps::action_summand& summand: parameters.lps.action_summands())
+    std::vector<pbes_expression> left(summands.size());
+    std::vector<data::mutable_map_substitution<>> sigma(summands.size());
+    for (std::size_t i = 0; i < summands.size(); i++)
     {
+      const lps::action_summand& summand = summands[i];
       const data::data_expression& ci = summand.condition();
       const lps::multi_action& ai     = summand.multi_action();
       const data::assignment_list& gi = summand.assignments();
-      const data::variable_list& yi   = summand.summation_variables();
 
-      pbes_expression right = rhs_phi;
       const data::data_expression& ti = ai.time();
       pbes_expression sat = Sat(ai, alpha, parameters.id_generator, TermTraits());
-      data::mutable_map_substitution<> sigma;
       for (const data::assignment& a: gi)
       {
-        sigma[a.lhs()] = a.rhs();
+        sigma[i][a.lhs()] = a.rhs();
       }
-      pbes_expression left = tr::and_(sat, atermpp::down_cast<pbes_expression>(ci));
+      left[i] = tr::and_(sat, atermpp::down_cast<pbes_expression>(ci));
 
       if (timed)
       {
-        sigma[parameters.T] = ti;
-        left = tr::and_(left, atermpp::down_cast<pbes_expression>(data::greater(ti, parameters.T)));
+        sigma[i][parameters.T] = ti;
+        left[i] = tr::and_(left[i], atermpp::down_cast<pbes_expression>(data::greater(ti, parameters.T)));
       }
+    }
 
-      right = pbes_system::replace_variables_capture_avoiding(right, sigma);
+    std::vector<pbes_expression> p(summands.size());
+    const Parameters& params = parameters;
+    utilities::detail::parallel_apply(summands.size(), parameters.number_of_threads, [&](std::size_t i, std::size_t /* thread */)
+      {
+        const lps::action_summand& summand = summands[i];
+        pbes_expression right = pbes_system::replace_variables_capture_avoiding(rhs_phi, sigma[i]);
+        p[i] = params.rhs_may_must(is_must, summand.summation_variables(), left[i], right, summand.multi_action(), summand.assignments(), TermTraits());
+      });
 
-      pbes_expression p = parameters.rhs_may_must(is_must, yi, left, right, ai, gi, TermTraits());
-      v.push_back(derived().apply_may_must_result(p));
+    std::vector<pbes_expression> v;
+    for (const pbes_expression& p_i: p)
+    {
+      v.push_back(derived().apply_may_must_result(p_i));
     }
 
     pbes_expression result = is_must ? tr::join_and(v.begin(), v.end()) : tr::join_or(v.begin(), v.end());
@@ -15,6 +15,7 @@
 #include "mcrl2/utilities/input_output_tool.h"
 #include "mcrl2/utilities/logger.h"
 #include "mcrl2/utilities/parallel_tool.h"
+#include "mcrl2/utilities/performance_counters.h"
 #include "mcrl2/utilities/file_utility.h"
 #include "mcrl2/data/rewriter_tool.h"
 #include "mcrl2/lps/detail/instantiate_global_variables.h"
@@ -35,6 +36,25 @@ using mcrl2::data::tools::rewriter_tool;
 using mcrl2::utilities::tools::input_tool;
 using utilities::tools::parallel_tool;
 
+inline const utilities::performance_counter structure_graph_vertices_counter("pbes.structure_graph.vertices", utilities::performance_counter_kind::maximum);
+inline const utilities::performance_counter structure_graph_edges_counter("pbes.structure_graph.edges", utilities::performance_counter_kind::maximum);
+
+/// \brief Records the number of vertices and edges of G in the performance counters.
+inline
+void record_structure_graph_size(const structure_graph& G)
+{
+  if (utilities::performance_counters_enabled())
+  {
+    std::size_t edges = 0;
+    for (const structure_graph::vertex& u: G.all_vertices())
+    {
+      edges += u.successors.size();
+    }
+    structure_graph_vertices_counter.add(G.all_vertices().size());
+    structure_graph_edges_counter.add(edges);
+  }
+}
+
 inline
 bool run_solve(const pbes_system::pbes& pbesspec, 
   const data::mutable_map_substitution<>& sigma,
@@ -48,6 +68,7 @@ bool run_solve(const pbes_system::pbes& pbesspec,
   mcrl2::utilities::execution_timer& timer)
 {  
   bool result;
+  record_structure_graph_size(G);
   if (!lpsfile.empty())
   {
     lps::specification lpsspec;
@@ -390,6 +411,7 @@ class pbessolve_tool
 
       mCRL2log(log::verbose) << "Number of vertices in the structure graph: "
                              << initial_G.all_vertices().size() << std::endl;      
+      record_structure_graph_size(initial_G);
 
       // Solve the initial pbes and obtain the strategies in G.
       timer().start("first-solving");
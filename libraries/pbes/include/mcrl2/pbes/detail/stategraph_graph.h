@@ -444,7 +444,7 @@ struct control_flow_graph
 
   const Vertex& insert_vertex(const Vertex& v_)
   {
-    auto j = std::find(vertices.begin(), vertices.end(), v_);
+    auto j = vertices.find(v_);
     if (j == vertices.end())
     {
       mCRL2log(log::trace) << " add vertex v = " << v_ << std::endl;
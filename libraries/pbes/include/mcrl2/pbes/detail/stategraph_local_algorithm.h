@@ -14,6 +14,8 @@
 
 #include "mcrl2/pbes/algorithms.h"
 #include "mcrl2/pbes/detail/stategraph_algorithm.h"
+#include <deque>
+#include <unordered_map>
 
 namespace mcrl2::pbes_system::detail {
 
@@ -165,18 +167,27 @@ class stategraph_local_algorithm: public stategraph_algorithm
       }
     };
 
-    // maps (X, i) to the set of all edges with label i and source vertex with name X
-    std::map<core::identifier_string, std::map<std::size_t, std::set<vertex_pair> > > m_edge_index;
+    // m_edge_index[n][i] contains all edges with label i and a source vertex with the name of the n-th equation,
+    // sorted on the source and target vertices
+    std::vector<std::vector<std::vector<vertex_pair> > > m_edge_index;
 
     void compute_edge_index()
     {
+      auto const& equations = m_pbes.equations();
+      m_edge_index.clear();
+      m_edge_index.reserve(equations.size());
+      for (const stategraph_equation& eq_X: equations)
+      {
+        m_edge_index.emplace_back(eq_X.predicate_variables().size());
+      }
+
       for (std::size_t k = 0; k < m_local_control_flow_graphs.size(); k++)
       {
         auto const& Gk = m_local_control_flow_graphs[k];
         auto const& vertices = Gk.vertices;
         for (const auto& u: vertices)
         {
-          auto const& X = u.name();
+          auto& EX = m_edge_index[m_pbes.equation_index(u.name())];
           auto const& outgoing_edges = u.outgoing_edges();
           for(const auto& e: outgoing_edges)
           {
@@ -184,11 +195,20 @@ class stategraph_local_algorithm: public stategraph_algorithm
             auto const& I = e.second;
             for (std::size_t i: I)
             {
-              m_edge_index[X][i].insert(vertex_pair(&u, &v, k));
+              EX[i].emplace_back(&u, &v, k);
             }
           }
         }
       }
+
+      for (auto& EX: m_edge_index)
+      {
+        for (auto& EXi: EX)
+        {
+          std::sort(EXi.begin(), EXi.end());
+          EXi.erase(std::unique(EXi.begin(), EXi.end(), [](const vertex_pair& x, const vertex_pair& y) { return x.u == y.u && x.v == y.v; }), EXi.end());
+        }
+      }
     }
 
     std::string print_edge_index()
@@ -197,15 +217,14 @@ class stategraph_local_algorithm: public stategraph_algorithm
       auto const& equations = m_pbes.equations();
       std::ostringstream out;
 
-      for (const stategraph_equation& eq_X: equations)
+      for (std::size_t n = 0; n < equations.size(); n++)
       {
-        auto const& X = eq_X.variable().name();
-        auto& EX = m_edge_index[X];
+        auto const& X = equations[n].variable().name();
+        auto const& EX = m_edge_index[n];
         out << "index for equation " << X << std::endl;
-        for (std::size_t i = 0; i < eq_X.predicate_variables().size(); i++)
+        for (std::size_t i = 0; i < EX.size(); i++)
         {
-          auto& EXi = EX[i];
-          for (const auto& ei: EXi)
+          for (const auto& ei: EX[i])
           {
             out << " edge " << *ei.u << " --" << i << "--> " << *ei.v << std::endl;
           }
@@ -679,8 +698,7 @@ class stategraph_local_algorithm: public stategraph_algorithm
         mCRL2log(log::trace) << "    rule: considering equation " << X << std::endl;
         mCRL2log(log::trace) << "    rule2: considering PVI nr. " << i << std::endl;
 
-        auto& EX = m_edge_index[X];
-        auto& EXi = EX[i];
+        auto const& EXi = m_edge_index[m_pbes.equation_index(X)][i];
         for (auto ei = EXi.begin(); ei != EXi.end(); ++ei)
         {
           const local_control_flow_graph_vertex& u = *ei->u;
@@ -713,13 +731,23 @@ class stategraph_local_algorithm: public stategraph_algorithm
     }
 
     // an efficient version that uses an edge index
+    //
+    // Instead of repeatedly applying the rules to all vertices until nothing changes, a worklist of vertices
+    // is maintained of which the marking has changed. If the marking of a vertex v in graph Vk changes, only
+    // the following updates need to be reconsidered:
+    // - rule 1 for the edges (u, i, v) in Vk
+    // - rule 2 for the edges (u', i, v') in Vj with j != k, and u' has the same name as u
+    // Since marking updates are monotonic, this yields the same marking as the other algorithms.
     void compute_control_flow_marking_efficient()
     {
       mCRL2log(log::debug) << "=== computing control flow marking ===" << std::endl;
-      using utilities::detail::pick_element;
 
       start_timer("marking initialization");
       std::size_t J = m_local_control_flow_graphs.size();
+
+      // assign consecutive numbers to the vertices of all graphs
+      std::vector<std::pair<const local_control_flow_graph_vertex*, std::size_t> > vertices;
+      std::unordered_map<const local_control_flow_graph_vertex*, std::size_t> vertex_index;
       for (std::size_t j = 0; j < J; j++)
       {
         auto const& Vj = m_local_control_flow_graphs[j];
@@ -728,116 +756,79 @@ class stategraph_local_algorithm: public stategraph_algorithm
         {
           auto const& X = u.name();
           u.set_marking(belongs_intersection(significant_variables(u), Bj, X));
+          vertex_index[&u] = vertices.size();
+          vertices.emplace_back(&u, j);
         }
         mCRL2log(log::debug) << "--- initial control flow marking for graph " << j << "\n" << Vj.print_marking();
       }
       finish_timer("marking initialization");
 
       start_timer("marking computation");
-      bool stable = false;
-      while (!stable)
+      std::deque<std::size_t> todo;
+      std::vector<bool> in_todo(vertices.size(), true);
+      for (std::size_t n = 0; n < vertices.size(); n++)
       {
-        bool stableint = false;
-        while (!stableint)
+        todo.push_back(n);
+      }
+
+      auto insert_todo = [&](const local_control_flow_graph_vertex& u)
+      {
+        std::size_t n = vertex_index[&u];
+        if (!in_todo[n])
         {
-          stableint = true;
-          for (std::size_t j = 0; j < J; j++)
-          {
-            auto const& Vj = m_local_control_flow_graphs[j];
-            auto const& Bj = m_belongs[j];
-            std::set<const local_control_flow_graph_vertex*> todo;
-            for (const auto& v: Vj.vertices)
-            {
-              todo.insert(&v);
-            }
-            while (!todo.empty())
-            {
-              auto const& v = *pick_element(todo);
+          in_todo[n] = true;
+          todo.push_back(n);
+        }
+      };
 
-              mCRL2log(log::trace) << " extend marking rule1: v = " << v << " marking(v) = " << core::detail::print_set(v.marking()) << std::endl;
+      while (!todo.empty())
+      {
+        std::size_t n = todo.front();
+        todo.pop_front();
+        in_todo[n] = false;
+        auto const& v = *vertices[n].first;
+        std::size_t k = vertices[n].second;
+        auto const& Bk = m_belongs[k];
 
-              auto const& incoming_edges = v.incoming_edges();
-              for (const auto& e: incoming_edges)
-              {
-                bool changed = false;
-                auto const& u = *e.first;
-                auto const& labels = e.second;
-                for (std::size_t i: labels)
-                {
-                    // consider edge (u, i, v)
-                    bool updated = update_marking_rule(Bj, u, i, v, false);
-                    changed = changed || updated;
-                }
-                if (changed)
-                {
-                  mCRL2log(log::trace) << "   marking(u)' = " << core::detail::print_set(u.marking()) << std::endl;
-                  todo.insert(&u);
-                  stableint = false;
-                }
-              }
-            }
-          }
-        }
+        mCRL2log(log::trace) << " extend marking: v = " << v << " marking(v) = " << core::detail::print_set(v.marking()) << std::endl;
 
-        // stableext := false
-        // while not stableext do
-        //   stableext := true;
-        //   for X in bnd(E) do
-        //     for i <= npred(phi_X) do
-        //       let E := { ( u, i, v) in E1 union ... union EJ | exists n,z: u = (X,n,dX[n]=z) };
-        //       for (u,i,v) in E do
-        //         let j be such that u in Vj;
-        //         if (marking(u) = {d | (X,d) in Bj}) then continue;
-        //         for (u',i,v') in E do
-        //           let k be such that u' in Vk;
-        //           if (j == k) then continue;
-        //           m := marking(u);
-        //           marking(u) := UpdateMarkingRule2(Bj,u,i,v')
-        //           if not(marking(u) == m) then
-        //             stableint := false;
-        //             stableext := false;
-        // stable := stableint /\ stableext;
-        bool stableext = false;
-        auto const& equations = m_pbes.equations();
-        while (!stableext)
+        auto const& incoming_edges = v.incoming_edges();
+        for (const auto& e: incoming_edges)
         {
-          stableext = true;
-          for (const auto& eq_X: equations)
+          auto const& u = *e.first;
+          auto const& EX = m_edge_index[m_pbes.equation_index(u.name())];
+          auto const& labels = e.second;
+          for (std::size_t i: labels)
           {
-            auto const& X = eq_X.variable().name();
-            auto& EX = m_edge_index[X];
-            for (std::size_t i = 0; i < eq_X.predicate_variables().size(); i++)
+            // rule 1 for the edge (u, i, v)
+            if (update_marking_rule(Bk, u, i, v, false))
+            {
+              mCRL2log(log::trace) << "   marking(u)' = " << core::detail::print_set(u.marking()) << std::endl;
+              insert_todo(u);
+            }
+
+            // rule 2 for the edges (u1, i, v1) in other graphs
+            for (const auto& ei: EX[i])
             {
-              auto& EXi = EX[i];
-              for (auto ei = EXi.begin(); ei != EXi.end(); ++ei)
+              std::size_t j = ei.k;
+              if (j == k)
               {
-                const local_control_flow_graph_vertex& u = *ei->u;
-                std::size_t j = ei->k;
-                auto const& Bj = m_belongs[j];
-                if (u.marking().size() == Bj[X].size())
-                {
-                  continue;
-                }
-                for (const auto& ej: EXi)
-                {
-                  const local_control_flow_graph_vertex& v1 = *ej.v;
-                  std::size_t k = ej.k;
-                  if (j == k)
-                  {
-                    continue;
-                  }
-                  bool updated = update_marking_rule(Bj, u, i, v1, true);
-                  if (updated)
-                  {
-                    stableint = false;
-                    stableext = false;
-                  }
-                }
+                continue;
+              }
+              const local_control_flow_graph_vertex& u1 = *ei.u;
+              auto& Bj = m_belongs[j];
+              if (u1.marking().size() == Bj[u1.name()].size())
+              {
+                continue;
+              }
+              if (update_marking_rule(Bj, u1, i, v, true))
+              {
+                mCRL2log(log::trace) << "   marking(u1)' = " << core::detail::print_set(u1.marking()) << std::endl;
+                insert_todo(u1);
               }
             }
           }
         }
-        stable = stableint;
       }
       finish_timer("marking computation");
     }
@@ -16,6 +16,7 @@
 #include "mcrl2/pbes/detail/guard_traverser.h"
 #include "mcrl2/pbes/detail/stategraph_simplify_rewriter.h"
 #include "mcrl2/pbes/detail/stategraph_utility.h"
+#include <unordered_map>
 
 
 
@@ -490,6 +491,9 @@ class stategraph_pbes
     std::set<data::variable> m_global_variables;
     propositional_variable_instantiation m_initial_state;
 
+    // maps the names of the binding variables to the index of their equation; it is computed on demand
+    mutable std::unordered_map<core::identifier_string, std::size_t> m_equation_index;
+
   public:
     stategraph_pbes() = default;
 
@@ -530,6 +534,24 @@ class stategraph_pbes
       return m_initial_state;
     }
 
+    /// \brief Returns the index of the equation with binding variable X, or equations().size() if there is
+    /// no such equation. Since the equations may be modified, the index is recomputed if it is out of date.
+    std::size_t equation_index(const core::identifier_string& X) const
+    {
+      auto i = m_equation_index.find(X);
+      if (i != m_equation_index.end() && i->second < m_equations.size() && m_equations[i->second].variable().name() == X)
+      {
+        return i->second;
+      }
+      m_equation_index.clear();
+      for (std::size_t k = 0; k < m_equations.size(); k++)
+      {
+        m_equation_index.emplace(m_equations[k].variable().name(), k);
+      }
+      i = m_equation_index.find(X);
+      return i == m_equation_index.end() ? m_equations.size() : i->second;
+    }
+
     const data::data_specification& data() const
     {
       return m_data;
@@ -576,12 +598,10 @@ inline
 std::vector<stategraph_equation>::const_iterator find_equation(const stategraph_pbes& p, const core::identifier_string& X, bool warn = true)
 {
   auto const& equations = p.equations();
-  for (auto i = equations.begin(); i != equations.end(); ++i)
+  std::size_t k = p.equation_index(X);
+  if (k < equations.size())
   {
-    if (i->variable().name() == X)
-    {
-      return i;
-    }
+    return equations.begin() + k;
   }
   if (warn)
   {
@@ -401,7 +401,8 @@ void symbolic_exploration(const std::string& input_filename,
                           const utilities::file_format& output_format,
                           bool optimized = true,
                           bool clustered = false,
-                          bool instantiate = false
+                          bool instantiate = false,
+                          bool compress = false
                          )
 {
   // load the pbes
@@ -413,7 +414,7 @@ void symbolic_exploration(const std::string& input_filename,
   algorithm.run();
 
   // save the result
-  save_pbes(p, output_filename, output_format);
+  save_pbes(p, output_filename, output_format, true, compress);
 
   if (instantiate)
   {
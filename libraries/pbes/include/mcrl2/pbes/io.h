@@ -61,9 +61,11 @@ inline utilities::file_format guess_format(const std::string& filename)
 /// \param stream The stream to which the output is saved.
 /// \param format Determines the format in which the result is written. If unspecified, or
 ///        pbes_file_unknown is specified, then a default format is chosen.
+/// \param compress Whether the PBES is compressed, which only applies to the binary formats.
 void save_pbes(const pbes& pbes,
                std::ostream& stream,
-               utilities::file_format format = utilities::file_format());
+               utilities::file_format format = utilities::file_format(),
+               bool compress = false);
 
 /// \brief Load a PBES from file.
 /// \param pbes The PBES to which the result is loaded.
@@ -79,12 +81,14 @@ void load_pbes(pbes& pbes, std::istream& stream, utilities::file_format format,
 /// \param format The format in which to save the PBES.
 /// \param welltypedness_check If set to false, skips checking whether pbes is well typed before
 ///                            saving it to file.
+/// \param compress Whether the PBES is compressed, which only applies to the binary formats.
 ///
 /// The format of the file in infilename is guessed if format is not given or if it is equal to
 /// utilities::file_format().
 void save_pbes(const pbes& pbes, const std::string& filename,
                utilities::file_format format = utilities::file_format(),
-               bool welltypedness_check = true);
+               bool welltypedness_check = true,
+               bool compress = false);
 
 /// \brief Load pbes from file.
 /// \param pbes The pbes to which the result is loaded.
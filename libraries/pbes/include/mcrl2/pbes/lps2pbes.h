@@ -34,6 +34,7 @@ class lps2pbes_algorithm
   protected:
     data::set_identifier_generator m_generator;
     bool m_check_only = false;
+    std::size_t m_number_of_threads = 1;
 
     template <typename Parameters>
     void run(const state_formulas::state_formula& f, bool structured, bool unoptimized, std::vector<pbes_equation>& equations, Parameters& parameters)
@@ -64,8 +65,12 @@ class lps2pbes_algorithm
 
   public:
     /// \brief Constructor
-    explicit lps2pbes_algorithm(bool check_only = false)
-     : m_check_only(check_only)
+    /// \param check_only If true, only the formula is checked and no PBES is generated.
+    /// \param number_of_threads The number of threads that is used to handle the summands of the LPS. The
+    ///        result does not depend on the number of threads.
+    explicit lps2pbes_algorithm(bool check_only = false, std::size_t number_of_threads = 1)
+     : m_check_only(check_only),
+       m_number_of_threads(number_of_threads)
     {}
 
     /// \brief Runs the translation algorithm
@@ -107,12 +112,14 @@ class lps2pbes_algorithm
       if (generate_counter_example)
       {
         detail::lps2pbes_counter_example_parameters parameters(f, lpsspec.process(), m_generator, T);
+        parameters.number_of_threads = m_number_of_threads;
         run(f, structured, unoptimized, equations, parameters);
         equations = equations + parameters.equations();
       }
       else
       {
         detail::lps2pbes_parameters parameters(f, lpsspec.process(), m_generator, T);
+        parameters.number_of_threads = m_number_of_threads;
         run(f, structured, unoptimized, equations, parameters);
       }
 
@@ -152,6 +159,8 @@ class lps2pbes_algorithm
 /// \param preprocess_modal_operators A boolean indicating that the modal operators can be preprocessed to
 ///                                   obtain a more compact PBES.
 /// \param generate_counter_example A boolean indicating that a counter example must be generated.
+/// \param check_only If check_only is true, only the formula will be checked, but no PBES is generated
+/// \param number_of_threads The number of threads that is used in the translation.
 /// \return The resulting pbes.
 inline
 pbes lps2pbes(const lps::stochastic_specification& lpsspec,
@@ -161,7 +170,8 @@ pbes lps2pbes(const lps::stochastic_specification& lpsspec,
               bool unoptimized = false,
               bool preprocess_modal_operators = false,
               bool generate_counter_example = false,
-              bool check_only = false
+              bool check_only = false,
+              std::size_t number_of_threads = 1
              )
 {
   if ((formula.has_time() || lpsspec.process().has_time()) && !timed)
@@ -181,11 +191,11 @@ pbes lps2pbes(const lps::stochastic_specification& lpsspec,
     generator.add_identifiers(data::function_and_mapping_identifiers(lpsspec.data()));
     data::variable T(generator("T"), data::sort_real::real_());
     lps::detail::make_timed_lps(lpsspec_timed.process(), generator.context());
-    return lps2pbes_algorithm(check_only).run(formula, lpsspec_timed, structured, unoptimized, preprocess_modal_operators, generate_counter_example, T);
+    return lps2pbes_algorithm(check_only, number_of_threads).run(formula, lpsspec_timed, structured, unoptimized, preprocess_modal_operators, generate_counter_example, T);
   }
   else
   {
-    return lps2pbes_algorithm(check_only).run(formula, lpsspec, structured, unoptimized, preprocess_modal_operators, generate_counter_example);
+    return lps2pbes_algorithm(check_only, number_of_threads).run(formula, lpsspec, structured, unoptimized, preprocess_modal_operators, generate_counter_example);
   }
 }
 
@@ -235,6 +245,7 @@ pbes lps2pbes(const lps::specification& lpsspec,
 ///                                   obtain a more compact PBES.
 /// \param generate_counter_example A boolean indicating that a counter example must be generated.
 /// \param check_only If check_only is true, only the formula will be checked, but no PBES is generated
+/// \param number_of_threads The number of threads that is used in the translation.
 /// \return The resulting pbes.
 inline
 pbes lps2pbes(const lps::stochastic_specification& lpsspec,
@@ -244,14 +255,15 @@ pbes lps2pbes(const lps::stochastic_specification& lpsspec,
               bool unoptimized = false,
               bool preprocess_modal_operators = false,
               bool generate_counter_example = false,
-              bool check_only = false
+              bool check_only = false,
+              std::size_t number_of_threads = 1
              )
 {
   lps::stochastic_specification lpsspec1 = lpsspec;
   lpsspec1.data() = data::merge_data_specifications(lpsspec1.data(), formspec.data());
   lps::normalize_sorts(lpsspec1, lpsspec1.data());
   lpsspec1.action_labels() = process::merge_action_specifications(lpsspec1.action_labels(), formspec.action_labels());
-  return lps2pbes(lpsspec1, formspec.formula(), timed, structured, unoptimized, preprocess_modal_operators, generate_counter_example, check_only);
+  return lps2pbes(lpsspec1, formspec.formula(), timed, structured, unoptimized, preprocess_modal_operators, generate_counter_example, check_only, number_of_threads);
 }
 
 /// \brief Applies the lps2pbes algorithm.
@@ -32,6 +32,9 @@ class pbes_output_tool: public Tool
     /// \brief The type of the pbes output format
     utilities::file_format m_pbes_output_format;
 
+    /// \brief Whether the output is compressed
+    bool m_compress_output = false;
+
     /// \brief Returns the file formats that are available for this tool.
     /// Override this method to change the standard behavior.
     /// \return The set { pbes, text }
@@ -72,6 +75,9 @@ class pbes_output_tool: public Tool
         option_argument.add_value_desc(type.shortname(), type.description(), type == default_output_format());
       }
       desc.add_option("out", option_argument, "use output format FORMAT:", 'o');
+      desc.add_option("compress",
+                      "compress the output in blocks when it is written in a binary format. Such files cannot "
+                      "be read by versions of the toolset that do not support compression");
     }
 
     /// \brief Parse non-standard options
@@ -79,6 +85,7 @@ class pbes_output_tool: public Tool
     void parse_options(const utilities::command_line_parser& parser) override
     {
       Tool::parse_options(parser);
+      m_compress_output = parser.has_option("compress");
       m_pbes_output_format = utilities::file_format();
       if(parser.options.count("out"))
       {
@@ -129,6 +136,13 @@ class pbes_output_tool: public Tool
     {
       return m_pbes_output_format;
     }
+
+    /// \brief Returns whether the output must be compressed
+    /// \return True if the option --compress is given
+    bool compress_output() const
+    {
+      return m_compress_output;
+    }
 };
 
 } // namespace mcrl2::pbes_system::tools
@@ -20,6 +20,7 @@
 #include <regex>
 
 #include "mcrl2/utilities/detail/container_utility.h"
+#include "mcrl2/utilities/performance_counters.h"
 #include "mcrl2/atermpp/standard_containers/deque.h"
 #include "mcrl2/atermpp/standard_containers/indexed_set.h"
 #include "mcrl2/data/substitution_utility.h"
@@ -41,6 +42,20 @@
 namespace mcrl2::pbes_system
 {
 
+namespace detail
+{
+
+/// \brief The instantiation of the right hand side of a single equation.
+inline const utilities::performance_span pbesinst_instantiate_span("pbes.pbesinst.instantiate");
+/// \brief The optional rewrite step of a generated equation, which is performed under the todo lock.
+inline const utilities::performance_span pbesinst_rewrite_psi_span("pbes.pbesinst.rewrite_psi");
+/// \brief The time that a thread waits for exclusive access to the todo set.
+inline const utilities::performance_span pbesinst_lock_span("pbes.pbesinst.wait_for_lock");
+/// \brief The time that a thread is idle because the todo set is empty.
+inline const utilities::performance_span pbesinst_idle_span("pbes.pbesinst.wait_for_work");
+
+} // namespace detail
+
 // This todo set maintains elements that were removed by the reset procedure.
 class pbesinst_lazy_todo
 {
@@ -167,6 +182,13 @@ class pbesinst_lazy_algorithm
 
     volatile bool m_must_abort = false;
 
+    // Acquires m_todo_access, and records the time spent waiting for it.
+    void lock_todo()
+    {
+      utilities::scoped_performance_span wait_for_lock(detail::pbesinst_lock_span);
+      m_todo_access.lock();
+    }
+
     // \brief Returns a status message about the progress
     virtual std::optional<std::string> status_message(std::size_t equation_count)
     {
@@ -344,7 +366,7 @@ class pbesinst_lazy_algorithm
 
       while (number_of_active_processes > 0)
       {
-        m_todo_access.lock();
+        lock_todo();
         while (!todo.elements().empty() && !m_must_abort)
         {
           ++m_iteration_count;
@@ -363,21 +385,27 @@ class pbesinst_lazy_algorithm
           const pbes_equation& eqn = m_pbes.equations()[index];
           const auto& phi = eqn.formula();
           data::add_assignments(sigma, eqn.variable().parameters(), X_e.parameters());
-          R(psi_e, phi, sigma, phi_substitution(thread_index, eqn.symbol(), X_e, phi));
+          {
+            utilities::scoped_performance_span instantiate(detail::pbesinst_instantiate_span);
+            R(psi_e, phi, sigma, phi_substitution(thread_index, eqn.symbol(), X_e, phi));
+          }
           R.clear_identifier_generator();
           data::remove_assignments(sigma, eqn.variable().parameters());
 
           // optional step
-          m_todo_access.lock();
+          lock_todo();
           tmp = psi_e; // use tmp as input, psi_e as output for rewriting
-          rewrite_psi(thread_index, psi_e, eqn.symbol(), X_e, tmp);
+          {
+            utilities::scoped_performance_span rewrite(detail::pbesinst_rewrite_psi_span);
+            rewrite_psi(thread_index, psi_e, eqn.symbol(), X_e, tmp);
+          }
           m_todo_access.unlock();
 
           std::set<propositional_variable_instantiation> occ = find_propositional_variable_instantiations(psi_e);
 
           // report the generated equation
           std::size_t k = m_equation_index.rank(X_e.name());
-          m_todo_access.lock();
+          lock_todo();
 
           // If pruning took place, the current equation may not have been relevant, and therefore we simply
           // ignore it. If the current equation is not relevant, the newly discovered variables are also possibly
@@ -408,7 +436,10 @@ class pbesinst_lazy_algorithm
         // active again, and tries to see whether the todo buffer is not empty,
         // to take up more work.
         number_of_active_processes--;
-        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        {
+          utilities::scoped_performance_span wait_for_work(detail::pbesinst_idle_span);
+          std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        }
         if (number_of_active_processes > 0)
         {
           number_of_active_processes++;
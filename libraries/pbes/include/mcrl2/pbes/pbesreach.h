@@ -30,6 +30,7 @@
 #include "mcrl2/pbes/rewriters/one_point_rule_rewriter.h"
 #include "mcrl2/pbes/srf_pbes.h"
 #include "mcrl2/pbes/unify_parameters.h"
+#include "mcrl2/symbolic/checkpoint.h"
 #include "mcrl2/symbolic/print.h"
 #include "mcrl2/symbolic/symbolic_reachability.h"
 
@@ -292,6 +293,25 @@ class pbesreach_algorithm
       return symbolic::print_size(L, m_options.print_exact, m_options.print_nodesize);
     }
 
+    void save_checkpoint(std::size_t iteration_count)
+    {
+      stopwatch timer;
+      symbolic::save_reachability_checkpoint(m_options.checkpoint_file, {iteration_count, m_visited, m_todo, m_deadlocks}, m_process_parameters, m_data_index, m_summand_groups);
+      mCRL2log(log::verbose) << "saved checkpoint after " << iteration_count << " iterations to " << m_options.checkpoint_file
+                             << " (time = " << std::setprecision(2) << std::fixed << timer.seconds() << "s)" << std::endl;
+    }
+
+    // Restores m_visited, m_todo and m_deadlocks from the checkpoint, and returns the number of completed iterations.
+    std::size_t load_checkpoint()
+    {
+      symbolic::reachability_checkpoint checkpoint = symbolic::load_reachability_checkpoint(m_options.checkpoint_file, m_process_parameters, m_data_index, m_summand_groups);
+      m_visited = checkpoint.visited;
+      m_todo = checkpoint.todo;
+      m_deadlocks = checkpoint.deadlocks;
+      mCRL2log(log::verbose) << "resuming from checkpoint " << m_options.checkpoint_file << " after " << checkpoint.iteration << " iterations" << std::endl;
+      return checkpoint.iteration;
+    }
+
   public:
     pbesreach_algorithm(const pbes_system::srf_pbes& srf_pbes, const symbolic_reachability_options& options_)
       : m_options(options_),
@@ -332,6 +352,11 @@ class pbesreach_algorithm
       m_variable_order = symbolic::compute_variable_order(m_options.variable_order, m_process_parameters.size(), m_summand_patterns, true);
       assert(m_variable_order[0] == 0); // It is required that the propositional variable name stays up front
       mCRL2log(log::debug) << "variable order = " << core::detail::print_list(m_variable_order) << std::endl;
+      mCRL2log(log::verbose) << "event span of the variable order = " << symbolic::event_span(m_summand_patterns, m_variable_order) << std::endl;
+      if (m_options.info)
+      {
+        mCRL2log(log::info) << symbolic::print_event_span_report(m_summand_patterns, m_variable_order, m_options.variable_order, true);
+      }
       m_summand_patterns = symbolic::reorder_read_write_patterns(m_summand_patterns, m_variable_order);
 
       m_process_parameters = symbolic::permute_copy(m_process_parameters, m_variable_order);
@@ -490,6 +515,12 @@ class pbesreach_algorithm
       m_todo = m_initial_vertex;
       m_deadlocks = empty_set();
 
+      if (m_options.resume)
+      {
+        iteration_count = load_checkpoint();
+      }
+      stopwatch checkpoint_timer;
+
       while (m_todo != empty_set() && !solution_found() && (m_options.max_iterations == 0 || iteration_count < m_options.max_iterations))
       {
         stopwatch loop_start;
@@ -515,6 +546,12 @@ class pbesreach_algorithm
         }
 
         on_end_while_loop();
+
+        if (!m_options.checkpoint_file.empty() && m_todo != empty_set() && checkpoint_timer.seconds() >= static_cast<double>(m_options.checkpoint_interval))
+        {
+          save_checkpoint(iteration_count);
+          checkpoint_timer.reset();
+        }
         sylvan::sylvan_stats_report(stderr);
       }
 
@@ -647,14 +647,15 @@ inline void pbeschain(const std::string& input_filename,
   const std::string& output_filename,
   const utilities::file_format& input_format,
   const utilities::file_format& output_format,
-  pbeschain_options options)
+  pbeschain_options options,
+  bool compress = false)
 {
   pbes p;
   load_pbes(p, input_filename, input_format);
   algorithms::normalize(p);
   pbeschain_pbes_backward_substituter backward_substituter;
   backward_substituter.run(p, options);
-  save_pbes(p, output_filename, output_format);
+  save_pbes(p, output_filename, output_format, true, compress);
 }
 
 } // namespace mcrl2::pbes_system
@@ -47,9 +47,11 @@ const std::vector<utilities::file_format>& pbes_file_formats()
 /// \param stream The stream to which the output is saved.
 /// \param format Determines the format in which the result is written. If unspecified, or
 ///        pbes_file_unknown is specified, then a default format is chosen.
+/// \param compress Whether the PBES is compressed, which only applies to the binary formats.
 void save_pbes(const pbes& pbes,
                std::ostream& stream,
-               utilities::file_format format)
+               utilities::file_format format,
+               bool compress)
 {
   if (format == utilities::file_format())
   {
@@ -58,7 +60,7 @@ void save_pbes(const pbes& pbes,
   mCRL2log(log::verbose) << "Saving result in " << format.shortname() << " format..." << std::endl;
   if (format == pbes_format_internal() || (format == pbes_format_internal_bes() && pbes_system::algorithms::is_bes(pbes)))
   {
-    atermpp::binary_aterm_ostream(stream) << pbes;
+    atermpp::binary_aterm_ostream(stream, compress) << pbes;
   }
   else if (format == pbes_format_pgsolver() && pbes_system::algorithms::is_bes(pbes))
   {
@@ -108,12 +110,14 @@ void load_pbes(pbes& pbes, std::istream& stream, utilities::file_format format,
 /// \param format The format in which to save the PBES.
 /// \param welltypedness_check If set to false, skips checking whether pbes is well typed before
 ///                            saving it to file.
+/// \param compress Whether the PBES is compressed, which only applies to the binary formats.
 ///
 /// The format of the file in infilename is guessed if format is not given or if it is equal to
 /// utilities::file_format().
 void save_pbes(const pbes& pbes, const std::string& filename,
                utilities::file_format format,
-               bool welltypedness_check)
+               bool welltypedness_check,
+               bool compress)
 {
   if (welltypedness_check)
   {
@@ -126,7 +130,7 @@ void save_pbes(const pbes& pbes, const std::string& filename,
 
   if (filename.empty() || filename == "-")
   {
-    save_pbes(pbes, std::cout, format);
+    save_pbes(pbes, std::cout, format, compress);
   }
   else
   {
@@ -135,7 +139,7 @@ void save_pbes(const pbes& pbes, const std::string& filename,
     {
       throw mcrl2::runtime_error("Could not open file " + filename);
     }
-    save_pbes(pbes, filestream, format);
+    save_pbes(pbes, filestream, format, compress);
   }
 }
 
@@ -289,3 +289,23 @@ BOOST_AUTO_TEST_CASE(test_constelm)
   data::detail::set_enumerator_iteration_limit(10); // This final test requires 50*50 enumerations and the default limit of 1000 takes too long.
   test_pbes(t18, x18, true);
 }
+
+// A PBES with many equations and a dependency graph with cycles of different lengths. The parameter n is
+// constant in all equations, while m is not.
+BOOST_AUTO_TEST_CASE(test_constelm_many_equations)
+{
+  const std::size_t N = 200;
+  std::ostringstream text;
+  std::ostringstream expected;
+  text << "pbes\n";
+  expected << "binding_variables = ";
+  for (std::size_t i = 0; i < N; ++i)
+  {
+    text << "  nu X" << i << "(n, m: Nat) = (val(m > 3) && X" << (i + 1) % N << "(n, m + 1)) || X" << (7 * i) % N << "(n, m);\n";
+    expected << (i == 0 ? "" : ", ") << "X" << i << "(m: Nat)";
+  }
+  text << "init X0(5, 4);\n";
+
+  test_pbes(text.str(), expected.str(), false);
+  test_pbes(text.str(), expected.str(), true);
+}
@@ -785,6 +785,37 @@ BOOST_AUTO_TEST_CASE(test_counter_example)
   test_lps2pbes_and_solve(lps_spec, mcf_formula, expected_solution, timed, rewrite, generate_counter_example);
 }
 
+// The translation with multiple threads must give exactly the same PBES as the sequential translation.
+BOOST_AUTO_TEST_CASE(test_threads)
+{
+  std::string lps_spec =
+    "act  a, b: Nat;                                  \n"
+    "     c;                                          \n"
+    "proc P(n, m: Nat) = (n < 3) -> a(n) . P(n = n + 1)\n"
+    "                  + sum k: Nat. (k < m) -> b(k) . P(m = k)\n"
+    "                  + (n == m) -> c . P(n = 0, m = n + 1)\n"
+    "                  + sum d: Nat. (d < 2) -> a(d) . P(m = m + d);\n"
+    "init P(0, 2);                                    \n"
+    ;
+  lps::stochastic_specification lpsspec = lps::linearise(lps_spec);
+  const std::size_t number_of_threads = mcrl2::utilities::detail::GlobalThreadSafe ? 4 : 1;
+
+  for (const std::string& formula_text: { "nu X. ([true]X && forall d:Nat. [a(d)] mu Y. (<true>Y || <b(d)>true))",
+                                          "nu X(n: Nat = 0). ([c]X(n + 1) && exists k: Nat. <a(k)>val(k < n))" })
+  {
+    state_formulas::state_formula formula = state_formulas::algorithms::parse_state_formula(formula_text, lpsspec, false);
+    for (bool structured: { false, true })
+    {
+      for (bool generate_counter_example: { false, true })
+      {
+        pbes expected = lps2pbes(lpsspec, formula, false, structured, false, false, generate_counter_example, false, 1);
+        pbes result = lps2pbes(lpsspec, formula, false, structured, false, false, generate_counter_example, false, number_of_threads);
+        BOOST_CHECK_EQUAL(pbes_system::pp(expected), pbes_system::pp(result));
+      }
+    }
+  }
+}
+
 
 #else // ndef MCRL2_SKIP_LONG_TESTS
 
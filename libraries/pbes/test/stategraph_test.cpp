@@ -14,6 +14,7 @@
 
 #include "mcrl2/pbes/detail/stategraph_local_reset_variables.h"
 #include "mcrl2/pbes/significant_variables.h"
+#include "mcrl2/pbes/stategraph.h"
 #include "mcrl2/pbes/txt2pbes.h"
 #include "mcrl2/utilities/detail/split.h"
 
@@ -770,3 +771,73 @@ BOOST_AUTO_TEST_CASE(test_cfp)
     }
   }
 }
+
+// Returns a PBES with n equations and two control flow parameters s and t
+std::string generate_stategraph_pbes(std::size_t n)
+{
+  std::ostringstream out;
+  out << "pbes\n";
+  for (std::size_t k = 0; k < n; k++)
+  {
+    std::size_t k1 = (k + 1) % n;
+    std::size_t k2 = (3 * k) % n;
+    out << "nu X" << k << "(s, t, d, e: Nat) =\n"
+        << "  (val(s == 0) => X" << k1 << "(1, t, d + 1, e)) &&\n"
+        << "  (val(s == 1) => X" << k << "(0, t, e, d)) &&\n"
+        << "  (val(t == " << (k % 3) << ") => X" << k2 << "(s, " << (k % 2) << ", d, e + 1))"
+        << (k % 4 == 0 ? " && val(d < 10)" : "") << ";\n";
+  }
+  out << "init X0(0, 0, 0, 0);\n";
+  return out.str();
+}
+
+// Checks that the marking algorithms and the caching of marking updates do not influence the result
+BOOST_AUTO_TEST_CASE(test_marking_algorithms)
+{
+  std::vector<std::string> texts =
+  {
+    "pbes\n"
+    "nu X(i,n:Nat) = (val(i == 0) => Y(i,n+1));\n"
+    "nu Y(i,n:Nat) = (val(i==0) => Z(i,0,n+1)) && (val(i==0) => X(i,n+1));\n"
+    "nu Z(i,j,n:Nat) = (val(i==0 && n == 1) => Z(1,j,n)) && (val(i==1) => X(n,j));\n"
+    "init X(0,0);\n",
+
+    "pbes\n"
+    "nu X(i,n:Nat) = (val(i == 0) => Y(i,n));\n"
+    "nu Y(i,n:Nat) = (val(i==0) => X(i,0)) && (val(i==1) => X(n+1,2));\n"
+    "init X(0,0);\n",
+
+    "pbes\n"
+    "nu X(c:Pos, d:Nat) = val(c == 1) => Y(1,d+1) && (val(c == 1) => X(1,d+2));\n"
+    "nu Y(c:Pos, d:Nat) = (val(c == 1) => Y(c,d+1)) && (val(d > 0));\n"
+    "init X(1,0);\n",
+
+    generate_stategraph_pbes(5),
+    generate_stategraph_pbes(40)
+  };
+
+  for (const std::string& text: texts)
+  {
+    std::string expected_result;
+    for (int marking_algorithm = 0; marking_algorithm <= 2; marking_algorithm++)
+    {
+      for (bool cache_marking_updates: { false, true })
+      {
+        pbes p = txt2pbes(text, false);
+        pbesstategraph_options options;
+        options.marking_algorithm = marking_algorithm;
+        options.cache_marking_updates = cache_marking_updates;
+        stategraph(p, options);
+        std::string result = pbes_system::pp(p);
+        if (expected_result.empty())
+        {
+          expected_result = result;
+        }
+        else if (result != expected_result)
+        {
+          check_result(text, result, expected_result, "marking algorithm " + std::to_string(marking_algorithm));
+        }
+      }
+    }
+  }
+}
@@ -201,21 +201,36 @@ multi_action_name_set set_intersection(const allow_set& A1, const multi_action_n
 inline
 std::pair<multi_action_name_set, bool> bounded_concat(const multi_action_name_set& A1, const multi_action_name_set& A2, const allow_set& A)
 {
+  detail::multi_action_name_encoding encoding;
+  encoding.add_names(A1);
+  encoding.add_names(A2);
+  encoding.set_capacity(detail::max_size(A1) + detail::max_size(A2));
+  std::vector<detail::packed_multi_action_name> P1 = encoding.encode(A1);
+  std::vector<detail::packed_multi_action_name> P2 = encoding.encode(A2);
+
+  detail::packed_multi_action_name_set candidates;
+  detail::packed_multi_action_name alpha;
+  for (const detail::packed_multi_action_name& i: P1)
+  {
+    for (const detail::packed_multi_action_name& j: P2)
+    {
+      encoding.add(i, j, alpha);
+      candidates.insert(alpha);
+    }
+  }
+
   bool removed = false;
   multi_action_name_set result;
-  for (const multi_action_name& i: A1)
+  for (const detail::packed_multi_action_name& x: candidates)
   {
-    for (const multi_action_name& j: A2)
+    multi_action_name beta = encoding.decode(x);
+    if (A.contains(beta))
     {
-      multi_action_name alpha = multiset_union(i, j);
-      if (A.contains(alpha))
-      {
-        result.insert(alpha);
-      }
-      else
-      {
-        removed = true;
-      }
+      result.insert(beta);
+    }
+    else
+    {
+      removed = true;
     }
   }
   return { result, removed };
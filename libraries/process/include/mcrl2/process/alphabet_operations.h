@@ -16,6 +16,7 @@
 #include "mcrl2/process/communication_expression.h"
 #include "mcrl2/process/multi_action_name.h"
 #include "mcrl2/process/action_names.h"
+#include "mcrl2/process/detail/packed_multi_action_name.h"
 #include "mcrl2/process/process_expression.h"
 #include "mcrl2/process/rename_expression.h"
 #include "mcrl2/utilities/detail/atomic_wrapper.h"
@@ -141,18 +142,29 @@ multi_action_name_set hide_inverse(const core::identifier_string_list& I, const
 // merge/left_merge/sync operations
 //-----------------------------------------------------//
 
+// The products below are computed on packed multi action names, such that each multiset union is a
+// few word additions, and duplicates are removed using a hash set before the result is decoded.
 inline
 multi_action_name_set concat(const multi_action_name_set& A1, const multi_action_name_set& A2)
 {
-  multi_action_name_set result;
-  for (const multi_action_name& i: A1)
+  detail::multi_action_name_encoding encoding;
+  encoding.add_names(A1);
+  encoding.add_names(A2);
+  encoding.set_capacity(detail::max_size(A1) + detail::max_size(A2));
+  std::vector<detail::packed_multi_action_name> P1 = encoding.encode(A1);
+  std::vector<detail::packed_multi_action_name> P2 = encoding.encode(A2);
+
+  detail::packed_multi_action_name_set result;
+  detail::packed_multi_action_name alpha;
+  for (const detail::packed_multi_action_name& i: P1)
   {
-    for (const multi_action_name& j: A2)
+    for (const detail::packed_multi_action_name& j: P2)
     {
-       result.insert(multiset_union(i, j));
+      encoding.add(i, j, alpha);
+      result.insert(alpha);
     }
   }
-  return result;
+  return encoding.decode(result);
 }
 
 // Returns true if alpha in concat(A1, A2).
@@ -177,16 +189,32 @@ bool concat_includes(const multi_action_name_set& A1, const multi_action_name_se
 inline
 multi_action_name_set bounded_concat(const multi_action_name_set& A1, const multi_action_name_set& A2, const multi_action_name_set& A)
 {
+  detail::multi_action_name_encoding encoding;
+  encoding.add_names(A1);
+  encoding.add_names(A2);
+  encoding.add_names(A);
+  encoding.set_capacity(std::max(detail::max_size(A1) + detail::max_size(A2), detail::max_size(A)));
+  std::vector<detail::packed_multi_action_name> P1 = encoding.encode(A1);
+  std::vector<detail::packed_multi_action_name> P2 = encoding.encode(A2);
+  std::vector<detail::packed_multi_action_name> P = encoding.encode(A);
+
+  detail::packed_multi_action_name_set candidates;
+  detail::packed_multi_action_name alpha;
+  for (const detail::packed_multi_action_name& i: P1)
+  {
+    for (const detail::packed_multi_action_name& j: P2)
+    {
+      encoding.add(i, j, alpha);
+      candidates.insert(alpha);
+    }
+  }
+
   multi_action_name_set result;
-  for (const multi_action_name& i: A1)
+  for (const detail::packed_multi_action_name& x: candidates)
   {
-    for (const multi_action_name& j: A2)
+    if (std::any_of(P.begin(), P.end(), [&](const detail::packed_multi_action_name& y) { return encoding.includes(y, x); }))
     {
-      multi_action_name alpha = multiset_union(i, j);
-      if (subset_includes(A, alpha))
-      {
-        result.insert(alpha);
-      }
+      result.insert(encoding.decode(x));
     }
   }
   return result;
@@ -195,21 +223,35 @@ multi_action_name_set bounded_concat(const multi_action_name_set& A1, const mult
 inline
 multi_action_name_set left_arrow1(const multi_action_name_set& A1, const multi_action_name_set& A2)
 {
-  multi_action_name_set result = A1; // needed because tau is not explicitly stored
-  for (const multi_action_name& beta: A2)
+  detail::multi_action_name_encoding encoding;
+  encoding.add_names(A1);
+  encoding.add_names(A2);
+  encoding.set_capacity(std::max(detail::max_size(A1), detail::max_size(A2)));
+  std::vector<detail::packed_multi_action_name> P1 = encoding.encode(A1);
+  std::vector<detail::packed_multi_action_name> P2 = encoding.encode(A2);
+
+  detail::packed_multi_action_name_set differences;
+  detail::packed_multi_action_name alpha;
+  for (const detail::packed_multi_action_name& beta: P2)
   {
-    for (const multi_action_name& gamma: A1)
+    for (const detail::packed_multi_action_name& gamma: P1)
     {
-      if (includes(gamma, beta))
+      if (encoding.includes(gamma, beta))
       {
-        multi_action_name alpha = multiset_difference(gamma, beta);
-        if (!alpha.empty())
+        encoding.subtract(gamma, beta, alpha);
+        if (!encoding.is_empty(alpha))
         {
-          result.insert(alpha);
+          differences.insert(alpha);
         }
       }
     }
   }
+
+  multi_action_name_set result = A1; // needed because tau is not explicitly stored
+  for (const detail::packed_multi_action_name& x: differences)
+  {
+    result.insert(encoding.decode(x));
+  }
   return result;
 }
 
@@ -232,22 +274,38 @@ multi_action_name_set left_arrow(const multi_action_name_set& A1, bool A1_includ
 inline
 multi_action_name_set left_arrow2(const multi_action_name_set& A, const std::set<core::identifier_string>& I, const multi_action_name_set& A2)
 {
-  multi_action_name_set result = A; // needed because tau is not explicitly stored
-  for (const multi_action_name& alpha2: A2)
+  detail::multi_action_name_encoding encoding;
+  encoding.add_names(A);
+  encoding.add_names(A2);
+  encoding.set_capacity(std::max(detail::max_size(A), detail::max_size(A2)));
+  std::vector<detail::packed_multi_action_name> P = encoding.encode(A);
+  std::vector<detail::packed_multi_action_name> P2 = encoding.encode(A2);
+  const detail::packed_multi_action_name mask = encoding.hide_mask(I);
+
+  detail::packed_multi_action_name_set differences;
+  detail::packed_multi_action_name gamma;
+  for (detail::packed_multi_action_name& beta: P2)
   {
-    multi_action_name beta = hide(I, alpha2);
-    for (const multi_action_name& alpha: A)
+    encoding.hide(beta, mask);
+    for (const detail::packed_multi_action_name& alpha: P)
     {
-      if (includes(alpha, beta))
+      if (encoding.includes(alpha, beta))
       {
-        multi_action_name gamma = multiset_difference(alpha, beta);
-        if (!gamma.empty())
+        encoding.subtract(alpha, beta, gamma);
+        if (!encoding.is_empty(gamma))
         {
-          result.insert(hide(I, gamma));
+          encoding.hide(gamma, mask);
+          differences.insert(gamma);
         }
       }
     }
   }
+
+  multi_action_name_set result = A; // needed because tau is not explicitly stored
+  for (const detail::packed_multi_action_name& x: differences)
+  {
+    result.insert(encoding.decode(x));
+  }
   return result;
 }
 
@@ -452,15 +510,49 @@ void apply_comm(const communication_expression& c, multi_action_name_set& A)
 inline
 multi_action_name_set comm(const communication_expression_list& C, const multi_action_name_set& A, bool /* A_includes_subsets */ = false)
 {
-  multi_action_name_set result = A;
+  // A communication never increases the size of a multi action name, so the elements of the result fit in the
+  // capacity of A. The left hand sides of the communications must fit as well, as they are encoded to be compared
+  // with the elements of A.
+  detail::multi_action_name_encoding encoding;
+  encoding.add_names(A);
+  std::size_t capacity = detail::max_size(A);
+  for (const communication_expression& c: C)
+  {
+    encoding.add_names(c.action_name().names());
+    encoding.add_name(c.name());
+    capacity = std::max(capacity, c.action_name().names().size());
+  }
+  encoding.set_capacity(capacity);
 
-  // sequentially apply the communication rules to result
+  std::vector<detail::packed_multi_action_name> result = encoding.encode(A);
+  detail::packed_multi_action_name_set result_set(result.begin(), result.end());
+
+  // sequentially apply the communication rules to result, as in apply_comm
   for (const communication_expression& c: C)
   {
-    apply_comm(c, result);
+    const core::identifier_string_list& names = c.action_name().names();
+    const detail::packed_multi_action_name alpha = encoding.encode(multi_action_name(names.begin(), names.end()));
+    multi_action_name a;
+    a.insert(c.name());
+    const detail::packed_multi_action_name a_packed = encoding.encode(a);
+
+    const std::size_t n = result.size();
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      detail::packed_multi_action_name beta = result[i];
+      while (encoding.includes(beta, alpha))
+      {
+        encoding.subtract(beta, alpha, beta);
+        encoding.add(beta, a_packed, beta);
+        if (result_set.insert(beta).second)
+        {
+          result.push_back(beta);
+        }
+      }
+    }
   }
 
-  return result;
+  return encoding.decode(result);
 }
 
 inline
@@ -672,18 +764,39 @@ inline
 multi_action_name_set allow(const action_name_multiset_list& V, const multi_action_name_set& A, bool A_includes_subsets = false)
 {
   multi_action_name_set result;
+  if (!A_includes_subsets)
+  {
+    for (const action_name_multiset& s: V)
+    {
+      const core::identifier_string_list& names = s.names();
+      multi_action_name v(names.begin(), names.end());
+      if (A.find(v) != A.end())
+      {
+        result.insert(v);
+      }
+    }
+    return result;
+  }
+
+  detail::multi_action_name_encoding encoding;
+  encoding.add_names(A);
+  std::size_t capacity = detail::max_size(A);
+  for (const action_name_multiset& s: V)
+  {
+    encoding.add_names(s.names());
+    capacity = std::max(capacity, s.names().size());
+  }
+  encoding.set_capacity(capacity);
+  std::vector<detail::packed_multi_action_name> P = encoding.encode(A);
 
   for (const action_name_multiset& s: V)
   {
     const core::identifier_string_list& names = s.names();
     multi_action_name v(names.begin(), names.end());
-    for (const multi_action_name& alpha: A)
+    detail::packed_multi_action_name v_packed = encoding.encode(v);
+    if (std::any_of(P.begin(), P.end(), [&](const detail::packed_multi_action_name& alpha) { return encoding.includes(alpha, v_packed); }))
     {
-      bool keep = A_includes_subsets ? includes(alpha, v) : alpha == v;
-      if (keep)
-      {
-        result.insert(v);
-      }
+      result.insert(v);
     }
   }
   return result;
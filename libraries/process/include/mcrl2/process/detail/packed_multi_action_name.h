@@ -0,0 +1,223 @@
+// Author(s): agent
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/process/detail/packed_multi_action_name.h
+/// \brief A compact encoding of multi action names as packed vectors of counts.
+
+#ifndef MCRL2_PROCESS_DETAIL_PACKED_MULTI_ACTION_NAME_H
+#define MCRL2_PROCESS_DETAIL_PACKED_MULTI_ACTION_NAME_H
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "mcrl2/process/multi_action_name.h"
+#include "mcrl2/utilities/hash_utility.h"
+
+namespace mcrl2::process::detail
+{
+
+/// \brief A multi action name stored as a sequence of words, in which each word contains the counts of a fixed
+/// number of action names in bit fields of equal width.
+using packed_multi_action_name = std::vector<std::uint64_t>;
+
+/// \brief A set of packed multi action names.
+using packed_multi_action_name_set = std::unordered_set<packed_multi_action_name>;
+
+/// \brief Returns the maximal size of the elements of A.
+inline std::size_t max_size(const multi_action_name_set& A)
+{
+  std::size_t result = 0;
+  for (const multi_action_name& alpha: A)
+  {
+    result = std::max(result, alpha.size());
+  }
+  return result;
+}
+
+/// \brief Maps the action names occurring in an alphabet computation to consecutive indices, and encodes multi
+/// action names over these names as packed count vectors.
+/// \details Each count is stored in a bit field with one additional guard bit, which is always zero. This allows
+/// the addition, subtraction and inclusion test of two multi action names to be performed on whole words at once.
+/// First all action names must be added, after which set_capacity fixes the layout.
+class multi_action_name_encoding
+{
+  protected:
+    std::unordered_map<core::identifier_string, std::size_t> m_indices;
+    std::vector<core::identifier_string> m_names;
+    std::size_t m_field_width = 0;     // the width of a bit field, including the guard bit
+    std::size_t m_fields_per_word = 0;
+    std::size_t m_words = 0;
+    std::uint64_t m_guard_bits = 0;    // the guard bits of a word with all fields in use
+
+    std::size_t word(std::size_t i) const
+    {
+      return i / m_fields_per_word;
+    }
+
+    std::size_t shift(std::size_t i) const
+    {
+      return (i % m_fields_per_word) * m_field_width;
+    }
+
+  public:
+    void add_name(const core::identifier_string& a)
+    {
+      if (m_indices.emplace(a, m_names.size()).second)
+      {
+        m_names.push_back(a);
+      }
+    }
+
+    template <typename Container>
+    void add_names(const Container& names)
+    {
+      for (const core::identifier_string& a: names)
+      {
+        add_name(a);
+      }
+    }
+
+    void add_names(const multi_action_name_set& A)
+    {
+      for (const multi_action_name& alpha: A)
+      {
+        add_names(alpha);
+      }
+    }
+
+    /// \brief Fixes the layout such that each count of an action name can be at most max_count.
+    void set_capacity(std::size_t max_count)
+    {
+      m_field_width = std::bit_width(std::max<std::size_t>(max_count, 1)) + 1;
+      m_fields_per_word = 64 / m_field_width;
+      m_words = (m_names.size() + m_fields_per_word - 1) / m_fields_per_word;
+      m_guard_bits = 0;
+      for (std::size_t i = 0; i < m_fields_per_word; ++i)
+      {
+        m_guard_bits |= std::uint64_t(1) << (i * m_field_width + m_field_width - 1);
+      }
+    }
+
+    packed_multi_action_name encode(const multi_action_name& alpha) const
+    {
+      packed_multi_action_name result(m_words, 0);
+      for (const core::identifier_string& a: alpha)
+      {
+        std::size_t i = m_indices.at(a);
+        result[word(i)] += std::uint64_t(1) << shift(i);
+      }
+      return result;
+    }
+
+    std::vector<packed_multi_action_name> encode(const multi_action_name_set& A) const
+    {
+      std::vector<packed_multi_action_name> result;
+      result.reserve(A.size());
+      for (const multi_action_name& alpha: A)
+      {
+        result.push_back(encode(alpha));
+      }
+      return result;
+    }
+
+    multi_action_name decode(const packed_multi_action_name& x) const
+    {
+      const std::uint64_t field_mask = (std::uint64_t(1) << m_field_width) - 1;
+      std::vector<core::identifier_string> names;
+      for (std::size_t i = 0; i < m_names.size(); ++i)
+      {
+        std::size_t count = (x[word(i)] >> shift(i)) & field_mask;
+        names.insert(names.end(), count, m_names[i]);
+      }
+      return multi_action_name(names.begin(), names.end());
+    }
+
+    template <typename Container>
+    multi_action_name_set decode(const Container& A) const
+    {
+      multi_action_name_set result;
+      for (const packed_multi_action_name& x: A)
+      {
+        result.insert(decode(x));
+      }
+      return result;
+    }
+
+    /// \brief Returns a mask that removes the action names in I by a bitwise and.
+    template <typename IdentifierContainer>
+    packed_multi_action_name hide_mask(const IdentifierContainer& I) const
+    {
+      packed_multi_action_name result(m_words, ~std::uint64_t(0));
+      for (const core::identifier_string& a: I)
+      {
+        auto j = m_indices.find(a);
+        if (j != m_indices.end())
+        {
+          std::size_t i = j->second;
+          result[word(i)] &= ~(((std::uint64_t(1) << m_field_width) - 1) << shift(i));
+        }
+      }
+      return result;
+    }
+
+    /// \brief Computes result = x + y. The counts of the result may not exceed the capacity.
+    void add(const packed_multi_action_name& x, const packed_multi_action_name& y, packed_multi_action_name& result) const
+    {
+      result.resize(m_words);
+      for (std::size_t k = 0; k < m_words; ++k)
+      {
+        result[k] = x[k] + y[k];
+      }
+    }
+
+    /// \brief Computes result = x - y, provided that includes(x, y).
+    void subtract(const packed_multi_action_name& x, const packed_multi_action_name& y, packed_multi_action_name& result) const
+    {
+      result.resize(m_words);
+      for (std::size_t k = 0; k < m_words; ++k)
+      {
+        result[k] = x[k] - y[k];
+      }
+    }
+
+    /// \brief Computes x = x & mask.
+    void hide(packed_multi_action_name& x, const packed_multi_action_name& mask) const
+    {
+      for (std::size_t k = 0; k < m_words; ++k)
+      {
+        x[k] &= mask[k];
+      }
+    }
+
+    /// \brief Returns true if the multiset y is contained in x.
+    /// \details For each field, the guard bit of (x | guard) - y is set if and only if x >= y. The subtraction
+    /// never borrows from the next field.
+    bool includes(const packed_multi_action_name& x, const packed_multi_action_name& y) const
+    {
+      for (std::size_t k = 0; k < m_words; ++k)
+      {
+        if ((((x[k] | m_guard_bits) - y[k]) & m_guard_bits) != m_guard_bits)
+        {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    static bool is_empty(const packed_multi_action_name& x)
+    {
+      return std::all_of(x.begin(), x.end(), [](std::uint64_t w) { return w == 0; });
+    }
+};
+
+} // namespace mcrl2::process::detail
+
+#endif // MCRL2_PROCESS_DETAIL_PACKED_MULTI_ACTION_NAME_H
@@ -169,6 +169,11 @@ BOOST_AUTO_TEST_CASE(test_alphabet_operations)
   test_alphabet_operation("{ab, b}", "{b}", "{a, ab, b}", left_arrow1, "left_arrow1"); // N.B. tau is excluded!
   test_alphabet_operation("{bc}", "{c}", "{b, bc}", left_arrow1, "left_arrow1");
   test_alphabet_operation("{a}", "{a}", "{a}", left_arrow1, "left_arrow1");
+
+  // multi action names with large counts, or with more action names than fit in one word of the packed encoding
+  test_alphabet_operation("{aaa, b}", "{aaaa, b}", "{aaaaaaa, aaaab, aaab, bb}", concat, "concat");
+  test_alphabet_operation("{abcdefghijklm}", "{nopqrstuvwxyz}", "{abcdefghijklmnopqrstuvwxyz}", concat, "concat");
+  test_alphabet_operation("{abcdefghijklmnopqrstuvwxyz}", "{az}", "{abcdefghijklmnopqrstuvwxyz, bcdefghijklmnopqrstuvwxy}", left_arrow1, "left_arrow1");
 }
 
 void test_push_allow(const std::string& expression, const std::string& Atext, const std::string& expected_result, const std::string& equations = "")
@@ -222,6 +227,9 @@ BOOST_AUTO_TEST_CASE(test_comm_operations)
   test_comm_operation("{a|c->d}", "{b, d, e}", "{aa, ab, ad}@", "{b, d, tau}@", comm_inverse, "comm_inverse");
   test_comm_operation("{a|b -> c}", "{a, b, c}", "{ab, aab, aabb, abd}", "{aab, aabb, ab, abc, abd, ac, c, cc, cd}", comm, "comm");
   test_comm_operation("{a|b -> c}", "{a, b, c}", "{ab, aab, aabb, abd}@", "{aab, aabb, ab, abc, abd, ac, c, cc, cd}@", comm, "comm");
+  // The left hand side of a communication is larger than the multi actions in A.
+  test_comm_operation("{a|a|a|a -> c}", "{a, b, c}", "{b}", "{b}", comm, "comm");
+  test_comm_operation("{a|a|a|a -> c}", "{a, b, c}", "{aaa, b}", "{aaa, b}", comm, "comm");
 }
 
 template <typename Operation>
@@ -0,0 +1,188 @@
+// Author(s): agent
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/symbolic/checkpoint.h
+/// \brief Saving and restoring the state of a symbolic reachability computation.
+
+#ifndef MCRL2_SYMBOLIC_CHECKPOINT_H
+#define MCRL2_SYMBOLIC_CHECKPOINT_H
+
+#ifdef MCRL2_ENABLE_SYLVAN
+
+#include "mcrl2/atermpp/aterm_io_binary.h"
+#include "mcrl2/data/detail/io.h"
+#include "mcrl2/symbolic/data_index.h"
+#include "mcrl2/symbolic/ldd_stream.h"
+
+#include <filesystem>
+#include <fstream>
+#include <functional>
+
+namespace mcrl2::symbolic
+{
+
+/// \brief The state of a breadth-first reachability computation after a completed iteration.
+struct reachability_checkpoint
+{
+  std::size_t iteration = 0;
+  sylvan::ldds::ldd visited;
+  sylvan::ldds::ldd todo;
+  sylvan::ldds::ldd deadlocks;
+};
+
+/// \brief Writes or reads additional information of a specific algorithm, such as an action index.
+using checkpoint_write_function = std::function<void(atermpp::aterm_ostream&, utilities::obitstream&)>;
+using checkpoint_read_function = std::function<void(atermpp::aterm_istream&, utilities::ibitstream&)>;
+
+namespace detail
+{
+
+inline
+atermpp::aterm reachability_checkpoint_mark()
+{
+  return atermpp::aterm(atermpp::function_symbol("symbolic_reachability_checkpoint", 0));
+}
+
+} // namespace detail
+
+/// \brief Saves the checkpoint, the data indices and the learned transition relations to the file.
+/// \details The file is first written under a temporary name and then renamed, such that an interrupted
+///          write never destroys the previous checkpoint.
+template <typename SummandGroup>
+void save_reachability_checkpoint(const std::string& filename,
+                                  const reachability_checkpoint& checkpoint,
+                                  const data::variable_list& process_parameters,
+                                  const std::vector<data_expression_index>& data_index,
+                                  const std::vector<SummandGroup>& summand_groups,
+                                  const checkpoint_write_function& write_extra = nullptr)
+{
+  const std::string temporary_filename = filename + ".tmp";
+  {
+    std::ofstream stream(temporary_filename, std::ofstream::out | std::ofstream::binary);
+    if (!stream.good())
+    {
+      throw mcrl2::runtime_error("Could not write the checkpoint to " + temporary_filename + ".");
+    }
+
+    std::shared_ptr<utilities::obitstream> bitstream = std::make_shared<utilities::obitstream>(stream);
+    atermpp::binary_aterm_ostream aterm_stream(bitstream);
+    binary_ldd_ostream ldd_stream(bitstream);
+    aterm_stream << data::detail::remove_index_impl;
+
+    aterm_stream << detail::reachability_checkpoint_mark();
+    aterm_stream << process_parameters;
+    bitstream->write_integer(checkpoint.iteration);
+    ldd_stream << checkpoint.visited;
+    ldd_stream << checkpoint.todo;
+    ldd_stream << checkpoint.deadlocks;
+
+    for (const data_expression_index& index: data_index)
+    {
+      bitstream->write_integer(index.size());
+      for (const data::data_expression& value: index)
+      {
+        aterm_stream << value;
+      }
+    }
+
+    if (write_extra)
+    {
+      write_extra(aterm_stream, *bitstream);
+    }
+
+    bitstream->write_integer(summand_groups.size());
+    for (const SummandGroup& group: summand_groups)
+    {
+      ldd_stream << group.L;
+      ldd_stream << group.Ldomain;
+      bitstream->write_integer(group.learn_calls);
+    }
+  }
+  std::filesystem::rename(temporary_filename, filename);
+}
+
+/// \brief Restores a checkpoint that was saved by save_reachability_checkpoint. The process parameters and
+///        the number of summand groups must be the same as when the checkpoint was saved, and data_index may
+///        only contain the values that were inserted before exploration started (such as the initial state).
+template <typename SummandGroup>
+reachability_checkpoint load_reachability_checkpoint(const std::string& filename,
+                                                     const data::variable_list& process_parameters,
+                                                     std::vector<data_expression_index>& data_index,
+                                                     std::vector<SummandGroup>& summand_groups,
+                                                     const checkpoint_read_function& read_extra = nullptr)
+{
+  std::ifstream stream(filename, std::ifstream::in | std::ifstream::binary);
+  if (!stream.good())
+  {
+    throw mcrl2::runtime_error("Could not read the checkpoint from " + filename + ".");
+  }
+
+  std::shared_ptr<utilities::ibitstream> bitstream = std::make_shared<utilities::ibitstream>(stream);
+  atermpp::binary_aterm_istream aterm_stream(bitstream);
+  binary_ldd_istream ldd_stream(bitstream);
+  aterm_stream >> data::detail::add_index_impl;
+
+  atermpp::aterm marker;
+  aterm_stream >> marker;
+  if (marker != detail::reachability_checkpoint_mark())
+  {
+    throw mcrl2::runtime_error("The file " + filename + " does not contain a symbolic reachability checkpoint.");
+  }
+
+  data::variable_list parameters;
+  aterm_stream >> parameters;
+  if (parameters != process_parameters)
+  {
+    throw mcrl2::runtime_error("The checkpoint " + filename + " belongs to a different specification or variable order.");
+  }
+
+  reachability_checkpoint result;
+  result.iteration = bitstream->read_integer();
+  ldd_stream >> result.visited;
+  ldd_stream >> result.todo;
+  ldd_stream >> result.deadlocks;
+
+  // The values must get the same indices as before, since these are the values in the LDDs.
+  for (data_expression_index& index: data_index)
+  {
+    std::size_t number_of_entries = bitstream->read_integer();
+    for (std::size_t i = 0; i < number_of_entries; ++i)
+    {
+      data::data_expression value;
+      aterm_stream >> value;
+      if (index.insert(value).first != i)
+      {
+        throw mcrl2::runtime_error("The data indices in the checkpoint " + filename + " do not match with the specification.");
+      }
+    }
+  }
+
+  if (read_extra)
+  {
+    read_extra(aterm_stream, *bitstream);
+  }
+
+  if (bitstream->read_integer() != summand_groups.size())
+  {
+    throw mcrl2::runtime_error("The checkpoint " + filename + " has a different number of summand groups.");
+  }
+  for (SummandGroup& group: summand_groups)
+  {
+    ldd_stream >> group.L;
+    ldd_stream >> group.Ldomain;
+    group.learn_calls = bitstream->read_integer();
+  }
+
+  return result;
+}
+
+} // namespace mcrl2::symbolic
+
+#endif // MCRL2_ENABLE_SYLVAN
+
+#endif // MCRL2_SYMBOLIC_CHECKPOINT_H
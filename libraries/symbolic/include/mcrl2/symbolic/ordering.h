@@ -10,6 +10,7 @@
 #ifndef MCRL2_SYMBOLIC_ORDERING_H
 #define MCRL2_SYMBOLIC_ORDERING_H
 
+#include "mcrl2/core/detail/print_utility.h"
 #include "mcrl2/data/variable.h"
 #include "mcrl2/utilities/detail/container_utility.h"
 #include "mcrl2/utilities/logger.h"
@@ -27,6 +28,7 @@
 #include <limits>
 #include <random>
 #include <regex>
+#include <sstream>
 
 namespace mcrl2::symbolic
 {
@@ -339,6 +341,300 @@ std::vector<std::size_t> compute_variable_order_weighted(const std::vector<boost
   return order;
 }
 
+/// \brief Returns the event span of the patterns for the given variable order, i.e. the sum over all patterns of
+///        the distance between the first and the last used variable plus one. Patterns that use no variables
+///        do not contribute. A small event span indicates that the summands are local in the LDD.
+inline
+std::size_t event_span(const std::vector<boost::dynamic_bitset<>>& patterns, const std::vector<std::size_t>& variable_order)
+{
+  std::size_t result = 0;
+  for (const auto& pattern: patterns)
+  {
+    std::size_t first = std::numeric_limits<std::size_t>::max();
+    std::size_t last = 0;
+    for (std::size_t i = 0; i < variable_order.size(); i++)
+    {
+      if (is_used(pattern, variable_order[i]))
+      {
+        first = std::min(first, i);
+        last = i;
+      }
+    }
+    if (first != std::numeric_limits<std::size_t>::max())
+    {
+      result += last - first + 1;
+    }
+  }
+  return result;
+}
+
+/// \brief Returns the event span divided by its maximum value, which is the number of patterns times the number of variables.
+inline
+double normalised_event_span(const std::vector<boost::dynamic_bitset<>>& patterns, const std::vector<std::size_t>& variable_order)
+{
+  if (patterns.empty() || variable_order.empty())
+  {
+    return 0.0;
+  }
+  return static_cast<double>(event_span(patterns, variable_order)) / static_cast<double>(patterns.size() * variable_order.size());
+}
+
+/// \brief Returns the order in which the first variable is moved to the front, if exclude_first_variable is true.
+inline
+std::vector<std::size_t> fix_first_variable(std::vector<std::size_t> order, bool exclude_first_variable)
+{
+  if (exclude_first_variable && !order.empty())
+  {
+    order.erase(std::find(order.begin(), order.end(), 0));
+    order.insert(order.begin(), 0);
+  }
+  return order;
+}
+
+/// \brief Improves the given variable order using the FORCE heuristic of Aloul, Markov and Sakallah. Every pattern
+///        is a hyperedge over the variables it uses. In every iteration all variables are moved to the average
+///        center of gravity of the hyperedges that contain them. The order with the smallest event span is returned.
+inline
+std::vector<std::size_t> force_improve(const std::vector<boost::dynamic_bitset<>>& patterns, std::vector<std::size_t> order)
+{
+  const std::size_t n = order.size();
+  std::vector<std::size_t> best = order;
+  std::size_t best_span = event_span(patterns, order);
+
+  std::vector<std::size_t> position(n);
+  std::vector<double> gravity(n);
+  std::vector<std::size_t> degree(n);
+  const std::size_t max_iterations = std::max<std::size_t>(100, 10 * n);
+  for (std::size_t iteration = 0; iteration < max_iterations; iteration++)
+  {
+    for (std::size_t i = 0; i < n; i++)
+    {
+      position[order[i]] = i;
+    }
+    std::fill(gravity.begin(), gravity.end(), 0.0);
+    std::fill(degree.begin(), degree.end(), 0);
+    for (const auto& pattern: patterns)
+    {
+      double center = 0.0;
+      std::size_t size = 0;
+      for (std::size_t j = 0; j < n; j++)
+      {
+        if (is_used(pattern, j))
+        {
+          center += static_cast<double>(position[j]);
+          size++;
+        }
+      }
+      if (size == 0)
+      {
+        continue;
+      }
+      center /= static_cast<double>(size);
+      for (std::size_t j = 0; j < n; j++)
+      {
+        if (is_used(pattern, j))
+        {
+          gravity[j] += center;
+          degree[j]++;
+        }
+      }
+    }
+    for (std::size_t j = 0; j < n; j++)
+    {
+      // Variables that are not used by any pattern keep their position.
+      gravity[j] = degree[j] == 0 ? static_cast<double>(position[j]) : gravity[j] / static_cast<double>(degree[j]);
+    }
+
+    std::vector<std::size_t> next = order;
+    std::stable_sort(next.begin(), next.end(), [&](std::size_t x, std::size_t y) { return gravity[x] < gravity[y]; });
+    if (next == order)
+    {
+      break;
+    }
+    order = next;
+
+    std::size_t span = event_span(patterns, order);
+    if (span < best_span)
+    {
+      best_span = span;
+      best = order;
+    }
+  }
+  return best;
+}
+
+/// \brief Computes a variable order using the FORCE heuristic. Since FORCE gets stuck in symmetric configurations,
+///        it is started from the default order and from a number of random orders with a fixed seed, such that the
+///        result is deterministic.
+inline
+std::vector<std::size_t> compute_variable_order_force(const std::vector<boost::dynamic_bitset<>>& patterns, std::size_t n, bool exclude_first_variable = false)
+{
+  const std::size_t restarts = 10;
+  std::vector<std::size_t> order = compute_variable_order_default(n);
+  std::vector<std::size_t> best = force_improve(patterns, order);
+  std::mt19937 generator(n);
+  for (std::size_t i = 0; i < restarts; i++)
+  {
+    std::shuffle(order.begin(), order.end(), generator);
+    std::vector<std::size_t> candidate = force_improve(patterns, order);
+    if (event_span(patterns, candidate) < event_span(patterns, best))
+    {
+      best = candidate;
+    }
+  }
+
+  best = fix_first_variable(best, exclude_first_variable);
+  mCRL2log(log::verbose) << "force order = " << core::detail::print_list(best) << std::endl;
+  return best;
+}
+
+/// \brief Computes a variable order using the bandwidth and profile reduction algorithm of Sloan on the graph in
+///        which two variables are adjacent iff they are used by the same pattern.
+inline
+std::vector<std::size_t> compute_variable_order_sloan(const std::vector<boost::dynamic_bitset<>>& patterns, std::size_t n, bool exclude_first_variable = false)
+{
+  // The weights of the distance to the end vertex and the degree, as suggested by Sloan.
+  const long W1 = 1;
+  const long W2 = 2;
+
+  std::vector<std::vector<std::size_t>> neighbours(n);
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    for (std::size_t j = 0; j < n; ++j)
+    {
+      if (i != j && std::any_of(patterns.begin(), patterns.end(), [&](const auto& pattern) { return is_used(pattern, i) && is_used(pattern, j); }))
+      {
+        neighbours[i].push_back(j);
+      }
+    }
+  }
+
+  // Computes the distances to s within the vertices that are not numbered yet.
+  std::vector<bool> numbered(n, false);
+  auto bfs = [&](std::size_t s)
+  {
+    std::vector<long> dist(n, -1);
+    std::vector<std::size_t> queue{s};
+    dist[s] = 0;
+    for (std::size_t k = 0; k < queue.size(); ++k)
+    {
+      for (std::size_t j: neighbours[queue[k]])
+      {
+        if (!numbered[j] && dist[j] == -1)
+        {
+          dist[j] = dist[queue[k]] + 1;
+          queue.push_back(j);
+        }
+      }
+    }
+    return std::make_pair(dist, queue.back()); // the last vertex in the queue is a farthest one
+  };
+
+  enum class status { inactive, preactive, active, postactive };
+  std::vector<status> state(n, status::inactive);
+  std::vector<long> priority(n, 0);
+  std::vector<std::size_t> order;
+
+  while (order.size() < n)
+  {
+    // Find a pseudo peripheral pair of vertices (s, e) in the remaining component of minimal degree.
+    std::size_t s = n;
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      if (!numbered[i] && (s == n || neighbours[i].size() < neighbours[s].size()))
+      {
+        s = i;
+      }
+    }
+    std::size_t e = bfs(s).second;
+    std::swap(s, e);
+    e = bfs(s).second;
+    const std::vector<long> dist = bfs(e).first;
+
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      if (dist[i] != -1)
+      {
+        priority[i] = W1 * dist[i] - W2 * static_cast<long>(neighbours[i].size() + 1);
+      }
+    }
+
+    std::vector<std::size_t> queue{s};
+    state[s] = status::preactive;
+    while (!queue.empty())
+    {
+      auto max = std::max_element(queue.begin(), queue.end(), [&](std::size_t x, std::size_t y) { return priority[x] < priority[y]; });
+      const std::size_t i = *max;
+      queue.erase(max);
+
+      if (state[i] == status::preactive)
+      {
+        for (std::size_t j: neighbours[i])
+        {
+          priority[j] += W2;
+          if (state[j] == status::inactive)
+          {
+            state[j] = status::preactive;
+            queue.push_back(j);
+          }
+        }
+      }
+      order.push_back(i);
+      numbered[i] = true;
+      state[i] = status::postactive;
+
+      for (std::size_t j: neighbours[i])
+      {
+        if (state[j] == status::preactive)
+        {
+          state[j] = status::active;
+          priority[j] += W2;
+          for (std::size_t k: neighbours[j])
+          {
+            if (state[k] != status::postactive)
+            {
+              priority[k] += W2;
+              if (state[k] == status::inactive)
+              {
+                state[k] = status::preactive;
+                queue.push_back(k);
+              }
+            }
+          }
+        }
+      }
+    }
+  }
+
+  order = fix_first_variable(order, exclude_first_variable);
+  mCRL2log(log::verbose) << "sloan order = " << core::detail::print_list(order) << std::endl;
+  return order;
+}
+
+/// \brief Computes a variable order in which the variables that are read by the most patterns come first. The
+///        relative order of variables that are read equally often is preserved.
+inline
+std::vector<std::size_t> compute_variable_order_most_read_first(const std::vector<boost::dynamic_bitset<>>& patterns, std::size_t n, bool exclude_first_variable = false)
+{
+  std::vector<std::size_t> reads(n, 0);
+  for (const auto& pattern: patterns)
+  {
+    for (std::size_t j = 0; j < n; j++)
+    {
+      if (pattern[2*j])
+      {
+        reads[j]++;
+      }
+    }
+  }
+
+  std::vector<std::size_t> order = compute_variable_order_default(n);
+  std::stable_sort(order.begin(), order.end(), [&](std::size_t x, std::size_t y) { return reads[x] > reads[y]; });
+  order = fix_first_variable(order, exclude_first_variable);
+  mCRL2log(log::verbose) << "most-read-first order = " << core::detail::print_list(order) << std::endl;
+  return order;
+}
+
 inline
 std::vector<std::size_t> parse_variable_order(std::string text, std::size_t n, bool exclude_first_variable = false)
 {
@@ -387,12 +683,61 @@ std::vector<std::size_t> compute_variable_order(const std::string& text, std::si
   {
     return compute_variable_order_weighted(summand_groups, exclude_first_variable);
   }
+  else if (text == "force")
+  {
+    return compute_variable_order_force(summand_groups, number_of_variables, exclude_first_variable);
+  }
+  else if (text == "sloan")
+  {
+    return compute_variable_order_sloan(summand_groups, number_of_variables, exclude_first_variable);
+  }
+  else if (text == "most-read-first")
+  {
+    return compute_variable_order_most_read_first(summand_groups, number_of_variables, exclude_first_variable);
+  }
   else
   {
     return parse_variable_order(text, number_of_variables, exclude_first_variable);
   }
 }
 
+/// \brief Returns a report of the event span of the given variable order, and of all built-in heuristic orders.
+/// \details The FORCE order runs the heuristic from several starting orders, which is too expensive for a report.
+///          It is only included if it is the selected order, given by its name in selected_order.
+inline
+std::string print_event_span_report(const std::vector<boost::dynamic_bitset<>>& patterns,
+                                    const std::vector<std::size_t>& variable_order,
+                                    const std::string& selected_order,
+                                    bool exclude_first_variable = false)
+{
+  const std::size_t n = variable_order.size();
+  std::ostringstream out;
+  auto print = [&](const std::string& name, const std::vector<std::size_t>& order)
+  {
+    out << std::setw(16) << std::left << name << std::right << " event span " << std::setw(8) << event_span(patterns, order)
+        << " (normalised " << std::setprecision(3) << std::fixed << normalised_event_span(patterns, order) << ")" << std::endl;
+  };
+
+  out << "event span of variable orders" << std::endl;
+  print("selected", variable_order);
+  print("none", compute_variable_order_default(n));
+  if (!patterns.empty())
+  {
+    print("weighted", compute_variable_order_weighted(patterns, exclude_first_variable));
+  }
+  if (selected_order == "force")
+  {
+    print("force", variable_order);
+  }
+  else
+  {
+    out << std::setw(16) << std::left << "force" << std::right << " not computed, use --reorder=force" << std::endl;
+  }
+  print("sloan", compute_variable_order_sloan(patterns, n, exclude_first_variable));
+  print("most-read-first", compute_variable_order_most_read_first(patterns, n, exclude_first_variable));
+  return out.str();
+}
+
 inline
 std::vector<boost::dynamic_bitset<>> reorder_read_write_patterns(const std::vector<boost::dynamic_bitset<>>& patterns, const std::vector<std::size_t>& variable_order)
 {
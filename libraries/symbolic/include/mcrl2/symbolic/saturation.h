@@ -0,0 +1,176 @@
+// Author(s): agent
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/symbolic/saturation.h
+/// \brief Saturation based symbolic reachability over LDDs, following Ciardo et al.
+
+#ifndef MCRL2_SYMBOLIC_SATURATION_H
+#define MCRL2_SYMBOLIC_SATURATION_H
+
+#ifdef MCRL2_ENABLE_SYLVAN
+
+#include "mcrl2/symbolic/summand_group.h"
+
+#include <sylvan_ldd.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+namespace mcrl2::symbolic
+{
+
+/// \brief Returns the first (topmost) variable that is read or written by the summand group, or zero
+///        if it reads and writes no variables at all.
+inline
+std::size_t top_level(const summand_group& group)
+{
+  std::size_t result = 0;
+  if (!group.read.empty() && !group.write.empty())
+  {
+    result = std::min(group.read.front(), group.write.front());
+  }
+  else if (!group.read.empty())
+  {
+    result = group.read.front();
+  }
+  else if (!group.write.empty())
+  {
+    result = group.write.front();
+  }
+  return result;
+}
+
+/// \brief Computes the reachable states using saturation. A node at level k is saturated when it is closed
+///        under all summand groups of which the top level is at least k. Its children are saturated first,
+///        after which the groups with top level k are applied until a fixpoint is reached. The results are
+///        stored in the Sylvan operation cache, such that shared nodes are saturated only once.
+/// \details Transitions are learned on the fly: before a group is applied to a node at its top level, the
+///          transitions of the projection of that node are learned. Learning only adds transitions for new
+///          projections, so nodes that are saturated earlier remain saturated and the cache stays valid.
+template <typename SummandGroup>
+class saturation_algorithm
+{
+    using ldd = sylvan::ldds::ldd;
+
+  public:
+    /// \brief Learns the transitions of group i for the projected states X.
+    using learn_function = std::function<void(std::size_t i, SummandGroup& group, const ldd& X)>;
+
+  protected:
+    std::vector<SummandGroup>& m_groups;
+    learn_function m_learn;
+    std::size_t m_height;                                // the number of process parameters
+    std::vector<std::vector<std::size_t>> m_level_groups; // the groups per top level
+    std::vector<ldd> m_Ir;                               // relprod meta of every group relative to its top level
+    std::vector<ldd> m_Ip;                               // project meta of every group relative to its top level
+    std::uint64_t m_opid;                                // the identifier of this saturation in the operation cache
+
+    // Returns the node with the same values as X, in which all children are saturated at level k + 1.
+    ldd saturate_children(const ldd& X, std::size_t k)
+    {
+      using namespace sylvan::ldds;
+      std::vector<std::pair<std::uint32_t, ldd>> children;
+      for (ldd x = X; x != false_(); x = x.right())
+      {
+        children.emplace_back(x.value(), saturate(x.down(), k + 1));
+      }
+
+      ldd result = false_();
+      for (auto i = children.rbegin(); i != children.rend(); ++i)
+      {
+        result = node(i->first, i->second, result);
+      }
+      return result;
+    }
+
+  public:
+    saturation_algorithm(std::vector<SummandGroup>& groups, std::size_t height, learn_function learn)
+      : m_groups(groups),
+        m_learn(std::move(learn)),
+        m_height(height),
+        m_level_groups(height + 1),
+        m_opid(sylvan::cache_next_opid())
+    {
+      using namespace sylvan::ldds;
+      for (std::size_t i = 0; i < m_groups.size(); i++)
+      {
+        const SummandGroup& group = m_groups[i];
+        const std::size_t top = top_level(group);
+        m_level_groups[top].push_back(i);
+
+        // The meta data of the group with the levels above its top level removed.
+        std::vector<std::size_t> read;
+        std::vector<std::size_t> write;
+        for (std::size_t j: group.read)
+        {
+          read.push_back(j - top);
+        }
+        for (std::size_t j: group.write)
+        {
+          write.push_back(j - top);
+        }
+        std::vector<std::uint32_t> Ip_values;
+        for (std::size_t j = top; j < m_height; j++)
+        {
+          Ip_values.push_back(std::find(group.read.begin(), group.read.end(), j) != group.read.end() ? 1 : 0);
+        }
+        m_Ir.push_back(compute_meta(read, write, true));
+        m_Ip.push_back(cube(optimise_project(Ip_values)));
+      }
+    }
+
+    /// \brief Returns the saturation of the set X with depth m_height - k, where k is the level of X.
+    ldd saturate(const ldd& X, std::size_t k = 0)
+    {
+      using namespace sylvan::ldds;
+      if (X == false_() || X == true_())
+      {
+        return X;
+      }
+
+      sylvan::MDD cached;
+      if (sylvan::cache_get(m_opid, X.get(), k, &cached))
+      {
+        return ldd(cached);
+      }
+
+      ldd result = saturate_children(X, k);
+      std::vector<ldd> learned(m_level_groups[k].size(), false_()); // the projections that have been learned
+      bool changed = true;
+      while (changed)
+      {
+        changed = false;
+        for (std::size_t j = 0; j < m_level_groups[k].size(); j++)
+        {
+          const std::size_t i = m_level_groups[k][j];
+          SummandGroup& group = m_groups[i];
+          ldd projection = project(result, m_Ip[i]);
+          m_learn(i, group, minus(projection, learned[j]));
+          learned[j] = projection;
+
+          ldd successors = minus(relprod(result, group.L, m_Ir[i]), result);
+          if (successors != false_())
+          {
+            result = union_(result, saturate_children(successors, k));
+            changed = true;
+          }
+        }
+      }
+
+      sylvan::cache_put(m_opid, X.get(), k, result.get());
+      sylvan::cache_put(m_opid, result.get(), k, result.get());
+      return result;
+    }
+};
+
+} // namespace mcrl2::symbolic
+
+#endif // MCRL2_ENABLE_SYLVAN
+
+#endif // MCRL2_SYMBOLIC_SATURATION_H
@@ -21,6 +21,7 @@
 #include "mcrl2/data/undefined.h"
 #include "mcrl2/symbolic/alternative_relprod.h"
 #include "mcrl2/symbolic/summand_group.h"
+#include "mcrl2/utilities/performance_counters.h"
 #include "mcrl2/utilities/stopwatch.h"
 
 #include <sylvan_ldd.hpp>
@@ -50,6 +51,9 @@ struct symbolic_reachability_options
   std::string summand_groups;
   std::string variable_order;
   std::string dot_file;
+  std::string checkpoint_file;          // the file to which checkpoints are written, if not empty
+  std::size_t checkpoint_interval = 600; // the minimal number of seconds between two checkpoints
+  bool resume = false;                  // continue from the checkpoint in checkpoint_file
 };
 
 inline
@@ -72,6 +76,9 @@ std::ostream& operator<<(std::ostream& out, const symbolic_reachability_options&
   out << "groups = " << options.summand_groups << std::endl;
   out << "reorder = " << options.variable_order << std::endl;
   out << "dot = " << options.dot_file << std::endl;
+  out << "checkpoint = " << options.checkpoint_file << std::endl;
+  out << "checkpoint-interval = " << options.checkpoint_interval << std::endl;
+  out << "resume = " << std::boolalpha << options.resume << std::endl;
   return out;
 }
 
@@ -115,6 +122,9 @@ void check_enumerator_solution(const EnumeratorElement& p, const summand_group&)
   }
 }
 
+/// \brief The time spent on learning the transitions of summand groups, over all groups.
+inline const utilities::performance_span learn_successors_span("symbolic.learn_transitions");
+
 /// \brief If ActionLabel is true then the multi-action will be rewritten and added to the relation.
 template <typename Context, bool ActionLabel>
 void learn_successors_callback(WorkerP*, Task*, std::uint32_t* x, std::size_t, void* context)
@@ -142,9 +152,13 @@ void learn_successors_callback(WorkerP*, Task*, std::uint32_t* x, std::size_t, v
 
   MCRL2_DECLARE_STACK_ARRAY(xy, std::uint32_t, xy_size);
 
+  // The projected next state of a summand is rewritten with one call of the rewriter.
+  MCRL2_DECLARE_STACK_ARRAY(next_state, data::data_expression, y_size);
+
   // add the assignments corresponding to x to sigma
   // add x to the transition xy
   stopwatch learn_start;
+  utilities::scoped_performance_span learn_span(learn_successors_span);
   for (std::size_t j = 0; j < x_size; j++)
   {
     sigma[group.read_parameters[j]] = data_index[group.read[j]][x[j]];
@@ -162,9 +176,10 @@ void learn_successors_callback(WorkerP*, Task*, std::uint32_t* x, std::size_t, v
                            [&](const enumerator_element& p) {
                              check_enumerator_solution(p, group);
                              p.add_assignments(smd.variables, sigma, rewr);
+                             rewr(std::span<data::data_expression>(next_state.data(), y_size), std::span<const data::data_expression>(smd.next_state), sigma);
                              for (std::size_t j = 0; j < y_size; j++)
                              {
-                               data::data_expression value = rewr(smd.next_state[j], sigma);
+                               const data::data_expression& value = next_state[j];
                                assert(value != data::undefined_data_expression());
 
                                // Determine whether this is a copy parameter, insert special value if that is the case.
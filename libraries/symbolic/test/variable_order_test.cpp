@@ -0,0 +1,73 @@
+// Author(s): agent
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#define BOOST_TEST_MODULE variable_order_test
+#include <boost/test/included/unit_test.hpp>
+
+#include "mcrl2/symbolic/ordering.h"
+
+using namespace mcrl2::symbolic;
+
+// Creates a pattern over n variables from a string with a character per variable: 'r', 'w', '+' or '-'.
+static boost::dynamic_bitset<> make_pattern(const std::string& text)
+{
+  boost::dynamic_bitset<> result(2 * text.size());
+  for (std::size_t i = 0; i < text.size(); i++)
+  {
+    result[2*i] = text[i] == 'r' || text[i] == '+';
+    result[2*i + 1] = text[i] == 'w' || text[i] == '+';
+  }
+  return result;
+}
+
+static bool is_permutation(const std::vector<std::size_t>& order, std::size_t n)
+{
+  std::vector<std::size_t> sorted = order;
+  std::sort(sorted.begin(), sorted.end());
+  return sorted == compute_variable_order_default(n);
+}
+
+BOOST_AUTO_TEST_CASE(test_event_span)
+{
+  std::vector<boost::dynamic_bitset<>> patterns = { make_pattern("r--w"), make_pattern("-+--"), make_pattern("----") };
+  BOOST_CHECK_EQUAL(event_span(patterns, {0, 1, 2, 3}), 5u);
+  BOOST_CHECK_EQUAL(event_span(patterns, {0, 3, 1, 2}), 3u);
+}
+
+BOOST_AUTO_TEST_CASE(test_heuristic_orders)
+{
+  // Variables 0 and 5, 1 and 4, and 2 and 3 are used together, so interleaving them is a bad order.
+  std::vector<boost::dynamic_bitset<>> patterns = {
+    make_pattern("+----r"),
+    make_pattern("-+--w-"),
+    make_pattern("--++--"),
+    make_pattern("r----+"),
+    make_pattern("-r--+-"),
+  };
+  const std::size_t n = 6;
+  const std::size_t initial = event_span(patterns, compute_variable_order_default(n));
+
+  for (const char* heuristic: { "force", "sloan", "most-read-first" })
+  {
+    for (bool exclude_first_variable: { false, true })
+    {
+      std::vector<std::size_t> order = compute_variable_order(heuristic, n, patterns, exclude_first_variable);
+      BOOST_CHECK(is_permutation(order, n));
+      if (exclude_first_variable)
+      {
+        BOOST_CHECK_EQUAL(order[0], 0u);
+      }
+    }
+  }
+
+  BOOST_CHECK(event_span(patterns, compute_variable_order_force(patterns, n)) < initial);
+  BOOST_CHECK(event_span(patterns, compute_variable_order_sloan(patterns, n)) < initial);
+  BOOST_CHECK(print_event_span_report(patterns, compute_variable_order_default(n), "none").find("not computed") != std::string::npos);
+  BOOST_CHECK(print_event_span_report(patterns, compute_variable_order_force(patterns, n), "force").find("not computed") == std::string::npos);
+}
@@ -10,8 +10,10 @@
 #ifndef MCRL2_UTILITIES_BITSTREAM_H
 #define MCRL2_UTILITIES_BITSTREAM_H
 
-#include <bitset>
 #include <cstdint>
+#include <iosfwd>
+#include <memory>
+#include <string>
 #include <vector>
 
 namespace mcrl2::utilities
@@ -24,8 +26,19 @@ constexpr std::size_t integer_encoding_size()
   return ((sizeof(T) + 1) * 8) / 7;
 }
 
+/// \brief The size of the blocks in which a compressed bitstream is compressed.
+constexpr std::size_t compression_block_size = 256 * 1024;
+
+namespace detail
+{
+class block_reader;
+} // namespace detail
+
 /// \brief A bitstream provides per bit writing of data to any stream (including stdout).
-/// \details Internally uses bitpacking and buffering for compact and efficient IO.
+/// \details Internally uses bitpacking and buffering for compact and efficient IO. The bits are collected in a
+///          64 bit word that is written in big endian order, and the written words are buffered before they are
+///          passed to the underlying stream. The written data is only guaranteed to be on the stream after the
+///          bitstream has been destroyed.
 class obitstream
 {
 public:
@@ -46,6 +59,11 @@ public:
   /// \details Uses most significant bit encoding.
   void write_integer(std::size_t value);
 
+  /// \brief All data that is written after this call is compressed in blocks of compression_block_size bytes.
+  /// \details First pads the written data to the next byte. The reader must call ibitstream::enable_decompression
+  ///          after reading the same data. Has no effect when compression is already enabled.
+  void enable_compression();
+
 private:
   /// \brief Flush the remaining bits in the buffer to the output stream.
   /// \details Note that this aligns it to the next byte, e.g. when bits_in_buffer is 6 then two zero bits are added redundantly.
@@ -54,12 +72,24 @@ private:
   /// \brief Writes size bytes from the given buffer.
   void write(const std::uint8_t* buffer, std::size_t size);
 
+  /// \brief Appends the full write_buffer to the output buffer.
+  void write_word();
+
+  /// \brief Writes the output buffer to the stream, as a compressed block when compression is enabled.
+  void flush_output();
+
   std::ostream& stream;
 
-  /// \brief Buffer that is filled starting from bit 127 when writing
-  std::bitset<128> write_buffer = 0;
+  /// \brief Buffer that is filled starting from bit 63 when writing.
+  std::uint64_t write_buffer = 0;
 
-  unsigned int bits_in_buffer = 0; ///< how many bits in are used in the buffer.
+  unsigned int bits_in_buffer = 0; ///< how many bits in are used in the buffer, always less than 64.
+
+  std::vector<std::uint8_t> output_buffer; ///< The bytes that have not yet been written to the stream.
+  std::size_t output_size = 0; ///< The number of bytes used in the output buffer.
+
+  bool m_compress = false; ///< Whether the output buffer is compressed.
+  std::vector<std::uint8_t> m_compressed_buffer; ///< The compressed output buffer.
 
   std::uint8_t integer_buffer[integer_encoding_size<std::size_t>()]{}; ///< Reserved space to store an n byte integer. // NOLINT(cppcoreguidelines-avoid-c-arrays,modernize-avoid-c-arrays)
 };
@@ -71,6 +101,7 @@ class ibitstream
 public:
   /// \brief Provides the stream on which the read function operate.
   ibitstream(std::istream& stream);
+  ~ibitstream();
 
   /// \brief Reads an num_of_bits bits from the input stream and stores them in the least significant part (in descending order) of the return value.
   /// \param num_of_bits Number of bits to read from the input stream.
@@ -83,18 +114,33 @@ public:
   /// \returns A natural number that was read from the binary stream encoded in most significant bit encoding.
   std::size_t read_integer();
 
+  /// \brief All data that is read after this call was written after obitstream::enable_compression.
+  /// \details The blocks are read and decompressed by a background thread, so the input stream should not be
+  ///          used otherwise until this bitstream has been destroyed. Has no effect when decompression is already enabled.
+  void enable_decompression();
+
 private:
   /// \brief Read size bytes into the provided buffer.
   void read(std::size_t size, std::uint8_t* buffer);
 
+  /// \brief Reads exactly size bytes from the stream, or the decompressed blocks, into the provided buffer.
+  void read_stream(char* buffer, std::size_t size);
+
+  /// \brief Reads size bytes, at most eight, from the stream and returns them in the most significant part of the result.
+  std::uint64_t read_word(std::size_t size);
+
   std::istream& stream;
 
-  /// \brief Buffer that is filled starting from bit 127 when reading.
-  std::bitset<128> read_buffer = 0;
+  /// \brief Buffer that is filled starting from bit 63 when reading.
+  std::uint64_t read_buffer = 0;
 
   unsigned int bits_in_buffer = 0; ///< how many bits in the buffer are used.
 
   std::vector<char> m_text_buffer; ///< A temporary buffer to store char array strings.
+
+  std::unique_ptr<detail::block_reader> m_blocks; ///< Provides the decompressed blocks when decompression is enabled.
+  std::vector<std::uint8_t> m_block; ///< The current decompressed block.
+  std::size_t m_block_position = 0; ///< The number of bytes of the current block that have been read.
 };
 
 } // namespace mcrl2::utilities
@@ -0,0 +1,82 @@
+// Author(s): agent
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/utilities/detail/parallel_apply.h
+/// \brief Applies a function to a range of indices using multiple threads.
+
+#ifndef MCRL2_UTILITIES_DETAIL_PARALLEL_APPLY_H
+#define MCRL2_UTILITIES_DETAIL_PARALLEL_APPLY_H
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace mcrl2::utilities::detail
+{
+
+/// \brief Calls f(i, t) for i = 0, ..., n - 1 using at most number_of_threads threads, where t < number_of_threads
+/// is the index of the thread that makes the call. The calls must be independent of each other. If a call throws
+/// an exception, the remaining indices are skipped and the exception is rethrown in the calling thread.
+template <typename Function>
+void parallel_apply(std::size_t n, std::size_t number_of_threads, Function f)
+{
+  number_of_threads = std::min(number_of_threads, n);
+  if (number_of_threads <= 1)
+  {
+    for (std::size_t i = 0; i < n; i++)
+    {
+      f(i, std::size_t(0));
+    }
+    return;
+  }
+
+  std::atomic<std::size_t> next = 0;
+  std::exception_ptr error;
+  std::mutex error_mutex;
+  auto worker = [&](std::size_t t)
+  {
+    try
+    {
+      for (std::size_t i = next++; i < n; i = next++)
+      {
+        f(i, t);
+      }
+    }
+    catch (...)
+    {
+      std::lock_guard<std::mutex> guard(error_mutex);
+      if (!error)
+      {
+        error = std::current_exception();
+      }
+      next = n;
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(number_of_threads);
+  for (std::size_t t = 0; t < number_of_threads; t++)
+  {
+    threads.emplace_back(worker, t);
+  }
+  for (std::thread& t: threads)
+  {
+    t.join();
+  }
+  if (error)
+  {
+    std::rethrow_exception(error);
+  }
+}
+
+} // namespace mcrl2::utilities::detail
+
+#endif // MCRL2_UTILITIES_DETAIL_PARALLEL_APPLY_H
@@ -13,6 +13,7 @@
 #define MCRL2_UTILITIES_EXECUTION_TIMER_H
 
 #include "mcrl2/utilities/exception.h"
+#include "mcrl2/utilities/performance_counters.h"
 
 #include <chrono>
 #include <fstream>
@@ -143,6 +144,7 @@ class execution_timer
 
       t->second.finish = finish;
       t->second.finish_user = clock();
+      record_performance_span(timing_name, t->second.start, t->second.finish);
     }
 
     /// \brief Write all timing information that has been recorded.
@@ -0,0 +1,202 @@
+// Author(s): agent
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file mcrl2/utilities/performance_counters.h
+/// \brief Named counters and timed spans that can be enabled at runtime, and reported as JSON. The spans can
+///        also be recorded on a timeline per thread, which is written in the Chrome trace event format.
+
+#ifndef MCRL2_UTILITIES_PERFORMANCE_COUNTERS_H
+#define MCRL2_UTILITIES_PERFORMANCE_COUNTERS_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace mcrl2::utilities
+{
+
+/// \brief Returns the flag that determines whether performance counters are recorded.
+/// \details When the flag is false, updating a counter or span costs one relaxed load and a branch.
+inline std::atomic<bool>& performance_counters_enabled_flag()
+{
+  static std::atomic<bool> enabled(false);
+  return enabled;
+}
+
+inline bool performance_counters_enabled()
+{
+  return performance_counters_enabled_flag().load(std::memory_order_relaxed);
+}
+
+/// \brief Enables or disables the recording of all performance counters and spans.
+inline void enable_performance_counters(bool enable = true)
+{
+  performance_counters_enabled_flag().store(enable, std::memory_order_relaxed);
+}
+
+/// \brief Returns the flag that determines whether spans are recorded as events on a timeline.
+inline std::atomic<bool>& performance_tracing_enabled_flag()
+{
+  static std::atomic<bool> enabled(false);
+  return enabled;
+}
+
+inline bool performance_tracing_enabled()
+{
+  return performance_tracing_enabled_flag().load(std::memory_order_relaxed);
+}
+
+/// \brief Enables the recording of spans as events on a timeline. Each thread keeps its last events_per_thread
+///        events in a ring buffer.
+void enable_performance_tracing(std::size_t events_per_thread = 1 << 20);
+
+/// \brief The way in which the values of a counter are combined.
+enum class performance_counter_kind
+{
+  sum,    ///< The reported value is the sum of all values.
+  maximum ///< The reported value is the largest value.
+};
+
+namespace detail
+{
+
+std::size_t register_performance_counter(const std::string& name, performance_counter_kind kind);
+std::size_t register_performance_span(const std::string& name);
+void update_performance_counter(std::size_t index, performance_counter_kind kind, std::uint64_t value);
+std::uint64_t performance_counter_value(std::size_t index);
+void update_performance_span(std::size_t index, std::chrono::steady_clock::duration duration);
+void trace_performance_span(std::size_t index, std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point finish);
+
+} // namespace detail
+
+/// \brief A named counter. The values are first accumulated in a buffer of the thread that updates the counter, and
+///        are combined when a report is written.
+/// \details Counters are typically declared as static objects, as registering a counter requires a lock.
+///          Counters with the same name share their value.
+class performance_counter
+{
+  protected:
+    std::size_t m_index;
+    performance_counter_kind m_kind;
+
+  public:
+    explicit performance_counter(const std::string& name, performance_counter_kind kind = performance_counter_kind::sum)
+      : m_index(detail::register_performance_counter(name, kind)),
+        m_kind(kind)
+    {}
+
+    /// \brief Adds n to a sum counter, or records n as a candidate for a maximum counter.
+    void add(std::uint64_t n = 1) const
+    {
+      if (performance_counters_enabled())
+      {
+        detail::update_performance_counter(m_index, m_kind, n);
+      }
+    }
+
+    /// \brief Returns the value of this counter, combined over all threads.
+    /// \pre No other thread updates performance counters.
+    std::uint64_t value() const
+    {
+      return detail::performance_counter_value(m_index);
+    }
+};
+
+/// \brief A named span of time, for which the number of occurrences, the total and the maximal duration are reported.
+class performance_span
+{
+  protected:
+    std::size_t m_index;
+
+  public:
+    explicit performance_span(const std::string& name)
+      : m_index(detail::register_performance_span(name))
+    {}
+
+    void record(std::chrono::steady_clock::duration duration) const
+    {
+      if (performance_counters_enabled())
+      {
+        detail::update_performance_span(m_index, duration);
+      }
+    }
+
+    /// \brief Records the span from start to finish, both in the counters and on the timeline if these are enabled.
+    void record(std::chrono::steady_clock::time_point start, std::chrono::steady_clock::time_point finish) const
+    {
+      record(finish - start);
+      if (performance_tracing_enabled())
+      {
+        detail::trace_performance_span(m_index, start, finish);
+      }
+    }
+};
+
+/// \brief Records the time between its construction and destruction in a performance span.
+class scoped_performance_span
+{
+  protected:
+    const performance_span& m_span;
+    bool m_enabled;
+    std::chrono::steady_clock::time_point m_start;
+
+  public:
+    explicit scoped_performance_span(const performance_span& span)
+      : m_span(span),
+        m_enabled(performance_counters_enabled() || performance_tracing_enabled())
+    {
+      if (m_enabled)
+      {
+        m_start = std::chrono::steady_clock::now();
+      }
+    }
+
+    scoped_performance_span(const scoped_performance_span&) = delete;
+    scoped_performance_span& operator=(const scoped_performance_span&) = delete;
+
+    ~scoped_performance_span()
+    {
+      if (m_enabled)
+      {
+        m_span.record(m_start, std::chrono::steady_clock::now());
+      }
+    }
+};
+
+/// \brief Records the span with the given name from start to finish. This looks up the span, and is therefore
+///        intended for coarse phases, such as those measured by an execution_timer.
+void record_performance_span(const std::string& name,
+                             std::chrono::steady_clock::time_point start,
+                             std::chrono::steady_clock::time_point finish);
+
+/// \brief Writes the values of all counters and spans as a JSON object, together with the largest resident set size
+///        of the process so far.
+/// \pre No other thread updates performance counters while the report is written.
+void write_performance_report(std::ostream& out, const std::string& tool_name);
+
+/// \brief Writes the values of all counters and spans as a JSON object to the given file.
+void write_performance_report(const std::string& filename, const std::string& tool_name);
+
+/// \brief Writes the events on the timelines of all threads in the Chrome trace event format, which can be
+///        shown by chrome://tracing or Perfetto.
+/// \pre No other thread records events while the trace is written.
+void write_performance_trace(std::ostream& out);
+
+/// \brief Writes the events on the timelines of all threads in the Chrome trace event format to the given file.
+void write_performance_trace(const std::string& filename);
+
+/// \brief Sets the values of all counters and spans to zero, and removes all events.
+/// \pre No other thread updates performance counters.
+void reset_performance_counters();
+
+} // namespace mcrl2::utilities
+
+#endif // MCRL2_UTILITIES_PERFORMANCE_COUNTERS_H
@@ -56,6 +56,12 @@ class tool
     /// Determines whether timing output should be written
     bool m_timing_enabled = false;
 
+    /// The filename to which the performance counters must be written, if non-empty
+    std::string m_performance_report_filename;
+
+    /// The filename to which the timeline of the timed spans must be written, if non-empty
+    std::string m_performance_trace_filename;
+
     /// \brief Add options to an interface description.
     /// \param desc An interface description
     virtual void add_options(interface_description& desc)
@@ -63,6 +69,13 @@ class tool
       desc.add_option("timings", make_optional_argument<std::string>("FILE", ""),
                       "append timing measurements to FILE. Measurements are written to "
                       "standard error if no FILE is provided");
+      desc.add_option("perf-report", make_mandatory_argument("FILE"),
+                      "write the values of the performance counters, such as the number of rewrite calls, "
+                      "the garbage collection pauses and the durations of the timed phases, to FILE in JSON format");
+      desc.add_option("perf-trace", make_mandatory_argument("FILE"),
+                      "write the timed spans of all threads, such as the exploration of states, the waits for locks "
+                      "and the garbage collection pauses, to FILE in the Chrome trace event format, which can be "
+                      "viewed with chrome://tracing or Perfetto");
     }
 
     /// \brief Parse non-standard options
@@ -75,6 +88,16 @@ class tool
         log::logger::set_report_time_info();
         m_timing_filename = parser.option_argument("timings");
       }
+      if (parser.has_option("perf-report"))
+      {
+        m_performance_report_filename = parser.option_argument("perf-report");
+        enable_performance_counters();
+      }
+      if (parser.has_option("perf-trace"))
+      {
+        m_performance_trace_filename = parser.option_argument("perf-trace");
+        enable_performance_tracing();
+      }
     }
 
     /// \brief Executed only if run would be executed and invoked before run.
@@ -216,6 +239,14 @@ class tool
             {
               timer().report();
             }
+            if (!m_performance_report_filename.empty())
+            {
+              write_performance_report(m_performance_report_filename, m_name);
+            }
+            if (!m_performance_trace_filename.empty())
+            {
+              write_performance_trace(m_performance_trace_filename);
+            }
           }
 
           // Either pre_run or run failed.
@@ -14,6 +14,15 @@
 #include "mcrl2/utilities/power_of_two.h"
 #include "mcrl2/utilities/platform.h"
 
+#include "lzblock.h"
+
+#include <algorithm>
+#include <array>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+
 #ifdef MCRL2_PLATFORM_WINDOWS
 #include <io.h>
 #include <fcntl.h>
@@ -21,6 +30,164 @@
 
 using namespace mcrl2::utilities;
 
+/// \brief The number of bytes that are buffered before they are written to an uncompressed stream.
+static constexpr std::size_t output_buffer_size = 4096;
+
+/// \brief Writes a 32 bit value in little endian order.
+static void write_uint32(std::uint8_t* output, std::size_t value)
+{
+  for (std::size_t i = 0; i < 4; ++i)
+  {
+    output[i] = static_cast<std::uint8_t>(value >> (8 * i));
+  }
+}
+
+/// \brief Reads a 32 bit value in little endian order.
+static std::size_t read_uint32(const std::uint8_t* input)
+{
+  std::size_t value = 0;
+  for (std::size_t i = 0; i < 4; ++i)
+  {
+    value |= static_cast<std::size_t>(input[i]) << (8 * i);
+  }
+  return value;
+}
+
+namespace mcrl2::utilities::detail
+{
+
+/// \brief Reads and decompresses the blocks of a compressed bitstream in a separate thread.
+/// \details Every block is preceded by its uncompressed and its compressed size, as 32 bit little endian values. When
+///          both are equal the block is stored without compression, and an uncompressed size of zero marks the end.
+class block_reader
+{
+public:
+  block_reader(std::istream& stream)
+    : m_stream(stream),
+      m_thread([this]() { run(); })
+  {}
+
+  ~block_reader()
+  {
+    {
+      std::lock_guard<std::mutex> guard(m_mutex);
+      m_stop = true;
+    }
+    m_condition.notify_all();
+    m_thread.join();
+  }
+
+  block_reader(const block_reader&) = delete;
+  block_reader& operator=(const block_reader&) = delete;
+
+  /// \brief Replaces block by the next decompressed block.
+  /// \returns False when there are no blocks left.
+  bool next(std::vector<std::uint8_t>& block)
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_condition.wait(lock, [this]() { return !m_blocks.empty() || m_finished; });
+    if (!m_blocks.empty())
+    {
+      block.swap(m_blocks.front());
+      m_blocks.pop_front();
+      m_condition.notify_all();
+      return true;
+    }
+
+    if (m_error)
+    {
+      std::rethrow_exception(m_error);
+    }
+    return false;
+  }
+
+private:
+  /// \brief The number of decompressed blocks that are read ahead.
+  static constexpr std::size_t read_ahead = 4;
+
+  void read(std::uint8_t* buffer, std::size_t size)
+  {
+    m_stream.read(reinterpret_cast<char*>(buffer), static_cast<std::streamsize>(size));
+    if (m_stream.eof())
+    {
+      throw mcrl2::runtime_error("Unexpected end-of-file reached in the input file/stream.");
+    }
+    else if (m_stream.fail())
+    {
+      throw mcrl2::runtime_error("Failed to read bytes from the input file/stream.");
+    }
+  }
+
+  void run()
+  {
+    try
+    {
+      std::vector<std::uint8_t> compressed;
+      while (true)
+      {
+        std::array<std::uint8_t, 8> header;
+        read(header.data(), header.size());
+        const std::size_t size = read_uint32(header.data());
+        const std::size_t compressed_size = read_uint32(header.data() + 4);
+        if (size == 0)
+        {
+          break;
+        }
+        if (size > compression_block_size || compressed_size > lzblock_compress_bound(size))
+        {
+          throw mcrl2::runtime_error("The compressed input file/stream is corrupted.");
+        }
+
+        std::vector<std::uint8_t> block(size);
+        if (compressed_size == size)
+        {
+          read(block.data(), size);
+        }
+        else
+        {
+          compressed.resize(compressed_size);
+          read(compressed.data(), compressed_size);
+          if (lzblock_decompress(compressed.data(), compressed_size, block.data(), size) != 0)
+          {
+            throw mcrl2::runtime_error("The compressed input file/stream is corrupted.");
+          }
+        }
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_condition.wait(lock, [this]() { return m_blocks.size() < read_ahead || m_stop; });
+        if (m_stop)
+        {
+          return;
+        }
+        m_blocks.push_back(std::move(block));
+        m_condition.notify_all();
+      }
+    }
+    catch (...)
+    {
+      std::lock_guard<std::mutex> guard(m_mutex);
+      m_error = std::current_exception();
+    }
+
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_finished = true;
+    m_condition.notify_all();
+  }
+
+  std::istream& m_stream;
+
+  std::mutex m_mutex;
+  std::condition_variable m_condition;
+  std::deque<std::vector<std::uint8_t>> m_blocks; ///< The decompressed blocks that have not been read yet.
+  bool m_finished = false; ///< The last block has been read, or an error occurred.
+  bool m_stop = false; ///< The reader must stop since the bitstream is destroyed.
+  std::exception_ptr m_error;
+
+  std::thread m_thread; ///< Must be initialised last, since it uses the other members.
+};
+
+} // namespace mcrl2::utilities::detail
+
 /// \brief Encodes an unsigned variable-length integer using the most significant bit (MSB) algorithm.
 ///        This function assumes that the value is stored as little endian.
 /// \param value The input value. Any standard integer type is allowed.
@@ -97,7 +264,8 @@ static void set_stream_binary([[maybe_unused]] const std::string& name, [[maybe_
 }
 
 obitstream::obitstream(std::ostream& stream)
-  : stream(stream)
+  : stream(stream),
+    output_buffer(output_buffer_size)
 {
   // Ensures that the given stream is changed to binary mode.
   if (stream.rdbuf() == std::cout.rdbuf())
@@ -114,31 +282,31 @@ void obitstream::write_bits(std::size_t value, unsigned int number_of_bits)
 {
   // Add val to the buffer by masking out additional bits and put them at left-most position free in the buffer.
   assert(number_of_bits <= std::numeric_limits<std::size_t>::digits);
-  if (number_of_bits < std::numeric_limits<std::size_t>::digits) // the check is needed to avoid undefined behavior
+  if (number_of_bits == 0)
   {
-    value &= (static_cast<std::size_t>(1) << number_of_bits) - 1;
+    return;
   }
 
-  write_buffer |= std::bitset<128>(value) << ((128 - bits_in_buffer) - number_of_bits);
-  bits_in_buffer += number_of_bits;
-
-  // Write 8 bytes if available
-  if (bits_in_buffer >= 64)
+  std::uint64_t bits = value;
+  if (number_of_bits < 64) // the check is needed to avoid undefined behavior
   {
-    unsigned long long write_value = (write_buffer >> 64).to_ullong();
-    write_buffer <<= 64;
-    bits_in_buffer -= 64;
-
-    for (int32_t i = 7; i >= 0; --i)
-    {
-      // Write the 8 * i most significant bits and mask out the other values.
-      stream.put(static_cast<char>((write_value >> (8 * i)) & 255));
+    bits &= (static_cast<std::uint64_t>(1) << number_of_bits) - 1;
+  }
 
-      if (stream.fail())
-      {
-        throw mcrl2::runtime_error("Failed to write bytes to the output file/stream.");
-      }
-    }
+  const unsigned int free_bits = 64 - bits_in_buffer;
+  if (number_of_bits < free_bits)
+  {
+    write_buffer |= bits << (free_bits - number_of_bits);
+    bits_in_buffer += number_of_bits;
+  }
+  else
+  {
+    // Fill the buffer completely, write it and keep the remaining bits of value.
+    const unsigned int remaining_bits = number_of_bits - free_bits;
+    write_buffer |= bits >> remaining_bits;
+    write_word();
+    write_buffer = (remaining_bits == 0 ? 0 : bits << (64 - remaining_bits));
+    bits_in_buffer = remaining_bits;
   }
 }
 
@@ -168,6 +336,8 @@ ibitstream::ibitstream(std::istream& stream)
   }
 }
 
+ibitstream::~ibitstream() = default;
+
 const char* ibitstream::read_string()
 {
   std::size_t length;
@@ -192,33 +362,30 @@ std::size_t ibitstream::read_bits(unsigned int number_of_bits)
 {
   // Read at most the number of bits of a std::size_t.
   assert(number_of_bits <= std::numeric_limits<std::size_t>::digits);
-
-  while (bits_in_buffer < number_of_bits)
+  if (number_of_bits == 0)
   {
-    // Read bytes until the buffer is sufficiently full.
-    int byte = stream.get();
-
-    if (stream.eof())
-    {
-      throw mcrl2::runtime_error("Unexpected end-of-file reached in the input file/stream.");
-    }
-    else if (stream.fail())
-    {
-      throw mcrl2::runtime_error("Failed to read bytes from the input file/stream.");
-    }
-
-    // Shift the 8 bits to the first free (120 - bits_in_buffer) position in the buffer.
-    read_buffer |= std::bitset<128>(static_cast<std::size_t>(byte)) << (56 + 64 - bits_in_buffer);
-    bits_in_buffer += 8;
+    return 0;
   }
 
-  // Read nr_bits from the buffer by shifting them to the least significant bits and masking out the remaining bits.
-  std::size_t value = (read_buffer >> (128 - number_of_bits)).to_ullong();
+  if (number_of_bits <= bits_in_buffer)
+  {
+    // Read nr_bits from the buffer by shifting them to the least significant bits, and remove them from the buffer.
+    std::size_t value = read_buffer >> (64 - number_of_bits);
+    read_buffer = (number_of_bits == 64 ? 0 : read_buffer << number_of_bits);
+    bits_in_buffer -= number_of_bits;
+    return value;
+  }
 
-  // Shift the first bit to the first position in the buffer.
-  read_buffer <<= number_of_bits;
-  bits_in_buffer -= number_of_bits;
+  // Take all bits in the buffer and only read the bytes that are necessary for the remaining bits from the stream,
+  // such that no data after the last value is consumed.
+  const unsigned int missing_bits = number_of_bits - bits_in_buffer;
+  const std::size_t bytes = (missing_bits + 7) / 8;
+  std::uint64_t value = (bits_in_buffer == 0 ? 0 : read_buffer >> (64 - bits_in_buffer));
+  std::uint64_t word = read_word(bytes);
 
+  value = (missing_bits == 64 ? 0 : value << missing_bits) | (word >> (64 - missing_bits));
+  read_buffer = (missing_bits == 64 ? 0 : word << missing_bits);
+  bits_in_buffer = static_cast<unsigned int>(8 * bytes) - missing_bits;
   return value;
 }
 
@@ -227,6 +394,45 @@ std::size_t ibitstream::read_integer()
   return decode_variablesize_int(*this);
 }
 
+void obitstream::enable_compression()
+{
+  if (m_compress)
+  {
+    return;
+  }
+
+  // Pad the data to a byte and write it uncompressed, such that the compressed blocks start at a byte boundary.
+  write_bits(0, (8 - bits_in_buffer % 8) % 8);
+  if (output_size + 8 > output_buffer.size())
+  {
+    flush_output();
+  }
+  for (; bits_in_buffer > 0; bits_in_buffer -= 8)
+  {
+    output_buffer[output_size++] = static_cast<std::uint8_t>(write_buffer >> 56);
+    write_buffer <<= 8;
+  }
+  flush_output();
+
+  m_compress = true;
+  output_buffer.resize(compression_block_size);
+  m_compressed_buffer.resize(8 + lzblock_compress_bound(compression_block_size));
+}
+
+void ibitstream::enable_decompression()
+{
+  if (m_blocks)
+  {
+    return;
+  }
+
+  // Only the padding of the last byte can be left in the buffer, since the bytes are read when they are needed.
+  assert(bits_in_buffer < 8);
+  read_buffer = 0;
+  bits_in_buffer = 0;
+  m_blocks = std::make_unique<detail::block_reader>(stream);
+}
+
 // Private functions
 
 void obitstream::flush()
@@ -234,6 +440,14 @@ void obitstream::flush()
   // Writing the buffer full to 64 bits should flush it internally, this also guarantees that the unnecessary bits are zeroed out.
   write_bits(0, 64 - bits_in_buffer);
   assert(bits_in_buffer == 0);
+  flush_output();
+
+  if (m_compress)
+  {
+    // A block of size zero marks the end of the compressed blocks.
+    const std::array<std::uint8_t, 8> end{};
+    stream.write(reinterpret_cast<const char*>(end.data()), end.size());
+  }
 
   stream.flush();
   if (stream.fail())
@@ -242,21 +456,187 @@ void obitstream::flush()
   }
 }
 
+void obitstream::write_word()
+{
+  if (output_size + 8 > output_buffer.size())
+  {
+    flush_output();
+  }
+
+  for (std::size_t i = 0; i < 8; ++i)
+  {
+    // Write the most significant byte first.
+    output_buffer[output_size + i] = static_cast<std::uint8_t>(write_buffer >> (56 - 8 * i));
+  }
+  output_size += 8;
+}
+
+void obitstream::flush_output()
+{
+  if (m_compress && output_size > 0)
+  {
+    // Store the block without compression when it does not become smaller.
+    std::size_t compressed_size = lzblock_compress(output_buffer.data(), output_size, m_compressed_buffer.data() + 8);
+    if (compressed_size >= output_size)
+    {
+      std::copy(output_buffer.begin(), output_buffer.begin() + output_size, m_compressed_buffer.begin() + 8);
+      compressed_size = output_size;
+    }
+
+    write_uint32(m_compressed_buffer.data(), output_size);
+    write_uint32(m_compressed_buffer.data() + 4, compressed_size);
+    stream.write(reinterpret_cast<const char*>(m_compressed_buffer.data()), static_cast<std::streamsize>(8 + compressed_size));
+  }
+  else
+  {
+    stream.write(reinterpret_cast<const char*>(output_buffer.data()), static_cast<std::streamsize>(output_size));
+  }
+  output_size = 0;
+
+  if (stream.fail())
+  {
+    throw mcrl2::runtime_error("Failed to write bytes to the output file/stream.");
+  }
+}
+
 void obitstream::write(const uint8_t* buffer, std::size_t size)
 {
-  for (std::size_t index = 0; index < size; ++index)
+  // Write the bytes as complete words, which are copied as is when the buffer is aligned.
+  std::size_t index = 0;
+  for (; index + 8 <= size; index += 8)
+  {
+    if (bits_in_buffer == 0 && output_size + 8 <= output_buffer.size())
+    {
+      std::copy(buffer + index, buffer + index + 8, output_buffer.begin() + output_size);
+      output_size += 8;
+    }
+    else
+    {
+      std::uint64_t word = 0;
+      for (std::size_t i = 0; i < 8; ++i)
+      {
+        word = (word << 8) | buffer[index + i];
+      }
+      write_bits(word, 64);
+    }
+  }
+
+  // Write the remaining bytes at once.
+  std::uint64_t word = 0;
+  for (std::size_t i = index; i < size; ++i)
   {
-    // Write a single byte for every entry in the buffer that was filled (size).
-    write_bits(buffer[index], 8);
+    word = (word << 8) | buffer[i];
   }
+  write_bits(word, static_cast<unsigned int>(8 * (size - index)));
+}
+
+void ibitstream::read_stream(char* buffer, std::size_t size)
+{
+  if (m_blocks)
+  {
+    while (size > 0)
+    {
+      if (m_block_position == m_block.size())
+      {
+        m_block_position = 0;
+        if (!m_blocks->next(m_block))
+        {
+          m_block.clear();
+          throw mcrl2::runtime_error("Unexpected end-of-file reached in the input file/stream.");
+        }
+      }
+
+      const std::size_t count = std::min(size, m_block.size() - m_block_position);
+      std::copy(m_block.begin() + m_block_position, m_block.begin() + m_block_position + count, buffer);
+      m_block_position += count;
+      buffer += count;
+      size -= count;
+    }
+    return;
+  }
+
+  if (size == 0)
+  {
+    return;
+  }
+
+  if (!stream.good())
+  {
+    throw mcrl2::runtime_error("Failed to read bytes from the input file/stream.");
+  }
+
+  std::streamsize count = stream.rdbuf()->sgetn(buffer, static_cast<std::streamsize>(size));
+  if (count != static_cast<std::streamsize>(size))
+  {
+    stream.setstate(std::ios_base::eofbit | std::ios_base::failbit);
+    throw mcrl2::runtime_error("Unexpected end-of-file reached in the input file/stream.");
+  }
+}
+
+std::uint64_t ibitstream::read_word(std::size_t size)
+{
+  assert(0 < size && size <= 8);
+  if (m_blocks)
+  {
+    std::array<std::uint8_t, 8> bytes{};
+    read_stream(reinterpret_cast<char*>(bytes.data()), size);
+
+    std::uint64_t word = 0;
+    for (std::size_t i = 0; i < 8; ++i)
+    {
+      word = (word << 8) | bytes[i];
+    }
+    return word;
+  }
+
+  if (!stream.good())
+  {
+    throw mcrl2::runtime_error("Failed to read bytes from the input file/stream.");
+  }
+
+  // Reading single bytes from the stream buffer is inlined, contrary to std::istream::get and std::istream::read.
+  std::streambuf& buffer = *stream.rdbuf();
+  std::uint64_t word = 0;
+  for (std::size_t i = 0; i < size; ++i)
+  {
+    std::streambuf::int_type byte = buffer.sbumpc();
+    if (std::streambuf::traits_type::eq_int_type(byte, std::streambuf::traits_type::eof()))
+    {
+      stream.setstate(std::ios_base::eofbit | std::ios_base::failbit);
+      throw mcrl2::runtime_error("Unexpected end-of-file reached in the input file/stream.");
+    }
+    word = (word << 8) | static_cast<std::uint8_t>(std::streambuf::traits_type::to_char_type(byte));
+  }
+  return word << (64 - 8 * size);
 }
 
 void ibitstream::read(std::size_t size, std::uint8_t* buffer)
 {
-  for (std::size_t index = 0; index < size; ++index)
+  // Empty the bytes that are left in the buffer, after which the remaining bytes can be read directly from the stream.
+  std::size_t index = 0;
+  if (bits_in_buffer % 8 == 0)
+  {
+    for (; index < size && bits_in_buffer > 0; ++index)
+    {
+      buffer[index] = static_cast<std::uint8_t>(read_bits(8));
+    }
+
+    read_stream(reinterpret_cast<char*>(buffer + index), size - index);
+    return;
+  }
+
+  for (; index + 8 <= size; index += 8)
+  {
+    std::uint64_t word = read_bits(64);
+    for (std::size_t i = 0; i < 8; ++i)
+    {
+      buffer[index + i] = static_cast<std::uint8_t>(word >> (56 - 8 * i));
+    }
+  }
+
+  for (; index < size; ++index)
   {
-    // Read a single byte for every entry into the buffer that was filled (size).
-    std::size_t value = read_bits(8);
-    buffer[index] = static_cast<std::uint8_t>(value);
+    // Read a single byte for every remaining entry into the buffer.
+    buffer[index] = static_cast<std::uint8_t>(read_bits(8));
   }
 }
@@ -0,0 +1,449 @@
+// Author(s): agent
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file performance_counters.cpp
+
+#include "mcrl2/utilities/performance_counters.h"
+#include "mcrl2/utilities/exception.h"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <mutex>
+#include <set>
+#include <vector>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+namespace mcrl2::utilities
+{
+
+namespace
+{
+
+struct span_statistics
+{
+  std::uint64_t count = 0;
+  std::chrono::steady_clock::duration total{0};
+  std::chrono::steady_clock::duration maximum{0};
+
+  void add(std::chrono::steady_clock::duration duration)
+  {
+    count++;
+    total += duration;
+    maximum = std::max(maximum, duration);
+  }
+
+  void add(const span_statistics& other)
+  {
+    count += other.count;
+    total += other.total;
+    maximum = std::max(maximum, other.maximum);
+  }
+};
+
+/// \brief An occurrence of a span on the timeline of a thread.
+struct trace_event
+{
+  std::size_t span;
+  std::chrono::steady_clock::time_point start;
+  std::chrono::steady_clock::time_point finish;
+};
+
+/// \brief The events of one thread in chronological order of their completion.
+struct thread_trace
+{
+  std::size_t thread_number;
+  std::vector<trace_event> events;
+};
+
+void combine(performance_counter_kind kind, std::uint64_t& x, std::uint64_t value)
+{
+  x = kind == performance_counter_kind::sum ? x + value : std::max(x, value);
+}
+
+struct thread_buffer;
+
+/// \brief The names of all counters and spans, and the values of threads that have terminated.
+struct performance_registry
+{
+  std::mutex mutex;
+  std::vector<std::string> counter_names;
+  std::vector<performance_counter_kind> counter_kinds;
+  std::map<std::string, std::size_t> counter_indices;
+  std::vector<std::string> span_names;
+  std::map<std::string, std::size_t> span_indices;
+
+  std::vector<std::uint64_t> counters;
+  std::vector<span_statistics> spans;
+  std::set<thread_buffer*> buffers;
+
+  std::size_t events_per_thread = 0;
+  std::size_t thread_count = 0;
+  std::chrono::steady_clock::time_point trace_origin;
+  std::vector<thread_trace> traces;
+};
+
+performance_registry& registry()
+{
+  static performance_registry instance;
+  return instance;
+}
+
+/// \brief The values that are recorded by one thread. These are added to the registry when the thread terminates.
+struct thread_buffer
+{
+  std::vector<std::uint64_t> counters;
+  std::vector<span_statistics> spans;
+
+  std::size_t thread_number;
+  std::size_t events_per_thread;
+  std::vector<trace_event> events; // A ring buffer, of which next_event is the oldest event once it is full.
+  std::size_t next_event = 0;
+
+  thread_buffer()
+  {
+    performance_registry& r = registry();
+    std::lock_guard<std::mutex> guard(r.mutex);
+    r.buffers.insert(this);
+    thread_number = r.thread_count++;
+    events_per_thread = r.events_per_thread;
+  }
+
+  ~thread_buffer()
+  {
+    performance_registry& r = registry();
+    std::lock_guard<std::mutex> guard(r.mutex);
+    merge_into(r.counter_kinds, r.counters, r.spans);
+    if (!events.empty())
+    {
+      r.traces.push_back(trace());
+    }
+    r.buffers.erase(this);
+  }
+
+  void add_event(const trace_event& event)
+  {
+    if (events.size() < events_per_thread)
+    {
+      events.push_back(event);
+    }
+    else if (events_per_thread > 0)
+    {
+      events[next_event] = event;
+      next_event = (next_event + 1) % events_per_thread;
+    }
+  }
+
+  thread_trace trace() const
+  {
+    thread_trace result{thread_number, {}};
+    result.events.reserve(events.size());
+    result.events.insert(result.events.end(), events.begin() + next_event, events.end());
+    result.events.insert(result.events.end(), events.begin(), events.begin() + next_event);
+    return result;
+  }
+
+  void clear()
+  {
+    std::fill(counters.begin(), counters.end(), 0);
+    std::fill(spans.begin(), spans.end(), span_statistics());
+    events.clear();
+    next_event = 0;
+  }
+
+  void merge_into(const std::vector<performance_counter_kind>& kinds,
+                  std::vector<std::uint64_t>& counters_total,
+                  std::vector<span_statistics>& spans_total) const
+  {
+    for (std::size_t i = 0; i < counters.size(); ++i)
+    {
+      combine(kinds[i], counters_total[i], counters[i]);
+    }
+    for (std::size_t i = 0; i < spans.size(); ++i)
+    {
+      spans_total[i].add(spans[i]);
+    }
+  }
+};
+
+thread_buffer& local_buffer()
+{
+  thread_local thread_buffer buffer;
+  return buffer;
+}
+
+void write_json_string(std::ostream& out, const std::string& s)
+{
+  out << '"';
+  for (char c: s)
+  {
+    if (c == '"' || c == '\\')
+    {
+      out << '\\';
+    }
+    out << c;
+  }
+  out << '"';
+}
+
+double seconds(std::chrono::steady_clock::duration duration)
+{
+  return std::chrono::duration<double>(duration).count();
+}
+
+/// \brief Returns the largest resident set size of this process in kilobytes, or zero when it is unknown.
+std::uint64_t max_resident_kilobytes()
+{
+#if defined(__linux__) || defined(__APPLE__)
+  rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) == 0)
+  {
+#ifdef __APPLE__
+    return static_cast<std::uint64_t>(usage.ru_maxrss) / 1024; // In bytes on macOS.
+#else
+    return static_cast<std::uint64_t>(usage.ru_maxrss);
+#endif
+  }
+#endif
+  return 0;
+}
+
+double microseconds(std::chrono::steady_clock::duration duration)
+{
+  return std::chrono::duration<double, std::micro>(duration).count();
+}
+
+} // namespace
+
+namespace detail
+{
+
+std::size_t register_performance_counter(const std::string& name, performance_counter_kind kind)
+{
+  performance_registry& r = registry();
+  std::lock_guard<std::mutex> guard(r.mutex);
+  auto [i, inserted] = r.counter_indices.emplace(name, r.counter_names.size());
+  if (inserted)
+  {
+    r.counter_names.push_back(name);
+    r.counter_kinds.push_back(kind);
+    r.counters.push_back(0);
+  }
+  else if (r.counter_kinds[i->second] != kind)
+  {
+    throw mcrl2::runtime_error("The performance counter " + name + " is registered with two different kinds.");
+  }
+  return i->second;
+}
+
+std::size_t register_performance_span(const std::string& name)
+{
+  performance_registry& r = registry();
+  std::lock_guard<std::mutex> guard(r.mutex);
+  auto [i, inserted] = r.span_indices.emplace(name, r.span_names.size());
+  if (inserted)
+  {
+    r.span_names.push_back(name);
+    r.spans.emplace_back();
+  }
+  return i->second;
+}
+
+void update_performance_counter(std::size_t index, performance_counter_kind kind, std::uint64_t value)
+{
+  thread_buffer& buffer = local_buffer();
+  if (index >= buffer.counters.size())
+  {
+    buffer.counters.resize(index + 1, 0);
+  }
+  combine(kind, buffer.counters[index], value);
+}
+
+std::uint64_t performance_counter_value(std::size_t index)
+{
+  performance_registry& r = registry();
+  std::lock_guard<std::mutex> guard(r.mutex);
+  std::uint64_t result = r.counters[index];
+  for (const thread_buffer* buffer: r.buffers)
+  {
+    if (index < buffer->counters.size())
+    {
+      combine(r.counter_kinds[index], result, buffer->counters[index]);
+    }
+  }
+  return result;
+}
+
+void update_performance_span(std::size_t index, std::chrono::steady_clock::duration duration)
+{
+  thread_buffer& buffer = local_buffer();
+  if (index >= buffer.spans.size())
+  {
+    buffer.spans.resize(index + 1);
+  }
+  buffer.spans[index].add(duration);
+}
+
+void trace_performance_span(std::size_t index,
+                            std::chrono::steady_clock::time_point start,
+                            std::chrono::steady_clock::time_point finish)
+{
+  local_buffer().add_event(trace_event{index, start, finish});
+}
+
+} // namespace detail
+
+void enable_performance_tracing(std::size_t events_per_thread)
+{
+  performance_registry& r = registry();
+  {
+    std::lock_guard<std::mutex> guard(r.mutex);
+    r.events_per_thread = events_per_thread;
+    r.trace_origin = std::chrono::steady_clock::now();
+    for (thread_buffer* buffer: r.buffers)
+    {
+      buffer->clear();
+      buffer->events_per_thread = events_per_thread;
+    }
+    r.traces.clear();
+  }
+  performance_tracing_enabled_flag().store(true, std::memory_order_relaxed);
+}
+
+void record_performance_span(const std::string& name,
+                             std::chrono::steady_clock::time_point start,
+                             std::chrono::steady_clock::time_point finish)
+{
+  if (performance_counters_enabled() || performance_tracing_enabled())
+  {
+    performance_span(name).record(start, finish);
+  }
+}
+
+void write_performance_report(std::ostream& out, const std::string& tool_name)
+{
+  performance_registry& r = registry();
+  std::lock_guard<std::mutex> guard(r.mutex);
+
+  // Combine the values of the terminated threads with those of the running threads.
+  std::vector<std::uint64_t> counters = r.counters;
+  std::vector<span_statistics> spans = r.spans;
+  for (const thread_buffer* buffer: r.buffers)
+  {
+    buffer->merge_into(r.counter_kinds, counters, spans);
+  }
+
+  std::ios::fmtflags oldflags = out.setf(std::ios::fixed, std::ios::floatfield);
+  std::streamsize oldprecision = out.precision(6);
+
+  out << "{\n  \"tool\": ";
+  write_json_string(out, tool_name);
+  out << ",\n  \"max_resident_kb\": " << max_resident_kilobytes();
+  out << ",\n  \"counters\": {";
+  for (std::size_t i = 0; i < r.counter_names.size(); ++i)
+  {
+    out << (i == 0 ? "\n    " : ",\n    ");
+    write_json_string(out, r.counter_names[i]);
+    out << ": " << counters[i];
+  }
+  out << (r.counter_names.empty() ? "" : "\n  ") << "},\n  \"spans\": {";
+  for (std::size_t i = 0; i < r.span_names.size(); ++i)
+  {
+    out << (i == 0 ? "\n    " : ",\n    ");
+    write_json_string(out, r.span_names[i]);
+    out << ": { \"count\": " << spans[i].count
+        << ", \"seconds\": " << seconds(spans[i].total)
+        << ", \"max_seconds\": " << seconds(spans[i].maximum) << " }";
+  }
+  out << (r.span_names.empty() ? "" : "\n  ") << "}\n}\n";
+
+  out.flags(oldflags);
+  out.precision(oldprecision);
+}
+
+void write_performance_report(const std::string& filename, const std::string& tool_name)
+{
+  std::ofstream out(filename);
+  if (!out)
+  {
+    throw mcrl2::runtime_error("Could not open file " + filename + " to write the performance report.");
+  }
+  write_performance_report(out, tool_name);
+}
+
+void write_performance_trace(std::ostream& out)
+{
+  performance_registry& r = registry();
+  std::lock_guard<std::mutex> guard(r.mutex);
+
+  std::vector<thread_trace> traces = r.traces;
+  for (const thread_buffer* buffer: r.buffers)
+  {
+    if (!buffer->events.empty())
+    {
+      traces.push_back(buffer->trace());
+    }
+  }
+  std::sort(traces.begin(), traces.end(),
+            [](const thread_trace& x, const thread_trace& y) { return x.thread_number < y.thread_number; });
+
+  std::ios::fmtflags oldflags = out.setf(std::ios::fixed, std::ios::floatfield);
+  std::streamsize oldprecision = out.precision(3);
+
+  // Timestamps and durations are given in microseconds, relative to the moment that tracing was enabled.
+  out << "{\n  \"traceEvents\": [";
+  bool first = true;
+  for (const thread_trace& trace: traces)
+  {
+    out << (first ? "\n    " : ",\n    ");
+    first = false;
+    out << "{ \"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": " << trace.thread_number
+        << ", \"args\": { \"name\": \"thread " << trace.thread_number << "\" } }";
+    for (const trace_event& event: trace.events)
+    {
+      out << ",\n    { \"name\": ";
+      write_json_string(out, r.span_names[event.span]);
+      out << ", \"ph\": \"X\", \"ts\": " << microseconds(event.start - r.trace_origin)
+          << ", \"dur\": " << microseconds(event.finish - event.start)
+          << ", \"pid\": 1, \"tid\": " << trace.thread_number << " }";
+    }
+  }
+  out << (first ? "" : "\n  ") << "],\n  \"displayTimeUnit\": \"ms\"\n}\n";
+
+  out.flags(oldflags);
+  out.precision(oldprecision);
+}
+
+void write_performance_trace(const std::string& filename)
+{
+  std::ofstream out(filename);
+  if (!out)
+  {
+    throw mcrl2::runtime_error("Could not open file " + filename + " to write the performance trace.");
+  }
+  write_performance_trace(out);
+}
+
+void reset_performance_counters()
+{
+  performance_registry& r = registry();
+  std::lock_guard<std::mutex> guard(r.mutex);
+  std::fill(r.counters.begin(), r.counters.end(), 0);
+  std::fill(r.spans.begin(), r.spans.end(), span_statistics());
+  r.traces.clear();
+  for (thread_buffer* buffer: r.buffers)
+  {
+    buffer->clear();
+  }
+}
+
+} // namespace mcrl2::utilities
@@ -9,6 +9,8 @@
 
 #include "mcrl2/utilities/bitstream.h"
 
+#include <random>
+
 #define BOOST_AUTO_TEST_MAIN
 #include <boost/test/included/unit_test.hpp>
 
@@ -47,3 +49,113 @@ BOOST_AUTO_TEST_CASE(fixed_sequence_test)
   
   BOOST_CHECK_EQUAL(output.read_integer(), std::size_t(1) << 63);
 }
+
+// The straightforward encoding of a sequence of bits, in which every bit is written in order and the result is
+// padded with zeroes to a multiple of 64 bits (plus one additional word when the last word is already full).
+class reference_bitstream
+{
+public:
+  void write_bits(std::size_t value, unsigned int number_of_bits)
+  {
+    for (unsigned int i = number_of_bits; i > 0; --i)
+    {
+      bits.push_back(((value >> (i - 1)) & 1) != 0);
+    }
+  }
+
+  std::string bytes()
+  {
+    std::vector<bool> padded = bits;
+    padded.resize(padded.size() + 64 - padded.size() % 64, false);
+    std::string result;
+    for (std::size_t i = 0; i < padded.size(); i += 8)
+    {
+      unsigned char byte = 0;
+      for (std::size_t j = 0; j < 8; ++j)
+      {
+        byte = static_cast<unsigned char>((byte << 1) | (padded[i + j] ? 1 : 0));
+      }
+      result.push_back(static_cast<char>(byte));
+    }
+    return result;
+  }
+
+private:
+  std::vector<bool> bits;
+};
+
+BOOST_AUTO_TEST_CASE(random_sequence_test)
+{
+  std::mt19937_64 generator(42);
+  std::vector<std::pair<std::size_t, unsigned int>> values;
+  for (std::size_t i = 0; i < 100000; ++i)
+  {
+    unsigned int number_of_bits = static_cast<unsigned int>(generator() % 65);
+    std::size_t value = generator();
+    values.emplace_back(number_of_bits < 64 ? value & ((std::size_t(1) << number_of_bits) - 1) : value, number_of_bits);
+  }
+  const std::string text(1000, 'x');
+
+  std::stringstream stream;
+  reference_bitstream reference;
+  {
+    obitstream input(stream);
+    for (std::size_t i = 0; i < values.size(); ++i)
+    {
+      input.write_bits(values[i].first, values[i].second);
+      reference.write_bits(values[i].first, values[i].second);
+
+      if (i % 1000 == 0)
+      {
+        // Strings of various lengths, both aligned and unaligned.
+        input.write_string(text.substr(0, i / 1000));
+        reference.write_bits(i / 1000, 8);
+        for (char c: text.substr(0, i / 1000))
+        {
+          reference.write_bits(static_cast<unsigned char>(c), 8);
+        }
+      }
+    }
+  }
+
+  // The encoding must be exactly the bit by bit encoding.
+  BOOST_CHECK(stream.str() == reference.bytes());
+
+  ibitstream output(stream);
+  for (std::size_t i = 0; i < values.size(); ++i)
+  {
+    BOOST_CHECK_EQUAL(output.read_bits(values[i].second), values[i].first);
+    if (i % 1000 == 0)
+    {
+      BOOST_CHECK_EQUAL(std::string(output.read_string()), text.substr(0, i / 1000));
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(compression_test)
+{
+  const std::size_t number_of_values = 200000;
+  std::stringstream stream;
+  {
+    obitstream input(stream);
+    input.write_bits(5, 3);
+    input.enable_compression();
+    for (std::size_t i = 0; i < number_of_values; ++i)
+    {
+      input.write_bits(i % 7, 3);
+      input.write_integer(i);
+      input.write_string("value");
+    }
+  }
+  stream << "after";
+
+  ibitstream output(stream);
+  BOOST_CHECK_EQUAL(output.read_bits(3), 5);
+  output.enable_decompression();
+  for (std::size_t i = 0; i < number_of_values; ++i)
+  {
+    BOOST_CHECK_EQUAL(output.read_bits(3), i % 7);
+    BOOST_CHECK_EQUAL(output.read_integer(), i);
+    BOOST_CHECK_EQUAL(std::string(output.read_string()), "value");
+  }
+}
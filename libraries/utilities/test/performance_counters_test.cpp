@@ -0,0 +1,123 @@
+// Author(s): agent
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#define BOOST_AUTO_TEST_MAIN
+#include <boost/test/included/unit_test.hpp>
+
+#include "mcrl2/utilities/performance_counters.h"
+
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace mcrl2::utilities;
+
+static std::string report()
+{
+  std::ostringstream out;
+  write_performance_report(out, "test");
+  return out.str();
+}
+
+static bool contains(const std::string& text, const std::string& s)
+{
+  return text.find(s) != std::string::npos;
+}
+
+BOOST_AUTO_TEST_CASE(test_disabled)
+{
+  enable_performance_counters(false);
+  reset_performance_counters();
+  performance_counter counter("test.disabled");
+  counter.add(5);
+  BOOST_CHECK(contains(report(), "\"test.disabled\": 0"));
+}
+
+BOOST_AUTO_TEST_CASE(test_threads)
+{
+  enable_performance_counters();
+  reset_performance_counters();
+  performance_counter sum("test.sum");
+  performance_counter maximum("test.maximum", performance_counter_kind::maximum);
+  performance_span span("test.span");
+
+  std::vector<std::thread> threads;
+  for (std::size_t t = 0; t < 4; ++t)
+  {
+    threads.emplace_back([&, t]()
+      {
+        for (std::size_t i = 0; i < 1000; ++i)
+        {
+          sum.add();
+        }
+        maximum.add(t * 10);
+        scoped_performance_span s(span);
+      });
+  }
+
+  // The values of the main thread are combined with those of the terminated threads.
+  sum.add(2);
+  for (std::thread& thread: threads)
+  {
+    thread.join();
+  }
+
+  std::string result = report();
+  BOOST_CHECK(contains(result, "\"tool\": \"test\""));
+  BOOST_CHECK(contains(result, "\"max_resident_kb\": "));
+  BOOST_CHECK(contains(result, "\"test.sum\": 4002"));
+  BOOST_CHECK(contains(result, "\"test.maximum\": 30"));
+  BOOST_CHECK(contains(result, "\"test.span\": { \"count\": 4,"));
+
+  // Counters with the same name share their value.
+  performance_counter other("test.sum");
+  other.add(8);
+  BOOST_CHECK(contains(report(), "\"test.sum\": 4010"));
+  BOOST_CHECK_EQUAL(sum.value(), 4010u);
+  BOOST_CHECK_EQUAL(maximum.value(), 30u);
+
+  auto now = std::chrono::steady_clock::now();
+  record_performance_span("test.span", now, now + std::chrono::seconds(1));
+  BOOST_CHECK(contains(report(), "\"test.span\": { \"count\": 5,"));
+  enable_performance_counters(false);
+}
+
+BOOST_AUTO_TEST_CASE(test_trace)
+{
+  enable_performance_tracing(2);
+  performance_span span("test.traced");
+
+  std::thread thread([&]()
+    {
+      // Only the last two events are kept.
+      for (std::size_t i = 0; i < 3; ++i)
+      {
+        scoped_performance_span s(span);
+      }
+    });
+  thread.join();
+  {
+    scoped_performance_span s(span);
+  }
+
+  std::ostringstream out;
+  write_performance_trace(out);
+  std::string result = out.str();
+  BOOST_CHECK(contains(result, "\"traceEvents\": ["));
+  BOOST_CHECK(contains(result, "\"ph\": \"M\""));
+
+  std::size_t count = 0;
+  for (std::size_t i = result.find("\"test.traced\""); i != std::string::npos; i = result.find("\"test.traced\"", i + 1))
+  {
+    count++;
+  }
+  BOOST_CHECK_EQUAL(count, 3u);
+  performance_tracing_enabled_flag().store(false);
+  reset_performance_counters();
+}
@@ -0,0 +1,41 @@
+#!/usr/bin/env python
+
+"""
+A script that compares two result files of the rewriter_throughput benchmark,
+for example of two different commits, and prints the relative change of the
+throughput and the number of created terms of every workload. Returns a
+non-zero exit code when the throughput of a workload decreased by more than
+the given threshold (default 10%).
+"""
+import json
+import sys
+
+if len(sys.argv) not in [3, 4]:
+    print("Usage: compare_rewriter_benchmarks.py <baseline.json> <result.json> [threshold]")
+    exit(-1)
+
+with open(sys.argv[1], "r", encoding="utf-8") as file:
+    baseline = json.load(file)
+
+with open(sys.argv[2], "r", encoding="utf-8") as file:
+    result = json.load(file)
+
+threshold = float(sys.argv[3]) if len(sys.argv) == 4 else 0.1
+
+regressions = []
+for name, workload in result["workloads"].items():
+    if name not in baseline["workloads"]:
+        print(f"{name:20} (new)")
+        continue
+
+    old = baseline["workloads"][name]
+    speedup = workload["rewrites_per_second"] / old["rewrites_per_second"]
+    terms = workload["terms_created"] / max(old["terms_created"], 1)
+    print(f"{name:20} {speedup:6.2f}x throughput {terms:6.2f}x terms created")
+
+    if speedup < 1.0 - threshold:
+        regressions.append(name)
+
+if regressions:
+    print("Regressions in: " + ", ".join(regressions))
+    exit(1)
@@ -210,6 +210,10 @@ class Lps2ltsParallelTest(ProcessTauTest):
     def __init__(self, name, settings):
         super().__init__(name, ymlfile('lps2lts_parallel'), settings)
 
+class Lps2ltsDistributedTest(ProcessTauTest):
+    def __init__(self, name, settings):
+        super().__init__(name, ymlfile('lps2lts_distributed'), settings)
+
 class Lps2ltsAlgorithmsTest(ProcessTauTest):
     def __init__(self, name, settings):
         super().__init__(name, ymlfile('lps2lts-algorithms'), settings)
@@ -590,6 +594,7 @@ if shutil.which("z3") is not None:
 
 # These test do not work on Windows due to dependencies.
 if os.name != 'nt':
+    available_tests.update({'lps2lts-distributed' : lambda name, settings: Lps2ltsDistributedTest(name, settings) })
     available_tests.update({'pbessolvesymbolic' : lambda name, settings: PbessolvesymbolicTest(name, [], settings) })
     available_tests.update({'pbessolvesymbolic-parallel' : lambda name, settings: PbessolvesymbolicTest(name, ['--threads=8'], settings) })
     available_tests.update({'pbessolvesymbolic-total' : lambda name, settings: PbessolvesymbolicTest(name, ['--total'], settings) })
@@ -658,7 +658,7 @@ class besconvert_tool: public super
         mCRL2log(verbose) << "done" << std::endl;
         bes_reduction_algorithm(b, equivalence, m_translation, m_lts_filename, m_no_reduction).run(timer());
       }
-      save_pbes(b, output_filename(), pbes_output_format());
+      save_pbes(b, output_filename(), pbes_output_format(), true, compress_output());
 
       return true;
     }
@@ -113,7 +113,7 @@ class complps2pbes_tool : public mcrl2::pbes_system::tools::pbes_output_tool<inp
         mCRL2log(log::verbose) << "writing PBES to file '" <<  output_filename() << "'..." << std::endl;
       }
       
-      save_pbes(result, output_filename(), m_pbes_output_format);
+      save_pbes(result, output_filename(), m_pbes_output_format, true, compress_output());
       return true;
     }
 
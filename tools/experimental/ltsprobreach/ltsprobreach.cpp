@@ -0,0 +1,175 @@
+// Author(s): agent
+// Copyright: see the accompanying file COPYING or copy at
+// https://github.com/mCRL2org/mCRL2/blob/master/COPYING
+//
+// Distributed under the Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt or copy at
+// http://www.boost.org/LICENSE_1_0.txt)
+//
+/// \file ltsprobreach.cpp
+
+static constexpr const char* NAME = "ltsprobreach";
+static constexpr const char* AUTHOR = "agent";
+
+#include "mcrl2/utilities/input_tool.h"
+#include "mcrl2/utilities/parallel_tool.h"
+#include "mcrl2/lts/lts_io.h"
+#include "mcrl2/lts/probabilistic_reachability.h"
+
+using namespace mcrl2::lts;
+using namespace mcrl2::utilities::tools;
+using namespace mcrl2::utilities;
+using namespace mcrl2::log;
+
+using ltsprobreach_base = parallel_tool<input_tool>;
+class ltsprobreach_tool : public ltsprobreach_base
+{
+  private:
+    lts_type intype = lts_none;
+    std::vector<std::string> target_actions;
+    probabilistic_reachability_options options;
+
+    // An action label is a target if it equals one of the target actions, or if its name does.
+    template <class LTS_TYPE>
+    std::vector<bool> target_labels(const LTS_TYPE& l) const
+    {
+      std::vector<bool> result(l.num_action_labels(), false);
+      for (std::size_t i = 0; i < l.num_action_labels(); ++i)
+      {
+        const std::string label = pp(l.action_label(i));
+        const std::string name = label.substr(0, label.find('('));
+        for (const std::string& a: target_actions)
+        {
+          if (a == label || a == name)
+          {
+            result[i] = true;
+          }
+        }
+      }
+      return result;
+    }
+
+    template <class LTS_TYPE>
+    void compute_probability()
+    {
+      LTS_TYPE l;
+      l.load(input_filename());
+      mCRL2log(verbose) << "The LTS has " << l.num_states() << " states and " << l.num_transitions() << " transitions." << std::endl;
+
+      std::vector<bool> targets = target_labels(l);
+      if (std::find(targets.begin(), targets.end(), true) == targets.end())
+      {
+        mCRL2log(warning) << "None of the target actions occurs in the LTS." << std::endl;
+      }
+      std::cout << reachability_probability(l, targets, options) << std::endl;
+    }
+
+  public:
+    ltsprobreach_tool()
+      : ltsprobreach_base(NAME, AUTHOR,
+                          "compute reachability probabilities of a probabilistic LTS",
+                          "Print the maximal (or with --min the minimal) probability over all schedulers "
+                          "that the probabilistic labelled transition system (LTS) in INFILE eventually "
+                          "performs one of the actions given with --action. If INFILE is not supplied, "
+                          "stdin is used.\n"
+                          "\n"
+                          "The format of INFILE is determined by its contents. "
+                          "The option --in can be used to force the format for INFILE. "
+                          "The supported formats are:\n"
+                          + mcrl2::lts::detail::supported_lts_formats_text())
+    {}
+
+  protected:
+    void add_options(interface_description& desc) override
+    {
+      ltsprobreach_base::add_options(desc);
+      desc.add_option("action", make_mandatory_argument("NAMES"),
+                      "the target actions, given as a comma separated list of action labels or action names", 'a');
+      desc.add_option("in", make_mandatory_argument("FORMAT"),
+                      "use FORMAT as the input format", 'i');
+      desc.add_option("min", "compute the minimal instead of the maximal probability");
+      desc.add_option("method", make_enum_argument<reachability_method>("NAME")
+                      .add_value(reachability_method::value_iteration, true)
+                      .add_value(reachability_method::interval_iteration)
+                      .add_value(reachability_method::policy_iteration),
+                      "use method NAME to compute the probabilities:", 'm');
+      desc.add_option("epsilon", make_mandatory_argument("EPS"),
+                      "compute the probability up to an absolute error EPS (default 0.000001)", 'e');
+    }
+
+    void parse_options(const command_line_parser& parser) override
+    {
+      ltsprobreach_base::parse_options(parser);
+
+      if (!parser.has_option("action"))
+      {
+        parser.error("No target actions are given. Use the option --action.");
+      }
+      target_actions = split(parser.option_argument("action"), ",");
+
+      if (parser.has_option("in"))
+      {
+        intype = mcrl2::lts::detail::parse_format(parser.option_argument("in"));
+        if (intype == lts_none || intype == lts_dot)
+        {
+          parser.error("Option -i/--in has illegal argument '" + parser.option_argument("in") + "'.");
+        }
+      }
+
+      options.maximise = !parser.has_option("min");
+      options.method = parser.option_argument_as<reachability_method>("method");
+      if (parser.has_option("epsilon"))
+      {
+        options.epsilon = parser.option_argument_as<double>("epsilon");
+        if (options.epsilon <= 0.0)
+        {
+          parser.error("The value of --epsilon must be positive.");
+        }
+      }
+      options.number_of_threads = number_of_threads();
+    }
+
+  public:
+    bool run() override
+    {
+      if (intype == lts_none)
+      {
+        intype = mcrl2::lts::detail::guess_format(input_filename());
+      }
+
+      switch (intype)
+      {
+        case lts_lts:
+        case lts_lts_probabilistic:
+        {
+          compute_probability<probabilistic_lts_lts_t>();
+          break;
+        }
+        case lts_fsm:
+        case lts_fsm_probabilistic:
+        {
+          compute_probability<probabilistic_lts_fsm_t>();
+          break;
+        }
+        case lts_none:
+          mCRL2log(warning) << "Cannot determine type of input. Assuming .aut.\n";
+          [[fallthrough]];
+        case lts_aut:
+        case lts_aut_probabilistic:
+        {
+          compute_probability<probabilistic_lts_aut_t>();
+          break;
+        }
+        case lts_dot:
+        {
+          throw mcrl2::runtime_error("Reachability probabilities cannot be computed for a .dot file.");
+        }
+      }
+      return true;
+    }
+};
+
+int main(int argc, char** argv)
+{
+  return ltsprobreach_tool().execute(argc, argv);
+}
@@ -107,7 +107,7 @@ class pbes_absinthe_tool: public pbes_input_tool<pbes_output_tool<input_output_t
       algorithm.run(p, abstraction_text, over_approximation);
 
       // save the result
-      save_pbes(p, output_filename(), pbes_output_format());
+      save_pbes(p, output_filename(), pbes_output_format(), true, compress_output());
       return true;
     }
 
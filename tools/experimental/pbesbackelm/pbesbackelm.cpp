@@ -67,7 +67,7 @@ class pbesbackelm_tool: public pbes_input_tool<pbes_output_tool<pbes_rewriter_to
       algorithms::normalize(p);
       pbesbackelm_pbes_backward_substituter backward_substituter;
       backward_substituter.run(p, m_options);
-      save_pbes(p, output_filename(), pbes_output_format());
+      save_pbes(p, output_filename(), pbes_output_format(), true, compress_output());
       return true;
     }
 
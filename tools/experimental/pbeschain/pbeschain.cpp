@@ -106,7 +106,8 @@ class pbeschain_tool: public pbes_input_tool<pbes_output_tool<pbes_rewriter_tool
                   output_filename(),
                   pbes_input_format(),
                   pbes_output_format(),
-                  m_options
+                  m_options,
+                  compress_output()
                  );
 
       return true;
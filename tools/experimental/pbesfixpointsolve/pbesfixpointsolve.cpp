@@ -80,7 +80,7 @@ class pbesfixpointsolve_tool: public pbes_input_tool<pbes_output_tool<pbes_rewri
       algorithms::normalize(p);
       pbesfixpointsolve_pbes_fixpoint_iterator fixpoint_iterator;
       fixpoint_iterator.run(p, m_options);
-      save_pbes(p, output_filename(), pbes_output_format());
+      save_pbes(p, output_filename(), pbes_output_format(), true, compress_output());
       
       log::logger::set_reporting_level(log::status);
       bool result = mcrl2::pbes_system::detail::pbessolve(p);
@@ -74,7 +74,7 @@ class pbes_eqelm_tool: public pbes_input_tool<pbes_output_tool<pbes_rewriter_too
       eqelm(p, rewrite_strategy(), rewriter_type(), m_ignore_initial_state);
 
       // save the result
-      save_pbes(p, output_filename(), pbes_output_format());
+      save_pbes(p, output_filename(), pbes_output_format(), true, compress_output());
       return true;
     }
 };
@@ -232,7 +232,7 @@ class pbespor_tool: public pbes_input_tool<pbes_output_tool<pbes_rewriter_tool<r
       algorithms::normalize(p);
       pbespor_pbes_composer composer;
       pbes result = composer.run(p, m_options);
-      save_pbes(result, output_filename(), pbes_output_format());
+      save_pbes(result, output_filename(), pbes_output_format(), true, compress_output());
 
       return true;
     }
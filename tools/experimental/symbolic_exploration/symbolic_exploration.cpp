@@ -71,7 +71,8 @@ protected:
                                                 pbes_output_format(),
                                                 m_optimized,
                                                 m_clustered,
-                                                m_instantiate);
+                                                m_instantiate,
+                                                compress_output());
       return true;
     }
 };
@@ -16,7 +16,11 @@
 #include "mcrl2/utilities/parallel_tool.h"
 #include "mcrl2/data/rewriter_tool.h"
 #include "mcrl2/lps/is_stochastic.h"
+#include "mcrl2/lts/detail/lts_columnar_io.h"
+#include "mcrl2/lts/distributed_state_space_generator.h"
+#include "mcrl2/lts/incremental_state_space_generator.h"
 #include "mcrl2/lts/lts_io.h"
+#include "mcrl2/lts/mapped_lts.h"
 #include "mcrl2/lts/stochastic_lts_builder.h"
 #include "mcrl2/lts/state_space_generator.h"
 
@@ -37,6 +41,9 @@ class lps2lts_tool: public parallel_tool<rewriter_tool<input_output_tool>>
   lts::lts_type output_format = lts::lts_none;
   lps::abortable* current_explorer = nullptr;
   std::set<std::string> trace_multiaction_strings;
+  std::size_t number_of_processes = 1;
+  std::string previous_lps_filename;
+  std::string previous_lts_filename;
 
 #ifdef MCRL2_USE_CONTROL_FLOW
   pbes_system::pbesstategraph_options stategraph_options{};
@@ -63,6 +70,19 @@ class lps2lts_tool: public parallel_tool<rewriter_tool<input_output_tool>>
       desc.add_hidden_option("no-replace-constants-by-variables", "do not move constant expressions to a substitution");
       desc.add_option("no-probability-checking", "do not check if probabilities in stochastic specifications have sensible values");
       desc.add_hidden_option("dfs-recursive", "use recursive depth first search for divergence detection");
+      desc.add_option("processes", utilities::make_mandatory_argument("NUM"),
+                 "generate the state space with NUM worker processes, each of which owns a part of the states "
+                 "and uses its own rewriter. The processes exchange newly discovered states over sockets. "
+                 "This option cannot be combined with --threads, --confluence, --max, --trace and the detection options, "
+                 "and is not available for stochastic specifications or on Windows. ");
+      desc.add_option("previous-lts", utilities::make_mandatory_argument("FILE"),
+                 "reuse the state space in FILE, which must be the complete .lts output of lps2lts, with state labels, "
+                 "for the specification given by --previous-lps. The transitions of a state are copied if no summand "
+                 "or rewrite rule that differs between the two specifications applies to it; all other states are explored. "
+                 "This option cannot be combined with --threads, --processes, --confluence, --max, --trace and the detection options, "
+                 "and is not available for stochastic or timed specifications. ");
+      desc.add_option("previous-lps", utilities::make_mandatory_argument("FILE"),
+                 "the specification from which the state space given by --previous-lts was generated. ");
       desc.add_option("cached", "use enumeration caching techniques to speed up state space generation. ");
       desc.add_option("project", "use read/write projections ");
 #ifdef MCRL2_USE_CONTROL_FLOW
@@ -124,6 +144,9 @@ class lps2lts_tool: public parallel_tool<rewriter_tool<input_output_tool>>
       desc.add_option("save-at-end", "delay saving of the generated LTS until the end. "
                  "This option only applies to .aut and .lts files, which are by default saved on the fly.");
       desc.add_option("no-info", "do not add state label information to OUTFILE. This option only applies to .lts files.");
+      desc.add_option("compress", "compress OUTFILE in blocks. Such files cannot be read by versions of the toolset that "
+                                  "do not support compression. This option only applies to .lts files, and cannot be used "
+                                  "for the .ltsc and .ltsm formats.");
 
 #ifdef MCRL2_PREPROCESS
       desc.add_option("preprocess","apply some preprocessing, which sometimes benefits.");
@@ -248,6 +271,7 @@ class lps2lts_tool: public parallel_tool<rewriter_tool<input_output_tool>>
       options.suppress_progress_messages            = parser.has_option("suppress");
       options.dfs_recursive                         = parser.has_option("dfs-recursive");
       options.discard_lts_state_labels              = parser.has_option("no-info");
+      options.compress_lts                          = parser.has_option("compress");
       options.search_strategy = parser.option_argument_as<lps::exploration_strategy>("strategy");
       options.number_of_threads = number_of_threads();
       bool to_stdout = output_filename().empty() || output_filename() == "-";
@@ -351,6 +375,12 @@ class lps2lts_tool: public parallel_tool<rewriter_tool<input_output_tool>>
       {
         parser.error("Option '--no-info' requires that the output is in .lts format.");
       }
+      if (options.compress_lts && (output_format != lts::lts_lts ||
+                                   lts::detail::has_columnar_lts_extension(output_filename()) ||
+                                   lts::detail::has_mapped_lts_extension(output_filename())))
+      {
+        parser.error("Option '--compress' requires that the output is in .lts format, and not in .ltsc or .ltsm format.");
+      }
       if (options.number_of_threads>1)
       {
          if (options.save_error_trace)
@@ -367,6 +397,59 @@ class lps2lts_tool: public parallel_tool<rewriter_tool<input_output_tool>>
          }
       }
 
+      if (parser.has_option("processes"))
+      {
+        number_of_processes = parser.option_argument_as<std::size_t>("processes");
+        if (number_of_processes == 0)
+        {
+          parser.error("Option --processes requires a positive number of processes.");
+        }
+        if (options.number_of_threads > 1)
+        {
+          parser.error("Option --processes cannot be combined with --threads.");
+        }
+        if (options.save_error_trace || options.generate_traces || options.detect_deadlock || options.detect_nondeterminism ||
+            options.detect_divergence || options.detect_action || !trace_multiaction_strings.empty())
+        {
+          parser.error("Option --processes cannot be combined with --trace, --error-trace or the detection options.");
+        }
+        if (options.confluence)
+        {
+          parser.error("Option --processes cannot be combined with --confluence.");
+        }
+        if (parser.options.count("max"))
+        {
+          parser.error("Option --processes cannot be combined with --max.");
+        }
+      }
+
+      if (parser.has_option("previous-lts") != parser.has_option("previous-lps"))
+      {
+        parser.error("Options --previous-lts and --previous-lps must be used together.");
+      }
+      if (parser.has_option("previous-lts"))
+      {
+        previous_lts_filename = parser.option_argument("previous-lts");
+        previous_lps_filename = parser.option_argument("previous-lps");
+        if (options.number_of_threads > 1 || number_of_processes > 1)
+        {
+          parser.error("Option --previous-lts cannot be combined with --threads or --processes.");
+        }
+        if (options.save_error_trace || options.generate_traces || options.detect_deadlock || options.detect_nondeterminism ||
+            options.detect_divergence || options.detect_action || !trace_multiaction_strings.empty())
+        {
+          parser.error("Option --previous-lts cannot be combined with --trace, --error-trace or the detection options.");
+        }
+        if (options.confluence)
+        {
+          parser.error("Option --previous-lts cannot be combined with --confluence.");
+        }
+        if (parser.options.count("max"))
+        {
+          parser.error("Option --previous-lts cannot be combined with --max.");
+        }
+      }
+
       options.rewrite_actions = output_format!=lts::lts_none ||
                                 options.save_error_trace ||
                                 options.generate_traces;
@@ -421,6 +504,43 @@ class lps2lts_tool: public parallel_tool<rewriter_tool<input_output_tool>>
       return result;
     }
 
+    template <bool Timed>
+    bool generate_state_space_distributed(const lps::specification& lpsspec, lts::lts_builder& builder)
+    {
+      data::rewriter rewr = lps::construct_rewriter(lpsspec, options.rewrite_strategy, options.remove_unused_rewrite_rules);
+      lps::explorer<false, Timed, lps::specification> explorer(lpsspec, options, rewr);
+      lts::distributed_state_space_generator<Timed, lps::specification> generator(explorer, number_of_processes);
+      current_explorer = &generator;
+
+      bool result = generator.explore(builder, output_format != lts::lts_none);
+      builder.save(output_filename());
+      return result;
+    }
+
+    bool generate_state_space_incremental(const lps::specification& lpsspec, lts::lts_builder& builder)
+    {
+      lps::stochastic_specification stochastic_old_lpsspec;
+      lps::load_lps(stochastic_old_lpsspec, previous_lps_filename);
+      if (lps::is_stochastic(stochastic_old_lpsspec) || stochastic_old_lpsspec.process().has_time())
+      {
+        throw mcrl2::runtime_error("The specification in " + previous_lps_filename + " is stochastic or timed.");
+      }
+      lps::specification old_lpsspec = lps::remove_stochastic_operators(stochastic_old_lpsspec);
+      lts::lts_lts_t old_lts;
+      old_lts.load(previous_lts_filename);
+
+      data::rewriter old_rewr = lps::construct_rewriter(old_lpsspec, options.rewrite_strategy, options.remove_unused_rewrite_rules);
+      lps::explorer<false, false, lps::specification> old_explorer(old_lpsspec, options, old_rewr);
+      data::rewriter rewr = lps::construct_rewriter(lpsspec, options.rewrite_strategy, options.remove_unused_rewrite_rules);
+      lps::explorer<false, false, lps::specification> explorer(lpsspec, options, rewr);
+      lts::incremental_state_space_generator generator(old_lpsspec, lpsspec, old_explorer, explorer);
+      current_explorer = &generator;
+
+      bool result = generator.explore(old_lts, builder);
+      builder.save(output_filename());
+      return result;
+    }
+
     bool run() override
     {
       mCRL2log(log::debug) << options << std::endl;
@@ -436,6 +556,14 @@ class lps2lts_tool: public parallel_tool<rewriter_tool<input_output_tool>>
 
       if (lps::is_stochastic(stochastic_lpsspec))
       {
+        if (number_of_processes > 1)
+        {
+          throw mcrl2::runtime_error("Distributed state space generation is not supported for stochastic specifications.");
+        }
+        if (!previous_lts_filename.empty())
+        {
+          throw mcrl2::runtime_error("Incremental state space generation is not supported for stochastic specifications.");
+        }
         if (options.use_projections) {
             options.use_projections = false;
             mCRL2log(log::warning) << "Projections are currently not supported for stochastic specifications. "
@@ -456,7 +584,20 @@ class lps2lts_tool: public parallel_tool<rewriter_tool<input_output_tool>>
       {
         lps::specification lpsspec = lps::remove_stochastic_operators(stochastic_lpsspec);
         auto builder = create_lts_builder(lpsspec, options, output_format, output_filename());
-        if (is_timed)
+        if (!previous_lts_filename.empty())
+        {
+          if (is_timed)
+          {
+            throw mcrl2::runtime_error("Incremental state space generation is not supported for timed specifications.");
+          }
+          result = generate_state_space_incremental(lpsspec, *builder);
+        }
+        else if (number_of_processes > 1)
+        {
+          result = is_timed ? generate_state_space_distributed<true>(lpsspec, *builder)
+                            : generate_state_space_distributed<false>(lpsspec, *builder);
+        }
+        else if (is_timed)
         {
           result = generate_state_space<false, true>(
             lpsspec,
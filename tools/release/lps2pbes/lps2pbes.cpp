@@ -14,6 +14,7 @@
 #include "mcrl2/pbes/lps2pbes.h"
 #include "mcrl2/pbes/pbes_output_tool.h"
 #include "mcrl2/utilities/input_output_tool.h"
+#include "mcrl2/utilities/parallel_tool.h"
 #include "mcrl2/modal_formula/parse.h"
 
 
@@ -49,9 +50,9 @@ using namespace mcrl2::utilities::tools;
 using namespace mcrl2::log;
 using pbes_system::tools::pbes_output_tool;
 
-class lps2pbes_tool : public pbes_output_tool<input_output_tool>
+class lps2pbes_tool : public parallel_tool<pbes_output_tool<input_output_tool>>
 {
-  using super = pbes_output_tool<input_output_tool>;
+  using super = parallel_tool<pbes_output_tool<input_output_tool>>;
 
 protected:
   std::string formula_filename;
@@ -164,7 +165,7 @@ protected:
       state_formulas::state_formula_specification formspec = state_formulas::algorithms::parse_state_formula_specification(text, lpsspec, formula_is_quantitative);
       pbes_system::detail::check_lps2pbes_actions(formspec.formula(), lpsspec);
       mCRL2log(log::verbose) << "Converting state formula and LPS to a PBES..." << std::endl;
-      pbes_system::pbes result = pbes_system::lps2pbes(lpsspec, formspec, timed, structured, unoptimized, preprocess_modal_operators, generate_counter_example, check_only);
+      pbes_system::pbes result = pbes_system::lps2pbes(lpsspec, formspec, timed, structured, unoptimized, preprocess_modal_operators, generate_counter_example, check_only, number_of_threads());
 
       if (check_only)
       {
@@ -182,7 +183,7 @@ protected:
       {
         mCRL2log(log::verbose) << "Writing PBES to file '" <<  output_filename() << "'..." << std::endl;
       }
-      save_pbes(result, output_filename(), pbes_output_format());
+      save_pbes(result, output_filename(), pbes_output_format(), true, compress_output());
       return true;
     }
 
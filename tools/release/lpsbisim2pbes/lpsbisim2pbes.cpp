@@ -106,7 +106,7 @@ class lpsbisim2pbes_tool: public super
       {
         algorithms::normalize(result);
       }
-      save_pbes(result, output_filename(), pbes_output_format());
+      save_pbes(result, output_filename(), pbes_output_format(), true, compress_output());
       return true;
     }
 };
@@ -13,6 +13,7 @@
 #include "mcrl2/lps/io.h"
 #include "mcrl2/lps/stochastic_specification.h"
 #include "mcrl2/utilities/input_output_tool.h"
+#include "mcrl2/utilities/parallel_tool.h"
 
 using namespace mcrl2;
 using namespace mcrl2::lps;
@@ -21,11 +22,11 @@ using namespace mcrl2::utilities::tools;
 
 using mcrl2::data::tools::rewriter_tool;
 
-class lpsconstelm_tool: public rewriter_tool<input_output_tool >
+class lpsconstelm_tool: public parallel_tool<rewriter_tool<input_output_tool> >
 {
   protected:
 
-    using super = rewriter_tool<input_output_tool>;
+    using super = parallel_tool<rewriter_tool<input_output_tool>>;
 
     bool m_instantiate_free_variables = false;
     bool m_ignore_conditions = false;
@@ -84,6 +85,7 @@ class lpsconstelm_tool: public rewriter_tool<input_output_tool >
       load_lps(spec, input_filename());
       mcrl2::data::rewriter R(spec.data(), rewrite_strategy());
       lps::constelm_algorithm<data::rewriter, stochastic_specification> algorithm(spec, R);
+      algorithm.set_number_of_threads(number_of_threads());
 
       // preprocess: remove single element sorts
       if (m_remove_singleton_sorts)
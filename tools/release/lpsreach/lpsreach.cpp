@@ -70,7 +70,7 @@ protected:
     desc.add_option("chaining",
       "reduce the amount of breadth-first iterations by applying the transition groups consecutively");
     desc.add_option("deadlock", "report the number of deadlocks (i.e. states with no outgoing transitions).");
-    desc.add_option("info", "print read/write information of the summands");
+    desc.add_option("info", "print read/write information of the summands, and the event span of the available variable orders");
     desc.add_option("groups",
       utilities::make_optional_argument("GROUPS", "none"),
       "'none' (default) no summand groups\n"
@@ -82,7 +82,19 @@ protected:
       "'none' (default) no variable reordering\n"
       "'random' variables are put in a random order\n"
       "'weighted' variables are put in an order defined by their connectivity weight\n"
+      "'force' variables are put in an order computed by the FORCE heuristic, which minimises the event span\n"
+      "'sloan' variables are put in an order computed by Sloan's bandwidth and profile reduction algorithm\n"
+      "'most-read-first' variables that are read by the most summands are put first\n"
       "'a user defined permutation e.g. '1 3 2 0 4'");
+    desc.add_option("checkpoint",
+      utilities::make_mandatory_argument("FILE"),
+      "periodically save the state of the exploration, including the learned transitions, to FILE "
+      "(cannot be combined with --saturation)");
+    desc.add_option("checkpoint-interval",
+      utilities::make_optional_argument("SEC", "600"),
+      "the minimal number of seconds between two checkpoints (default 600)");
+    desc.add_option("resume",
+      "continue the exploration from the checkpoint in the file given by --checkpoint");
     desc.add_option("max-iterations",
       utilities::make_optional_argument("NUM", "0"),
       "limit number of breadth-first iterations to NUM");
@@ -91,8 +103,8 @@ protected:
     desc.add_option("print-nodesize",
       "print the number of LDD nodes in addition to the number of elements represented as 'elements[nodes]'");
     desc.add_option("saturation",
-      "reduce the amount of breadth-first iterations required by applying the transition groups until fixed point is "
-      "reached");
+      "compute the reachable states in a single iteration using saturation, which saturates the LDD nodes bottom-up "
+      "by level with the transition groups of which the topmost parameter is at that level");
     desc.add_option("replace-dont-care",
       "replace parameters assignments to don't care variables by assignments to the parameter itself");
     desc.add_hidden_option("no-discard", "do not discard any parameters");
@@ -129,11 +141,37 @@ protected:
     options.no_discard_read = parser.has_option("no-read");
     options.no_discard_write = parser.has_option("no-write");
     options.no_relprod = parser.has_option("no-relprod");
+    if (options.saturation && options.no_relprod)
+    {
+      throw mcrl2::runtime_error("The options --saturation and --no-relprod cannot be combined.");
+    }
+    if (options.saturation && options.chaining)
+    {
+      throw mcrl2::runtime_error("The options --saturation and --chaining cannot be combined.");
+    }
     options.info = parser.has_option("info");
     options.summand_groups = parser.option_argument("groups");
     options.variable_order = parser.option_argument("reorder");
     options.rewrite_strategy = rewrite_strategy();
     options.dot_file = parser.option_argument("dot");
+    if (parser.has_option("checkpoint"))
+    {
+      options.checkpoint_file = parser.option_argument("checkpoint");
+    }
+    if (parser.has_option("checkpoint-interval"))
+    {
+      options.checkpoint_interval = parser.option_argument_as<std::size_t>("checkpoint-interval");
+    }
+    options.resume = parser.has_option("resume");
+    if (options.resume && options.checkpoint_file.empty())
+    {
+      throw mcrl2::runtime_error("The option --resume requires that a checkpoint file is given with --checkpoint.");
+    }
+    if (options.saturation && !options.checkpoint_file.empty())
+    {
+      // Saturation computes the reachable states in a single iteration, after which a checkpoint is never saved.
+      throw mcrl2::runtime_error("The options --saturation and --checkpoint cannot be combined.");
+    }
     if (parser.has_option("lace-dqsize"))
     {
       lace_dqsize = parser.option_argument_as<int>("lace-dqsize");
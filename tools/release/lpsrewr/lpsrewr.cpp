@@ -19,19 +19,21 @@
 #include "mcrl2/lps/rewriters/one_point_condition_rewrite.h"
 #include "mcrl2/lps/stochastic_specification.h"
 #include "mcrl2/utilities/input_output_tool.h"
+#include "mcrl2/utilities/parallel_tool.h"
 
 using namespace mcrl2;
 using namespace mcrl2::lps;
 using namespace mcrl2::log;
 using namespace mcrl2::utilities;
 using mcrl2::utilities::tools::input_output_tool;
+using mcrl2::utilities::tools::parallel_tool;
 using mcrl2::data::tools::rewriter_tool;
 using lps::tools::lps_rewriter_tool;
 
-class lps_rewriter : public lps_rewriter_tool<rewriter_tool< input_output_tool > >
+class lps_rewriter : public parallel_tool<lps_rewriter_tool<rewriter_tool< input_output_tool > > >
 {
   protected:
-    using super = lps_rewriter_tool<rewriter_tool<input_output_tool>>;
+    using super = parallel_tool<lps_rewriter_tool<rewriter_tool<input_output_tool>>>;
 
   public:
     lps_rewriter()
@@ -61,7 +63,7 @@ class lps_rewriter : public lps_rewriter_tool<rewriter_tool< input_output_tool >
         case simplify:
         {
           mcrl2::data::rewriter R(spec.data(), rewrite_strategy());
-          lps::rewrite(spec, R);
+          lps::rewrite(spec, R, number_of_threads());
           break;
         }
         case quantifier_one_point:
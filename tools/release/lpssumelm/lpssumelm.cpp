@@ -12,6 +12,7 @@
 #include "mcrl2/lps/stochastic_specification.h"
 #include "mcrl2/lps/sumelm.h"
 #include "mcrl2/utilities/input_output_tool.h"
+#include "mcrl2/utilities/parallel_tool.h"
 
 using namespace mcrl2;
 using namespace mcrl2::utilities;
@@ -20,11 +21,11 @@ using namespace mcrl2::core;
 using namespace mcrl2::lps;
 using namespace mcrl2::log;
 
-class sumelm_tool: public input_output_tool
+class sumelm_tool: public parallel_tool<input_output_tool>
 {
   protected:
 
-    using super = input_output_tool;
+    using super = parallel_tool<input_output_tool>;
     bool m_decluster = false;
 
     void add_options(interface_description& desc) override
@@ -58,7 +59,9 @@ class sumelm_tool: public input_output_tool
       stochastic_specification spec;
       load_lps(spec, input_filename());
 
-      sumelm_algorithm<stochastic_specification>(spec, m_decluster).run();
+      sumelm_algorithm<stochastic_specification> algorithm(spec, m_decluster);
+      algorithm.set_number_of_threads(number_of_threads());
+      algorithm.run();
 
       mCRL2log(log::debug) << "Sum elimination completed, saving to " <<  output_filename() << std::endl;
       save_lps(spec, output_filename());
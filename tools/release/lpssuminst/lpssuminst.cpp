@@ -14,6 +14,7 @@
 #include "mcrl2/lps/stochastic_specification.h"
 #include "mcrl2/lps/suminst.h"
 #include "mcrl2/utilities/input_output_tool.h"
+#include "mcrl2/utilities/parallel_tool.h"
 
 using namespace mcrl2;
 using namespace mcrl2::lps;
@@ -22,11 +23,11 @@ using namespace mcrl2::utilities::tools;
 
 using mcrl2::data::tools::rewriter_tool;
 
-class suminst_tool: public rewriter_tool<input_output_tool>
+class suminst_tool: public parallel_tool<rewriter_tool<input_output_tool>>
 {
   protected:
 
-    using super = rewriter_tool<input_output_tool>;
+    using super = parallel_tool<rewriter_tool<input_output_tool>>;
 
     bool m_tau_summands_only = false;
     bool m_finite_sorts_only = false;
@@ -103,7 +104,9 @@ class suminst_tool: public rewriter_tool<input_output_tool>
       mCRL2log(log::verbose) << "expanding summation variables of sorts: " << data::pp(sorts) << std::endl;
 
       mcrl2::data::rewriter r(spec.data(), m_rewrite_strategy);
-      lps::suminst_algorithm<data::rewriter, stochastic_specification>(spec, r, sorts, m_tau_summands_only).run();
+      lps::suminst_algorithm<data::rewriter, stochastic_specification> algorithm(spec, r, sorts, m_tau_summands_only);
+      algorithm.set_number_of_threads(number_of_threads());
+      algorithm.run();
       save_lps(spec, output_filename());
       return true;
     }
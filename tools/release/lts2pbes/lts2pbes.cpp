@@ -157,7 +157,7 @@ class lts2pbes_tool : public pbes_output_tool<input_output_tool>
       {
         mCRL2log(log::verbose) << "Writing PBES to file '" <<  output_filename() << "'..." << std::endl;
       }
-      save_pbes(result, output_filename(), pbes_output_format());
+      save_pbes(result, output_filename(), pbes_output_format(), true, compress_output());
       return true;
     }
 };
@@ -9,6 +9,7 @@
 /// \file ltscompare.cpp
 
 #include "mcrl2/utilities/input_tool.h"
+#include "mcrl2/utilities/parallel_tool.h"
 
 #include "mcrl2/lts/lts_algorithm.h"
 #include "mcrl2/lts/lts_io.h"
@@ -36,7 +37,7 @@ struct t_tool_options
   bool enable_preprocessing      = true;
 };
 
-using ltscompare_base = input_tool;
+using ltscompare_base = parallel_tool<input_tool>;
 class ltscompare_tool : public ltscompare_base
 {
   private:
@@ -101,7 +102,7 @@ class ltscompare_tool : public ltscompare_base
         mCRL2log(verbose) << "comparing LTSs using " <<
                      tool_options.equivalence << "..." << std::endl;
 
-        result = destructive_compare(l1, l2, tool_options.equivalence, tool_options.generate_counter_examples, tool_options.counter_example_file, tool_options.structured_output);
+        result = destructive_compare(l1, l2, tool_options.equivalence, tool_options.generate_counter_examples, tool_options.counter_example_file, tool_options.structured_output, number_of_threads());
 
         mCRL2log(info) << "LTSs are " << ((result) ? "" : "not ")
                        << "equal ("
@@ -114,7 +115,7 @@ class ltscompare_tool : public ltscompare_base
                      description(tool_options.preorder) << "..."
                      " using the " << print_exploration_strategy(tool_options.strategy) << " strategy.\n";
 
-        result = destructive_compare(l1, l2, tool_options.preorder, tool_options.generate_counter_examples, tool_options.counter_example_file, tool_options.structured_output, tool_options.strategy, tool_options.enable_preprocessing);
+        result = destructive_compare(l1, l2, tool_options.preorder, tool_options.generate_counter_examples, tool_options.counter_example_file, tool_options.structured_output, tool_options.strategy, tool_options.enable_preprocessing, number_of_threads());
 
         if (!tool_options.structured_output)
         {
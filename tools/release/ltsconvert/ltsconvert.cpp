@@ -13,7 +13,10 @@ constexpr auto NAME = "ltsconvert";
 constexpr auto AUTHOR = "Muck van Weerdenburg, Jan Friso Groote";
 
 #include "mcrl2/utilities/input_output_tool.h"
+#include "mcrl2/utilities/parallel_tool.h"
 #include "mcrl2/lts/lts_io.h"
+#include "mcrl2/lts/detail/lts_columnar_io.h"
+#include "mcrl2/lts/mapped_lts.h"
 #include "mcrl2/lts/lts_algorithm.h"
 
 using namespace mcrl2::lts;
@@ -37,6 +40,7 @@ public:
   bool determinise = false;
   bool check_reach = true;
   bool add_state_as_state_label = false;
+  bool compress = false;
 
   inline std::string source_string() const
   {
@@ -125,24 +129,26 @@ public:
 
 };
 
-class ltsconvert_tool : public input_output_tool
+class ltsconvert_tool : public parallel_tool<input_output_tool>
 {
   private:
+    using super = parallel_tool<input_output_tool>;
+
     t_tool_options tool_options;
 
   public:
     ltsconvert_tool() :
-      input_output_tool(NAME,AUTHOR,
-                      "convert and optionally minimise an LTS",
-                      "Convert the labelled transition system (LTS) from INFILE to OUTFILE in the\n"
-                      "requested format after applying the selected minimisation method (default is\n"
-                      "none). If OUTFILE is not supplied, stdout is used. If INFILE is not supplied,\n"
-                      "stdin is used.\n"
-                      "\n"
-                      "The output format is determined by the extension of OUTFILE, whereas the input\n"
-                      "format is determined by the content of INFILE. Options --in and --out can be\n"
-                      "used to force the input and output formats. The supported formats are:\n"
-                      + mcrl2::lts::detail::supported_lts_formats_text(lts_lts)
+      super(NAME,AUTHOR,
+            "convert and optionally minimise an LTS",
+            "Convert the labelled transition system (LTS) from INFILE to OUTFILE in the\n"
+            "requested format after applying the selected minimisation method (default is\n"
+            "none). If OUTFILE is not supplied, stdout is used. If INFILE is not supplied,\n"
+            "stdin is used.\n"
+            "\n"
+            "The output format is determined by the extension of OUTFILE, whereas the input\n"
+            "format is determined by the content of INFILE. Options --in and --out can be\n"
+            "used to force the input and output formats. The supported formats are:\n"
+            + mcrl2::lts::detail::supported_lts_formats_text(lts_lts)
                      )
     {
     }
@@ -201,7 +207,7 @@ class ltsconvert_tool : public input_output_tool
           mCRL2log(verbose) << "Reducing LTS (modulo " <<  description(tool_options.equivalence) << ")..." << std::endl;
           mCRL2log(verbose) << "Before reduction: " << l.num_states() << " states and " << l.num_transitions() << " transitions." << std::endl;
           timer().start("reduction");
-          reduce(l,tool_options.equivalence);
+          reduce(l,tool_options.equivalence,number_of_threads());
           timer().finish("reduction");
           mCRL2log(verbose) << "After reduction: " << l.num_states() << " states and " << l.num_transitions() << " transitions." << std::endl;
         }
@@ -238,14 +244,14 @@ class ltsconvert_tool : public input_output_tool
         {
           lts_lts_t l_out;
           lts_convert(l,l_out,spec.data(),spec.action_labels(),spec.process().process_parameters(),!tool_options.lpsfile.empty());
-          l_out.save(tool_options.outfilename);
+          l_out.save(tool_options.outfilename, tool_options.compress);
           return true;
         }
         case lts_lts_probabilistic:
         {
           probabilistic_lts_lts_t l_out;
           lts_convert(l,l_out,spec.data(),spec.action_labels(),spec.process().process_parameters(),!tool_options.lpsfile.empty());
-          l_out.save(tool_options.outfilename);
+          l_out.save(tool_options.outfilename, tool_options.compress);
           return true;
         }
         case lts_none:
@@ -331,7 +337,7 @@ class ltsconvert_tool : public input_output_tool
   protected:
     void add_options(interface_description& desc) override
     {
-      input_output_tool::add_options(desc);
+      super::add_options(desc);
 
       desc.add_option("no-reach",
                       "do not perform a reachability check on the input LTS.");
@@ -385,6 +391,10 @@ class ltsconvert_tool : public input_output_tool
                       "consider actions with a name in the comma separated list ACTNAMES to "
                       "be internal (tau) actions in addition to those defined as such by "
                       "the input.");
+      desc.add_option("compress",
+                      "compress the output in blocks when it is written in the .lts format. Such files cannot "
+                      "be read by versions of the toolset that do not support compression. This option cannot be used for "
+                      "the .ltsc and .ltsm formats.");
       desc.add_hidden_option("add-state-as-state-label",
                              "add the state number as the label of the states in the input file, "
                              "and remove other state labels if they exist");
@@ -404,7 +414,7 @@ class ltsconvert_tool : public input_output_tool
 
     void parse_options(const command_line_parser& parser) override
     {
-      input_output_tool::parse_options(parser);
+      super::parse_options(parser);
 
       if (parser.options.count("lps"))
       {
@@ -465,6 +475,7 @@ class ltsconvert_tool : public input_output_tool
       tool_options.determinise                       = 0 < parser.options.count("determinise");
       tool_options.check_reach                       = parser.options.count("no-reach") == 0;
       tool_options.remove_state_information          = parser.options.count("no-state") != 0;
+      tool_options.compress                          = parser.options.count("compress") != 0;
 
       if (tool_options.determinise && (tool_options.equivalence != lts_eq_none))
       {
@@ -510,6 +521,12 @@ class ltsconvert_tool : public input_output_tool
           }
         }
       }
+
+      if (tool_options.compress && (mcrl2::lts::detail::has_columnar_lts_extension(tool_options.outfilename) ||
+                                    mcrl2::lts::detail::has_mapped_lts_extension(tool_options.outfilename)))
+      {
+        parser.error("cannot use --compress for the .ltsc and .ltsm output formats\n");
+      }
     }
 
 };
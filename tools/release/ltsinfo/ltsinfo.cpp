@@ -14,6 +14,7 @@ static constexpr const char* AUTHOR = "Muck van Weerdenburg";
 #include "mcrl2/utilities/input_tool.h"
 #include "mcrl2/lts/lts_io.h"
 #include "mcrl2/lts/lts_algorithm.h"
+#include "mcrl2/lts/mapped_lts.h"
 
 using namespace mcrl2::utilities::tools;
 using namespace mcrl2::utilities;
@@ -226,6 +227,18 @@ class ltsinfo_tool : public ltsinfo_base
 
     // Print the state labels for a probabilistic lts.
     void print_the_state_labels(const mcrl2::lts::probabilistic_lts_lts_t& l) const
+    {
+      print_lts_state_labels(l);
+    }
+
+    // Print the state labels for an lts in the mapped format.
+    void print_the_state_labels(const mcrl2::lts::mapped_lts& l) const
+    {
+      print_lts_state_labels(l);
+    }
+
+    template <class LTS_TYPE>
+    void print_lts_state_labels(const LTS_TYPE& l) const
     {
       if (print_state_labels)
       {
@@ -300,6 +313,67 @@ class ltsinfo_tool : public ltsinfo_base
       return true;
     }
 
+    // Provide the information of an lts in the mapped format, which is used without copying its transitions.
+    bool provide_mapped_information() const
+    {
+      const mcrl2::lts::mapped_lts l(infilename);
+
+      mCRL2log(info)
+          << "Number of states: " << l.num_states() << ".\n"
+          << "Number of action labels: " << l.num_action_labels() << " (including a tau label).\n"
+          << "Number of transitions: " << l.num_transitions() << ".\n";
+
+      if (l.has_state_info())
+      {
+        mCRL2log(info) << "Number of state labels: " << l.num_state_labels() << ".\n";
+      }
+      else if (!print_state_labels)
+      {
+        mCRL2log(info) << "There are no state labels." << std::endl;
+      }
+
+      mCRL2log(verbose) << "Checking reachability..." << std::endl;
+      std::vector<bool> reached(l.num_states(), false);
+      std::vector<std::size_t> todo(1, l.initial_state());
+      reached[l.initial_state()] = true;
+      std::size_t number_reached = 1;
+      while (!todo.empty())
+      {
+        const std::size_t s = todo.back();
+        todo.pop_back();
+        for (const mcrl2::lts::transition& t: l.outgoing_transitions(s))
+        {
+          if (!reached[t.to()])
+          {
+            reached[t.to()] = true;
+            ++number_reached;
+            todo.push_back(t.to());
+          }
+        }
+      }
+      if (number_reached != l.num_states())
+      {
+        mCRL2log(info) << "Warning: some states are not reachable from the initial state! (This might result in unspecified behaviour of LTS tools.)" << std::endl;
+      }
+
+      // The transitions are sorted on source, label and target, so nondeterminism shows up in consecutive transitions.
+      mCRL2log(verbose) << "Checking whether lts is deterministic..." << std::endl;
+      const std::span<const mcrl2::lts::transition> transitions = l.get_transitions();
+      const bool deterministic = std::adjacent_find(transitions.begin(), transitions.end(),
+          [](const mcrl2::lts::transition& t1, const mcrl2::lts::transition& t2)
+          {
+            return t1.from() == t2.from() && t1.label() == t2.label() && t1.to() != t2.to();
+          }) == transitions.end();
+      mCRL2log(info) << "LTS is " << (deterministic ? "" : "not ") << "deterministic." << std::endl;
+      mCRL2log(info) << "This lts has no probabilistic states.\n";
+
+      print_the_action_labels(l);
+      print_the_state_labels(l);
+      print_the_branching_factor(l);
+
+      return true;
+    }
+
   public:
 
     bool run() override
@@ -317,6 +391,10 @@ class ltsinfo_tool : public ltsinfo_base
         case lts_lts:
         case lts_lts_probabilistic:
         {
+          if (!infilename.empty() && is_mapped_lts_file(infilename))
+          {
+            return provide_mapped_information();
+          }
           return provide_information<probabilistic_lts_lts_t>();
         }
         case lts_none:
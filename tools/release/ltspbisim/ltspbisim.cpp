@@ -11,11 +11,13 @@ constexpr auto NAME = "ltspbisim";
 constexpr auto AUTHOR = "Hector Joao Rivera Verduzco";
 
 #include "mcrl2/utilities/input_output_tool.h"
+#include "mcrl2/utilities/parallel_tool.h"
 #include "mcrl2/lts/lts_probabilistic_equivalence.h"
 #include "mcrl2/lts/lts_io.h"
 #include "mcrl2/lts/lts_algorithm.h"
 #include "mcrl2/lts/detail/liblts_pbisim_bem.h"
 #include "mcrl2/lts/detail/liblts_pbisim_grv.h"
+#include "mcrl2/lts/detail/liblts_pbisim_sig.h"
 
 using namespace mcrl2::lts;
 using namespace mcrl2::utilities::tools;
@@ -82,14 +84,16 @@ class t_tool_options
 };
 
 
-class ltsconvert_tool : public input_output_tool
+class ltsconvert_tool : public parallel_tool<input_output_tool>
 {
   private:
+    using super = parallel_tool<input_output_tool>;
+
     t_tool_options tool_options;
 
   public:
     ltsconvert_tool() :
-      input_output_tool(NAME,AUTHOR,
+      super(NAME,AUTHOR,
                       "Convert and optionally minimise an LTS",
                       "Convert the labelled transition system (LTS) from INFILE to OUTFILE in the\n"
                       "requested format after applying the selected minimisation method (default is\n"
@@ -137,6 +141,11 @@ class ltsconvert_tool : public input_output_tool
             mcrl2::lts::detail::probabilistic_bisimulation_reduce_bem(l,timer());
             break;
           }
+          case lts_probabilistic_bisim_sig:
+          {
+            mcrl2::lts::detail::probabilistic_bisimulation_reduce_sig(l,timer(),number_of_threads());
+            break;
+          }
           default:
           break;
         }
@@ -245,12 +254,13 @@ class ltsconvert_tool : public input_output_tool
   protected:
     void add_options(interface_description& desc) override
     {
-      input_output_tool::add_options(desc);
+      super::add_options(desc);
     
       desc.add_option("equivalence",make_enum_argument<lts_probabilistic_equivalence>("NAME")
                       .add_value(lts_probabilistic_eq_none, true)
                       .add_value(lts_probabilistic_bisim_grv)
-                      .add_value(lts_probabilistic_bisim_bem),
+                      .add_value(lts_probabilistic_bisim_bem)
+                      .add_value(lts_probabilistic_bisim_sig),
                       "generate an equivalent LTS, preserving equivalence NAME:"
                       , 'e');
     }
@@ -269,7 +279,7 @@ class ltsconvert_tool : public input_output_tool
 
   void parse_options(const command_line_parser& parser) override
   {
-    input_output_tool::parse_options(parser);
+    super::parse_options(parser);
 
     if (parser.options.count("lps"))
     {
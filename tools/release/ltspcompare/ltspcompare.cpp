@@ -14,6 +14,7 @@
 #include "mcrl2/lts/lts_probabilistic_equivalence.h"
 #include "mcrl2/lts/detail/liblts_pbisim_grv.h"
 #include "mcrl2/lts/detail/liblts_pbisim_bem.h"
+#include "mcrl2/lts/detail/liblts_pbisim_sig.h"
 #include "mcrl2/lts/lts_io.h"
 
 using namespace mcrl2::lts;
@@ -108,6 +109,10 @@ class ltspcompare_tool : public ltscompare_base
         {
           result=destructive_probabilistic_bisimulation_compare_grv(l1, l2, timer());
         }
+        else if (tool_options.equivalence==lts_probabilistic_bisim_sig)
+        {
+          result=destructive_probabilistic_bisimulation_compare_sig(l1, l2, timer());
+        }
         else 
         {
           throw mcrl2::runtime_error("Unknown equivalence to compare probabilistic transition systems:" + 
@@ -227,7 +232,8 @@ class ltspcompare_tool : public ltscompare_base
       add_option("equivalence", make_enum_argument<lts_probabilistic_equivalence>("NAME)")
                  .add_value(lts_probabilistic_eq_none, true)
                  .add_value(lts_probabilistic_bisim_grv)
-                 .add_value(lts_probabilistic_bisim_bem),
+                 .add_value(lts_probabilistic_bisim_bem)
+                 .add_value(lts_probabilistic_bisim_sig),
                  "use equivalence NAME (not allowed in combination with -p/--preorder):", 'e').
       add_option("preorder", make_enum_argument<lts_probabilistic_preorder>("NAME")
                  .add_value(lts_probabilistic_pre_none, true),
@@ -13,14 +13,16 @@
 #include "mcrl2/lps/io.h"
 #include "mcrl2/lps/linearise.h"
 #include "mcrl2/utilities/input_output_tool.h"
+#include "mcrl2/utilities/parallel_tool.h"
 #include "mcrl2/data/rewriter_tool.h"
 
 using mcrl2::utilities::tools::input_output_tool;
+using mcrl2::utilities::tools::parallel_tool;
 using mcrl2::data::tools::rewriter_tool;
 
-class mcrl22lps_tool : public rewriter_tool< input_output_tool >
+class mcrl22lps_tool : public parallel_tool< rewriter_tool< input_output_tool > >
 {
-  using super = rewriter_tool<input_output_tool>;
+  using super = parallel_tool<rewriter_tool<input_output_tool>>;
 
 private:
   mcrl2::lps::t_lin_options m_linearisation_options;
@@ -165,6 +167,7 @@ protected:
       }
 
       m_linearisation_options.rewrite_strategy = rewrite_strategy();
+      m_linearisation_options.number_of_threads = number_of_threads();
     }
 
   public:
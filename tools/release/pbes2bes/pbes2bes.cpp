@@ -188,7 +188,7 @@ class pbes2bes_tool: public rewriter_tool<pbes_input_tool<pbes_output_tool<input
 
       timer().finish("instantiation");
 
-      mcrl2::pbes_system::save_pbes(bes, output_filename(), pbes_output_format());
+      mcrl2::pbes_system::save_pbes(bes, output_filename(), pbes_output_format(), true, compress_output());
 
       return true;
     }
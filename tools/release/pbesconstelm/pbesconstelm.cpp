@@ -77,7 +77,7 @@ class pbes_constelm_tool: public pbes_input_tool<pbes_output_tool<pbes_rewriter_
       constelm(p, rewrite_strategy(), rewriter_type(), m_compute_conditions, m_remove_redundant_equations, m_check_quantifiers);
 
       // save the result
-      save_pbes(p, output_filename(), pbes_output_format());
+      save_pbes(p, output_filename(), pbes_output_format(), true, compress_output());
       return true;
     }
 
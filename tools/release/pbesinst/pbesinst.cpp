@@ -205,7 +205,7 @@ class pbesinst_tool: public rewriter_tool<pbes_input_output_tool<input_output_to
       }
 
       // save the result
-      pbes_system::save_pbes(p, output_filename(), pbes_output_format());
+      pbes_system::save_pbes(p, output_filename(), pbes_output_format(), true, compress_output());
 
       return true;
     }
@@ -64,7 +64,7 @@ public:
     parelm(p, ignore_cex);
 
     // save the result
-    save_pbes(p, output_filename(), pbes_output_format());
+    save_pbes(p, output_filename(), pbes_output_format(), true, compress_output());
 
     return true;
     }
@@ -152,7 +152,7 @@ class pbes_rewriter : public pbes_input_tool<pbes_output_tool<pbes_rewriter_tool
           pbes_system::detail::instantiate_global_variables(p);
           pbes_system::algorithms::normalize(p);
           auto result = pbes2srf(p,true);
-          save_pbes(result.to_pbes(), output_filename(), m_pbes_output_format);  
+          save_pbes(result.to_pbes(), output_filename(), m_pbes_output_format, true, compress_output());  
           return true;
           break;
         }
@@ -161,7 +161,7 @@ class pbes_rewriter : public pbes_input_tool<pbes_output_tool<pbes_rewriter_tool
           pbes_system::detail::instantiate_global_variables(p);
           pbes_system::algorithms::normalize(p);
           auto result = pbes2pre_srf(p);
-          save_pbes(result.to_pbes(), output_filename(), m_pbes_output_format);  
+          save_pbes(result.to_pbes(), output_filename(), m_pbes_output_format, true, compress_output());  
           return true;
           break;    
         }
@@ -180,13 +180,13 @@ class pbes_rewriter : public pbes_input_tool<pbes_output_tool<pbes_rewriter_tool
         case pbes_rewriter_type::remove_cex_variables:
         {
           auto result = pbes_system::detail::remove_counterexample_info(p, true, true, false);
-          save_pbes(result, output_filename(), m_pbes_output_format);
+          save_pbes(result, output_filename(), m_pbes_output_format, true, compress_output());
           return true;
           break;
         }
       }
       
-      save_pbes(p, output_filename(), m_pbes_output_format);
+      save_pbes(p, output_filename(), m_pbes_output_format, true, compress_output());
       return true;
     }
 
@@ -93,7 +93,7 @@ protected:
 
       stategraph(p, options);
 
-      save_pbes(p, output_filename(), pbes_output_format(), false);
+      save_pbes(p, output_filename(), pbes_output_format(), false, compress_output());
       if (!p.is_well_typed())
       {
         mCRL2log(log::error) << "pbesstategraph error: not well typed!" << std::endl;
@@ -47,7 +47,7 @@ public:
       std::ifstream from(input_filename().c_str());
       p = pbes_system::txt2pbes(from);
     }
-    pbes_system::save_pbes(p, output_filename(), pbes_output_format());
+    pbes_system::save_pbes(p, output_filename(), pbes_output_format(), true, compress_output());
     return true;
     }
 };
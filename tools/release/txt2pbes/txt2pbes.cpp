@@ -74,7 +74,7 @@ protected:
         }
         p = txt2pbes(instream, m_normalize);
       }
-      save_pbes(p, output_filename(), pbes_output_format());
+      save_pbes(p, output_filename(), pbes_output_format(), true, compress_output());
       return true;
     }
 };